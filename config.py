@@ -112,6 +112,8 @@ class configuration:
                       'src/Cmfd.cpp',
                       'src/CPUSolver.cpp',
                       'src/CPULSSolver.cpp',
+                      'src/CriticalitySearch.cpp',
+                      'src/EigenmodeSolver.cpp',
                       'src/ExpEvaluator.cpp',
                       'src/Geometry.cpp',
                       'src/linalg.cpp',
@@ -119,14 +121,17 @@ class configuration:
                       'src/log.cpp',
                       'src/Material.cpp',
                       'src/Matrix.cpp',
+                      'src/memory_accounting.cpp',
                       'src/Mesh.cpp',
                       'src/MOCKernel.cpp',
                       'src/Point.cpp',
                       'src/Progress.cpp',
                       'src/Quadrature.cpp',
                       'src/Region.cpp',
+                      'src/ResourceEstimator.cpp',
                       'src/RunTime.cpp',
                       'src/Solver.cpp',
+                      'src/SPHSolver.cpp',
                       'src/Surface.cpp',
                       'src/Timer.cpp',
                       'src/Track.cpp',
@@ -16,3 +16,49 @@ void expH_fractional(FP_PRECISION INPUT, FP_PRECISION* OUTPUT);
 void expG_fractional(FP_PRECISION INPUT, FP_PRECISION* OUTPUT);
 void expG2_fractional(FP_PRECISION INPUT, FP_PRECISION* OUTPUT);
 void cram7(FP_PRECISION INPUT, FP_PRECISION* OUTPUT);
+
+
+/* Calls a Python callable as the parameter callback of a CriticalitySearch,
+ * a Python exception is reported and stops the search */
+%{
+  static void python_parameter_callback(double parameter, void* data) {
+    PyObject* result = PyObject_CallFunction((PyObject*) data, "d",
+                                             parameter);
+    if (result == NULL) {
+      PyErr_Print();
+      log_printf(ERROR, "The criticality search parameter callback failed "
+                 "for parameter %f", parameter);
+    }
+    Py_XDECREF(result);
+  }
+%}
+
+/* CriticalitySearch::setParameterCallback takes a Python callable of the
+ * parameter or None. The search holds a reference to the callable, which is
+ * released when the callable is replaced or the search is destroyed. */
+%ignore CriticalitySearch::setParameterCallback;
+%ignore CriticalitySearch::getParameterCallbackData;
+%rename(setParameterCallback) CriticalitySearch::setPythonParameterCallback;
+
+%extend CriticalitySearch {
+
+  void setPythonParameterCallback(PyObject* callback) {
+    if (callback != Py_None && !PyCallable_Check(callback))
+      log_printf(ERROR, "The parameter callback must be a callable or None");
+
+    PyObject* previous = (PyObject*) $self->getParameterCallbackData();
+    if (callback == Py_None)
+      $self->setParameterCallback(NULL, NULL);
+    else {
+      Py_INCREF(callback);
+      $self->setParameterCallback(python_parameter_callback,
+                                  (void*) callback);
+    }
+    Py_XDECREF(previous);
+  }
+
+  ~CriticalitySearch() {
+    Py_XDECREF((PyObject*) $self->getParameterCallbackData());
+    delete $self;
+  }
+}
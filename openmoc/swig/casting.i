@@ -13,6 +13,10 @@
     return dynamic_cast<Universe*>(lattice);
   }
 
+  HexLattice* castUniverseToHexLattice(Universe* universe) {
+    return dynamic_cast<HexLattice*>(universe);
+  }
+
   Intersection* castRegionToIntersection(Region* region) {
     return dynamic_cast<Intersection*>(region);
   }
@@ -169,3 +169,78 @@
     }
   }
 }
+
+
+/* Typemap for HexLattice::setUniverses(int num_z, int num_rings,
+ *                                        Universe** universes)
+ * method - allows users to pass in Python lists of rows of Universes for
+ * each axial level of a hexagonal lattice */
+%typemap(in) (int num_z, int num_rings, Universe** universes) {
+
+  if (!PyList_Check($input)) {
+    PyErr_SetString(PyExc_ValueError,"Expected a Python list of rows of "
+                    "Universes for the HexLattice cells");
+    SWIG_fail;
+  }
+
+  $1 = PySequence_Length($input);  // num_z
+  if ($1 == 0) {
+    PyErr_SetString(PyExc_ValueError, "Expected at least one axial level of "
+                    "Universes in input to HexLattice:setUniverses method");
+    SWIG_fail;
+  }
+
+  int num_rows = PySequence_Length(PyList_GetItem($input,0));
+  $2 = (num_rows + 1) / 2; // num_rings
+  int num_cells = 3 * $2 * ($2 - 1) + 1;
+
+  if (num_rows % 2 == 0) {
+    PyErr_SetString(PyExc_ValueError, "Expected an odd number of rows of "
+                    "Universes in input to HexLattice:setUniverses method");
+    SWIG_fail;
+  }
+
+  $3 = (Universe**) malloc(($1 * num_cells) * sizeof(Universe*)); // universes
+
+  /* Loop over the xy-planes */
+  int index = 0;
+  for (int k = 0; k < $1; k++) {
+
+    /* Check that the k-th xy-plane has as many rows as the 1st xy-plane */
+    PyObject* outer_outer_list = PyList_GetItem($input,k);
+    if (!PyList_Check(outer_outer_list) ||
+        PySequence_Length(outer_outer_list) != num_rows) {
+      PyErr_SetString(PyExc_ValueError, "Size mismatch in the number of rows "
+                      "of Universes in the axial levels in input to "
+                      "HexLattice:setUniverses method");
+      SWIG_fail;
+    }
+
+    /* Loop over rows from the top */
+    for (int j = 0; j < num_rows; j++) {
+
+      /* Check that the j-th row has 2 * num_rings - 1 - |r| universes */
+      PyObject* outer_list = PyList_GetItem(outer_outer_list, j);
+      if (PySequence_Length(outer_list) != num_rows - abs($2 - 1 - j)) {
+        PyErr_SetString(PyExc_ValueError, "Size mismatch in the rows of "
+                        "Universes in input to HexLattice:setUniverses "
+                        "method");
+        SWIG_fail;
+      }
+
+      /* Loop over universes in the j-th row of the k-th xy-plane */
+      for (int i = 0; i < PySequence_Length(outer_list); i++) {
+        PyObject* o = PyList_GetItem(outer_list, i);
+        void *p1 = 0;
+        SWIG_ConvertPtr(o, &p1, SWIGTYPE_p_Universe, 0 | 0);
+        $3[index++] = (Universe*) p1;
+      }
+    }
+  }
+}
+
+
+/* Free the Universes array, which HexLattice::setUniverses copies */
+%typemap(freearg) (int num_z, int num_rings, Universe** universes) {
+  free($3);
+}
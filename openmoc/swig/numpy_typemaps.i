@@ -75,6 +75,19 @@
 /* The typemap used to match the method signature for Solver::setFluxes */
 %apply (FP_PRECISION* INPLACE_ARRAY1, int DIM1) {(FP_PRECISION* in_fluxes, int num_fluxes)}
 
+/* The typemap used to match the method signature for
+ * EigenmodeSolver::getEigenmode */
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* eigenmode, int num_fluxes)}
+
+/* The typemap used to match the method signature for
+ * Material::scaleCrossSections */
+%apply (double* IN_ARRAY1, int DIM1) {(double* factors, int num_groups)}
+
+/* The typemaps used to match the method signatures for
+ * SPHSolver::setReferenceFluxes and SPHSolver::getSPHFactors */
+%apply (double* IN_ARRAY1, int DIM1) {(double* reference_fluxes, int num_domains_groups)}
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* out_sph_factors, int num_domains_groups)}
+
 /* The typemap used to match the method signature for Mesh::getFormattedReactionRates */
 %typemap(out) std::vector<std::vector<std::vector<FP_PRECISION> > >& 
 {
@@ -17,23 +17,28 @@
   #include "../../src/Cell.h"
   #include "../../src/Cmfd.h"
   #include "../../src/constants.h"
+  #include "../../src/CriticalitySearch.h"
   #include "../../src/ExpEvaluator.h"
   #include "../../src/Geometry.h"
   #include "../../src/linalg.h"
   #include "../../src/log.h"
   #include "../../src/Material.h"
   #include "../../src/Matrix.h"
+  #include "../../src/memory_accounting.h"
   #include "../../src/Mesh.h"
   #include "../../src/LocalCoords.h"
   #include "../../src/Point.h"
   #include "../../src/Progress.h"
   #include "../../src/Quadrature.h"
   #include "../../src/Region.h"
+  #include "../../src/ResourceEstimator.h"
   #include "../../src/RunTime.h"
   #include "../../src/segmentation_type.h"
   #include "../../src/Solver.h"
   #include "../../src/CPUSolver.h"
   #include "../../src/CPULSSolver.h"
+  #include "../../src/EigenmodeSolver.h"
+  #include "../../src/SPHSolver.h"
   #include "../../src/Surface.h"
   #include "../../src/Timer.h"
   #include "../../src/Track.h"
@@ -156,6 +161,7 @@ namespace std {
 %include ../../src/log.h
 %include ../../src/Material.h
 %include ../../src/Matrix.h
+%include ../../src/memory_accounting.h
 %include ../../src/Mesh.h
 %include ../../src/LocalCoords.h
 %include ../../src/Point.h
@@ -167,6 +173,9 @@ namespace std {
 %include ../../src/Solver.h
 %include ../../src/CPUSolver.h
 %include ../../src/CPULSSolver.h
+%include ../../src/EigenmodeSolver.h
+%include ../../src/SPHSolver.h
+%include ../../src/CriticalitySearch.h
 %include ../../src/Surface.h
 %include ../../src/Timer.h
 %include ../../src/Track.h
@@ -175,6 +184,7 @@ namespace std {
 %include ../../src/TrackGenerator3D.h
 %include ../../src/TraverseSegments.h
 %include ../../src/TrackTraversingAlgorithms.h
+%include ../../src/ResourceEstimator.h
 %include ../../src/Universe.h
 %include ../../src/Vector.h
 
@@ -158,6 +158,26 @@
                     universes[i][j][k].thisown = False
 %}
 
+/* A HexLattice owns the memory for each Universe it contains */
+%pythonappend HexLattice::setUniverses %{
+        # SWIG 3
+        if 'num_z' in locals():
+            universes = locals()['num_z']
+        elif 'args' in locals() and 'num_z' in locals()['args']:
+            universes = locals()['args']['num_z']
+        elif 'kwargs' in locals() and 'num_z' in locals()['kwargs']:
+            universes = locals()['kwargs']['num_z']
+
+        # SWIG 2
+        else:
+            universes = locals()['args'][0]
+
+        for i in range(len(universes)):
+            for j in range(len(universes[i])):
+                for k in range(len(universes[i][j])):
+                    universes[i][j][k].thisown = False
+%}
+
 /* A Lattice owns the memory for each Universe it contains */
 %pythonappend Lattice::updateUniverse %{
         # SWIG 3
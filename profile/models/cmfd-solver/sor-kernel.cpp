@@ -0,0 +1,133 @@
+#include "../../../src/linalg.h"
+#include "../../../src/Timer.h"
+#include "../../../src/log.h"
+#include <iostream>
+
+/**
+ * @brief Fills a CMFD-like loss and production matrix pair on a regular mesh.
+ * @details The loss matrix has a 7-point diffusion stencil in each group, and
+ *          a dense in-cell scattering block with down- and up-scattering. The
+ *          production matrix has a fission spectrum in the first groups.
+ */
+void fillMatrices(Matrix* A, Matrix* M, int nx, int ny, int nz, int ng) {
+
+  double width = 1.26;
+  for (int i=0; i < nx*ny*nz; i++) {
+
+    int ix = i % nx;
+    int iy = (i / nx) % ny;
+    int iz = i / (nx * ny);
+    int neighbors[NUM_FACES] = {ix > 0 ? i-1 : -1, iy > 0 ? i-nx : -1,
+                                iz > 0 ? i-nx*ny : -1, ix < nx-1 ? i+1 : -1,
+                                iy < ny-1 ? i+nx : -1,
+                                iz < nz-1 ? i+nx*ny : -1};
+
+    for (int e=0; e < ng; e++) {
+
+      double dif_coef = 1.5 - e / double(ng);
+      double sigma_t = 0.3 + 0.7 * e / double(ng);
+      double dif_surf = 2 * dif_coef / (width * (1 + 2 * dif_coef / width));
+      A->incrementValue(i, e, i, e, sigma_t * width);
+
+      for (int s=0; s < NUM_FACES; s++) {
+        A->incrementValue(i, e, i, e, dif_surf);
+        if (neighbors[s] != -1)
+          A->incrementValue(neighbors[s], e, i, e, -dif_surf);
+      }
+
+      /* Scattering from all groups, mostly down-scattering */
+      for (int g=0; g < ng; g++) {
+        if (g == e)
+          continue;
+        double sigma_s = (g < e) ? 0.1 / (e - g) : 0.01 / (g - e);
+        if (g != e && sigma_s > 1e-3)
+          A->incrementValue(i, g, i, e, -sigma_s * sigma_t * width / ng);
+      }
+
+      /* Fission */
+      double chi = (e < ng / 2 + 1) ? 2.0 / (ng + 2) : 0.0;
+      for (int g=0; g < ng; g++)
+        M->incrementValue(i, g, i, e, chi * 1.5 * (1 + g) / ng * width);
+    }
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+
+#ifdef MPIx
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+  log_set_ranks(MPI_COMM_WORLD);
+#endif
+
+  /* Define benchmark parameters */
+  int nx = 34;
+  int ny = 34;
+  int nz = 10;
+  int ng = 8;
+  int num_solves = 3;
+  if (argc > 4) {
+    nx = atoi(argv[1]);
+    ny = atoi(argv[2]);
+    nz = atoi(argv[3]);
+    ng = atoi(argv[4]);
+  }
+  double tolerance = 1e-5;
+  double SOR_factor = 1.5;
+
+  set_log_level("NORMAL");
+  log_printf(TITLE, "Benchmarking the CMFD red-black SOR kernels");
+  log_printf(NORMAL, "CMFD mesh %d x %d x %d, %d groups, %d threads", nx, ny,
+             nz, ng, omp_get_max_threads());
+
+  /* Create the linear algebra objects */
+  int num_cells = nx * ny * nz;
+  omp_lock_t* cell_locks = new omp_lock_t[num_cells];
+  for (int i=0; i < num_cells; i++)
+    omp_init_lock(&cell_locks[i]);
+
+  Matrix A(cell_locks, nx, ny, nz, ng);
+  Matrix M(cell_locks, nx, ny, nz, ng);
+  Vector X(cell_locks, nx, ny, nz, ng);
+  fillMatrices(&A, &M, nx, ny, nz, ng);
+
+  Timer* timer = new Timer();
+  std::string kernels[2] = {"CSR", "Structured stencil"};
+  double k_eff[2];
+  for (int k=0; k < 2; k++) {
+
+    A.useStructuredStencil(k == 1);
+    A.getA();
+
+    /* Time repeated eigenvalue solves from a flat guess */
+    timer->startTimer();
+    for (int n=0; n < num_solves; n++) {
+      X.setAll(1.0);
+      ConvergenceData convergence_data;
+      k_eff[k] = eigenvalueSolve(&A, &M, &X, 1.0, tolerance, SOR_factor,
+                                 &convergence_data);
+    }
+    timer->stopTimer();
+    timer->recordSplit(kernels[k].c_str());
+
+    log_printf(RESULT, "%s kernel: k_eff = %1.6f, time per solve = %6.4e s",
+               kernels[k].c_str(), k_eff[k],
+               timer->getSplit(kernels[k].c_str()) / num_solves);
+  }
+
+  log_printf(RESULT, "Structured stencil speedup = %4.2f",
+             timer->getSplit(kernels[0].c_str()) /
+             timer->getSplit(kernels[1].c_str()));
+
+  for (int i=0; i < num_cells; i++)
+    omp_destroy_lock(&cell_locks[i]);
+  delete [] cell_locks;
+  delete timer;
+
+  log_printf(TITLE, "Finished");
+#ifdef MPIx
+  MPI_Finalize();
+#endif
+  return 0;
+}
@@ -3,59 +3,32 @@
 #include "log.h"
 #include "Mesh.h"
 #include "RunTime.h"
+#include "../synthetic-core/synthetic-core.h"
 #include <array>
 #include <iostream>
 
-int main(int argc, char* argv[]) {
+/**
+ * @brief Creates the Geometry and its CMFD mesh, and initializes the FSRs.
+ * @details The Geometry is loaded from the geometry file, or built from the
+ *          parameters of a synthetic core.
+ * @param runtime the run time options
+ * @return the Geometry
+ */
+Geometry* createGeometry(RuntimeParameters& runtime) {
 
-#ifdef MPIx
-  int provided;
-  MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
-  log_set_ranks(MPI_COMM_WORLD);
-  if (provided < MPI_THREAD_SERIALIZED) {
-    log_printf(ERROR, "Not enough thread support level in the MPI library");  
+  log_printf(NORMAL, "Creating geometry...");
+  Geometry *geometry;
+  if(!runtime._synthetic_core.empty()) {
+    SyntheticCoreParameters parameters;
+    parameters.setParameters(runtime._synthetic_core);
+    geometry = create_synthetic_core(parameters);
   }
-#endif
-  
-  int arg_index = 0;
-  std::string msg_string;
-  while (arg_index < argc) {
-    msg_string += argv[arg_index];
-    msg_string += " ";
-    arg_index++;
+  else {
+    geometry = new Geometry();
+    if(runtime._geo_filename.empty())
+      log_printf(ERROR, "No geometry file is provided");
+    geometry->loadFromFile(runtime._geo_filename);
   }
-  
-  RuntimeParameters runtime;
-  runtime.setRuntimeParameters(argc, argv);
-  
-  /* stuck here for debug tools to attach */
-  while (runtime._debug_flag) ;
-  
-  /* Define simulation parameters */
-#ifdef OPENMP
-  int num_threads = runtime._num_threads;
-#else
-  int num_threads = 1;
-#endif
-
-  /* Set logging information */
-  if(runtime._log_filename)
-    set_log_filename(runtime._log_filename);
-  set_log_level(runtime._log_level);
-  set_line_length(120);
-
-  log_printf(NORMAL, "Run-time options: %s", msg_string.c_str());
-  log_printf(NORMAL, "Azimuthal spacing = %f", runtime._azim_spacing);
-  log_printf(NORMAL, "Azimuthal angles = %d", runtime._num_azim);
-  log_printf(NORMAL, "Polar spacing = %f", runtime._polar_spacing);
-  log_printf(NORMAL, "Polar angles = %d", runtime._num_polar);
-
-  /* Create the geometry */
-  log_printf(NORMAL, "Creating geometry...");
-  Geometry *geometry = new Geometry();
-  if(runtime._geo_filename.empty())
-    log_printf(ERROR, "No geometry file is provided");
-  geometry->loadFromFile(runtime._geo_filename);
 #ifdef MPIx
   geometry->setDomainDecomposition(runtime._NDx, runtime._NDy, runtime._NDz, 
                                    MPI_COMM_WORLD); 
@@ -69,8 +42,6 @@ int main(int argc, char* argv[]) {
     /* Create CMFD mesh */
     log_printf(NORMAL, "Creating CMFD mesh...");
     Cmfd* cmfd = new Cmfd();
-    cmfd->setSORRelaxationFactor(runtime._SOR_factor);
-    cmfd->setCMFDRelaxationFactor(runtime._CMFD_relaxation_factor);
     if(runtime._cell_widths_x.empty() || runtime._cell_widths_y.empty() ||
         runtime._cell_widths_z.empty()) 
       cmfd->setLatticeStructure(runtime._NCx, runtime._NCy, runtime._NCz);
@@ -81,16 +52,40 @@ int main(int argc, char* argv[]) {
     }
     if (!runtime._CMFD_group_structure.empty())
       cmfd->setGroupStructure(runtime._CMFD_group_structure);
-    cmfd->setKNearest(runtime._knearest);
-    cmfd->setCentroidUpdateOn(runtime._CMFD_centroid_update_on);
-    cmfd->useAxialInterpolation(runtime._use_axial_interpolation);
     
     geometry->setCmfd(cmfd);
   }
 
   geometry->initializeFlatSourceRegions();
+  return geometry;
+}
+
+
+/**
+ * @brief Applies the CMFD solver options, which do not change the Geometry.
+ * @param cmfd the Cmfd of the Geometry
+ * @param runtime the run time options
+ */
+void setCmfdOptions(Cmfd* cmfd, RuntimeParameters& runtime) {
+  cmfd->setSORRelaxationFactor(runtime._SOR_factor);
+  cmfd->setCMFDRelaxationFactor(runtime._CMFD_relaxation_factor);
+  cmfd->setKNearest(runtime._knearest);
+  cmfd->setCentroidUpdateOn(runtime._CMFD_centroid_update_on);
+  cmfd->useAxialInterpolation(runtime._use_axial_interpolation);
+}
+
+
+/**
+ * @brief Creates the TrackGenerator and generates the Tracks.
+ * @param geometry the Geometry
+ * @param runtime the run time options
+ * @param num_threads the number of OpenMP threads
+ * @return the TrackGenerator
+ */
+TrackGenerator3D* createTrackGenerator(Geometry* geometry,
+                                       RuntimeParameters& runtime,
+                                       int num_threads) {
 
-  /* Initialize track generator and generate tracks */
   log_printf(NORMAL, "Initializing the track generator...");
   Quadrature* quad = NULL;
   switch(runtime._quadraturetype) {
@@ -103,40 +98,79 @@ int main(int argc, char* argv[]) {
 
   quad->setNumAzimAngles(runtime._num_azim);
   quad->setNumPolarAngles(runtime._num_polar);
-  TrackGenerator3D track_generator(geometry, runtime._num_azim, 
-                                   runtime._num_polar, runtime._azim_spacing,
-                                   runtime._polar_spacing);
-  track_generator.setNumThreads(num_threads);
-  track_generator.setQuadrature(quad);
-  track_generator.setSegmentFormation((segmentationType)
-                                      runtime._segmentation_type);
+  TrackGenerator3D* track_generator =
+      new TrackGenerator3D(geometry, runtime._num_azim, runtime._num_polar,
+                           runtime._azim_spacing, runtime._polar_spacing);
+  track_generator->setNumThreads(num_threads);
+  track_generator->setQuadrature(quad);
+  track_generator->setSegmentFormation((segmentationType)
+                                       runtime._segmentation_type);
   if(!runtime._seg_zones.empty())
-    track_generator.setSegmentationZones(runtime._seg_zones);
-  track_generator.generateTracks();
+    track_generator->setSegmentationZones(runtime._seg_zones);
+  track_generator->generateTracks();
+  return track_generator;
+}
+
+
+/**
+ * @brief Sets a cross section of a Material to a multiple of the cross
+ *        section of another Material.
+ * @details The absorption cross section is recomputed when the total or
+ *          scattering cross sections are perturbed.
+ * @param material the Material to modify
+ * @param xs the cross section, sigma_t, sigma_a, sigma_s, sigma_f or
+ *        nu_sigma_f
+ * @param values the Material with the cross section values
+ * @param factor the multiplication factor
+ */
+void setMaterialXS(Material* material, std::string xs, Material* values,
+                   double factor) {
+
+  int num_groups = material->getNumEnergyGroups();
+  for (int g=1; g <= num_groups; g++) {
+    if (xs == "sigma_t")
+      material->setSigmaTByGroup(factor * values->getSigmaTByGroup(g), g);
+    else if (xs == "sigma_a")
+      material->setSigmaAByGroup(factor * values->getSigmaAByGroup(g), g);
+    else if (xs == "sigma_f")
+      material->setSigmaFByGroup(factor * values->getSigmaFByGroup(g), g);
+    else if (xs == "nu_sigma_f")
+      material->setNuSigmaFByGroup(factor * values->getNuSigmaFByGroup(g), g);
+    else if (xs == "sigma_s")
+      for (int gp=1; gp <= num_groups; gp++)
+        material->setSigmaSByGroup(factor * values->getSigmaSByGroup(g, gp),
+                                   g, gp);
+    else
+      log_printf(ERROR, "Unable to perturb the unknown cross section %s",
+                 xs.c_str());
+  }
+
+  /* Recompute the absorption cross section from the perturbed total and
+   * scattering cross sections */
+  if (xs == "sigma_t" || xs == "sigma_s") {
+    for (int g=1; g <= num_groups; g++) {
+      double sigma_a = material->getSigmaTByGroup(g);
+      for (int gp=1; gp <= num_groups; gp++)
+        sigma_a -= material->getSigmaSByGroup(g, gp);
+      material->setSigmaAByGroup(sigma_a, g);
+    }
+  }
+}
+
+
+/**
+ * @brief Prints the reaction rates of the output meshes.
+ * @param solver the Solver of the calculation
+ * @param runtime the run time options
+ */
+void printReactionRates(CPUSolver* solver, RuntimeParameters& runtime) {
 
-  /* Initialize solver and run simulation */
-  CPUSolver *solver = NULL;
-  if(runtime._linear_solver)
-    solver= new CPULSSolver(&track_generator);
-  else
-    solver= new CPUSolver(&track_generator);
-  if(runtime._verbose_report)
-    solver->setVerboseIterationReport();
-  solver->setNumThreads(num_threads);
-  solver->setConvergenceThreshold(runtime._tolerance);
-  solver->computeEigenvalue(runtime._max_iters, 
-                           (residualType)runtime._MOC_src_residual_type);
-  if(runtime._time_report)
-    solver->printTimerReport();
-
-  /* Extract reaction rates */
   int my_rank = 0;
 #ifdef MPIx
   MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
 #endif
   std::string rxtype[4] = {"FISSION_RX", "TOTAL_RX", "ABSORPTION_RX", "FLUX_RX"};
                           
-
   for(int m=0; m< runtime._output_mesh_lattices.size(); m++) {
     Mesh mesh(solver);
     mesh.createLattice(runtime._output_mesh_lattices[m][0], 
@@ -185,6 +219,245 @@ int main(int argc, char* argv[]) {
       }
     }
   }
+}
+
+
+int main(int argc, char* argv[]) {
+
+#ifdef MPIx
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+  log_set_ranks(MPI_COMM_WORLD);
+  if (provided < MPI_THREAD_SERIALIZED) {
+    log_printf(ERROR, "Not enough thread support level in the MPI library");  
+  }
+#endif
+  
+  int arg_index = 0;
+  std::string msg_string;
+  while (arg_index < argc) {
+    msg_string += argv[arg_index];
+    msg_string += " ";
+    arg_index++;
+  }
+  
+  RuntimeParameters runtime;
+  runtime.setRuntimeParameters(argc, argv);
+  
+  /* stuck here for debug tools to attach */
+  while (runtime._debug_flag) ;
+  
+  /* Set logging information */
+  if(runtime._log_filename)
+    set_log_filename(runtime._log_filename);
+  set_log_level(runtime._log_level);
+  set_line_length(120);
+  set_memory_budget(runtime._memory_budget);
+
+  log_printf(NORMAL, "Run-time options: %s", msg_string.c_str());
+
+  /* Read the cases of a batch, or run the command line case */
+  std::vector<std::vector<std::string> > case_options;
+  if (!runtime._batch_filename.empty()) {
+    case_options = runtime.readBatchFile();
+    if (case_options.empty())
+      log_printf(ERROR, "No case found in the batch file %s",
+                 runtime._batch_filename.c_str());
+  }
+  else
+    case_options.resize(1);
+  int num_cases = case_options.size();
+
+  /* The objects shared by consecutive cases, and their options */
+  Geometry* geometry = NULL;
+  TrackGenerator3D* track_generator = NULL;
+  CPUSolver* solver = NULL;
+  RuntimeParameters previous;
+
+  /* Setup times and results of the cases */
+  Timer timer;
+  int num_geometries = 0;
+  int num_track_layouts = 0;
+  double setup_time = 0.;
+  double unshared_setup_time = 0.;
+  double geometry_time = 0.;
+  double track_time = 0.;
+  std::vector<double> keffs(num_cases);
+  std::vector<int> num_iterations(num_cases);
+  std::vector<double> solve_times(num_cases);
+
+  for (int c=0; c < num_cases; c++) {
+
+    /* Override the command line options with the case options, which must
+       be kept for the options pointing to them */
+    RuntimeParameters case_runtime = runtime;
+    std::vector<char*> case_argv;
+    for (size_t i=0; i < case_options[c].size(); i++)
+      case_argv.push_back(&case_options[c][i][0]);
+    if (!case_argv.empty()) {
+      std::string case_string;
+      for (size_t i=0; i < case_options[c].size(); i++)
+        case_string += case_options[c][i] + " ";
+      log_printf(TITLE, "Case %d of %d", c+1, num_cases);
+      log_printf(NORMAL, "Case options: %s", case_string.c_str());
+      case_runtime.setRuntimeParameters(case_argv.size(), &case_argv[0]);
+    }
+
+    log_printf(NORMAL, "Azimuthal spacing = %f", case_runtime._azim_spacing);
+    log_printf(NORMAL, "Azimuthal angles = %d", case_runtime._num_azim);
+    log_printf(NORMAL, "Polar spacing = %f", case_runtime._polar_spacing);
+    log_printf(NORMAL, "Polar angles = %d", case_runtime._num_polar);
+
+    /* Define simulation parameters */
+#ifdef OPENMP
+    int num_threads = case_runtime._num_threads;
+#else
+    int num_threads = 1;
+#endif
+
+    /* Create the geometry, unless it is shared with the previous case */
+    bool new_geometry = (geometry == NULL ||
+                         !case_runtime.hasSameGeometry(previous));
+    bool new_tracks = (new_geometry ||
+                       !case_runtime.hasSameTracks(previous));
+    bool new_solver = (new_tracks ||
+                       case_runtime._linear_solver != previous._linear_solver ||
+                       !case_runtime._fixed_sources.empty() ||
+                       !previous._fixed_sources.empty());
+    if (new_solver)
+      delete solver;
+    if (new_tracks)
+      delete track_generator;
+    if (new_geometry) {
+      if (geometry != NULL)
+        delete geometry->getCmfd();
+      delete geometry;
+      timer.startTimer();
+      geometry = createGeometry(case_runtime);
+      timer.stopTimer();
+      geometry_time = timer.getTime();
+      setup_time += geometry_time;
+      num_geometries++;
+    }
+    if (geometry->getCmfd() != NULL)
+      setCmfdOptions(geometry->getCmfd(), case_runtime);
+
+    /* Initialize track generator and generate tracks */
+    if (new_tracks) {
+      timer.startTimer();
+      track_generator = createTrackGenerator(geometry, case_runtime,
+                                             num_threads);
+      timer.stopTimer();
+      track_time = timer.getTime();
+      setup_time += track_time;
+      num_track_layouts++;
+
+      /* Profile the segments for tuning */
+      if (!case_runtime._segment_statistics_filename.empty()) {
+        SegmentStatistics statistics(track_generator);
+        statistics.execute();
+        statistics.printReport();
+        statistics.exportStatistics(case_runtime._segment_statistics_filename);
+      }
+    }
+    unshared_setup_time += geometry_time + track_time;
+
+    /* Initialize solver */
+    if (new_solver) {
+      if(case_runtime._linear_solver)
+        solver= new CPULSSolver(track_generator);
+      else
+        solver= new CPUSolver(track_generator);
+    }
+    if(case_runtime._verbose_report)
+      solver->setVerboseIterationReport();
+    solver->setNumThreads(num_threads);
+    solver->setConvergenceThreshold(case_runtime._tolerance);
+
+    /* Perturb the cross sections, from copies of the Materials */
+    std::map<int, Material*> materials = geometry->getAllMaterials();
+    std::map<int, Material*> original_materials;
+    for (size_t p=0; p < case_runtime._perturbed_material_ids.size(); p++) {
+      int id = case_runtime._perturbed_material_ids[p];
+      if (materials.find(id) == materials.end())
+        log_printf(ERROR, "Unable to perturb Material %d which is not in the "
+                   "Geometry", id);
+      if (original_materials.find(id) == original_materials.end())
+        original_materials[id] = materials[id]->clone();
+      setMaterialXS(materials[id], case_runtime._perturbed_xs[p],
+                    original_materials[id],
+                    case_runtime._perturbation_factors[p]);
+    }
+
+    /* Set the fixed sources */
+    for (size_t s=0; s < case_runtime._fixed_sources.size(); s++) {
+      int id = case_runtime._fixed_sources[s][0];
+      if (materials.find(id) == materials.end())
+        log_printf(ERROR, "Unable to set a fixed source in Material %d which "
+                   "is not in the Geometry", id);
+      solver->setFixedSourceByMaterial(materials[id],
+                                       int(case_runtime._fixed_sources[s][1]),
+                                       case_runtime._fixed_sources[s][2]);
+    }
+
+    /* Run simulation */
+    timer.startTimer();
+    if (case_runtime._fixed_sources.empty())
+      solver->computeEigenvalue(case_runtime._max_iters, 
+                                (residualType)case_runtime._MOC_src_residual_type);
+    else
+      solver->computeSource(case_runtime._max_iters, 1.0, TOTAL_SOURCE);
+    timer.stopTimer();
+    solve_times[c] = timer.getTime();
+    keffs[c] = solver->getKeff();
+    num_iterations[c] = solver->getNumIterations();
+    if(case_runtime._time_report) {
+      solver->printTimerReport();
+      print_memory_report();
+    }
+
+    /* Extract reaction rates */
+    printReactionRates(solver, case_runtime);
+
+    /* Restore the perturbed cross sections */
+    for (size_t p=0; p < case_runtime._perturbed_material_ids.size(); p++) {
+      int id = case_runtime._perturbed_material_ids[p];
+      setMaterialXS(materials[id], case_runtime._perturbed_xs[p],
+                    original_materials[id], 1.0);
+    }
+    std::map<int, Material*>::iterator iter;
+    for (iter = original_materials.begin(); iter != original_materials.end();
+         ++iter) {
+      /* The input absorption cross section may differ from its recomputed
+       * value */
+      setMaterialXS(materials[iter->first], "sigma_a", iter->second, 1.0);
+      delete iter->second;
+    }
+
+    previous = case_runtime;
+  }
+
+  /* Report the results of the cases and the amortized setup time */
+  if (!runtime._batch_filename.empty()) {
+    log_printf(TITLE, "BATCH SUMMARY");
+    for (int c=0; c < num_cases; c++)
+      log_printf(RESULT, "Case %4d:  k_eff = %1.6f  iterations = %4d  "
+                 "solve time = %1.4E sec", c+1, keffs[c], num_iterations[c],
+                 solve_times[c]);
+    log_printf(RESULT, "%d cases with %d geometries and %d track layouts",
+               num_cases, num_geometries, num_track_layouts);
+    msg_string = "Setup time";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), setup_time);
+    msg_string = "Amortized setup time per case";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(),
+               setup_time / num_cases);
+    msg_string = "Setup time without sharing";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(),
+               unshared_setup_time);
+  }
 
   log_printf(TITLE, "Finished");
 #ifdef MPIx
@@ -0,0 +1,48 @@
+#include "synthetic-core.h"
+#include "../../../src/RunTime.h"
+
+/**
+ * @brief Builds a synthetic core and writes it to a geometry file.
+ * @details The core is set by the -synthetic_core option of the run time
+ *          options and written to the -geo_filename file, synthetic-core.geo
+ *          by default, which may then be loaded by the other drivers.
+ */
+int main(int argc, char* argv[]) {
+
+#ifdef MPIx
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+  log_set_ranks(MPI_COMM_WORLD);
+#endif
+
+  RuntimeParameters runtime;
+  runtime.setRuntimeParameters(argc, argv);
+  set_log_level(runtime._log_level);
+
+  std::string filename = runtime._geo_filename;
+  if (filename.empty())
+    filename = "synthetic-core.geo";
+
+  SyntheticCoreParameters parameters;
+  parameters.setParameters(runtime._synthetic_core);
+  Geometry* geometry = create_synthetic_core(parameters);
+
+  int rank = 0;
+#ifdef MPIx
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#endif
+  if (rank == 0) {
+    log_printf(NORMAL, "Writing the synthetic core to %s...",
+               filename.c_str());
+    geometry->dumpToFile(filename);
+  }
+
+  log_printf(RESULT, "Synthetic core with %d materials and %d groups",
+             (int) geometry->getAllMaterials().size(),
+             geometry->getNumEnergyGroups());
+
+#ifdef MPIx
+  MPI_Finalize();
+#endif
+  return 0;
+}
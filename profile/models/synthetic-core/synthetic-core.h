@@ -0,0 +1,406 @@
+/**
+ * @file synthetic-core.h
+ * @brief A parametric generator of synthetic lattice cores for scaling
+ *        benchmarks.
+ * @details The core is a checkerboard of two fuel assembly types, optionally
+ *          surrounded by a row of water assemblies, with a fixed pattern of
+ *          guide tubes in each assembly. The cross sections are smooth
+ *          functions of the group index, so that any number of groups can be
+ *          generated, and the fuel varies axially with a cosine shape. The
+ *          number of FSRs, Tracks and segments can then be scaled over orders
+ *          of magnitude with a few integers, as well as the number of
+ *          nested lattice levels above the pin cells.
+ */
+
+#ifndef SYNTHETIC_CORE_H_
+#define SYNTHETIC_CORE_H_
+
+#include "../../../src/Geometry.h"
+#include "../../../src/log.h"
+#include <vector>
+#include <cmath>
+
+
+/**
+ * @struct SyntheticCoreParameters
+ * @brief The parameters of a synthetic core.
+ */
+struct SyntheticCoreParameters {
+
+  /** Number of pins along each side of an assembly */
+  int _pins_per_assembly;
+
+  /** Number of fuel assemblies along each side of the core */
+  int _num_assemblies;
+
+  /** Number of rings of the fuel and of the moderator in each pin cell */
+  int _fuel_rings;
+  int _moderator_rings;
+
+  /** Number of angular sectors of each pin cell */
+  int _num_sectors;
+
+  /** Number of axial zones of the fuel */
+  int _num_axial_zones;
+
+  /** Number of energy groups of the synthetic cross sections */
+  int _num_groups;
+
+  /** Whether the fuel assemblies are surrounded by water assemblies */
+  bool _reflector;
+
+  /** Number of nested lattice levels above the pin cells, at least 2 for
+   *  the core and assembly lattices */
+  int _lattice_depth;
+
+  /** Pin pitch, fuel pin radius and core height in cm */
+  double _pin_pitch;
+  double _fuel_radius;
+  double _height;
+
+  SyntheticCoreParameters() {
+    _pins_per_assembly = 17;
+    _num_assemblies = 3;
+    _fuel_rings = 1;
+    _moderator_rings = 1;
+    _num_sectors = 4;
+    _num_axial_zones = 1;
+    _num_groups = 7;
+    _reflector = false;
+    _lattice_depth = 2;
+    _pin_pitch = 1.26;
+    _fuel_radius = 0.41;
+    _height = 20.;
+  }
+
+  void setParameters(std::vector<int>& values);
+};
+
+
+/**
+ * @brief Sets the integer parameters from a list of values.
+ * @details The list is ordered as pins per assembly, assemblies, fuel rings,
+ *          moderator rings, sectors, axial zones, groups, reflector and
+ *          lattice depth, and the missing trailing values keep their default.
+ * @param values the list of parameter values
+ */
+inline void SyntheticCoreParameters::setParameters(std::vector<int>& values) {
+
+  int* pointer[] = {&_pins_per_assembly, &_num_assemblies, &_fuel_rings,
+                    &_moderator_rings, &_num_sectors, &_num_axial_zones,
+                    &_num_groups};
+  if (values.size() > 9)
+    log_printf(ERROR, "Unable to set %d synthetic core parameters, at most 9 "
+               "are expected", (int) values.size());
+  for (size_t i=0; i < values.size() && i < 7; i++) {
+    if (values[i] <= 0)
+      log_printf(ERROR, "Unable to set a non-positive synthetic core "
+                 "parameter %d", values[i]);
+    *pointer[i] = values[i];
+  }
+  if (values.size() >= 8)
+    _reflector = (values[7] != 0);
+  if (values.size() == 9) {
+    if (values[8] < 2)
+      log_printf(ERROR, "Unable to set a synthetic core lattice depth %d, "
+                 "below the 2 levels of the core and assembly lattices",
+                 values[8]);
+    _lattice_depth = values[8];
+  }
+}
+
+
+Material* create_synthetic_material(int id, const char* name, int num_groups,
+                                    double fissile, double moderation);
+
+/**
+ * @brief Creates a Material with synthetic cross sections.
+ * @details The cross sections are smooth functions of the normalized group
+ *          lethargy u in (0, 1). The total cross section rises towards the
+ *          thermal groups, the moderation sets the fraction of scattering to
+ *          lower groups, and the absorption rises as u^2 in the fuel. The
+ *          fission spectrum is concentrated in the fast groups.
+ * @param id the Material ID
+ * @param name the Material name
+ * @param num_groups the number of energy groups
+ * @param fissile the fission strength, 0 for a non-fissile Material
+ * @param moderation the moderation strength between 0 (fuel) and 1 (water)
+ * @return the Material
+ */
+inline Material* create_synthetic_material(int id, const char* name,
+                                           int num_groups, double fissile,
+                                           double moderation) {
+
+  Material* material = new Material(id, name);
+  material->setNumEnergyGroups(num_groups);
+
+  std::vector<double> sigma_t(num_groups), sigma_a(num_groups);
+  std::vector<double> sigma_f(num_groups), nu_sigma_f(num_groups);
+  std::vector<double> chi(num_groups);
+  std::vector<double> sigma_s(num_groups * num_groups, 0.);
+
+  double chi_sum = 0.;
+  for (int g=0; g < num_groups; g++) {
+
+    double u = (g + 0.5) / num_groups;
+    double m = moderation;
+    sigma_t[g] = (1. - m) * (0.2 + 0.35 * u) + m * (0.2 + 2.3 * u * u);
+    double absorption = (1. - m) * (0.03 + 0.35 * u * u) * (0.5 + fissile) +
+                        m * (0.002 + 0.015 * u * u * u);
+    sigma_a[g] = absorption * sigma_t[g];
+    sigma_f[g] = 0.55 * fissile * sigma_a[g];
+    nu_sigma_f[g] = 2.45 * sigma_f[g];
+    chi[g] = (fissile > 0.) ? exp(-8. * u) : 0.;
+    chi_sum += chi[g];
+
+    /* Scattering within the group and to the lower groups, with weights
+       halving for each group */
+    double scatter = sigma_t[g] - sigma_a[g];
+    double down_fraction = (g == num_groups - 1) ? 0. :
+                           (1. - u) * (0.05 + 0.6 * m);
+    sigma_s[g * num_groups + g] = scatter * (1. - down_fraction);
+    double weight_sum = 0.;
+    for (int gp=g+1; gp < num_groups; gp++)
+      weight_sum += pow(0.5, gp - g);
+    for (int gp=g+1; gp < num_groups; gp++)
+      sigma_s[g * num_groups + gp] = scatter * down_fraction *
+                                     pow(0.5, gp - g) / weight_sum;
+  }
+
+  if (chi_sum > 0.)
+    for (int g=0; g < num_groups; g++)
+      chi[g] /= chi_sum;
+
+  material->setSigmaT(&sigma_t[0], num_groups);
+  material->setSigmaS(&sigma_s[0], num_groups * num_groups);
+  material->setSigmaF(&sigma_f[0], num_groups);
+  material->setNuSigmaF(&nu_sigma_f[0], num_groups);
+  material->setChi(&chi[0], num_groups);
+  for (int g=0; g < num_groups; g++)
+    material->setSigmaAByGroup(sigma_a[g], g+1);
+
+  return material;
+}
+
+
+Universe* create_synthetic_pin(Material* inner, Material* outer,
+                               ZCylinder* cylinder,
+                               SyntheticCoreParameters& parameters);
+
+/**
+ * @brief Creates a pin cell Universe of a synthetic core.
+ * @param inner the Material inside the cylinder
+ * @param outer the Material outside the cylinder
+ * @param cylinder the cylinder of the pin
+ * @param parameters the parameters of the synthetic core
+ * @return the pin cell Universe
+ */
+inline Universe* create_synthetic_pin(Material* inner, Material* outer,
+                                      ZCylinder* cylinder,
+                                      SyntheticCoreParameters& parameters) {
+
+  Cell* inner_cell = new Cell();
+  inner_cell->setFill(inner);
+  inner_cell->addSurface(-1, cylinder);
+  inner_cell->setNumRings(parameters._fuel_rings);
+  inner_cell->setNumSectors(parameters._num_sectors);
+
+  Cell* outer_cell = new Cell();
+  outer_cell->setFill(outer);
+  outer_cell->addSurface(+1, cylinder);
+  outer_cell->setNumRings(parameters._moderator_rings);
+  outer_cell->setNumSectors(parameters._num_sectors);
+
+  Universe* pin = new Universe();
+  pin->addCell(inner_cell);
+  pin->addCell(outer_cell);
+  return pin;
+}
+
+
+Universe* wrap_synthetic_assembly(Universe* assembly, double width,
+                                  double height, int num_levels);
+
+/**
+ * @brief Nests an assembly Universe in single cell lattices.
+ * @details Each level is a lattice of one cell of the assembly size, which
+ *          adds a level of coordinates to every point of the assembly
+ *          without changing its FSRs.
+ * @param assembly the assembly Universe
+ * @param width the width of the assembly in cm
+ * @param height the height of an axial zone in cm
+ * @param num_levels the number of lattice levels to add
+ * @return the Universe of the outermost level
+ */
+inline Universe* wrap_synthetic_assembly(Universe* assembly, double width,
+                                         double height, int num_levels) {
+
+  for (int l=0; l < num_levels; l++) {
+    Lattice* lattice = new Lattice();
+    lattice->setWidth(width, width, height);
+    lattice->setUniverses(1, 1, 1, &assembly);
+
+    Cell* cell = new Cell();
+    cell->setFill(lattice);
+    assembly = new Universe();
+    assembly->addCell(cell);
+  }
+  return assembly;
+}
+
+
+Geometry* create_synthetic_core(SyntheticCoreParameters& parameters);
+
+/**
+ * @brief Creates the Geometry of a synthetic core.
+ * @details Each axial zone has its own fuel Materials, scaled by a cosine
+ *          shape, and every third pin along each direction of an assembly is
+ *          a water-filled guide tube. The radial boundaries are reflective,
+ *          or vacuum with the water reflector, and the axial boundaries are
+ *          vacuum. The assembly lattices are nested in single cell lattices
+ *          up to the lattice depth. The domain decomposition and the CMFD
+ *          mesh are left to the caller.
+ * @param parameters the parameters of the synthetic core
+ * @return the Geometry, whose FSRs are not initialized
+ */
+inline Geometry* create_synthetic_core(SyntheticCoreParameters& parameters) {
+
+  int num_pins = parameters._pins_per_assembly;
+  int num_zones = parameters._num_axial_zones;
+  int num_groups = parameters._num_groups;
+  double pitch = parameters._pin_pitch;
+  double zone_height = parameters._height / num_zones;
+  int num_assemblies = parameters._num_assemblies + 2 * parameters._reflector;
+  int num_wrapping_levels = parameters._lattice_depth - 2;
+  double assembly_width = num_pins * pitch;
+
+  if (2 * parameters._fuel_radius >= pitch)
+    log_printf(ERROR, "Unable to create a synthetic core with a fuel radius "
+               "%f larger than half the pin pitch %f",
+               parameters._fuel_radius, pitch);
+
+  log_printf(NORMAL, "Creating a synthetic core of %d x %d assemblies of %d x "
+             "%d pins, %d axial zones, %d groups and %d lattice levels...",
+             num_assemblies, num_assemblies, num_pins, num_pins, num_zones,
+             num_groups, parameters._lattice_depth);
+
+  /* Create the water and the two fuel types of each axial zone */
+  Material* water = create_synthetic_material(1, "Water", num_groups, 0., 1.);
+  std::vector<Material*> fuels[2];
+  double enrichments[2] = {1.0, 0.8};
+  char name[32];
+  for (int z=0; z < num_zones; z++) {
+    double shape = 0.7 + 0.3 * sin(M_PI * (z + 0.5) / num_zones);
+    for (int f=0; f < 2; f++) {
+      snprintf(name, sizeof(name), "Fuel %d zone %d", f+1, z+1);
+      fuels[f].push_back(create_synthetic_material(2 + 2*z + f, name,
+          num_groups, enrichments[f] * shape, 0.));
+    }
+  }
+
+  /* Create the pin cells, guide tubes and water pins being shared */
+  ZCylinder* fuel_cylinder = new ZCylinder(0., 0., parameters._fuel_radius);
+  ZCylinder* guide_cylinder = new ZCylinder(0., 0., 0.45 * pitch);
+  Universe* guide_tube = create_synthetic_pin(water, water, guide_cylinder,
+                                              parameters);
+  Universe* water_pin = create_synthetic_pin(water, water, fuel_cylinder,
+                                             parameters);
+
+  /* Create the assemblies of each fuel type and axial zone */
+  std::vector<Universe*> assemblies[2];
+  std::vector<Universe*> pins(num_pins * num_pins);
+  for (int z=0; z < num_zones; z++) {
+    for (int f=0; f < 2; f++) {
+
+      Universe* fuel_pin = create_synthetic_pin(fuels[f][z], water,
+                                                fuel_cylinder, parameters);
+      for (int j=0; j < num_pins; j++)
+        for (int i=0; i < num_pins; i++)
+          pins[j * num_pins + i] = (i % 3 == 2 && j % 3 == 2 &&
+                                    i < num_pins - 1 && j < num_pins - 1) ?
+                                   guide_tube : fuel_pin;
+
+      Lattice* lattice = new Lattice();
+      lattice->setWidth(pitch, pitch, zone_height);
+      lattice->setUniverses(1, num_pins, num_pins, &pins[0]);
+
+      Cell* assembly_cell = new Cell();
+      assembly_cell->setFill(lattice);
+      Universe* assembly = new Universe();
+      assembly->addCell(assembly_cell);
+      assemblies[f].push_back(wrap_synthetic_assembly(assembly,
+          assembly_width, zone_height, num_wrapping_levels));
+    }
+  }
+
+  /* Create the water assemblies of the reflector */
+  Universe* reflector = NULL;
+  if (parameters._reflector) {
+    for (int n=0; n < num_pins * num_pins; n++)
+      pins[n] = water_pin;
+    Lattice* lattice = new Lattice();
+    lattice->setWidth(pitch, pitch, zone_height);
+    lattice->setUniverses(1, num_pins, num_pins, &pins[0]);
+    Cell* reflector_cell = new Cell();
+    reflector_cell->setFill(lattice);
+    reflector = new Universe();
+    reflector->addCell(reflector_cell);
+    reflector = wrap_synthetic_assembly(reflector, assembly_width, zone_height,
+                                        num_wrapping_levels);
+  }
+
+  /* Create the core lattice, a checkerboard of the two fuel types */
+  std::vector<Universe*> core(num_zones * num_assemblies * num_assemblies);
+  int first = parameters._reflector;
+  int last = num_assemblies - 1 - parameters._reflector;
+  for (int z=0; z < num_zones; z++) {
+    for (int j=0; j < num_assemblies; j++) {
+      for (int i=0; i < num_assemblies; i++) {
+        Universe* assembly = reflector;
+        if (i >= first && i <= last && j >= first && j <= last)
+          assembly = assemblies[(i + j) % 2][z];
+        core[(z * num_assemblies + j) * num_assemblies + i] = assembly;
+      }
+    }
+  }
+
+  Lattice* core_lattice = new Lattice();
+  core_lattice->setWidth(assembly_width, assembly_width, zone_height);
+  core_lattice->setUniverses(num_zones, num_assemblies, num_assemblies,
+                             &core[0]);
+
+  /* Create the root cell bounding the core */
+  double half_width = 0.5 * num_assemblies * assembly_width;
+  double half_height = 0.5 * parameters._height;
+  boundaryType radial_boundary = parameters._reflector ? VACUUM : REFLECTIVE;
+  XPlane* xmin = new XPlane(-half_width);
+  XPlane* xmax = new XPlane(half_width);
+  YPlane* ymin = new YPlane(-half_width);
+  YPlane* ymax = new YPlane(half_width);
+  ZPlane* zmin = new ZPlane(-half_height);
+  ZPlane* zmax = new ZPlane(half_height);
+  xmin->setBoundaryType(radial_boundary);
+  xmax->setBoundaryType(radial_boundary);
+  ymin->setBoundaryType(radial_boundary);
+  ymax->setBoundaryType(radial_boundary);
+  zmin->setBoundaryType(VACUUM);
+  zmax->setBoundaryType(VACUUM);
+
+  Cell* root_cell = new Cell();
+  root_cell->setFill(core_lattice);
+  root_cell->addSurface(+1, xmin);
+  root_cell->addSurface(-1, xmax);
+  root_cell->addSurface(+1, ymin);
+  root_cell->addSurface(-1, ymax);
+  root_cell->addSurface(+1, zmin);
+  root_cell->addSurface(-1, zmax);
+
+  Universe* root_universe = new Universe();
+  root_universe->addCell(root_cell);
+
+  Geometry* geometry = new Geometry();
+  geometry->setRootUniverse(root_universe);
+  return geometry;
+}
+
+#endif /* SYNTHETIC_CORE_H_ */
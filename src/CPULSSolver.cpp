@@ -43,6 +43,8 @@ CPULSSolver::~CPULSSolver() {
 
   if (_FSR_source_constants != NULL)
     delete [] _FSR_source_constants;
+
+  release_memory(this);
 }
 
 
@@ -59,6 +61,12 @@ void CPULSSolver::initializeFluxArrays() {
   if (_scalar_flux_xyz != NULL)
     delete [] _scalar_flux_xyz;
 
+  /* Account the flux moments, outside of the allocation errors */
+  int num_moment_arrays = 1 + (_stabilize_transport && _stabilize_moments);
+  account_memory(this, "scalar flux moments", LINEAR_SOURCE_MEMORY,
+                 num_moment_arrays * _num_FSRs * _NUM_GROUPS * 3 *
+                 sizeof(FP_PRECISION));
+
   try {
     /* Allocate an array for the FSR scalar flux */
     long size = _num_FSRs * _NUM_GROUPS * 3;
@@ -101,6 +109,8 @@ void CPULSSolver::initializeSourceArrays() {
     delete [] _reduced_sources_xyz;
 
   long size = _num_FSRs * _NUM_GROUPS * 3;
+  account_memory(this, "source moments", LINEAR_SOURCE_MEMORY,
+                 size * sizeof(FP_PRECISION));
 
   /* Allocate memory for all source arrays */
   try {
@@ -1127,6 +1137,72 @@ FP_PRECISION CPULSSolver::getFluxByCoords(LocalCoords* coords, int group) {
 }
 
 
+/**
+ * @brief Remaps the scalar fluxes and flux moments after the FSRs were split
+ *        axially.
+ * @details The radial flux moments are copied from the FSR each new FSR
+ *          derives from. The axial moment of an FSR split in two halves is
+ *          divided by four, which preserves the axial flux slope over the
+ *          halved height.
+ * @param parents the ID of the FSR each new FSR derives from
+ */
+void CPULSSolver::remapFSRFluxes(std::vector<long>& parents) {
+
+  CPUSolver::remapFSRFluxes(parents);
+
+  /* Count the new FSRs deriving from each FSR to find the split FSRs */
+  long num_FSRs = parents.size();
+  long num_old_FSRs = *std::max_element(parents.begin(), parents.end()) + 1;
+  std::vector<int> num_halves(num_old_FSRs, 0);
+  for (long r=0; r < num_FSRs; r++)
+    num_halves[parents[r]]++;
+
+  long size = num_FSRs * _NUM_GROUPS * 3;
+  int num_moment_arrays = 1 + (_stabilizing_flux_xyz != NULL);
+  account_memory(this, "scalar flux moments", LINEAR_SOURCE_MEMORY,
+                 num_moment_arrays * size * sizeof(FP_PRECISION));
+  FP_PRECISION* scalar_flux_xyz = new FP_PRECISION[size];
+
+#pragma omp parallel for
+  for (long r=0; r < num_FSRs; r++) {
+    long parent = parents[r];
+    double z_factor = (num_halves[parent] > 1) ? 0.25 : 1.;
+    for (int e=0; e < _NUM_GROUPS; e++) {
+      scalar_flux_xyz[r*_NUM_GROUPS*3 + e] = _scalar_flux_xyz(parent, e, 0);
+      scalar_flux_xyz[r*_NUM_GROUPS*3 + _NUM_GROUPS + e] =
+          _scalar_flux_xyz(parent, e, 1);
+      scalar_flux_xyz[r*_NUM_GROUPS*3 + 2*_NUM_GROUPS + e] =
+          z_factor * _scalar_flux_xyz(parent, e, 2);
+    }
+  }
+
+  delete [] _scalar_flux_xyz;
+  _scalar_flux_xyz = scalar_flux_xyz;
+
+  if (_stabilizing_flux_xyz != NULL) {
+    delete [] _stabilizing_flux_xyz;
+    _stabilizing_flux_xyz = new FP_PRECISION[size]();
+  }
+}
+
+
+/**
+ * @brief Returns the axial slope of the scalar flux in an FSR.
+ * @param fsr_id the ID of the FSR
+ * @param group the energy group
+ * @return the axial derivative of the scalar flux
+ */
+FP_PRECISION CPULSSolver::getAxialFluxSlope(long fsr_id, int group) {
+
+  if (!_SOLVE_3D)
+    return 0.;
+
+  return _FSR_lin_exp_matrix[fsr_id*6+3] * _scalar_flux_xyz(fsr_id, group, 0) +
+         _FSR_lin_exp_matrix[fsr_id*6+4] * _scalar_flux_xyz(fsr_id, group, 1) +
+         _FSR_lin_exp_matrix[fsr_id*6+5] * _scalar_flux_xyz(fsr_id, group, 2);
+}
+
+
 /**
  * @brief Initializes a Cmfd object for acceleration prior to source iteration.
  * @details For the linear source solver, a pointer to the flux moments is
@@ -1162,6 +1238,12 @@ void CPULSSolver::initializeLinearSourceConstants() {
   if (_FSR_lin_exp_matrix != NULL)
     delete[] _FSR_lin_exp_matrix;
 
+  int num_dims = _SOLVE_3D ? 2 : 1;
+  long num_FSRs = _geometry->getNumFSRs();
+  account_memory(this, "source constants", LINEAR_SOURCE_MEMORY, num_dims *
+                 num_FSRs * (3 * _geometry->getNumEnergyGroups() *
+                 sizeof(FP_PRECISION) + 3 * sizeof(double)));
+
 #pragma omp critical
   {
     /* Initialize linear source constant component */
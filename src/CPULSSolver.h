@@ -71,6 +71,10 @@ protected:
   /** Whether fixed linear source moments have been provided */
   bool _fixed_source_moments_on;
 
+  /* Adaptive axial refinement of the FSRs */
+  void remapFSRFluxes(std::vector<long>& parents);
+  FP_PRECISION getAxialFluxSlope(long fsr_id, int group);
+
 public:
   CPULSSolver(TrackGenerator* track_generator=NULL);
   virtual ~CPULSSolver();
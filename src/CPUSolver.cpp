@@ -1,6 +1,7 @@
 #include "CPUSolver.h"
 #include <unordered_map>
 #include <numeric>
+#include <algorithm>
 
 /**
  * @brief Constructor initializes array pointers for Tracks and Materials.
@@ -16,6 +17,13 @@ CPUSolver::CPUSolver(TrackGenerator* track_generator)
   setNumThreads(1);
   _FSR_locks = NULL;
   _source_type = "Flat";
+  _cycle_ordered_sweep = false;
+  _cycle_tracks = NULL;
+  _cycle_offsets = NULL;
+  _num_cycles = 0;
+  _prefetch_distance = 0;
+  _streaming_stores = false;
+  _persistent_region = false;
 #ifdef MPIx
   _track_message_size = 0;
   _MPI_requests = NULL;
@@ -35,6 +43,16 @@ CPUSolver::~CPUSolver() {
 #ifdef MPIx
   deleteMPIBuffers();
 #endif
+
+  if (_cycle_tracks != NULL)
+    delete [] _cycle_tracks;
+
+  if (_cycle_offsets != NULL)
+    delete [] _cycle_offsets;
+
+  /* The start fluxes share the boundary flux array for cycle ordered sweeps */
+  if (_start_flux == _boundary_flux)
+    _start_flux = NULL;
 }
 
 
@@ -159,6 +177,127 @@ void CPUSolver::setNumThreads(int num_threads) {
 }
 
 
+/**
+ * @brief Sweeps the Tracks along their reflective and periodic cycles, and
+ *        transfers their outgoing angular fluxes in place.
+ * @details The Tracks linked by reflective and periodic boundary conditions
+ *          are grouped into independent cycles, which are distributed over
+ *          the threads and swept in the order the angular flux travels
+ *          through them. The outgoing angular flux of a Track is then
+ *          directly the incoming flux of the next Track of the cycle, in the
+ *          same transport sweep, so the start flux array and the copy into
+ *          the boundary flux array at every sweep are no longer needed. This
+ *          Gauss-Seidel update of the boundary fluxes speeds up the
+ *          convergence of reflective problems. It is only available for
+ *          explicit and OTF_TRACKS segmentations, on a single domain.
+ */
+void CPUSolver::useCycleOrderedSweep() {
+  _cycle_ordered_sweep = true;
+}
+
+
+/**
+ * @brief Sets the number of segments ahead for which the FSR data is
+ *        prefetched during transport sweeps.
+ * @details When the FSR data does not fit in cache, the sweep is bound by
+ *          the latency of fetching the source, scalar flux and cross section
+ *          rows of each new segment. Prefetching them a few segments ahead
+ *          hides that latency, along with the boundary fluxes of the next
+ *          Track. A distance of 0 (default) disables prefetching.
+ * @param prefetch_distance the number of segments to prefetch ahead
+ */
+void CPUSolver::setPrefetchDistance(int prefetch_distance) {
+  if (prefetch_distance < 0)
+    log_printf(ERROR, "Unable to set a negative prefetch distance %d",
+               prefetch_distance);
+  _prefetch_distance = prefetch_distance;
+}
+
+
+/**
+ * @brief Returns the number of segments ahead for which the FSR data is
+ *        prefetched during transport sweeps.
+ * @return the prefetch distance, 0 if prefetching is disabled
+ */
+int CPUSolver::getPrefetchDistance() {
+  return _prefetch_distance;
+}
+
+
+/**
+ * @brief Sets whether the outgoing boundary fluxes are transferred with
+ *        non-temporal stores.
+ * @details The outgoing angular fluxes are only read back at the next
+ *          transport sweep, so writing them around the cache keeps the FSR
+ *          data cached during the sweep. Streaming stores are only used on
+ *          processors with SSE and are not used for cycle ordered sweeps,
+ *          since the fluxes are then read back right away.
+ * @param streaming_stores whether to use non-temporal stores
+ */
+void CPUSolver::useStreamingStores(bool streaming_stores) {
+  _streaming_stores = streaming_stores;
+}
+
+
+/**
+ * @brief Sets whether the source iterations of eigenvalue calculations run
+ *        in a single parallel region.
+ * @details By default, each step of a source iteration forks and joins its
+ *          own team of threads. The threads may instead be kept for the whole
+ *          iteration loop, sharing the work of each step and only
+ *          synchronizing where a step needs the results of the previous one,
+ *          which lowers the threading overhead of small problems on many
+ *          threads. It is only available for the flat source CPUSolver with
+ *          explicit or on-the-fly Track segmentation, on a single domain,
+ *          without the CMFD sigma-t rebalance, transport stabilization or
+ *          axial refinement. With CMFD acceleration, the region is left for
+ *          each CMFD solve.
+ * @param persistent_region whether to run the iterations in a single
+ *        parallel region
+ */
+void CPUSolver::usePersistentParallelRegion(bool persistent_region) {
+  _persistent_region = persistent_region;
+}
+
+
+/**
+ * @brief Returns whether Tracks are swept along their reflective cycles.
+ * @return whether the sweep is ordered by cycles
+ */
+bool CPUSolver::isCycleOrderedSweep() {
+  return _cycle_ordered_sweep;
+}
+
+
+/**
+ * @brief Returns the indexes of the Tracks in their cycle sweep order.
+ * @return the array of Track indexes, grouped by cycle
+ */
+TrackStackIndexes* CPUSolver::getCycleTracks() {
+  return _cycle_tracks;
+}
+
+
+/**
+ * @brief Returns the offsets of the cycles into the ordered Tracks.
+ * @details The Tracks of cycle c are those from _cycle_offsets[c] to
+ *          _cycle_offsets[c+1] (excluded).
+ * @return the array of cycle offsets
+ */
+long* CPUSolver::getCycleOffsets() {
+  return _cycle_offsets;
+}
+
+
+/**
+ * @brief Returns the number of independent cycles of Tracks.
+ * @return the number of cycles
+ */
+long CPUSolver::getNumCycles() {
+  return _num_cycles;
+}
+
+
 /**
  * @brief Set the flux array for use in transport sweep source calculations.
  * @details This is a helper method for the checkpoint restart capabilities,
@@ -281,12 +420,12 @@ void CPUSolver::initializeFSRs() {
 void CPUSolver::initializeFluxArrays() {
 
   /* Delete old flux arrays if they exist */
+  if (_start_flux != NULL && _start_flux != _boundary_flux)
+    delete [] _start_flux;
+
   if (_boundary_flux != NULL)
     delete [] _boundary_flux;
 
-  if (_start_flux != NULL)
-    delete [] _start_flux;
-
   if (_boundary_leakage != NULL)
     delete [] _boundary_leakage;
 
@@ -306,6 +445,19 @@ void CPUSolver::initializeFluxArrays() {
 
   long size;
 
+  /* Account the flux arrays, outside of the allocation errors */
+  double boundary_bytes = 2 * _tot_num_tracks * _fluxes_per_track *
+                          sizeof(float);
+#ifndef ONLYVACUUMBC
+  if (!_cycle_ordered_sweep)
+    boundary_bytes *= 2;
+#endif
+  if (!_keff_from_fission_rates)
+    boundary_bytes += _tot_num_tracks * sizeof(float);
+  account_memory(this, "boundary fluxes", FLUX_MEMORY, boundary_bytes);
+  account_memory(this, "scalar fluxes", FLUX_MEMORY, (2 + _stabilize_transport)
+                 * _num_FSRs * _NUM_GROUPS * sizeof(FP_PRECISION));
+
   /* Allocate memory for the Track boundary fluxes and leakage arrays */
   try {
     size = 2 * _tot_num_tracks * _fluxes_per_track;
@@ -319,13 +471,19 @@ void CPUSolver::initializeFluxArrays() {
         / (double) (1e6);
 #ifdef ONLYVACUUMBC
     max_size_mb /= 2;
+#else
+    if (_cycle_ordered_sweep)
+      max_size_mb /= 2;
 #endif
     log_printf(NORMAL, "Max boundary angular flux storage per domain = %6.2f "
                "MB", max_size_mb);
 
     _boundary_flux = new float[size]();
 #ifndef ONLYVACUUMBC
-    _start_flux = new float[size]();
+    if (_cycle_ordered_sweep)
+      _start_flux = _boundary_flux;
+    else
+      _start_flux = new float[size]();
 #endif
 
     /* Allocate memory for boundary leakage if necessary */
@@ -377,6 +535,203 @@ void CPUSolver::initializeFluxArrays() {
   catch (std::exception &e) {
     log_printf(ERROR, "Could not allocate memory for the fluxes");
   }
+
+#ifndef ONLYVACUUMBC
+  /* Order the Tracks along their cycles for in-place flux transfers */
+  if (_cycle_ordered_sweep)
+    initializeTrackCycles();
+#endif
+}
+
+
+/**
+ * @brief Groups the Tracks into independent cycles and orders them as the
+ *        angular flux travels through each cycle.
+ * @details Two Tracks belong to the same cycle if the angular flux leaving
+ *          one of them is transferred to the other by a reflective or
+ *          periodic boundary condition. Within a cycle, the Tracks are
+ *          ordered by following the angular flux from the start of the
+ *          chain, or from any Track if the chain is closed. The cycles are
+ *          sorted by decreasing size to balance the load between threads.
+ */
+void CPUSolver::initializeTrackCycles() {
+
+  segmentationType segmentation = _track_generator->getSegmentFormation();
+  if (segmentation == OTF_STACKS)
+    log_printf(ERROR, "Cycle ordered sweeps are not available with OTF_STACKS"
+               " segmentation, since all the Tracks of a z-stack are swept "
+               "together");
+  if (_OTF_transport)
+    log_printf(ERROR, "Cycle ordered sweeps are not available with the OTF "
+               "transport sweep");
+  if (_geometry->isDomainDecomposed())
+    log_printf(ERROR, "Cycle ordered sweeps are not available with domain "
+               "decomposition, since interface fluxes need a start flux "
+               "array");
+
+  /* Gather the indexes and outgoing links of all Tracks by UID, the links
+     being -1 where the angular flux is not transferred */
+  TrackStackIndexes* tsis = new TrackStackIndexes[_tot_num_tracks];
+  long* links = new long[2 * _tot_num_tracks];
+  bool* links_fwd = new bool[2 * _tot_num_tracks];
+
+  int num_azim = _track_generator->getNumAzim();
+  Track** tracks_2D = _track_generator->get2DTracks();
+  TrackGenerator3D* track_generator_3D =
+       dynamic_cast<TrackGenerator3D*>(_track_generator);
+
+#pragma omp parallel for schedule(dynamic)
+  for (int a=0; a < num_azim/2; a++) {
+    int num_xy = _track_generator->getNumX(a) + _track_generator->getNumY(a);
+    for (int i=0; i < num_xy; i++) {
+
+      int num_polar = 1;
+      if (track_generator_3D != NULL)
+        num_polar = track_generator_3D->getNumPolar();
+
+      for (int p=0; p < num_polar; p++) {
+
+        int num_z = 1;
+        if (track_generator_3D != NULL)
+          num_z = track_generator_3D->getTracksPerStack()[a][i][p];
+
+        for (int z=0; z < num_z; z++) {
+
+          /* Extract the Track */
+          TrackStackIndexes tsi;
+          tsi._azim = a;
+          tsi._xy = i;
+          tsi._polar = p;
+          tsi._z = z;
+          Track* track;
+          Track3D track_3D;
+          if (segmentation == EXPLICIT_2D)
+            track = &tracks_2D[a][i];
+          else if (segmentation == EXPLICIT_3D)
+            track = &track_generator_3D->get3DTracks()[a][i][p][z];
+          else {
+            track_generator_3D->getTrackOTF(&track_3D, &tsi);
+            track = &track_3D;
+          }
+
+          /* Save the links of the Track in both directions */
+          long uid = track->getUid();
+          tsis[uid] = tsi;
+          for (int d=0; d < 2; d++) {
+            boundaryType bc = d ? track->getBCBwd() : track->getBCFwd();
+            if (bc == REFLECTIVE || bc == PERIODIC || bc == ROTATIONAL) {
+              links[2*uid + d] = d ? track->getTrackNextBwd() :
+                                     track->getTrackNextFwd();
+              links_fwd[2*uid + d] = d ? track->getNextBwdFwd() :
+                                         track->getNextFwdFwd();
+            }
+            else
+              links[2*uid + d] = -1;
+          }
+        }
+      }
+    }
+  }
+
+  /* Find the cycle of each Track by merging the linked Tracks */
+  long* cycles = new long[_tot_num_tracks];
+  std::iota(cycles, cycles + _tot_num_tracks, 0);
+  for (long t=0; t < _tot_num_tracks; t++) {
+    for (int d=0; d < 2; d++) {
+      if (links[2*t + d] == -1)
+        continue;
+      long root_1 = t;
+      while (cycles[root_1] != root_1)
+        root_1 = cycles[root_1] = cycles[cycles[root_1]];
+      long root_2 = links[2*t + d];
+      while (cycles[root_2] != root_2)
+        root_2 = cycles[root_2] = cycles[cycles[root_2]];
+      cycles[std::max(root_1, root_2)] = std::min(root_1, root_2);
+    }
+  }
+  long* cycle_sizes = new long[_tot_num_tracks]();
+  for (long t=0; t < _tot_num_tracks; t++) {
+    cycles[t] = cycles[cycles[t]];
+    cycle_sizes[cycles[t]]++;
+  }
+
+  /* Order the Tracks by following the angular flux through each chain */
+  std::vector<long> order;
+  order.reserve(_tot_num_tracks);
+  std::vector<bool> visited(_tot_num_tracks, false);
+  for (long t=0; t < _tot_num_tracks; t++) {
+
+    if (visited[t])
+      continue;
+
+    /* Go back to the start of the chain, the incoming angular flux of a
+       Track coming from the Track linked at its other end */
+    long start = t;
+    bool fwd = true;
+    for (long i=0; i < 2 * _tot_num_tracks; i++) {
+      long prev = links[2*start + fwd];
+      if (prev == -1)
+        break;
+      bool prev_fwd = !links_fwd[2*start + fwd];
+      if (visited[prev] || (prev == t && prev_fwd))
+        break;
+      start = prev;
+      fwd = prev_fwd;
+    }
+
+    /* Follow the angular flux to the end of the chain */
+    long curr = start;
+    bool curr_fwd = fwd;
+    for (long i=0; i < 2 * _tot_num_tracks; i++) {
+      if (!visited[curr]) {
+        visited[curr] = true;
+        order.push_back(curr);
+      }
+      long next = links[2*curr + !curr_fwd];
+      if (next == -1)
+        break;
+      curr_fwd = links_fwd[2*curr + !curr_fwd];
+      curr = next;
+      if (curr == start && curr_fwd == fwd)
+        break;
+    }
+  }
+
+  /* Group the Tracks by cycle, with the largest cycles first */
+  std::stable_sort(order.begin(), order.end(), [&](long t1, long t2) {
+    if (cycle_sizes[cycles[t1]] != cycle_sizes[cycles[t2]])
+      return cycle_sizes[cycles[t1]] > cycle_sizes[cycles[t2]];
+    return cycles[t1] < cycles[t2];
+  });
+
+  /* Save the ordered Track indexes and the offsets of the cycles */
+  if (_cycle_tracks != NULL)
+    delete [] _cycle_tracks;
+  if (_cycle_offsets != NULL)
+    delete [] _cycle_offsets;
+
+  _cycle_tracks = new TrackStackIndexes[_tot_num_tracks];
+  std::vector<long> offsets;
+  for (long i=0; i < _tot_num_tracks; i++) {
+    if (i == 0 || cycles[order[i]] != cycles[order[i-1]])
+      offsets.push_back(i);
+    _cycle_tracks[i] = tsis[order[i]];
+  }
+  offsets.push_back(_tot_num_tracks);
+
+  _num_cycles = offsets.size() - 1;
+  _cycle_offsets = new long[offsets.size()];
+  std::copy(offsets.begin(), offsets.end(), _cycle_offsets);
+
+  log_printf(NORMAL, "Sweeping %ld Tracks along %ld cycles, the largest "
+             "holding %ld Tracks", _tot_num_tracks, _num_cycles,
+             _cycle_offsets[1] - _cycle_offsets[0]);
+
+  delete [] tsis;
+  delete [] links;
+  delete [] links_fwd;
+  delete [] cycles;
+  delete [] cycle_sizes;
 }
 
 
@@ -394,6 +749,11 @@ void CPUSolver::initializeSourceArrays() {
     delete [] _fixed_sources;
 
   long size = _num_FSRs * _NUM_GROUPS;
+  account_memory(this, "reduced sources", SOURCE_MEMORY,
+                 size * sizeof(FP_PRECISION));
+  if (_fixed_sources_on && !_fixed_sources_initialized)
+    account_memory(this, "fixed sources", SOURCE_MEMORY,
+                   size * sizeof(FP_PRECISION));
 
   /* Allocate memory for all source arrays */
   _reduced_sources = new FP_PRECISION[size]();
@@ -585,6 +945,8 @@ void CPUSolver::setupMPIBuffers() {
                   _geometry->getMPICart());
     log_printf(INFO_ONCE, "Max track fluxes transfer buffer storage = %.2f MB",
                max_size / 1e6);
+    account_memory(this, "flux transfer buffers", MPI_BUFFER_MEMORY,
+                   size + 2 * _tot_num_tracks * sizeof(long));
 
     /* Allocate track fluxes transfer buffers */
     _send_buffers.resize(num_domains);
@@ -786,6 +1148,7 @@ void CPUSolver::deleteMPIBuffers() {
   delete [] _MPI_requests;
   delete [] _MPI_sends;
   delete [] _MPI_receives;
+  account_memory(this, "flux transfer buffers", MPI_BUFFER_MEMORY, 0);
 }
 #endif
 
@@ -1922,7 +2285,8 @@ double CPUSolver::normalizeFluxes() {
 #pragma omp parallel for schedule(static)
   for (long idx=0; idx < 2 * _tot_num_tracks * _fluxes_per_track; idx++) {
 #ifndef ONLYVACUUMBC
-    _start_flux[idx] *= norm_factor;
+    if (!_cycle_ordered_sweep)
+      _start_flux[idx] *= norm_factor;
 #endif
     _boundary_flux[idx] *= norm_factor;
   }
@@ -1945,49 +2309,79 @@ void CPUSolver::computeFSRSources(int iteration) {
 #pragma omp parallel for schedule(static)
   for (long r=0; r < _num_FSRs; r++) {
 
-    Material* material = _FSR_materials[r];
-    FP_PRECISION* sigma_s = material->getSigmaS();
-    FP_PRECISION fiss_mat;
-    FP_PRECISION fission_sources[_NUM_GROUPS];
-    FP_PRECISION scatter_sources[_NUM_GROUPS];
-    bool negative_source_in_fsr = false;
+    int num_negative_fsr_sources = computeFSRSource(r, iteration);
 
-    /* Compute total (fission+scatter+fixed) source for group G */
-    for (int G=0; G < _NUM_GROUPS; G++) {
-      int first_idx = G * _NUM_GROUPS;
-      fiss_mat = 0;
-      for (int g=0; g < _NUM_GROUPS; g++) {
-        if (material->isFissionable())
-          fiss_mat = material->getFissionMatrixByGroup(g+1,G+1);
-        scatter_sources[g] = sigma_s[first_idx+g] * _scalar_flux(r,g);
-        fission_sources[g] = _scalar_flux(r,g) * fiss_mat;
-      }
-      double scatter_source =
-          pairwise_sum<FP_PRECISION>(scatter_sources, _NUM_GROUPS);
-      double fission_source = pairwise_sum<FP_PRECISION>(fission_sources,
-                                                  _NUM_GROUPS);
-      fission_source /= _k_eff;
-      _reduced_sources(r,G) = fission_source;
-      _reduced_sources(r,G) += scatter_source;
-      if (_fixed_sources_on)
-        _reduced_sources(r,G) += _fixed_sources(r,G);
-      _reduced_sources(r,G) *= ONE_OVER_FOUR_PI;
-
-      /* Correct negative sources to (near) zero */
-      if (_reduced_sources(r,G) < 0.0) {
+    if (num_negative_fsr_sources > 0) {
 #pragma omp atomic update
-        num_negative_sources++;
-        negative_source_in_fsr = true;
-        if (iteration < 30 && !_negative_fluxes_allowed)
-          _reduced_sources(r,G) = FLUX_EPSILON;
-      }
-    }
-
-    if (negative_source_in_fsr)
+      num_negative_sources += num_negative_fsr_sources;
 #pragma omp atomic update
       num_negative_fsrs++;
+    }
+  }
+
+  reportNegativeSources(num_negative_sources, num_negative_fsrs, iteration);
+}
+
+
+/**
+ * @brief Computes the total source (fission, scattering, fixed) in a FSR.
+ * @details Negative sources are corrected to (near) zero during the first
+ *          iterations, unless negative fluxes are allowed.
+ * @param r the FSR ID
+ * @param iteration the source iteration
+ * @return the number of negative sources in the FSR
+ */
+int CPUSolver::computeFSRSource(long r, int iteration) {
+
+  Material* material = _FSR_materials[r];
+  FP_PRECISION* sigma_s = material->getSigmaS();
+  FP_PRECISION fiss_mat;
+  FP_PRECISION fission_sources[_NUM_GROUPS];
+  FP_PRECISION scatter_sources[_NUM_GROUPS];
+  int num_negative_sources = 0;
+
+  /* Compute total (fission+scatter+fixed) source for group G */
+  for (int G=0; G < _NUM_GROUPS; G++) {
+    int first_idx = G * _NUM_GROUPS;
+    fiss_mat = 0;
+    for (int g=0; g < _NUM_GROUPS; g++) {
+      if (material->isFissionable())
+        fiss_mat = material->getFissionMatrixByGroup(g+1,G+1);
+      scatter_sources[g] = sigma_s[first_idx+g] * _scalar_flux(r,g);
+      fission_sources[g] = _scalar_flux(r,g) * fiss_mat;
+    }
+    double scatter_source =
+        pairwise_sum<FP_PRECISION>(scatter_sources, _NUM_GROUPS);
+    double fission_source = pairwise_sum<FP_PRECISION>(fission_sources,
+                                                _NUM_GROUPS);
+    fission_source /= _k_eff;
+    _reduced_sources(r,G) = fission_source;
+    _reduced_sources(r,G) += scatter_source;
+    if (_fixed_sources_on)
+      _reduced_sources(r,G) += _fixed_sources(r,G);
+    _reduced_sources(r,G) *= ONE_OVER_FOUR_PI;
+
+    /* Correct negative sources to (near) zero */
+    if (_reduced_sources(r,G) < 0.0) {
+      num_negative_sources++;
+      if (iteration < 30 && !_negative_fluxes_allowed)
+        _reduced_sources(r,G) = FLUX_EPSILON;
+    }
   }
 
+  return num_negative_sources;
+}
+
+
+/**
+ * @brief Tallies the negative sources across domains and reports them.
+ * @param num_negative_sources the number of negative sources in the domain
+ * @param num_negative_fsrs the number of FSRs with a negative source
+ * @param iteration the source iteration
+ */
+void CPUSolver::reportNegativeSources(long num_negative_sources,
+                                      long num_negative_fsrs, int iteration) {
+
   /* Tally the total number of negative source across the entire problem */
   long total_num_negative_sources = num_negative_sources;
   long total_num_negative_fsrs = num_negative_fsrs;
@@ -2115,99 +2509,18 @@ double CPUSolver::computeResidual(residualType res_type) {
   long norm;
   double residual;
   double* residuals = _regionwise_scratch;
-  memset(residuals, 0, _num_FSRs * sizeof(double));
 
   FP_PRECISION* reference_flux = _old_scalar_flux;
   if (_calculate_residuals_by_reference)
     reference_flux = _reference_flux;
 
-  if (res_type == SCALAR_FLUX) {
-
-    norm = _num_FSRs;
-
-#pragma omp parallel for schedule(static)
-    for (long r=0; r < _num_FSRs; r++) {
-      for (int e=0; e < _NUM_GROUPS; e++)
-        if (reference_flux(r,e) > 0.) {
-          residuals[r] += pow((_scalar_flux(r,e) - reference_flux(r,e)) /
-                              reference_flux(r,e), 2);
-      }
-    }
-  }
-
-  else if (res_type == FISSION_SOURCE) {
-
+  norm = _num_FSRs;
+  if (res_type == FISSION_SOURCE)
     norm = _num_fissionable_FSRs;
 
-    double new_fission_source, old_fission_source;
-    FP_PRECISION* nu_sigma_f;
-    Material* material;
-
-#pragma omp parallel for private(new_fission_source, old_fission_source,\
-     material, nu_sigma_f) schedule(static)
-    for (long r=0; r < _num_FSRs; r++) {
-      new_fission_source = 0.;
-      old_fission_source = 0.;
-      material = _FSR_materials[r];
-
-      if (material->isFissionable()) {
-        nu_sigma_f = material->getNuSigmaF();
-
-        for (int e=0; e < _NUM_GROUPS; e++) {
-          new_fission_source += _scalar_flux(r,e) * nu_sigma_f[e];
-          old_fission_source += reference_flux(r,e) * nu_sigma_f[e];
-        }
-
-        if (old_fission_source > 0.)
-          residuals[r] = pow((new_fission_source -  old_fission_source) /
-                              old_fission_source, 2);
-      }
-    }
-  }
-
-  else if (res_type == TOTAL_SOURCE) {
-
-    norm = _num_FSRs;
-
-    double new_total_source, old_total_source;
-    double inverse_k_eff = 1.0 / _k_eff;
-    FP_PRECISION* nu_sigma_f;
-    Material* material;
-
-#pragma omp parallel for private(new_total_source, old_total_source,\
-     material, nu_sigma_f) schedule(static)
-    for (long r=0; r < _num_FSRs; r++) {
-      new_total_source = 0.;
-      old_total_source = 0.;
-      material = _FSR_materials[r];
-
-      if (material->isFissionable()) {
-        nu_sigma_f = material->getNuSigmaF();
-
-        for (int e=0; e < _NUM_GROUPS; e++) {
-          new_total_source += _scalar_flux(r,e) * nu_sigma_f[e];
-          old_total_source += reference_flux(r,e) * nu_sigma_f[e];
-        }
-
-        new_total_source *= inverse_k_eff;
-        old_total_source *= inverse_k_eff;
-      }
-
-      /* Compute total scattering source for group G */
-      FP_PRECISION* sigma_s = material->getSigmaS();
-      for (int G=0; G < _NUM_GROUPS; G++) {
-        int first_idx = G * _NUM_GROUPS;
-        for (int g=0; g < _NUM_GROUPS; g++) {
-          new_total_source += sigma_s[first_idx+g] * _scalar_flux(r,g);
-          old_total_source += sigma_s[first_idx+g] * reference_flux(r,g);
-        }
-      }
-
-      if (old_total_source > 0.)
-        residuals[r] = pow((new_total_source -  old_total_source) /
-                            old_total_source, 2);
-    }
-  }
+#pragma omp parallel for schedule(static)
+  for (long r=0; r < _num_FSRs; r++)
+    residuals[r] = computeFSRResidual(r, res_type, reference_flux);
 
   /* Sum up the residuals from each FSR and normalize */
   residual = pairwise_sum<double>(residuals, _num_FSRs);
@@ -2252,6 +2565,87 @@ double CPUSolver::computeResidual(residualType res_type) {
 }
 
 
+/**
+ * @brief Computes the squared relative residual of a FSR between source/flux
+ *        iterations.
+ * @param r the FSR ID
+ * @param res_type the type of residuals to compute
+ *        (SCALAR_FLUX, FISSION_SOURCE, TOTAL_SOURCE)
+ * @param reference_flux the scalar fluxes of the previous iteration or of
+ *        the reference solution
+ * @return the squared residual of the FSR
+ */
+double CPUSolver::computeFSRResidual(long r, residualType res_type,
+                                     FP_PRECISION* reference_flux) {
+
+  double residual = 0.;
+
+  if (res_type == SCALAR_FLUX) {
+    for (int e=0; e < _NUM_GROUPS; e++)
+      if (reference_flux(r,e) > 0.) {
+        residual += pow((_scalar_flux(r,e) - reference_flux(r,e)) /
+                        reference_flux(r,e), 2);
+    }
+  }
+
+  else if (res_type == FISSION_SOURCE) {
+
+    double new_fission_source = 0.;
+    double old_fission_source = 0.;
+    Material* material = _FSR_materials[r];
+
+    if (material->isFissionable()) {
+      FP_PRECISION* nu_sigma_f = material->getNuSigmaF();
+
+      for (int e=0; e < _NUM_GROUPS; e++) {
+        new_fission_source += _scalar_flux(r,e) * nu_sigma_f[e];
+        old_fission_source += reference_flux(r,e) * nu_sigma_f[e];
+      }
+
+      if (old_fission_source > 0.)
+        residual = pow((new_fission_source -  old_fission_source) /
+                        old_fission_source, 2);
+    }
+  }
+
+  else if (res_type == TOTAL_SOURCE) {
+
+    double new_total_source = 0.;
+    double old_total_source = 0.;
+    double inverse_k_eff = 1.0 / _k_eff;
+    Material* material = _FSR_materials[r];
+
+    if (material->isFissionable()) {
+      FP_PRECISION* nu_sigma_f = material->getNuSigmaF();
+
+      for (int e=0; e < _NUM_GROUPS; e++) {
+        new_total_source += _scalar_flux(r,e) * nu_sigma_f[e];
+        old_total_source += reference_flux(r,e) * nu_sigma_f[e];
+      }
+
+      new_total_source *= inverse_k_eff;
+      old_total_source *= inverse_k_eff;
+    }
+
+    /* Compute total scattering source for group G */
+    FP_PRECISION* sigma_s = material->getSigmaS();
+    for (int G=0; G < _NUM_GROUPS; G++) {
+      int first_idx = G * _NUM_GROUPS;
+      for (int g=0; g < _NUM_GROUPS; g++) {
+        new_total_source += sigma_s[first_idx+g] * _scalar_flux(r,g);
+        old_total_source += sigma_s[first_idx+g] * reference_flux(r,g);
+      }
+    }
+
+    if (old_total_source > 0.)
+      residual = pow((new_total_source -  old_total_source) /
+                      old_total_source, 2);
+  }
+
+  return residual;
+}
+
+
 /**
  * @brief Compute \f$ k_{eff} \f$ from successive fission sources.
  */
@@ -2347,8 +2741,10 @@ void CPUSolver::transportSweep() {
   flattenFSRFluxes(0.0);
 
 #ifndef ONLYVACUUMBC
-  /* Copy starting flux to current flux */
-  copyBoundaryFluxes();
+  /* Copy starting flux to current flux, unless they are transferred in
+     place along the Track cycles */
+  if (!_cycle_ordered_sweep)
+    copyBoundaryFluxes();
 #endif
 
   /* Tally the starting fluxes to boundaries */
@@ -2497,6 +2893,76 @@ void CPUSolver::tallyScalarFlux(segment* curr_segment,
 }
 
 
+/**
+ * @brief Computes the contribution to the FSR scalar flux from a band of
+ *        3D Tracks of a z-stack crossing the same segment.
+ * @details The Tracks of a z-stack that cross the full 2D length of an FSR
+ *          share the segment length, region and material, so the optical
+ *          lengths, exponentials and sources are computed once per group
+ *          and the angular fluxes of all the Tracks are then attenuated
+ *          together. With fewer groups than the SIMD vector length, the
+ *          vector lanes run across the Tracks instead of across the groups.
+ *          This is only used for 3D flat source sweeps.
+ * @param curr_segment a pointer to the segment shared by the Tracks
+ * @param num_tracks the number of Tracks in the band
+ * @param fsr_flux buffer to store the contribution to the region's scalar flux
+ * @param track_flux a pointer to the angular flux of the first Track, the
+ *        fluxes of the following Tracks being those of the consecutive
+ *        Track IDs in the same direction
+ */
+void CPUSolver::tallyScalarFluxStack(segment* curr_segment, int num_tracks,
+                                     FP_PRECISION* __restrict__ fsr_flux,
+                                     float* __restrict__ track_flux) {
+
+  long fsr_id = curr_segment->_region_id;
+  FP_PRECISION length = curr_segment->_length;
+  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
+  const long stride = 2 * _fluxes_per_track;
+
+  /* Compute the terms shared by all the Tracks of the band */
+  FP_PRECISION tau[_NUM_GROUPS] __attribute__ ((aligned(VEC_ALIGNMENT)));
+  FP_PRECISION exponential[_NUM_GROUPS]
+               __attribute__ ((aligned(VEC_ALIGNMENT)));
+  FP_PRECISION source[_NUM_GROUPS] __attribute__ ((aligned(VEC_ALIGNMENT)));
+
+#pragma omp simd aligned(sigma_t, tau, exponential, source)
+  for (int e=0; e < _NUM_GROUPS; e++) {
+    tau[e] = sigma_t[e] * length;
+    expF1_fractional(tau[e], &exponential[e]);
+    source[e] = length * _reduced_sources(fsr_id, e);
+  }
+
+  /* Vectorize across the Tracks for few-group problems */
+  if (_NUM_GROUPS < VEC_LENGTH) {
+    for (int e=0; e < _NUM_GROUPS; e++) {
+      FP_PRECISION tally = 0.;
+#pragma omp simd reduction(+:tally)
+      for (int t=0; t < num_tracks; t++) {
+        FP_PRECISION delta_psi = (tau[e] * track_flux[t*stride + e] -
+                                  source[e]) * exponential[e];
+        track_flux[t*stride + e] -= delta_psi;
+        tally += delta_psi;
+      }
+      fsr_flux[e] += tally;
+    }
+  }
+
+  /* Otherwise vectorize across the groups of each Track */
+  else {
+    for (int t=0; t < num_tracks; t++) {
+      float* psi = &track_flux[t*stride];
+#pragma omp simd aligned(tau, exponential, source, fsr_flux)
+      for (int e=0; e < _NUM_GROUPS; e++) {
+        FP_PRECISION delta_psi = (tau[e] * psi[e] - source[e]) *
+                                 exponential[e];
+        psi[e] -= delta_psi;
+        fsr_flux[e] += delta_psi;
+      }
+    }
+  }
+}
+
+
 /**
  * @brief Move the segment(s)' contributions to the scalar flux from the buffer
  * to the global scalar flux array.
@@ -2583,11 +3049,36 @@ void CPUSolver::transferBoundaryFlux(Track* track,
   }
 
   /* Determine if flux should be transferred */
-  if (bc_out == REFLECTIVE || bc_out == PERIODIC) {
+  if (bc_out == REFLECTIVE || bc_out == PERIODIC || bc_out == ROTATIONAL) {
     float* track_out_flux = &_start_flux(track_out_id, 0, start_out);
-    memcpy(track_out_flux, track_flux, _fluxes_per_track * sizeof(float));
+#ifdef __SSE__
+    if (_streaming_stores && !_cycle_ordered_sweep) {
+
+      /* Write the full cache lines of the destination around the cache,
+         partial lines being much slower to stream than to store */
+      const int line_length = CACHE_LINE_SIZE / sizeof(float);
+      int pe = 0;
+      for (; pe < _fluxes_per_track && reinterpret_cast<uintptr_t>(
+           &track_out_flux[pe]) % CACHE_LINE_SIZE != 0; pe++)
+        track_out_flux[pe] = track_flux[pe];
+      for (; pe + line_length <= _fluxes_per_track; pe += line_length)
+        for (int i=0; i < line_length; i += 4)
+          _mm_stream_ps(&track_out_flux[pe+i],
+                        _mm_loadu_ps(&track_flux[pe+i]));
+      for (; pe < _fluxes_per_track; pe++)
+        track_out_flux[pe] = track_flux[pe];
+    }
+    else
+#endif
+      memcpy(track_out_flux, track_flux, _fluxes_per_track * sizeof(float));
   }
-  /* For vacuum boundary conditions, losing the flux is enough */
+
+  /* For vacuum boundary conditions, losing the flux is enough, unless the
+     fluxes are updated in place, where the incoming flux in the reverse
+     direction needs to be reset */
+  else if (bc_out == VACUUM && _cycle_ordered_sweep)
+    memset(&_boundary_flux(track->getUid(), direction, 0), 0,
+           _fluxes_per_track * sizeof(float));
 
   /* Tally leakage if applicable */
   if (!_keff_from_fission_rates) {
@@ -2635,6 +3126,16 @@ void CPUSolver::addSourceToScalarFlux() {
     }
   }
 
+  reportNegativeFluxes(num_negative_fluxes);
+}
+
+
+/**
+ * @brief Tallies the negative fluxes across domains and reports them.
+ * @param num_negative_fluxes the number of negative fluxes in the domain
+ */
+void CPUSolver::reportNegativeFluxes(long num_negative_fluxes) {
+
   /* Tally the total number of negative fluxes across the entire problem */
   long total_num_negative_fluxes = num_negative_fluxes;
   int num_negative_flux_domains = (num_negative_fluxes > 0);
@@ -2658,6 +3159,318 @@ void CPUSolver::addSourceToScalarFlux() {
   }
 }
 
+/**
+ * @brief Runs the source iterations of an eigenvalue calculation in a single
+ *        parallel region.
+ * @details The threads share the work of each step of the source iterations
+ *          and only synchronize with barriers where a step depends on the
+ *          results of the previous one. The source is computed and the
+ *          scalar flux zeroed in the same loop over the FSRs, the source is
+ *          then added to the scalar flux along with the FSR fission and
+ *          absorption rates, and the fluxes are normalized along with the
+ *          FSR residuals. The reductions and the iteration report are done by
+ *          a single thread. With CMFD acceleration, the parallel region is
+ *          left after each transport sweep for the CMFD solve, which opens
+ *          its own parallel regions, and the next region starts with the flux
+ *          normalization. The iterations are the same as the source
+ *          iterations of Solver::computeEigenvalue(...), up to round-off.
+ * @param max_iters the maximum number of source iterations
+ * @param res_type the type of residual used for the convergence criterion
+ * @param convergence_data the CMFD convergence data of the iteration reports
+ * @return whether the source iterations were run
+ */
+bool CPUSolver::iterateInParallelRegion(int max_iters, residualType res_type,
+                                        ConvergenceData* convergence_data) {
+
+  if (!_persistent_region)
+    return false;
+
+  if (typeid(*this) != typeid(CPUSolver))
+    log_printf(ERROR, "Persistent parallel regions are only available with "
+               "the flat source CPUSolver");
+  if (_cmfd != NULL && _cmfd->isSigmaTRebalanceOn())
+    log_printf(ERROR, "Persistent parallel regions are not available with "
+               "the CMFD sigma-t rebalance");
+  if (_stabilize_transport || _axial_refinement_tolerance > 0.)
+    log_printf(ERROR, "Persistent parallel regions are not available with "
+               "transport stabilization or axial refinement");
+  if (_OTF_transport)
+    log_printf(ERROR, "Persistent parallel regions are not available with "
+               "the OTF transport sweep");
+  if (_geometry->isDomainDecomposed())
+    log_printf(ERROR, "Persistent parallel regions are not available with "
+               "domain decomposition");
+#ifdef ONLYVACUUMBC
+  log_printf(ERROR, "Persistent parallel regions are not available when "
+             "OpenMOC is compiled for vacuum boundaries only");
+#endif
+
+  bool cmfd_update = (_cmfd != NULL && _cmfd->isFluxUpdateOn());
+
+  /* FSR rates and residuals */
+  double* fission_rates = _regionwise_scratch;
+  std::vector<double> absorption_rates(_num_FSRs);
+  std::vector<double> residuals(_num_FSRs);
+
+  FP_PRECISION* reference_flux = _old_scalar_flux;
+  if (_calculate_residuals_by_reference)
+    reference_flux = _reference_flux;
+
+  long norm = _num_FSRs;
+  if (res_type == FISSION_SOURCE)
+    norm = _num_fissionable_FSRs;
+  if (res_type == FISSION_SOURCE && norm == 0)
+      log_printf(ERROR, "The Solver is unable to compute a "
+                 "FISSION_SOURCE residual without fissionable FSRs");
+
+  /* Data shared by the threads */
+  long num_negative_sources = 0;
+  long num_negative_fsrs = 0;
+  long num_negative_fluxes = 0;
+  double norm_factor = 1.;
+  double previous_residual = 1.;
+  double k_prev = _k_eff;
+  int i = 0;
+  bool flux_updated = false;
+  bool done = (max_iters <= 0);
+
+  TransportSweep sweep_tracks(this);
+
+  /* Parallel regions, only left for the CMFD solves */
+  while (!done) {
+
+#pragma omp parallel
+    {
+      while (true) {
+
+        /* Finish the previous iteration once its fluxes are updated */
+        if (flux_updated) {
+
+          /* Compute the fission source for the normalization of the CMFD
+             updated fluxes */
+          if (cmfd_update) {
+#pragma omp for schedule(static)
+            for (long r=0; r < _num_FSRs; r++) {
+              int tid = omp_get_thread_num();
+              FP_PRECISION* group_rates = _groupwise_scratch.at(tid);
+              FP_PRECISION* nu_sigma_f = _FSR_materials[r]->getNuSigmaF();
+              for (int e=0; e < _NUM_GROUPS; e++)
+                group_rates[e] = nu_sigma_f[e] * _scalar_flux(r,e);
+              fission_rates[r] = pairwise_sum<FP_PRECISION>(group_rates,
+                                                            _NUM_GROUPS);
+              fission_rates[r] *= _FSR_volumes[r];
+            }
+
+#pragma omp single
+            {
+              double fission = pairwise_sum<double>(fission_rates, _num_FSRs);
+              norm_factor = _num_FSRs / fission;
+              log_printf(DEBUG, "Tot. Fiss. Src. = %f, Norm. factor = %f",
+                         fission, norm_factor);
+            }
+          }
+
+          /* Normalize the scalar fluxes, compute the residuals and store the
+             fluxes for the next iteration */
+#pragma omp for schedule(static) nowait
+          for (long r=0; r < _num_FSRs; r++) {
+            for (int e=0; e < _NUM_GROUPS; e++)
+              _scalar_flux(r, e) *= norm_factor;
+            residuals[r] = computeFSRResidual(r, res_type, reference_flux);
+            for (int e=0; e < _NUM_GROUPS; e++)
+              _old_scalar_flux(r,e) = _scalar_flux(r,e);
+          }
+
+          /* Normalize angular boundary fluxes for each Track */
+#pragma omp for schedule(static) nowait
+          for (long idx=0; idx < 2 * _tot_num_tracks * _fluxes_per_track;
+               idx++) {
+            if (!_cycle_ordered_sweep)
+              _start_flux[idx] *= norm_factor;
+            _boundary_flux[idx] *= norm_factor;
+          }
+
+#pragma omp barrier
+#pragma omp single
+          {
+            /* Compute RMS residual */
+            double residual = pairwise_sum<double>(&residuals[0], _num_FSRs);
+            residual = sqrt(residual / std::max(norm, 1L));
+
+            /* Compute difference in k and apparent dominance ratio */
+            double dr = residual / previous_residual;
+            int dk = 1e5 * (_k_eff - k_prev);
+            previous_residual = residual;
+            k_prev = _k_eff;
+
+            printIterationReport(i, residual, dk, dr, convergence_data);
+
+            if (_cmfd != NULL) {
+              if (residual <= 0)
+                residual = 1e-6;
+              _cmfd->setSourceConvergenceThreshold(0.01*residual);
+            }
+
+            _num_iterations++;
+            i++;
+            flux_updated = false;
+
+            /* Check for convergence of the fission source distribution */
+            bool converged = (residual < _converge_thresh && std::abs(dk) < 1);
+            done = (converged || i == max_iters);
+          }
+
+          if (done)
+            break;
+        }
+
+        /* Compute the sources and zero the scalar fluxes */
+#pragma omp for schedule(static) nowait
+        for (long r=0; r < _num_FSRs; r++) {
+
+          int num_negative_fsr_sources = computeFSRSource(r, i);
+          if (num_negative_fsr_sources > 0) {
+#pragma omp atomic update
+            num_negative_sources += num_negative_fsr_sources;
+#pragma omp atomic update
+            num_negative_fsrs++;
+          }
+
+          for (int e=0; e < _NUM_GROUPS; e++)
+            _scalar_flux(r,e) = 0.;
+        }
+
+        /* Copy starting flux to current flux, unless they are transferred
+           in place along the Track cycles */
+        if (!_cycle_ordered_sweep) {
+#pragma omp for schedule(static) nowait
+          for (long t=0; t < _tot_num_tracks; t++)
+            for (int d=0; d < 2; d++)
+              for (int pe=0; pe < _fluxes_per_track; pe++)
+                _boundary_flux(t,d,pe) = _start_flux(t, d, pe);
+        }
+
+        /* Zero boundary leakage tally */
+        if (_boundary_leakage != NULL) {
+#pragma omp for schedule(static) nowait
+          for (long t=0; t < _tot_num_tracks; t++)
+            _boundary_leakage[t] = 0.;
+        }
+
+#pragma omp barrier
+#pragma omp single
+        {
+          reportNegativeSources(num_negative_sources, num_negative_fsrs, i);
+          num_negative_sources = 0;
+          num_negative_fsrs = 0;
+          if (cmfd_update)
+            _cmfd->zeroCurrents();
+          _timer->startTimer();
+        }
+
+        /* Sweep the Tracks with the threads of the region */
+        sweep_tracks.sweep();
+
+#pragma omp barrier
+#pragma omp master
+        {
+          _timer->stopTimer();
+          _timer->recordSplit("Transport Sweep");
+        }
+
+        /* Add the source to the scalar fluxes and compute the FSR rates */
+#pragma omp for schedule(static)
+        for (long r=0; r < _num_FSRs; r++) {
+
+          FP_PRECISION volume = _FSR_volumes[r];
+          Material* material = _FSR_materials[r];
+          FP_PRECISION* sigma_t = material->getSigmaT();
+
+          /* Handle zero volume source region case */
+          FP_PRECISION flux_volume = volume;
+          if (flux_volume < FLT_EPSILON)
+            flux_volume = 1e30;
+
+          for (int e=0; e < _NUM_GROUPS; e++) {
+
+            _scalar_flux(r, e) /= (sigma_t[e] * flux_volume);
+            _scalar_flux(r, e) += FOUR_PI * _reduced_sources(r, e) /
+                                  sigma_t[e];
+
+            if (_scalar_flux(r, e) < 0.0 && !_negative_fluxes_allowed) {
+              _scalar_flux(r, e) = FLUX_EPSILON;
+#pragma omp atomic update
+              num_negative_fluxes++;
+            }
+          }
+
+          /* The eigenvalue is computed by CMFD */
+          if (cmfd_update)
+            continue;
+
+          int tid = omp_get_thread_num();
+          FP_PRECISION* group_rates = _groupwise_scratch.at(tid);
+          FP_PRECISION* nu_sigma_f = material->getNuSigmaF();
+          for (int e=0; e < _NUM_GROUPS; e++)
+            group_rates[e] = nu_sigma_f[e] * _scalar_flux(r,e);
+          fission_rates[r] = pairwise_sum<FP_PRECISION>(group_rates,
+                                                        _NUM_GROUPS);
+          fission_rates[r] *= volume;
+
+          if (!_keff_from_fission_rates) {
+            FP_PRECISION* sigma_a = material->getSigmaA();
+            for (int e=0; e < _NUM_GROUPS; e++)
+              group_rates[e] = sigma_a[e] * _scalar_flux(r,e);
+            absorption_rates[r] = pairwise_sum<FP_PRECISION>(group_rates,
+                                                             _NUM_GROUPS);
+            absorption_rates[r] *= volume;
+          }
+        }
+
+        /* Leave the parallel region for the CMFD solve */
+        if (cmfd_update) {
+#pragma omp single
+          reportNegativeFluxes(num_negative_fluxes);
+          break;
+        }
+
+        /* Compute the eigenvalue and the flux normalization factor */
+#pragma omp single
+        {
+          reportNegativeFluxes(num_negative_fluxes);
+          num_negative_fluxes = 0;
+
+          double fission = pairwise_sum<double>(fission_rates, _num_FSRs);
+          if (!_keff_from_fission_rates) {
+            double absorption = pairwise_sum<double>(&absorption_rates[0],
+                                                     _num_FSRs);
+            double leakage = pairwise_sum<float>(_boundary_leakage,
+                                                 _tot_num_tracks);
+            _k_eff = fission / (absorption + leakage);
+          }
+          else
+            _k_eff *= fission / _num_FSRs;
+
+          norm_factor = _num_FSRs / fission;
+          log_printf(DEBUG, "Tot. Fiss. Src. = %f, Norm. factor = %f",
+                     fission, norm_factor);
+          flux_updated = true;
+        }
+      }
+    }
+
+    /* Solve the CMFD diffusion problem and update the MOC fluxes */
+    if (!done) {
+      num_negative_fluxes = 0;
+      _k_eff = _cmfd->computeKeff(_num_iterations);
+      flux_updated = true;
+    }
+  }
+
+  return true;
+}
+
+
 
 /**
  * @brief Computes the stabilizing flux for transport stabilization
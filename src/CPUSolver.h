@@ -17,6 +17,9 @@
 #include <omp.h>
 #include <stdlib.h>
 #include <unordered_map>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 #endif
 
 #undef track_flux
@@ -113,6 +116,28 @@ protected:
   std::vector<std::vector<bool> > _track_flux_sent;
 #endif
 
+  /** Whether Tracks are swept along their reflective cycles, with the
+   *  outgoing angular fluxes transferred in place */
+  bool _cycle_ordered_sweep;
+
+  /** The indexes of the Tracks in their sweep order, grouped by cycle */
+  TrackStackIndexes* _cycle_tracks;
+
+  /** The offsets of each cycle into the ordered Tracks */
+  long* _cycle_offsets;
+
+  /** The number of independent cycles of Tracks */
+  long _num_cycles;
+
+  /** The number of segments ahead for which the FSR data is prefetched */
+  int _prefetch_distance;
+
+  /** Whether outgoing boundary fluxes are written with non-temporal stores */
+  bool _streaming_stores;
+
+  /** Whether the source iterations run in a single parallel region */
+  bool _persistent_region;
+
   virtual void initializeFluxArrays();
   virtual void initializeSourceArrays();
   virtual void initializeFSRs();
@@ -120,6 +145,7 @@ protected:
 
   void zeroTrackFluxes();
   void copyBoundaryFluxes();
+  void initializeTrackCycles();
   void tallyStartingCurrents();
 #ifdef MPIx
   void setupMPIBuffers();
@@ -137,12 +163,20 @@ protected:
   void computeFSRFissionSources();
   void computeFSRScatterSources();
   virtual void computeFSRSources(int iteration);
+  int computeFSRSource(long r, int iteration);
+  void reportNegativeSources(long num_negative_sources, long num_negative_fsrs,
+                             int iteration);
   void transportSweep();
   virtual void computeStabilizingFlux();
   virtual void stabilizeFlux();
   virtual void addSourceToScalarFlux();
+  void reportNegativeFluxes(long num_negative_fluxes);
   void computeKeff();
   double computeResidual(residualType res_type);
+  double computeFSRResidual(long r, residualType res_type,
+                            FP_PRECISION* reference_flux);
+  bool iterateInParallelRegion(int max_iters, residualType res_type,
+                               ConvergenceData* convergence_data);
 
 public:
   CPUSolver(TrackGenerator* track_generator=NULL);
@@ -156,10 +190,25 @@ public:
   void computeFSRFissionRates(double* fission_rates, long num_FSRs,
                               bool nu = false);
   void printInputParamsSummary();
+  void useCycleOrderedSweep();
+  bool isCycleOrderedSweep();
+  TrackStackIndexes* getCycleTracks();
+  long* getCycleOffsets();
+  long getNumCycles();
+  void setPrefetchDistance(int prefetch_distance);
+  int getPrefetchDistance();
+  void useStreamingStores(bool streaming_stores);
+  void fenceStreamingStores();
+  void usePersistentParallelRegion(bool persistent_region);
+  void prefetchSegment(segment* curr_segment);
+  void prefetchTrackFlux(long track_id);
 
   void tallyScalarFlux(segment* curr_segment, int azim_index,
                        FP_PRECISION* fsr_flux, float* track_flux);
 
+  void tallyScalarFluxStack(segment* curr_segment, int num_tracks,
+                            FP_PRECISION* fsr_flux, float* track_flux);
+
   void accumulateScalarFluxContribution(long fsr_id, FP_PRECISION weight,
                                         FP_PRECISION* fsr_flux);
 
@@ -186,4 +235,54 @@ public:
 };
 
 
+/**
+ * @brief Prefetches the source, scalar flux and total cross section data of
+ *        a segment that will soon be swept.
+ * @details The FSR source row is prefetched for reading and the FSR scalar
+ *          flux row for writing, one cache line at a time.
+ * @param curr_segment a pointer to the upcoming segment
+ */
+inline void CPUSolver::prefetchSegment(segment* curr_segment) {
+
+  long fsr_id = curr_segment->_region_id;
+  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
+  const int line_length = CACHE_LINE_SIZE / sizeof(FP_PRECISION);
+
+  for (int e=0; e < _NUM_GROUPS; e += line_length) {
+    __builtin_prefetch(&_reduced_sources(fsr_id, e), 0);
+    __builtin_prefetch(&_scalar_flux(fsr_id, e), 1);
+    __builtin_prefetch(&sigma_t[e], 0);
+  }
+}
+
+
+/**
+ * @brief Prefetches the boundary angular fluxes of a Track in both
+ *        directions, before it is swept.
+ * @param track_id the unique ID of the Track
+ */
+inline void CPUSolver::prefetchTrackFlux(long track_id) {
+
+  if (track_id >= _tot_num_tracks)
+    return;
+
+  float* track_flux = &_boundary_flux(track_id, 0, 0);
+  const int line_length = CACHE_LINE_SIZE / sizeof(float);
+  for (int pe=0; pe < 2 * _fluxes_per_track; pe += line_length)
+    __builtin_prefetch(&track_flux[pe], 1);
+}
+
+
+/**
+ * @brief Makes the non-temporal stores of the calling thread visible before
+ *        the boundary fluxes are read again.
+ */
+inline void CPUSolver::fenceStreamingStores() {
+#ifdef __SSE__
+  if (_streaming_stores)
+    _mm_sfence();
+#endif
+}
+
+
 #endif /* CPUSOLVER_H_ */
@@ -1267,6 +1267,23 @@ double Cell::minSurfaceDist(Point* point, double azim, double polar) {
 }
 
 
+/**
+ * @brief Computes the minimum distance to a Surface from a Point travelling
+ *        along a given unit direction.
+ * @details If the trajectory will not intersect any of the Surfaces in the
+ *          Cell returns INFINITY.
+ * @param point the Point of interest
+ * @param direction the unit direction of the trajectory
+ * @return distance to nearest intersection with the cell's region boundaries
+ */
+double Cell::minSurfaceDist(Point* point, const Direction* direction) {
+  if (_region == NULL)
+    return INFINITY;
+  else
+    return _region->minSurfaceDist(point, direction);
+}
+
+
 /**
  * @brief Returns true if this Cell is filled with a fissionable Material.
  * @details If the Cell is filled by a Material, this method will simply query
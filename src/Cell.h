@@ -189,6 +189,7 @@ public:
   bool containsPoint(Point* point);
   bool containsCoords(LocalCoords* coords);
   double minSurfaceDist(Point* point, double azim, double polar);
+  double minSurfaceDist(Point* point, const Direction* direction);
   double minSurfaceDist(LocalCoords* coords);
 
   Cell* clone(bool clone_region=true);
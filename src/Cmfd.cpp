@@ -38,6 +38,17 @@ Cmfd::Cmfd() {
   _use_axial_interpolation = 0;
   _flux_limiting = true;
   _balance_sigma_t = false;
+  _structured_stencil = false;
+  _warm_start = false;
+  _max_power_iterations = MAX_LINALG_POWER_ITERATIONS;
+  _return_failures = false;
+  _dominance_ratio = -1;
+  _matrix_rebuild_threshold = 0;
+  _matrix_xs = NULL;
+  _streaming_coeffs = NULL;
+  _matrices_built = false;
+  _num_matrix_builds = 0;
+  _num_matrix_updates = 0;
   _k_nearest = 1;
   _SOR_factor = 1.5;
   _num_FSRs = 0;
@@ -87,7 +98,22 @@ Cmfd::Cmfd() {
   _lattice = NULL;
   _azim_spacings = NULL;
   _polar_spacings = NULL;
+  _k_nearest_offsets = NULL;
+  _k_nearest_cells = NULL;
+  _k_nearest_weights = NULL;
   _backup_cmfd = NULL;
+  _initial_condensed_groups = 0;
+  _num_condensed_groups = 0;
+  _condensation_stall_ratio = 0.8;
+  _num_stalled_iterations = 0;
+  _previous_source_threshold = -1;
+  _cmfd_group_to_condensed_group = NULL;
+  _num_condensed_solves = 0;
+  _condensed_solve_time = 0;
+  _condensed_residual_ratios = 0;
+  _condensed_max_iterations = MAX_LINALG_POWER_ITERATIONS;
+  _condensed_cmfd = NULL;
+  _currents_split = false;
   _cmfd_group_to_backup_group = NULL;
   _backup_group_structure.resize(0);
 
@@ -156,6 +182,12 @@ Cmfd::~Cmfd() {
   if (_old_dif_surf_corr != NULL)
     delete _old_dif_surf_corr;
 
+  if (_matrix_xs != NULL)
+    delete [] _matrix_xs;
+
+  if (_streaming_coeffs != NULL)
+    delete [] _streaming_coeffs;
+
   if (_volumes != NULL)
     delete _volumes;
 
@@ -185,12 +217,13 @@ Cmfd::~Cmfd() {
     iter1->clear();
   _cell_fsrs.clear();
 
-  /* Clear the _k_nearest_stencils map of vectors */
-  std::map<long, std::vector< std::pair<int, double> > >::iterator iter2;
-  for (iter2 = _k_nearest_stencils.begin(); iter2 != _k_nearest_stencils.end();
-       ++iter2)
-    iter2->second.clear();
-  _k_nearest_stencils.clear();
+  /* Delete the k-nearest stencils */
+  if (_k_nearest_offsets != NULL)
+    delete [] _k_nearest_offsets;
+  if (_k_nearest_cells != NULL)
+    delete [] _k_nearest_cells;
+  if (_k_nearest_weights != NULL)
+    delete [] _k_nearest_weights;
 
   /* Delete tally information */
   if (_tallies_allocated) {
@@ -251,7 +284,14 @@ Cmfd::~Cmfd() {
   if (_backup_cmfd != NULL)
     delete _backup_cmfd;
 
+  if (_condensed_cmfd != NULL)
+    delete _condensed_cmfd;
+
+  if (_cmfd_group_to_condensed_group != NULL)
+    delete [] _cmfd_group_to_condensed_group;
+
   delete _timer;
+  release_memory(this);
 }
 
 
@@ -730,37 +770,23 @@ void Cmfd::collapseXS() {
     log_printf(ERROR, "Tallies need to be allocated before collapsing "
                "cross-sections");
 
-  /* Split vertex and edge currents to side surfaces */
-  splitVertexCurrents();
-#ifdef MPIx
-  if (_geometry->isDomainDecomposed())
-    communicateSplits(false);
-#endif
-  splitEdgeCurrents();
-#ifdef MPIx
-  if (_geometry->isDomainDecomposed())
-    communicateSplits(true);
-#endif
+  /* The currents may only be split once per MOC iteration */
+  bool split_currents = !_currents_split;
+  _currents_split = false;
 
-  /* Report number of negative currents */
-  long num_negative_currents = _surface_currents->getNumNegativeValues();
-  int total_negative_CMFD_current_domains = (num_negative_currents > 0);
+  /* Split vertex currents to the faces and edges, the edge currents split
+   * onto other domains are exchanged while the cross-sections are collapsed */
+  if (split_currents)
+    splitVertexCurrents();
 #ifdef MPIx
-  if (_domain_communicator != NULL) {
-    long temp_sum_neg = num_negative_currents;
-    MPI_Allreduce(&temp_sum_neg, &num_negative_currents, 1, MPI_LONG, MPI_SUM,
-                  _domain_communicator->_MPI_cart);
-    int temp_sum_dom = total_negative_CMFD_current_domains;
-    MPI_Allreduce(&temp_sum_dom, &total_negative_CMFD_current_domains, 1,
-                  MPI_INT, MPI_SUM, _domain_communicator->_MPI_cart);
-  }
+  MPI_Request request;
+  if (split_currents && _geometry->isDomainDecomposed())
+    startNeighborExchange(_send_split_current_data,
+                          _receive_split_current_data,
+                          (NUM_FACES + NUM_EDGES) * _num_cmfd_groups,
+                          &request);
 #endif
 
-  if (_SOLVE_3D && num_negative_currents > 0)
-    log_printf(WARNING_ONCE, "Negative CMFD currents in %ld surfaces-groups in"
-               " %d domains.", num_negative_currents,
-               total_negative_CMFD_current_domains);
-
 #pragma omp parallel
   {
 
@@ -928,22 +954,56 @@ void Cmfd::collapseXS() {
   }
 
 #ifdef MPIx
-  if (_geometry->isDomainDecomposed()) {
-    if (_domain_communicator != NULL) {
+  /* Complete the edge current exchange */
+  if (split_currents && _geometry->isDomainDecomposed()) {
+    _timer->startTimer();
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    _timer->stopTimer();
+    _timer->recordSplit("CMFD MPI communication time");
+    unpackSplitCurrents(false);
+  }
+#endif
 
-      /* Start recording MPI communication time */
-      _timer->startTimer();
+  /* Split edge currents to side surfaces */
+  if (split_currents)
+    splitEdgeCurrents();
+#ifdef MPIx
+  if (split_currents && _geometry->isDomainDecomposed()) {
+    _timer->startTimer();
+    communicateSplits(true);
+    _timer->stopTimer();
+    _timer->recordSplit("CMFD MPI communication time");
+  }
+#endif
 
-      /* Do the Ghost cell exchange */
-      ghostCellExchange();
+#ifdef MPIx
+  /* Start the ghost cell exchange, which completes while the negative
+   * currents are counted and the local fluxes are computed */
+  bool ghost_exchange = _geometry->isDomainDecomposed() &&
+                        _domain_communicator != NULL;
+  if (ghost_exchange)
+    ghostCellExchange(&request);
+#endif
 
-      /* Tally the MPI communication time */
-      _timer->stopTimer();
-      _timer->recordSplit("CMFD MPI communication time");
-    }
+  /* Report number of negative currents */
+  long num_negative_currents = _surface_currents->getNumNegativeValues();
+  int total_negative_CMFD_current_domains = (num_negative_currents > 0);
+#ifdef MPIx
+  if (_domain_communicator != NULL) {
+    long temp_sum_neg = num_negative_currents;
+    MPI_Allreduce(&temp_sum_neg, &num_negative_currents, 1, MPI_LONG, MPI_SUM,
+                  _domain_communicator->_MPI_cart);
+    int temp_sum_dom = total_negative_CMFD_current_domains;
+    MPI_Allreduce(&temp_sum_dom, &total_negative_CMFD_current_domains, 1,
+                  MPI_INT, MPI_SUM, _domain_communicator->_MPI_cart);
   }
 #endif
 
+  if (_SOLVE_3D && num_negative_currents > 0)
+    log_printf(WARNING_ONCE, "Negative CMFD currents in %ld surfaces-groups in"
+               " %d domains.", num_negative_currents,
+               total_negative_CMFD_current_domains);
+
   /* Calculate (local) old fluxes and set volumes */
 #pragma omp parallel for
   for (int i = 0; i < _local_num_x * _local_num_y * _local_num_z; i++) {
@@ -961,6 +1021,16 @@ void Cmfd::collapseXS() {
     }
   }
 
+#ifdef MPIx
+  /* Complete the ghost cell exchange */
+  if (ghost_exchange) {
+    _timer->startTimer();
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    _timer->stopTimer();
+    _timer->recordSplit("CMFD MPI communication time");
+  }
+#endif
+
   /* Loop over boundary CMFD cells and set cross sections */
   if (_geometry->isDomainDecomposed()) {
 #pragma omp parallel for
@@ -1060,9 +1130,13 @@ void Cmfd::getSurfaceDiffusionCoefficient(int cmfd_cell, int surface,
   CMFD_PRECISION delta_interface = getSurfaceWidth(surface, global_cmfd_cell);
   CMFD_PRECISION delta = getPerpendicularSurfaceWidth(surface, global_cmfd_cell);
 
+  /* Get the surface index for the surface in the neighboring cell */
+  int surface_next = getSurfaceNext(global_cmfd_cell, surface);
+
   CMFD_PRECISION delta_next = 0.0;
   if (global_cmfd_cell_next != -1)
-    delta_next = getPerpendicularSurfaceWidth(surface, global_cmfd_cell_next);
+    delta_next = getPerpendicularSurfaceWidth(surface_next,
+                                              global_cmfd_cell_next);
 
   int sense = getSense(surface);
 
@@ -1094,12 +1168,10 @@ void Cmfd::getSurfaceDiffusionCoefficient(int cmfd_cell, int surface,
     }
   }
 
-  /* If surface is an interface or PERIODIC BC, use finite differencing */
+  /* If surface is an interface, PERIODIC or ROTATIONAL BC, use finite
+   * differencing */
   else {
 
-    /* Get the surface index for the surface in the neighboring cell */
-    int surface_next = (surface + NUM_FACES / 2) % NUM_FACES;
-
     /* Get the outward current on surface */
     current_out = _surface_currents->getValue
         (cmfd_cell, surface*_num_cmfd_groups + group);
@@ -1200,6 +1272,7 @@ double Cmfd::computeKeff(int moc_iteration) {
 
   /* Save MOC iteration number */
   _moc_iteration = moc_iteration;
+  _currents_split = false;
 
   /* Create matrix and vector objects */
   if (_A == NULL) {
@@ -1207,6 +1280,16 @@ double Cmfd::computeKeff(int moc_iteration) {
                "linear algebra matrices and arrays have not been created.");
   }
 
+  /* Solve on the automatically condensed group structure if requested */
+  if (_num_condensed_groups > 0) {
+    double k_eff = computeCondensedKeff(moc_iteration);
+    if (fabs(k_eff + 1) > FLT_EPSILON) {
+      _timer->stopTimer();
+      _timer->recordSplit("Total CMFD time");
+      return _k_eff;
+    }
+  }
+
   /* Start recording XS collapse time */
   _timer->startTimer();
 
@@ -1221,30 +1304,74 @@ double Cmfd::computeKeff(int moc_iteration) {
   _timer->stopTimer();
   _timer->recordSplit("Total collapse time");
 
+  /* Only update the current-dependent coefficients of the matrices if the
+   * collapsed cross-sections barely changed since they were last built */
+  bool rebuild_xs = true;
+  double xs_change = -1;
+  if (_matrix_rebuild_threshold > 0 && !_balance_sigma_t) {
+
+    int num_cells = _local_num_x * _local_num_y * _local_num_z;
+    if (_matrix_xs == NULL) {
+      _matrix_xs = new CMFD_PRECISION[num_cells * _num_cmfd_groups *
+                                      (3 + _num_cmfd_groups)];
+      _streaming_coeffs = new CMFD_PRECISION[2 * num_cells * NUM_FACES *
+                                             _num_cmfd_groups]();
+    }
+
+    /* The change must also stay below the MOC source residual, of which the
+     * source convergence threshold is a hundredth, so that the stale terms
+     * do not bias the converged eigenvalue */
+    if (_matrices_built && _moc_iteration > 0) {
+      xs_change = computeXSChange(false);
+      rebuild_xs = xs_change > std::min(_matrix_rebuild_threshold,
+                                        100 * _source_convergence_threshold);
+    }
+    if (rebuild_xs)
+      computeXSChange(true);
+  }
+
   /* Construct matrices and record time */
   _timer->startTimer();
-  constructMatrices();
+  constructMatrices(rebuild_xs);
   _timer->stopTimer();
   _timer->recordSplit("Matrix construction time");
+  if (rebuild_xs) {
+    _num_matrix_builds++;
+    log_printf(INFO, "CMFD matrices constructed in %1.4E sec",
+               _timer->getTime());
+  }
+  else {
+    _timer->recordSplit("Matrix update time");
+    _num_matrix_updates++;
+    log_printf(INFO, "CMFD matrices updated in %1.4E sec, cross-section "
+               "change %3.2e", _timer->getTime(), xs_change);
+  }
 
   /* Check neutron balance if requested */
   if (_check_neutron_balance)
     checkNeutronBalance(false, false);
 
-  /* Copy old flux to new flux to use collapsed flux as a starting guess */
-  _old_flux->copyTo(_new_flux);
+  /* Copy old flux to new flux to use collapsed flux as a starting guess,
+   * unless the previous CMFD eigenvector is used as a warm start */
+  if (!_warm_start || _dominance_ratio <= 0)
+    _old_flux->copyTo(_new_flux);
 
   /* Start recording CMFD solve time */
   _timer->startTimer();
 
   /* Solve the eigenvalue problem */
+  double* dominance_ratio = NULL;
+  if (_warm_start)
+    dominance_ratio = &_dominance_ratio;
   double k_eff = eigenvalueSolve(_A, _M, _new_flux, _k_eff,
                                  _source_convergence_threshold, _SOR_factor,
-                                 _convergence_data, _domain_communicator);
+                                 _convergence_data, _domain_communicator,
+                                 dominance_ratio, _max_power_iterations);
 
   /* Try to use a few-group solver to remedy convergence issues */
   bool reduced_group_solution = false;
-  if (fabs(k_eff + 1) < FLT_EPSILON && _num_cmfd_groups > _num_backup_groups) {
+  if (fabs(k_eff + 1) < FLT_EPSILON && _num_cmfd_groups > _num_backup_groups
+      && !_return_failures) {
 
     log_printf(NORMAL, "Switching to a %d group CMFD solver on this iteration",
                _num_backup_groups);
@@ -1261,9 +1388,15 @@ double Cmfd::computeKeff(int moc_iteration) {
   _timer->stopTimer();
   _timer->recordSplit("Total solver time");
 
+  /* The next solve cannot be warm-started from a failed solve */
+  if (reduced_group_solution || fabs(k_eff + 1) < FLT_EPSILON)
+    _dominance_ratio = -1;
+
   /* Check for a legitimate solve */
   if (fabs(k_eff + 1) > FLT_EPSILON)
     _k_eff = k_eff;
+  else if (_return_failures)
+    return -1.0;
   else
     return _k_eff;
 
@@ -1350,15 +1483,21 @@ void Cmfd::rescaleFlux() {
  * @details This method loops over all mesh cells and energy groups and
  *          accumulates the iteraction and streaming terms into their
  *          appropriate positions in the loss + streaming matrix and
- *          fission gain matrix.
+ *          fission gain matrix. If the cross-sections are not rebuilt, the
+ *          matrices of the previous construction are kept and only the
+ *          streaming terms, which depend on the MOC currents, are replaced.
+ * @param rebuild_xs whether to rebuild the matrices from the collapsed
+ *        cross-sections
  */
-void Cmfd::constructMatrices() {
+void Cmfd::constructMatrices(bool rebuild_xs) {
 
   log_printf(INFO, "Constructing matrices...");
 
   /* Zero _A and _M matrices */
-  _A->clear();
-  _M->clear();
+  if (rebuild_xs) {
+    _A->clear();
+    _M->clear();
+  }
 
   /* Zero the number of connections */
   if (_domain_communicator != NULL) {
@@ -1429,20 +1568,23 @@ void Cmfd::constructMatrices() {
       /* Loop over groups */
       for (int e = 0; e < _num_cmfd_groups; e++) {
 
-        /* Net removal term */
-        value = material->getSigmaTByGroup(e+1) * volume;
-        _A->incrementValue(i, e, i, e, value);
+        if (rebuild_xs) {
 
-        /* Re-compute diagonal if neutron re-balance requested */
-        if (_balance_sigma_t) {
-          enforceBalanceOnDiagonal(i, e);
-        }
+          /* Net removal term */
+          value = material->getSigmaTByGroup(e+1) * volume;
+          _A->incrementValue(i, e, i, e, value);
 
-        /* Scattering gain from all groups */
-        for (int g = 0; g < _num_cmfd_groups; g++) {
-          value = - material->getSigmaSByGroup(g+1, e+1) * volume;
-          if (std::abs(value) > FLT_EPSILON)
-            _A->incrementValue(i, g, i, e, value);
+          /* Re-compute diagonal if neutron re-balance requested */
+          if (_balance_sigma_t) {
+            enforceBalanceOnDiagonal(i, e);
+          }
+
+          /* Scattering gain from all groups */
+          for (int g = 0; g < _num_cmfd_groups; g++) {
+            value = - material->getSigmaSByGroup(g+1, e+1) * volume;
+            if (std::abs(value) > FLT_EPSILON)
+              _A->incrementValue(i, g, i, e, value);
+          }
         }
 
         /* Streaming to neighboring cells */
@@ -1457,14 +1599,32 @@ void Cmfd::constructMatrices() {
           /* Record the corrected diffusion coefficient */
           _old_dif_surf_corr->setValue(i, s*_num_cmfd_groups+e, dif_surf_corr);
 
+          /* Compute the diagonal and off diagonal terms */
+          CMFD_PRECISION diag_value = (dif_surf - sense * dif_surf_corr) *
+                                      delta;
+          CMFD_PRECISION off_diag_value = - (dif_surf + sense * dif_surf_corr)
+                                          * delta;
+
+          /* Replace the terms of the previous construction when updating */
+          CMFD_PRECISION diag_increment = diag_value;
+          CMFD_PRECISION off_diag_increment = off_diag_value;
+          if (_streaming_coeffs != NULL) {
+            int idx = 2 * ((i * NUM_FACES + s) * _num_cmfd_groups + e);
+            if (!rebuild_xs) {
+              diag_increment -= _streaming_coeffs[idx];
+              off_diag_increment -= _streaming_coeffs[idx+1];
+            }
+            _streaming_coeffs[idx] = diag_value;
+            _streaming_coeffs[idx+1] = off_diag_value;
+          }
+
           /* Set the diagonal term */
-          value = (dif_surf - sense * dif_surf_corr) * delta;
-          _A->incrementValue(i, e, i, e, value);
+          _A->incrementValue(i, e, i, e, diag_increment);
 
           /* Set the off diagonal term */
           if (getCellNext(i, s, false, false) != -1) {
-            value = - (dif_surf + sense * dif_surf_corr) * delta;
-            _A->incrementValue(getCellNext(i, s, false, false), e, i, e, value);
+            _A->incrementValue(getCellNext(i, s, false, false), e, i, e,
+                               off_diag_increment);
           }
 
           /* Check for cell in neighboring domain if applicable */
@@ -1476,10 +1636,10 @@ void Cmfd::constructMatrices() {
                 //FIXME Make num_connections, indexes and domains array not
                 // group dependent
                 int idx = _domain_communicator->num_connections[color][row];
-                value = - (dif_surf + sense * dif_surf_corr) * delta;
                 _domain_communicator->indexes[color][row][idx] = neighbor_cell;
                 _domain_communicator->domains[color][row][idx] = s;
-                _domain_communicator->coupling_coeffs[color][row][idx] = value;
+                _domain_communicator->coupling_coeffs[color][row][idx] =
+                    off_diag_value;
                 _domain_communicator->num_connections[color][row]++;
               }
             }
@@ -1487,11 +1647,13 @@ void Cmfd::constructMatrices() {
         }
 
         /* Fission source term */
-        for (int g = 0; g < _num_cmfd_groups; g++) {
-          value = material->getChiByGroup(e+1)
-              * material->getNuSigmaFByGroup(g+1) * volume;
-          if (std::abs(value) > FLT_EPSILON)
-            _M->incrementValue(i, g, i, e, value);
+        if (rebuild_xs) {
+          for (int g = 0; g < _num_cmfd_groups; g++) {
+            value = material->getChiByGroup(e+1)
+                * material->getNuSigmaFByGroup(g+1) * volume;
+            if (std::abs(value) > FLT_EPSILON)
+              _M->incrementValue(i, g, i, e, value);
+          }
         }
       }
     }
@@ -1499,10 +1661,71 @@ void Cmfd::constructMatrices() {
 
   /* Mark correction diffusion coefficient as valid for relaxation purposes */
   _old_dif_surf_valid = true;
+  _matrices_built = true;
   log_printf(INFO, "Done constructing matrices...");
 }
 
 
+/**
+ * @brief Compute the largest change in the collapsed cross-sections since the
+ *        CMFD matrices were last built from them.
+ * @details The changes in the total, nu-fission and scattering cross-sections
+ *          are taken relative to the total cross-section of the group, and the
+ *          changes in chi are absolute.
+ * @param record whether to save the current cross-sections as the ones the
+ *        matrices are built with instead of comparing them
+ * @return the maximum change over all CMFD cells and groups
+ */
+double Cmfd::computeXSChange(bool record) {
+
+  int num_cells = _local_num_x * _local_num_y * _local_num_z;
+  int num_xs = 3 + _num_cmfd_groups;
+  double max_change = 0.0;
+
+#pragma omp parallel for reduction(max:max_change)
+  for (int i = 0; i < num_cells; i++) {
+
+    Material* material = _materials[i];
+
+    for (int e = 0; e < _num_cmfd_groups; e++) {
+
+      /* Gather the cross-sections of this cell and group */
+      CMFD_PRECISION* xs = &_matrix_xs[(i * _num_cmfd_groups + e) * num_xs];
+      CMFD_PRECISION new_xs[num_xs];
+      new_xs[0] = material->getSigmaTByGroup(e+1);
+      new_xs[1] = material->getNuSigmaFByGroup(e+1);
+      new_xs[2] = material->getChiByGroup(e+1);
+      for (int g = 0; g < _num_cmfd_groups; g++)
+        new_xs[3+g] = material->getSigmaSByGroup(g+1, e+1);
+
+      if (record) {
+        for (int k = 0; k < num_xs; k++)
+          xs[k] = new_xs[k];
+      }
+      else {
+        double sigma_t = std::max(std::abs(double(xs[0])), double(FLT_EPSILON));
+        for (int k = 0; k < num_xs; k++) {
+          double change = std::abs(new_xs[k] - xs[k]);
+          if (k != 2)
+            change /= sigma_t;
+          max_change = std::max(max_change, change);
+        }
+      }
+    }
+  }
+
+#ifdef MPIx
+  if (_domain_communicator != NULL && !record) {
+    double temp_change = max_change;
+    MPI_Allreduce(&temp_change, &max_change, 1, MPI_DOUBLE, MPI_MAX,
+                  _domain_communicator->_MPI_cart);
+  }
+#endif
+
+  return max_change;
+}
+
+
 /**
  * @brief Update the MOC flux in each FSR.
  * @details This method uses the condensed flux from the last MOC transport
@@ -1856,6 +2079,7 @@ void Cmfd::initializeCurrents() {
               sizeof(CMFD_PRECISION) / float(1e6);
   log_printf(INFO_ONCE, "CMFD surface current storage per domain = %6.2f MB",
              size);
+  account_memory(this, "surface currents", CMFD_MEMORY, size * 1e6);
 
   /* Allocate memory for the CMFD Mesh surface and corner currents Vectors */
   _surface_currents = new Vector(_cell_locks, _local_num_x, _local_num_y,
@@ -1882,6 +2106,9 @@ void Cmfd::initializeCurrents() {
  */
 void Cmfd::initializeCellMap() {
 
+  /* Clear FSR vectors from a previous FSR numbering */
+  _cell_fsrs.clear();
+
   /* Allocate memory for mesh cell FSR vectors */
   for (int z = 0; z < _local_num_z; z++) {
     for (int y = 0; y < _local_num_y; y++) {
@@ -1913,6 +2140,9 @@ void Cmfd::allocateTallies() {
   int local_num_cells = _local_num_x * _local_num_y * _local_num_z;
   int tally_size = local_num_cells * _num_cmfd_groups;
   _total_tally_size = 3 * tally_size;
+  account_memory(this, "tallies", CMFD_MEMORY, _total_tally_size *
+                 sizeof(CMFD_PRECISION) + 3 * local_num_cells *
+                 sizeof(CMFD_PRECISION*));
   _tally_memory = new CMFD_PRECISION[_total_tally_size];
   CMFD_PRECISION** all_tallies[3];
   for (int t=0; t < 3; t++) {
@@ -2090,6 +2320,26 @@ void Cmfd::setNumFSRs(long num_fsrs) {
 }
 
 
+/**
+ * @brief Splits the vertex and edge currents to the side surfaces.
+ * @details The splits add the corner and edge currents onto the face currents
+ *          so they must be performed exactly once per MOC iteration.
+ */
+void Cmfd::splitCurrents() {
+
+  splitVertexCurrents();
+#ifdef MPIx
+  if (_geometry->isDomainDecomposed())
+    communicateSplits(false);
+#endif
+  splitEdgeCurrents();
+#ifdef MPIx
+  if (_geometry->isDomainDecomposed())
+    communicateSplits(true);
+#endif
+}
+
+
 /**
  * @brief Split the currents of the Mesh cell vertices to the adjacent faces and
  *        edges.
@@ -2402,6 +2652,10 @@ void Cmfd::getVertexSplitSurfaces(int cell, int vertex,
       else if (_boundaries[partial_surface] == PERIODIC)
         surfaces->push_back(cell_next * ns + remainder_surface);
 
+      else if (_boundaries[partial_surface] == ROTATIONAL)
+        surfaces->push_back(cell_next * ns +
+                            rotateSurface(remainder_surface, partial_surface));
+
     }
     else
       surfaces->push_back(cell_next * ns + remainder_surface);
@@ -2473,6 +2727,10 @@ void Cmfd::getEdgeSplitSurfaces(int cell, int edge,
 
         else if (_boundaries[partial_surface] == PERIODIC)
           surfaces->push_back(cell_next * ns + other_surface);
+
+        else if (_boundaries[partial_surface] == ROTATIONAL)
+          surfaces->push_back(cell_next * ns +
+                              rotateSurface(other_surface, partial_surface));
       }
       else
         surfaces->push_back(cell_next * ns + other_surface);
@@ -2529,6 +2787,8 @@ int Cmfd::getCellNext(int cell, int surface_id, bool global, bool neighbor) {
       cell_next = z * _local_num_y + y;
     else if (_boundaries[SURFACE_X_MIN] == PERIODIC)
       cell_next = cell + (_num_x-1);
+    else if (_boundaries[SURFACE_X_MIN] == ROTATIONAL)
+      cell_next = z * _num_x * _num_y + y;
   }
 
   else if (surface_id == SURFACE_Y_MIN) {
@@ -2538,6 +2798,8 @@ int Cmfd::getCellNext(int cell, int surface_id, bool global, bool neighbor) {
       cell_next = z * _local_num_x + x;
     else if (_boundaries[SURFACE_Y_MIN] == PERIODIC)
       cell_next = cell + _num_x*(_num_y-1);
+    else if (_boundaries[SURFACE_Y_MIN] == ROTATIONAL)
+      cell_next = z * _num_x * _num_y + x * _num_x;
   }
 
   else if (surface_id == SURFACE_Z_MIN) {
@@ -2580,6 +2842,58 @@ int Cmfd::getCellNext(int cell, int surface_id, bool global, bool neighbor) {
 }
 
 
+/**
+ * @brief Get the ID of the surface of the next Mesh cell that is shared with
+ *        a surface of the given Mesh cell.
+ * @details This is the opposite surface, except on the ROTATIONAL boundaries
+ *          where the x-min surfaces face the y-min surfaces.
+ * @param cell index of the current CMFD cell
+ * @param surface_id id of the surface between the current cell and the next
+ * @return the surface ID in the neighboring CMFD cell
+ */
+int Cmfd::getSurfaceNext(int cell, int surface_id) {
+
+  int surface_next = (surface_id + NUM_FACES / 2) % NUM_FACES;
+
+  if ((surface_id == SURFACE_X_MIN || surface_id == SURFACE_Y_MIN) &&
+      _boundaries[surface_id] == ROTATIONAL) {
+    int x = (cell % (_num_x * _num_y)) % _num_x;
+    int y = (cell % (_num_x * _num_y)) / _num_x;
+    if (surface_id == SURFACE_X_MIN && x == 0)
+      surface_next = SURFACE_Y_MIN;
+    else if (surface_id == SURFACE_Y_MIN && y == 0)
+      surface_next = SURFACE_X_MIN;
+  }
+
+  return surface_next;
+}
+
+
+/**
+ * @brief Rotates a Mesh cell surface or edge into the frame of the Mesh cell
+ *        across a ROTATIONAL boundary.
+ * @details Crossing the y-min boundary rotates directions by +90 degrees about
+ *          the z-axis and crossing the x-min boundary by -90 degrees.
+ * @param surface the surface, edge or vertex to rotate
+ * @param boundary the ROTATIONAL boundary crossed (SURFACE_X_MIN or
+ *        SURFACE_Y_MIN)
+ * @return the rotated surface, edge or vertex
+ */
+int Cmfd::rotateSurface(int surface, int boundary) {
+
+  int direction[3];
+  convertSurfaceToDirection(surface, direction);
+
+  int rotated[3] = {direction[1], -direction[0], direction[2]};
+  if (boundary == SURFACE_Y_MIN) {
+    rotated[0] = -direction[1];
+    rotated[1] = direction[0];
+  }
+
+  return convertDirectionToSurface(rotated);
+}
+
+
 /**
  * @brief Set the CMFD boundary type for a given surface.
  * @details The CMFD boundary is assumed to be rectangular with the
@@ -2749,6 +3063,57 @@ void Cmfd::useFluxLimiting(bool flux_limiting) {
 }
 
 
+/**
+ * @brief Sets whether the CMFD linear solver uses the structured stencil SOR
+ *        kernel instead of the CSR kernel.
+ * @details The structured stencil stores the neighbor couplings and the
+ *          group-to-group blocks of each CMFD cell contiguously, so that the
+ *          red-black SOR sweep vectorizes over the groups of a cell.
+ * @param structured_stencil whether to use the structured stencil kernel
+ */
+void Cmfd::useStructuredStencil(bool structured_stencil) {
+  _structured_stencil = structured_stencil;
+  if (_A != NULL)
+    _A->useStructuredStencil(structured_stencil);
+}
+
+
+/**
+ * @brief Sets whether the CMFD eigenvalue solve is warm-started from the
+ *        eigenvector of the previous CMFD solve.
+ * @details The dominance ratio estimated during the previous solve is used to
+ *          bound the distance to the converged source, which allows the power
+ *          method to stop after fewer iterations once the MOC iterations have
+ *          settled.
+ * @param warm_start whether to warm-start the CMFD eigenvalue solve
+ */
+void Cmfd::useWarmStart(bool warm_start) {
+  _warm_start = warm_start;
+  _dominance_ratio = -1;
+}
+
+
+/**
+ * @brief Sets the largest change in the collapsed cross-sections for which the
+ *        CMFD matrices are not rebuilt.
+ * @details Below this relative change, the removal, scattering and fission
+ *          terms of the previous matrix construction are kept and only the
+ *          streaming terms computed from the MOC currents are updated. A value
+ *          of 0 rebuilds the matrices on every CMFD solve. The matrices are
+ *          also rebuilt when the change exceeds the MOC source residual, so
+ *          that the converged eigenvalue is not affected.
+ * @param threshold the maximum relative change in collapsed cross-sections
+ */
+void Cmfd::setMatrixRebuildThreshold(double threshold) {
+
+  if (threshold < 0.0)
+    log_printf(ERROR, "Unable to set the CMFD matrix rebuild threshold to %f "
+               "since the threshold must be positive.", threshold);
+
+  _matrix_rebuild_threshold = threshold;
+}
+
+
 /**
  * @brief Modifies the diagonal element to be consistent with the MOC solve
  * @details This function re-computes a new total cross-section x volume that
@@ -2874,94 +3239,65 @@ void Cmfd::setQuadrature(Quadrature* quadrature) {
 /**
  * @brief Generate the k-nearest neighbor CMFD cell stencil for each FSR.
  * @details This method finds the k-nearest CMFD cell stencil for each FSR
- *          and saves the stencil, ordered from the closest-to-furthest
- *          CMFD cell, in the _k_nearest_stencils map. The stencil of cells
- *          surrounding the current cell is defined as:
- *
- *                             6 7 8
- *                             3 4 5
- *                             0 1 2
- *
- *          where 4 is the given CMFD cell. If the cell is on the edge or corner
- *          of the geometry and there are less than k nearest neighbor cells,
- *          k is reduced to the number of neighbor cells for that instance.
+ *          and saves the stencil in a compressed row layout: the stencil of
+ *          FSR r is stored between _k_nearest_offsets[r] and
+ *          _k_nearest_offsets[r+1] in the _k_nearest_cells and
+ *          _k_nearest_weights arrays. The stencils are generated in parallel,
+ *          a first pass counts the stencil sizes and a second pass fills them.
  */
 void Cmfd::generateKNearestStencils() {
-  std::vector< std::pair<int, double> >::iterator stencil_iter;
   std::vector<long>::iterator fsr_iter;
-  Point* centroid;
   long fsr_id;
 
   if (_centroid_update_on){
-    /* Number of cells in stencil */
-    int num_cells_in_stencil = 9;
-
-    /* Loop over mesh cells */
-    for (int i = 0; i < _local_num_x*_local_num_y*_local_num_z; i++) {
-
-      int global_ind = getGlobalCMFDCell(i);
 
-      /* Loop over FRSs in mesh cell */
+    int num_cells = _local_num_x * _local_num_y * _local_num_z;
+
+    /* Delete stencils from a previous initialization */
+    if (_k_nearest_offsets != NULL)
+      delete [] _k_nearest_offsets;
+    if (_k_nearest_cells != NULL)
+      delete [] _k_nearest_cells;
+    if (_k_nearest_weights != NULL)
+      delete [] _k_nearest_weights;
+
+    /* Count the number of cells in each FSR stencil */
+    _k_nearest_offsets = new long[_num_FSRs + 1]();
+#pragma omp parallel for private(fsr_iter) schedule(dynamic)
+    for (int i = 0; i < num_cells; i++) {
+      int cells[9];
+      float weights[9];
       for (fsr_iter = _cell_fsrs.at(i).begin();
-          fsr_iter != _cell_fsrs.at(i).end(); ++fsr_iter) {
-
-        fsr_id = *fsr_iter;
-
-        /* Get centroid */
-        centroid = _geometry->getFSRCentroid(fsr_id);
-
-        /* Create new stencil */
-        _k_nearest_stencils[fsr_id] =
-          std::vector< std::pair<int, double> >();
-
-        /* Get distance to all cells that touch current cell */
-        for (int j=0; j < num_cells_in_stencil; j++)
-          _k_nearest_stencils[fsr_id]
-            .push_back(std::make_pair<int, double>
-                      (int(j), getDistanceToCentroid(centroid, global_ind, i,
-                                                     j)));
-
-        /* Sort the distances */
-        std::sort(_k_nearest_stencils[fsr_id].begin(),
-                  _k_nearest_stencils[fsr_id].end(), stencilCompare);
-
-        /* Remove ghost cells that are outside the geometry boundaries */
-        stencil_iter = _k_nearest_stencils[fsr_id].begin();
-        while (stencil_iter != _k_nearest_stencils[fsr_id].end()) {
-          if (stencil_iter->second > FLT_INFINITY)
-            stencil_iter = _k_nearest_stencils[fsr_id].erase(stencil_iter);
-          else
-            ++stencil_iter;
-        }
+           fsr_iter != _cell_fsrs.at(i).end(); ++fsr_iter)
+        _k_nearest_offsets[*fsr_iter + 1] =
+             computeKNearestStencil(*fsr_iter, i, cells, weights);
+    }
 
-        /* Resize stencil to be of size <= _k_nearest */
-        _k_nearest_stencils[fsr_id].resize
-          (std::min(_k_nearest, int(_k_nearest_stencils[fsr_id].size())));
+    /* Convert the stencil sizes to offsets */
+    for (long r=0; r < _num_FSRs; r++)
+      _k_nearest_offsets[r+1] += _k_nearest_offsets[r];
+
+    /* Fill the stencil cells and weights */
+    long num_entries = _k_nearest_offsets[_num_FSRs];
+    account_memory(this, "k-nearest stencils", CMFD_MEMORY, (_num_FSRs + 1) *
+                   sizeof(long) + num_entries * (sizeof(int) + sizeof(float)));
+    _k_nearest_cells = new int[num_entries];
+    _k_nearest_weights = new float[num_entries];
+#pragma omp parallel for private(fsr_iter) schedule(dynamic)
+    for (int i = 0; i < num_cells; i++) {
+      for (fsr_iter = _cell_fsrs.at(i).begin();
+           fsr_iter != _cell_fsrs.at(i).end(); ++fsr_iter) {
+        long offset = _k_nearest_offsets[*fsr_iter];
+        computeKNearestStencil(*fsr_iter, i, &_k_nearest_cells[offset],
+                               &_k_nearest_weights[offset]);
       }
     }
 
-    /* Precompute (1.0 - cell distance / total distance) of each FSR centroid to
-    * its k-nearest CMFD cells */
-    double total_distance;
-    for (long i=0; i < _num_FSRs; i++) {
-      total_distance = 1.e-10;
-
-      /* Compute the total distance of each FSR centroid to its k-nearest CMFD
-      * cells */
-      for (stencil_iter = _k_nearest_stencils[i].begin();
-          stencil_iter < _k_nearest_stencils[i].end(); ++stencil_iter)
-        total_distance += stencil_iter->second;
-
-      /* Reset the second stencil value to
-      * (1.0 - cell_distance / total_distance) */
-      for (stencil_iter = _k_nearest_stencils[i].begin();
-          stencil_iter < _k_nearest_stencils[i].end(); ++stencil_iter)
-        stencil_iter->second = 1.0 - stencil_iter->second / total_distance;
-    }
+    log_printf(NORMAL, "CMFD k-nearest stencil storage per domain = %6.2f MB",
+               ((_num_FSRs + 1) * sizeof(long) + num_entries *
+               (sizeof(int) + sizeof(float))) / float(1e6));
   }
 
-
-
   /* Compute axial quadratic interpolation values if requested */
   if (_use_axial_interpolation && _local_num_z >= 3) {
 
@@ -3089,6 +3425,92 @@ void Cmfd::generateKNearestStencils() {
 }
 
 
+/**
+ * @brief Compute the k-nearest neighbor CMFD cell stencil of an FSR.
+ * @details The distances from the FSR centroid to the centers of its CMFD
+ *          cell and of the 8 neighboring CMFD cells are sorted, and the k
+ *          closest cells are kept. The stencil of cells surrounding the
+ *          current cell is defined as:
+ *
+ *                             6 7 8
+ *                             3 4 5
+ *                             0 1 2
+ *
+ *          where 4 is the given CMFD cell. If the cell is on the edge or corner
+ *          of the geometry and there are less than k nearest neighbor cells,
+ *          k is reduced to the number of neighbor cells for that instance.
+ *          Each cell is weighted by (1.0 - cell distance / total distance),
+ *          the weights are then normalized at build time so that the update
+ *          ratio of the FSR is the weighted sum of the cell flux ratios. The
+ *          containing cell is always stored first.
+ * @param fsr_id the FSR ID
+ * @param cell_id the local CMFD cell containing the FSR
+ * @param cells the local CMFD cells of the stencil (output)
+ * @param weights the prolongation weights of the stencil cells (output)
+ * @return the number of cells in the stencil
+ */
+int Cmfd::computeKNearestStencil(long fsr_id, int cell_id, int* cells,
+                                 float* weights) {
+
+  int num_cells_in_stencil = 9;
+  int global_ind = getGlobalCMFDCell(cell_id);
+  Point* centroid = _geometry->getFSRCentroid(fsr_id);
+
+  /* Sort the stencil cells inside the geometry by distance to the centroid */
+  int stencil_ids[num_cells_in_stencil];
+  double distances[num_cells_in_stencil];
+  int num_valid = 0;
+  for (int j=0; j < num_cells_in_stencil; j++) {
+
+    double distance = getDistanceToCentroid(centroid, global_ind, cell_id, j);
+
+    /* Remove ghost cells that are outside the geometry boundaries */
+    if (distance > FLT_INFINITY)
+      continue;
+
+    int k = num_valid;
+    while (k > 0 && distances[k-1] > distance) {
+      stencil_ids[k] = stencil_ids[k-1];
+      distances[k] = distances[k-1];
+      k--;
+    }
+    stencil_ids[k] = j;
+    distances[k] = distance;
+    num_valid++;
+  }
+
+  /* Reduce the stencil to be of size <= _k_nearest */
+  int size = std::min(_k_nearest, num_valid);
+
+  /* Compute the total distance of the centroid to its k-nearest cells */
+  double total_distance = 1.e-10;
+  for (int j=0; j < size; j++)
+    total_distance += distances[j];
+
+  /* The containing cell is weighted by the weight of the closest cell, all
+     the weights are averaged over the neighbor cells */
+  double norm = 1.0;
+  double cell_weight = 1.0;
+  if (size > 1) {
+    norm = 1.0 / (size - 1);
+    cell_weight = (1.0 - distances[0] / total_distance) * norm;
+  }
+
+  cells[0] = cell_id;
+  weights[0] = cell_weight;
+  int num_cells = 1;
+  for (int j=0; j < size; j++) {
+    if (stencil_ids[j] != 4) {
+      cells[num_cells] = getCellByStencil(cell_id, stencil_ids[j]);
+      weights[num_cells] = (1.0 - distances[j] / total_distance) * norm;
+      num_cells++;
+    }
+  }
+
+  return num_cells;
+}
+
+
 /**
  * @brief Get the ID of the Mesh cell given a stencil ID and Mesh cell ID.
  * @details The stencil of cells surrounding the current cell is defined as:
@@ -3097,6 +3519,8 @@ void Cmfd::generateKNearestStencils() {
  *                             3 4 5
  *                             0 1 2
  *
+ *          Across ROTATIONAL boundaries, the neighbors are found in the
+ *          rotated frame of the Mesh cell on the other side.
  * @param cell_id Current Mesh cell ID
  * @param stencil_id CMFD cell stencil ID
  * @return Neighboring CMFD cell ID
@@ -3110,22 +3534,36 @@ int Cmfd::getCellByStencil(int cell_id, int stencil_id) {
   if (stencil_id == 0) {
     if (x != 0 && y != 0)
       cell_next_id = cell_id - _local_num_x - 1;
+    else if (x != 0 && _boundaries[SURFACE_Y_MIN] == ROTATIONAL)
+      cell_next_id = getCellNext(getCellNext(cell_id, SURFACE_Y_MIN),
+                                 rotateSurface(SURFACE_X_MIN, SURFACE_Y_MIN));
+    else if (y != 0 && _boundaries[SURFACE_X_MIN] == ROTATIONAL)
+      cell_next_id = getCellNext(getCellNext(cell_id, SURFACE_X_MIN),
+                                 rotateSurface(SURFACE_Y_MIN, SURFACE_X_MIN));
   }
   else if (stencil_id == 1) {
     if (y != 0)
       cell_next_id = cell_id - _local_num_x;
     else if (_boundaries[SURFACE_Y_MIN] == PERIODIC)
       cell_next_id = cell_id + _local_num_x * (_local_num_y - 1);
+    else if (_boundaries[SURFACE_Y_MIN] == ROTATIONAL)
+      cell_next_id = getCellNext(cell_id, SURFACE_Y_MIN);
   }
   else if (stencil_id == 2) {
     if (x != _local_num_x - 1 && y != 0)
       cell_next_id = cell_id - _local_num_x + 1;
+    else if (x != _local_num_x - 1 &&
+             _boundaries[SURFACE_Y_MIN] == ROTATIONAL)
+      cell_next_id = getCellNext(getCellNext(cell_id, SURFACE_Y_MIN),
+                                 rotateSurface(SURFACE_X_MAX, SURFACE_Y_MIN));
   }
   else if (stencil_id == 3) {
     if (x != 0)
       cell_next_id = cell_id - 1;
     else if (_boundaries[SURFACE_X_MIN] == PERIODIC)
       cell_next_id = cell_id + (_local_num_x - 1);
+    else if (_boundaries[SURFACE_X_MIN] == ROTATIONAL)
+      cell_next_id = getCellNext(cell_id, SURFACE_X_MIN);
   }
   else if (stencil_id == 4) {
     cell_next_id = cell_id;
@@ -3139,6 +3577,10 @@ int Cmfd::getCellByStencil(int cell_id, int stencil_id) {
   else if (stencil_id == 6) {
     if (x != 0 && y != _local_num_y - 1)
       cell_next_id = cell_id + _local_num_x - 1;
+    else if (y != _local_num_y - 1 &&
+             _boundaries[SURFACE_X_MIN] == ROTATIONAL)
+      cell_next_id = getCellNext(getCellNext(cell_id, SURFACE_X_MIN),
+                                 rotateSurface(SURFACE_Y_MAX, SURFACE_X_MIN));
   }
   else if (stencil_id == 7) {
     if (y != _local_num_y - 1)
@@ -3172,6 +3614,8 @@ int Cmfd::getCellByStencil(int cell_id, int stencil_id) {
  *          where 4 is the given CMFD cell. If the cell is on the edge or corner
  *          of the geometry and there are less than k nearest neighbor cells,
  *          k is reduced to the number of neighbor cells for that instance.
+ *          The stencil cells and their normalized weights are precomputed by
+ *          generateKNearestStencils().
  * @param cell_id The CMFD cell ID containing the FSR.
  * @param group The CMFD energy group being updated.
  * @param fsr The fsr being updated.
@@ -3180,30 +3624,13 @@ int Cmfd::getCellByStencil(int cell_id, int stencil_id) {
 CMFD_PRECISION Cmfd::getUpdateRatio(int cell_id, int group, long fsr) {
 
   CMFD_PRECISION ratio = 0.0;
-  std::vector< std::pair<int, double> >::iterator iter;
-  int cell_next_id;
 
   if (_centroid_update_on) {
 
-    /* Compute the ratio for all the surrounding cells */
-    for (iter = _k_nearest_stencils[fsr].begin();
-         iter != _k_nearest_stencils[fsr].end(); ++iter) {
-
-      if (iter->first != 4) {
-        cell_next_id = getCellByStencil(cell_id, iter->first);//cell_id is Local itself here.
-
-        ratio += iter->second * getFluxRatio(cell_next_id, group, fsr);
-      }
-    }
-
-    /* INTERNAL */
-    if (_k_nearest_stencils[fsr].size() == 1)
-      ratio += getFluxRatio(cell_id, group, fsr);
-    else {
-      ratio += _k_nearest_stencils[fsr][0].second *
-            getFluxRatio(cell_id, group, fsr);
-      ratio /= (_k_nearest_stencils[fsr].size() - 1);
-    }
+    /* Weighted sum of the ratios of the stencil cells */
+    for (long j = _k_nearest_offsets[fsr]; j < _k_nearest_offsets[fsr+1]; j++)
+      ratio += _k_nearest_weights[j] *
+               getFluxRatio(_k_nearest_cells[j], group, fsr);
   }
   else
     ratio = getFluxRatio(cell_id, group, fsr);
@@ -3495,11 +3922,29 @@ void Cmfd::initialize() {
     delete _new_flux;
   if (_old_dif_surf_corr != NULL)
     delete _old_dif_surf_corr;
+  if (_matrix_xs != NULL)
+    delete [] _matrix_xs;
+  if (_streaming_coeffs != NULL)
+    delete [] _streaming_coeffs;
   if (_volumes != NULL)
     delete _volumes;
   if (_cell_locks != NULL)
     delete [] _cell_locks;
 
+  if (_condensed_cmfd != NULL)
+    delete _condensed_cmfd;
+
+  /* Reset the state kept between CMFD solves */
+  _condensed_cmfd = NULL;
+  _num_condensed_groups = _initial_condensed_groups;
+  _previous_source_threshold = -1;
+  _matrix_xs = NULL;
+  _streaming_coeffs = NULL;
+  _matrices_built = false;
+  _dominance_ratio = -1;
+  _num_matrix_builds = 0;
+  _num_matrix_updates = 0;
+
   /* Calculate the number of elements */
   int num_cells = _local_num_x * _local_num_y * _local_num_z;
   int ncg = _num_cmfd_groups;
@@ -3527,12 +3972,17 @@ void Cmfd::initialize() {
                   sizeof(CMFD_PRECISION) / (double) 1e6;
     log_printf(NORMAL, "CMFD A matrix est. storage per domain = %6.2f MB",
                size);
+    account_memory(this, "matrices", CMFD_MEMORY, 2 * size * 1e6);
+    account_memory(this, "fluxes and sources", CMFD_MEMORY, num_cells *
+                   ((4 + NUM_FACES) * ncg * sizeof(CMFD_PRECISION) +
+                   sizeof(CMFD_PRECISION) + sizeof(omp_lock_t)));
 
     /* Allocate memory for matrix and vector objects */
     _M = new Matrix(_cell_locks, _local_num_x, _local_num_y, _local_num_z,
                     ncg);
     _A = new Matrix(_cell_locks, _local_num_x, _local_num_y, _local_num_z,
                     ncg);
+    _A->useStructuredStencil(_structured_stencil);
     _old_source = new Vector(_cell_locks, _local_num_x, _local_num_y,
                              _local_num_z, ncg);
     _new_source = new Vector(_cell_locks, _local_num_x, _local_num_y,
@@ -3673,6 +4123,8 @@ void Cmfd::initialize() {
       log_printf(INFO_ONCE, "CMFD communication buffers size per domain = "
                  "%6.2f MB", (4 * comm_data_size + internal) *
                  sizeof(CMFD_PRECISION) / float(1e6));
+      account_memory(this, "communication buffers", MPI_BUFFER_MEMORY,
+                     (4 * comm_data_size + internal) * sizeof(CMFD_PRECISION));
 
       _inter_domain_data = new CMFD_PRECISION[comm_data_size + internal];
       _send_domain_data = new CMFD_PRECISION[comm_data_size];
@@ -3964,6 +4416,17 @@ void Cmfd::initializeLattice(Point* offset, bool is_2D) {
                fabs(_width_y - _accumulate_y[_num_y]),
                fabs(_width_z - _accumulate_z[_num_z]), FLT_EPSILON);
 
+  /* Rotational boundaries map the x-min cells onto the y-min cells */
+  if (_boundaries[SURFACE_X_MIN] == ROTATIONAL ||
+      _boundaries[SURFACE_Y_MIN] == ROTATIONAL) {
+    bool symmetric = (_num_x == _num_y);
+    for (int i=0; i < _num_x && symmetric; i++)
+      symmetric = fabs(_cell_widths_x[i] - _cell_widths_y[i]) < FLT_EPSILON;
+    if (!symmetric)
+      log_printf(ERROR, "Rotational boundaries require identical CMFD mesh "
+                 "widths in x and y");
+  }
+
   /* Delete old lattice if it exists */
   if (_lattice != NULL)
     delete _lattice;
@@ -3991,15 +4454,6 @@ void Cmfd::initializeLattice(Point* offset, bool is_2D) {
  */
 void Cmfd::initializeBackupCmfdSolver() {
 
-  /* Initialize new CMFD object */
-  _backup_cmfd = new Cmfd();
-  _backup_cmfd->useAxialInterpolation(_use_axial_interpolation);
-  _backup_cmfd->setLatticeStructure(_num_x, _num_y, _num_z);
-  _backup_cmfd->setKNearest(_k_nearest);
-  _backup_cmfd->setSORRelaxationFactor(_SOR_factor);
-  _backup_cmfd->setCMFDRelaxationFactor(_relaxation_factor);
-  _backup_cmfd->useFluxLimiting(_flux_limiting);
-
   /* Set one-group group structure */
   if (_backup_group_structure.size() == 0) {
 
@@ -4012,61 +4466,90 @@ void Cmfd::initializeBackupCmfdSolver() {
     for (int e=0; e < _num_cmfd_groups; e++)
       _cmfd_group_to_backup_group[e] = 0;
   }
-  _backup_cmfd->setGroupStructure(_backup_group_structure);
+
+  _backup_cmfd = createCondensedCmfdSolver(_backup_group_structure);
+}
+
+
+/**
+ * @brief Creates a CMFD solver on the same mesh as this solver with a coarser
+ *        group structure.
+ * @details The condensed solver shares the FSR data of this solver and is fed
+ *          with its currents condensed by copyCurrentsToCondensed().
+ * @param group_structure the indices of the condensed groups in the MOC groups
+ * @return the condensed CMFD solver
+ */
+Cmfd* Cmfd::createCondensedCmfdSolver(std::vector< std::vector<int> >
+                                      group_structure) {
+
+  /* Initialize new CMFD object */
+  Cmfd* condensed_cmfd = new Cmfd();
+  condensed_cmfd->useAxialInterpolation(_use_axial_interpolation);
+  condensed_cmfd->setLatticeStructure(_num_x, _num_y, _num_z);
+  condensed_cmfd->setKNearest(_k_nearest);
+  condensed_cmfd->setSORRelaxationFactor(_SOR_factor);
+  condensed_cmfd->setCMFDRelaxationFactor(_relaxation_factor);
+  condensed_cmfd->useFluxLimiting(_flux_limiting);
+  condensed_cmfd->useStructuredStencil(_structured_stencil);
+  condensed_cmfd->useWarmStart(_warm_start);
+  condensed_cmfd->setMatrixRebuildThreshold(_matrix_rebuild_threshold);
+  condensed_cmfd->setGroupStructure(group_structure);
 
   /* Set CMFD mesh boundary conditions */
   for (int i=0; i < 6; i++)
-    _backup_cmfd->setBoundary(i, _boundaries[i]);
+    condensed_cmfd->setBoundary(i, _boundaries[i]);
 
   /* Set CMFD mesh dimensions */
-  _backup_cmfd->setWidthX(_width_x);
-  _backup_cmfd->setWidthY(_width_y);
-  _backup_cmfd->setWidthZ(_width_z);
+  condensed_cmfd->setWidthX(_width_x);
+  condensed_cmfd->setWidthY(_width_y);
+  condensed_cmfd->setWidthZ(_width_z);
 
   /* Initialize CMFD Maps */
-  _backup_cmfd->initializeCellMap();
+  condensed_cmfd->initializeCellMap();
 
-  /* Initialize the CMFD lattice */
-  _backup_cmfd->initializeLattice(_lattice->getOffset());
-  _backup_cmfd->setGeometry(_geometry);
+  /* Initialize the CMFD lattice, which needs the geometry symmetries */
+  condensed_cmfd->setGeometry(_geometry);
+  condensed_cmfd->initializeLattice(_lattice->getOffset());
 
 #ifdef MPIx
   if (_domain_communicator != NULL) {
 
-    _backup_cmfd->setNumDomains(_domain_communicator->_num_domains_x,
-                                _domain_communicator->_num_domains_y,
-                                _domain_communicator->_num_domains_z);
-    _backup_cmfd->setDomainIndexes(_domain_communicator->_domain_idx_x,
-                                   _domain_communicator->_domain_idx_y,
-                                   _domain_communicator->_domain_idx_z);
+    condensed_cmfd->setNumDomains(_domain_communicator->_num_domains_x,
+                                  _domain_communicator->_num_domains_y,
+                                  _domain_communicator->_num_domains_z);
+    condensed_cmfd->setDomainIndexes(_domain_communicator->_domain_idx_x,
+                                     _domain_communicator->_domain_idx_y,
+                                     _domain_communicator->_domain_idx_z);
   }
 #endif
 
-  /* Initialize the backup CMFD solver */
-  _backup_cmfd->initialize();
+  /* Initialize the condensed CMFD solver */
+  condensed_cmfd->initialize();
 
   /* Initialize the CMFD energy group structure */
-  _backup_cmfd->setSourceConvergenceThreshold(_source_convergence_threshold);
-  _backup_cmfd->setNumMOCGroups(_num_moc_groups);
-  _backup_cmfd->initializeGroupMap();
+  condensed_cmfd->setSourceConvergenceThreshold(_source_convergence_threshold);
+  condensed_cmfd->setNumMOCGroups(_num_moc_groups);
+  condensed_cmfd->initializeGroupMap();
 
   /* Give CMFD number of FSRs and FSR property arrays */
-  _backup_cmfd->setSolve3D(_SOLVE_3D);
-  _backup_cmfd->setNumFSRs(_num_FSRs);
-  _backup_cmfd->setFSRVolumes(_FSR_volumes);
-  _backup_cmfd->setFSRMaterials(_FSR_materials);
-  _backup_cmfd->setFSRFluxes(_FSR_fluxes);
-  _backup_cmfd->setFSRSources(_FSR_sources);
-  _backup_cmfd->setQuadrature(_quadrature);
+  condensed_cmfd->setSolve3D(_SOLVE_3D);
+  condensed_cmfd->setNumFSRs(_num_FSRs);
+  condensed_cmfd->setFSRVolumes(_FSR_volumes);
+  condensed_cmfd->setFSRMaterials(_FSR_materials);
+  condensed_cmfd->setFSRFluxes(_FSR_fluxes);
+  condensed_cmfd->setFSRSources(_FSR_sources);
+  condensed_cmfd->setQuadrature(_quadrature);
   if (_flux_moments != NULL)
-    _backup_cmfd->setFluxMoments(_flux_moments);
+    condensed_cmfd->setFluxMoments(_flux_moments);
 
   /* Add FSRs to cells */
-  _backup_cmfd->setCellFSRs(&_cell_fsrs);
+  condensed_cmfd->setCellFSRs(&_cell_fsrs);
+
+  /* Initialize the condensed CMFD solver */
+  condensed_cmfd->initialize();
+  condensed_cmfd->setConvergenceData(_convergence_data);
 
-  /* Initialize the backup CMFD solver */
-  _backup_cmfd->initialize();
-  _backup_cmfd->setConvergenceData(_convergence_data);
+  return condensed_cmfd;
 }
 
 
@@ -4076,15 +4559,30 @@ void Cmfd::initializeBackupCmfdSolver() {
  *          when transfered as well.
  */
 void Cmfd::copyCurrentsToBackup() {
+  copyCurrentsToCondensed(_backup_cmfd, _cmfd_group_to_backup_group,
+                          _backup_group_structure.size());
+}
+
+
+/**
+ * @brief Copies the current from the regular to a condensed CMFD solver.
+ * @details The currents are summed over the CMFD groups of each condensed
+ *          group.
+ * @param condensed_cmfd the condensed CMFD solver
+ * @param group_map the condensed group of each CMFD group
+ * @param num_condensed_groups the number of groups of the condensed solver
+ */
+void Cmfd::copyCurrentsToCondensed(Cmfd* condensed_cmfd, int* group_map,
+                                   int num_condensed_groups) {
 
   /* Clear currents */
-  _backup_cmfd->zeroCurrents();
+  condensed_cmfd->zeroCurrents();
 
-  /* Get the number of backup groups */
-  int nbg = _backup_group_structure.size();
+  /* Get the number of condensed groups */
+  int nbg = num_condensed_groups;
 
   /* Get the local current array */
-  Vector* backup_currents = _backup_cmfd->getLocalCurrents();
+  Vector* backup_currents = condensed_cmfd->getLocalCurrents();
 
   /* Copy on-node surface currents */
 #pragma omp parallel for
@@ -4095,7 +4593,7 @@ void Cmfd::copyCurrentsToBackup() {
       for (int e=0; e < _num_cmfd_groups; e++) {
 
         /* Sum group contributions and add to currents */
-        int bg =  _cmfd_group_to_backup_group[e];
+        int bg =  group_map[e];
         CMFD_PRECISION val =
           _surface_currents->getValue(i, f * _num_cmfd_groups + e);
         backup_currents->incrementValue(i, f * nbg + bg, val);
@@ -4108,7 +4606,7 @@ void Cmfd::copyCurrentsToBackup() {
   if (_domain_communicator != NULL) {
 
     CMFD_PRECISION*** off_node_currents =
-      _backup_cmfd->getBoundarySurfaceCurrents();
+      condensed_cmfd->getBoundarySurfaceCurrents();
 
     for (int surface=0; surface < NUM_FACES; surface++) {
 
@@ -4128,7 +4626,7 @@ void Cmfd::copyCurrentsToBackup() {
 
           /* Loop over CMFD coarse energy groups */
           for (int e = 0; e < _num_cmfd_groups; e++) {
-            int bg =  _cmfd_group_to_backup_group[e];
+            int bg =  group_map[e];
             backup_currents[idx][f*nbg + bg] +=
               boundary_currents[idx][f*_num_cmfd_groups+e];
           }
@@ -4140,6 +4638,211 @@ void Cmfd::copyCurrentsToBackup() {
 }
 
 
+/**
+ * @brief Selects a condensed group structure from the collision rate spectrum
+ *        and creates the corresponding condensed CMFD solver.
+ * @details The CMFD groups are gathered into contiguous condensed groups that
+ *          each hold a similar share of the collision rate tallied from the
+ *          current MOC scalar fluxes, so that the spectrum from
+ *          Solver::calculateInitialSpectrum() or from the first transport
+ *          sweep decides where the condensed group boundaries fall.
+ * @param num_groups the number of condensed groups
+ */
+void Cmfd::condenseGroupStructure(int num_groups) {
+
+  num_groups = std::min(num_groups, _num_cmfd_groups);
+
+  /* Tally the collision rate in each CMFD group */
+  double spectrum[_num_cmfd_groups];
+  for (int e=0; e < _num_cmfd_groups; e++)
+    spectrum[e] = 0.0;
+
+#pragma omp parallel
+  {
+    double thread_spectrum[_num_cmfd_groups];
+    for (int e=0; e < _num_cmfd_groups; e++)
+      thread_spectrum[e] = 0.0;
+
+#pragma omp for
+    for (long r=0; r < _num_FSRs; r++) {
+      Material* material = _FSR_materials[r];
+      for (int h=0; h < _num_moc_groups; h++)
+        thread_spectrum[getCmfdGroup(h)] += material->getSigmaTByGroup(h+1)
+            * _FSR_fluxes[r*_num_moc_groups+h] * _FSR_volumes[r];
+    }
+
+#pragma omp critical
+    {
+      for (int e=0; e < _num_cmfd_groups; e++)
+        spectrum[e] += thread_spectrum[e];
+    }
+  }
+
+#ifdef MPIx
+  if (_domain_communicator != NULL) {
+    double temp_spectrum[_num_cmfd_groups];
+    for (int e=0; e < _num_cmfd_groups; e++)
+      temp_spectrum[e] = spectrum[e];
+    MPI_Allreduce(temp_spectrum, spectrum, _num_cmfd_groups, MPI_DOUBLE,
+                  MPI_SUM, _domain_communicator->_MPI_cart);
+  }
+#endif
+
+  double total = 0.0;
+  for (int e=0; e < _num_cmfd_groups; e++)
+    total += spectrum[e];
+
+  /* Start a new condensed group once the previous ones hold their share of
+   * the collision rate, or when the remaining CMFD groups are just enough to
+   * fill the remaining condensed groups */
+  if (_cmfd_group_to_condensed_group != NULL)
+    delete [] _cmfd_group_to_condensed_group;
+  _cmfd_group_to_condensed_group = new int[_num_cmfd_groups];
+
+  double cumulative = 0.0;
+  int k = 0;
+  for (int e=0; e < _num_cmfd_groups; e++) {
+    if (e > 0 && k < num_groups - 1 &&
+        (cumulative >= total * (k + 1) / num_groups ||
+         _num_cmfd_groups - e == num_groups - 1 - k))
+      k++;
+    _cmfd_group_to_condensed_group[e] = k;
+    cumulative += spectrum[e];
+  }
+
+  /* Express the condensed group structure in MOC groups */
+  std::vector< std::vector<int> > group_structure(num_groups);
+  for (int h=0; h < _num_moc_groups; h++)
+    group_structure.at(_cmfd_group_to_condensed_group[getCmfdGroup(h)])
+        .push_back(h+1);
+
+  log_printf(NORMAL, "CMFD group structure condensed to %d groups from the "
+             "collision rate spectrum", num_groups);
+  log_printf(NORMAL, "\t CMFD Group \t Condensed Group \t Collision Fraction");
+  for (int e=0; e < _num_cmfd_groups; e++)
+    log_printf(NORMAL, "\t %d \t\t %d \t\t\t %6.4f", e+1,
+               _cmfd_group_to_condensed_group[e]+1,
+               spectrum[e] / std::max(total, FLT_EPSILON));
+
+  /* Create the condensed solver */
+  if (_condensed_cmfd != NULL)
+    delete _condensed_cmfd;
+  _condensed_cmfd = createCondensedCmfdSolver(group_structure);
+  _condensed_cmfd->setKeff(_k_eff);
+  _condensed_cmfd->_max_power_iterations = _condensed_max_iterations;
+  _condensed_cmfd->_return_failures = true;
+  _num_condensed_groups = num_groups;
+
+  /* Reset the statistics of the condensed group structure */
+  _num_stalled_iterations = 0;
+  _num_condensed_solves = 0;
+  _condensed_solve_time = 0.0;
+  _condensed_residual_ratios = 0.0;
+}
+
+
+/**
+ * @brief Checks whether the MOC convergence has stalled.
+ * @details The source convergence threshold is set from the MOC source
+ *          residual on every MOC iteration, so the ratio of successive
+ *          thresholds is the apparent dominance ratio of the MOC iterations.
+ *          The convergence is considered stalled when this ratio stays above
+ *          the stall ratio for CMFD_CONDENSATION_STALLED_ITERATIONS iterations.
+ * @return whether the MOC convergence has stalled
+ */
+bool Cmfd::isConvergenceStalled() {
+
+  bool stalled = false;
+  if (_previous_source_threshold > 0 && _moc_iteration > 1) {
+
+    double ratio = _source_convergence_threshold / _previous_source_threshold;
+    _condensed_residual_ratios += ratio;
+
+    if (ratio > _condensation_stall_ratio)
+      _num_stalled_iterations++;
+    else
+      _num_stalled_iterations = 0;
+
+    stalled = _num_stalled_iterations >= CMFD_CONDENSATION_STALLED_ITERATIONS;
+  }
+  _previous_source_threshold = _source_convergence_threshold;
+
+  return stalled;
+}
+
+
+/**
+ * @brief Solves the CMFD problem on the automatically condensed group
+ *        structure.
+ * @details The condensed group structure is selected on the first solve and
+ *          the number of condensed groups is doubled every time the MOC
+ *          convergence stalls, since a transport sweep costs much more than
+ *          the extra CMFD groups. Once the condensed structure would match the
+ *          CMFD group structure, or if the condensed solve fails, the regular
+ *          CMFD solver is used for the rest of the calculation.
+ * @param moc_iteration MOC iteration number
+ * @return The dominant eigenvalue of the condensed diffusion problem, -1 if
+ *         the regular CMFD solver should be used instead
+ */
+double Cmfd::computeCondensedKeff(int moc_iteration) {
+
+  /* Select the condensed group structure on the first solve */
+  if (_condensed_cmfd == NULL)
+    condenseGroupStructure(_num_condensed_groups);
+
+  /* Refine the condensed group structure if the MOC convergence stalls */
+  else if (isConvergenceStalled()) {
+
+    log_printf(NORMAL, "CMFD with %d condensed groups: %d solves, %1.4E sec "
+               "per solve, average MOC residual ratio %1.3f",
+               _num_condensed_groups, _num_condensed_solves,
+               _condensed_solve_time / std::max(_num_condensed_solves, 1),
+               _condensed_residual_ratios / std::max(_num_condensed_solves, 1));
+
+    int num_groups = std::min(2 * _num_condensed_groups, _num_cmfd_groups);
+    if (num_groups < _num_cmfd_groups) {
+      log_printf(NORMAL, "MOC convergence stalled, refining the condensed CMFD"
+                 " group structure");
+      condenseGroupStructure(num_groups);
+    }
+    else {
+      log_printf(NORMAL, "MOC convergence stalled, switching to the %d group "
+                 "CMFD solver", _num_cmfd_groups);
+      _num_condensed_groups = 0;
+      return -1.0;
+    }
+  }
+
+  /* Split the edge and vertex currents, which is otherwise done when
+   * collapsing the cross-sections, and condense the face currents */
+  _timer->startTimer();
+  splitCurrents();
+  _currents_split = true;
+  copyCurrentsToCondensed(_condensed_cmfd, _cmfd_group_to_condensed_group,
+                          _num_condensed_groups);
+
+  /* Solve the condensed problem */
+  _condensed_cmfd->setSourceConvergenceThreshold(_source_convergence_threshold);
+  double k_eff = _condensed_cmfd->computeKeff(moc_iteration);
+  _timer->stopTimer();
+  _timer->recordSplit("Total solver time");
+
+  _num_condensed_solves++;
+  _condensed_solve_time += _timer->getTime();
+
+  if (fabs(k_eff + 1) < FLT_EPSILON) {
+    log_printf(WARNING, "The %d group condensed CMFD solver failed, switching "
+               "to the %d group CMFD solver", _num_condensed_groups,
+               _num_cmfd_groups);
+    _num_condensed_groups = 0;
+    return -1.0;
+  }
+
+  _k_eff = k_eff;
+  return k_eff;
+}
+
+
 /**
  * @brief Returns the width of a given surface
  * @param surface A surface index, from 0 to NUM_FACES - 1
@@ -4321,6 +5024,47 @@ void Cmfd::setBackupGroupStructure(std::vector< std::vector<int> >
 }
 
 
+/**
+ * @brief Sets the CMFD solver to condense its group structure automatically.
+ * @details The condensed group structure is selected from the collision rate
+ *          spectrum on the first CMFD solve, and refined by doubling the
+ *          number of condensed groups whenever the ratio of successive MOC
+ *          source residuals stays above the stall ratio. An example of how
+ *          this may be called from Python to start from 2 condensed groups is
+ *          illustrated below:
+ *
+ * @code
+ *          cmfd.useAutomaticGroupCondensation(2)
+ * @endcode
+ *
+ * @param num_groups the initial number of condensed groups, 0 to disable
+ * @param stall_ratio the MOC residual ratio above which the convergence is
+ *        considered stalled
+ * @param max_iterations the maximum number of power iterations of a condensed
+ *        solve, beyond which it fails and the regular CMFD solver is used
+ */
+void Cmfd::useAutomaticGroupCondensation(int num_groups, double stall_ratio,
+                                         int max_iterations) {
+
+  if (num_groups < 0)
+    log_printf(ERROR, "Unable to condense the CMFD group structure to %d "
+               "groups", num_groups);
+  if (stall_ratio <= 0.0 || stall_ratio >= 1.0)
+    log_printf(ERROR, "Unable to set the CMFD condensation stall ratio to %f "
+               "since it must be between 0 and 1", stall_ratio);
+
+  if (max_iterations <= 0 || max_iterations > MAX_LINALG_POWER_ITERATIONS)
+    log_printf(ERROR, "Unable to limit the condensed CMFD solves to %d "
+               "iterations, which is not between 1 and %d", max_iterations,
+               MAX_LINALG_POWER_ITERATIONS);
+
+  _initial_condensed_groups = num_groups;
+  _num_condensed_groups = num_groups;
+  _condensation_stall_ratio = stall_ratio;
+  _condensed_max_iterations = max_iterations;
+}
+
+
 /**
  * @brief A function that prints a summary of the CMFD input parameters.
  */
@@ -4356,6 +5100,17 @@ void Cmfd::printInputParamsSummary() {
     if (_balance_sigma_t)
       log_printf(INFO_ONCE, "CMFD total cross sections adjusted for matching "
                  "MOC reaction rates");
+    if (_structured_stencil)
+      log_printf(NORMAL, "CMFD linear solver using structured stencil kernel");
+    if (_warm_start)
+      log_printf(NORMAL, "CMFD eigenvalue solve warm-started from the previous"
+                 " CMFD eigenvector");
+    if (_matrix_rebuild_threshold > 0)
+      log_printf(NORMAL, "CMFD matrices rebuilt for cross-section changes "
+                 "above %3.2e", _matrix_rebuild_threshold);
+    if (_num_condensed_groups > 0)
+      log_printf(NORMAL, "CMFD automatic group condensation starting from %d "
+                 "groups", _num_condensed_groups);
   }
 
   // Print CMFD space and energy mesh information
@@ -4398,6 +5153,22 @@ void Cmfd::printTimerReport() {
   msg_string.resize(53, '.');
   log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), matrix_construction_time);
 
+  /* Get the time of the matrix updates and the savings per update */
+  if (_num_matrix_updates > 0) {
+    double matrix_update_time = _timer->getSplit("Matrix update time");
+    msg_string = "      Matrix update time";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), matrix_update_time);
+
+    double build_time = (matrix_construction_time - matrix_update_time) /
+                        std::max(_num_matrix_builds, 1);
+    double update_time = matrix_update_time / _num_matrix_updates;
+    log_printf(RESULT, "      %d of %d matrix constructions replaced by "
+               "updates, saving %1.4E sec each", _num_matrix_updates,
+               _num_matrix_builds + _num_matrix_updates,
+               build_time - update_time);
+  }
+
 #ifdef MPIx
   /* Get the MPI communication time */
   double comm_time = _timer->getSplit("CMFD MPI communication time");
@@ -4734,7 +5505,7 @@ void Cmfd::checkNeutronBalance(bool pre_split, bool moc_balance) {
         for (int s = 0; s < NUM_FACES; s++) {
           int idx = s * _num_cmfd_groups + e;
           int cmfd_cell_next = getCellNext(i, s, false);
-          int surface_next = (s + NUM_FACES / 2) % NUM_FACES;
+          int surface_next = getSurfaceNext(i, s);
           int idx_next = surface_next * _num_cmfd_groups + e;
 
           /* Out of domain currents */
@@ -4851,7 +5622,13 @@ int Cmfd::getCellColor(int cmfd_cell) {
 
 /**
  * @brief Packs reaction rates and currents into buffers for communication.
- * @details Buffer description is found in ghostCellExchange's docstring
+ * @details The send buffer holds the boundary CMFD cells surface by surface,
+ *          from SURFACE_X_MIN to SURFACE_Z_MAX, with the cells of a surface
+ *          ordered by z, y then x. Each cell stores its volume, then the
+ *          reaction and diffusion tallies of each CMFD group, then the
+ *          surface currents of each face and group (face-major), for
+ *          (2 + NUM_FACES) * num_cmfd_groups + 1 values per cell. The
+ *          exchange of the buffers is described in startNeighborExchange.
  */
 #ifdef MPIx
 void Cmfd::packBuffers() {
@@ -4903,23 +5680,26 @@ void Cmfd::packBuffers() {
 
 
 /**
- * @brief Exchanges ghost cell buffers in 3D cartesian (i.e., 6 directions)
- * @details comm The cartesian MPI domain communicator object that is
- *          configured for the CMFD exchange
- *          send_buffers A 2D array of floating point data. The outer dimension
- *          corresponds to each face of the domain, while the inner dimension
- *          is the serialized buffer corresponding to the number of 2D cells
- *          to exchange times the number of energy groups.
- *          recv_buffers A 2D array of floating point data. The outer dimension
- *          corresponds to each face of the domain,  while the inner dimension
- *          is the serialized buffer corresponding to the number of 2D cells to
- *          exchange times the number of energy groups.
+ * @brief Posts a nonblocking exchange of boundary cell data with the
+ *        neighboring domains.
+ * @details The send and receive buffers hold the data of the boundary CMFD
+ *          cells surface by surface, from SURFACE_X_MIN to SURFACE_Z_MAX, with
+ *          the same storage for every cell. The data on each surface is sent
+ *          to the domain across it, and the data received from that domain is
+ *          stored on the same surface. The neighbors of a cartesian
+ *          communicator are ordered by dimension, negative direction first,
+ *          so surface s is exchanged with neighbor 2 * (s % 3) + s / 3. The
+ *          buffers on surfaces without neighbors are left untouched. All the
+ *          data is sent in a single MPI_Ineighbor_alltoallv, which completes
+ *          with an MPI_Wait on the request.
+ * @param send_data the buffer of data to send
+ * @param recv_data the buffer receiving the neighbors data
+ * @param storage_per_cell the number of values exchanged per boundary cell
+ * @param request the MPI request of the exchange
  */
-void Cmfd::ghostCellExchange() {
-
-  packBuffers();
-
-  MPI_Request requests[2*NUM_FACES];
+void Cmfd::startNeighborExchange(CMFD_PRECISION* send_data,
+                                 CMFD_PRECISION* recv_data,
+                                 int storage_per_cell, MPI_Request* request) {
 
   MPI_Datatype precision;
   if (sizeof(CMFD_PRECISION) == 4)
@@ -4927,131 +5707,59 @@ void Cmfd::ghostCellExchange() {
   else
     precision = MPI_DOUBLE;
 
-  int storage_per_cell = ((2 + NUM_FACES) * _num_cmfd_groups + 1);
-
-  int sizes[NUM_FACES];
-  for (int coord=0; coord < 3; coord++) {
-    for (int d=0; d<2; d++) {
+  int num_per_side[3] = {_local_num_y * _local_num_z,
+                         _local_num_x * _local_num_z,
+                         _local_num_x * _local_num_y};
 
-      int dir = 2*d - 1;
-      int surf = coord + 3*d;
-      int op_surf = surf - 3*dir;
-      int source, dest;
-
-      // Figure out serialized buffer length for this face
-      int size = 0;
-      if (surf == SURFACE_X_MIN) {
-        size = _local_num_y * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_X_MAX) {
-        size = _local_num_y * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_Y_MIN) {
-        size = _local_num_x * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_Y_MAX) {
-        size = _local_num_x * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_Z_MIN) {
-        size = _local_num_x * _local_num_y * storage_per_cell;
-      }
-      else if (surf == SURFACE_Z_MAX) {
-        size = _local_num_x * _local_num_y * storage_per_cell;
-      }
+  /* The counts and displacements must be kept until the exchange completes */
+  int start = 0;
+  for (int s=0; s < NUM_FACES; s++) {
+    int neighbor = 2 * (s % 3) + s / 3;
+    _neighbor_counts[neighbor] = num_per_side[s % 3] * storage_per_cell;
+    _neighbor_displs[neighbor] = start;
+    start += _neighbor_counts[neighbor];
+  }
 
-      sizes[surf] = size;
+  MPI_Ineighbor_alltoallv(send_data, _neighbor_counts, _neighbor_displs,
+                          precision, recv_data, _neighbor_counts,
+                          _neighbor_displs, precision,
+                          _domain_communicator->_MPI_cart, request);
+}
 
-      /* Get ranks of source and destination domains, using the cartesian
-         structure of the domain decomposition */
-      MPI_Cart_shift(_domain_communicator->_MPI_cart, coord, dir, &source,
-                     &dest);
 
-      // Post send
-      MPI_Isend(_send_data_by_surface[surf], size, precision,
-          dest, 0, _domain_communicator->_MPI_cart, &requests[2*surf]);
+/**
+ * @brief Posts the exchange of ghost cell buffers in 3D cartesian (i.e., 6
+ *        directions).
+ * @details The reaction rates, diffusion tallies and surface currents of the
+ *          boundary cells are packed and exchanged with the neighboring
+ *          domains in a single nonblocking neighborhood exchange. The
+ *          exchange is completed with an MPI_Wait on the request, after which
+ *          the neighbors data is available in the _boundary_* arrays.
+ * @param request the MPI request of the exchange
+ */
+void Cmfd::ghostCellExchange(MPI_Request* request) {
 
-      // Post receive
-      MPI_Irecv(_domain_data_by_surface[op_surf], size, precision,
-          source, 0, _domain_communicator->_MPI_cart, &requests[2*surf+1]);
-    }
-  }
+  packBuffers();
 
-  // Block for communication round to complete
-  MPI_Waitall(12, requests, MPI_STATUSES_IGNORE);
+  int storage_per_cell = ((2 + NUM_FACES) * _num_cmfd_groups + 1);
+  startNeighborExchange(_send_domain_data, _inter_domain_data,
+                        storage_per_cell, request);
 }
 
 
 /**
  * @brief Communicate split (at corners and edges) currents (respectively edge
  *        and face currents) to other domains.
+ * @details The currents split onto the boundary cells of every neighboring
+ *          domain are sent in a single neighborhood exchange.
  * @param faces whether the currents are for edges or faces, for unpacking
  */
 void Cmfd::communicateSplits(bool faces) {
 
-  //TODO: Form into communicateEdgeCurrents and communicateFaceCurrents
-  // 1. communicate edge currents use array of length NUM_EDGES, called after
-  //    vertex splits
-  // 2. communicate face currents use array of length NUM_FACES, called after
-  //    edge splits
-  // NOTE: only communicate currents that are saved OFF DOMAIN at each step
-  // NOTE: communicateFaceCurrents will use currents formed from vertex splits
-
-  MPI_Request requests[2*NUM_FACES];
-
-  MPI_Datatype precision;
-  if (sizeof(CMFD_PRECISION) == 4)
-    precision = MPI_FLOAT;
-  else
-    precision = MPI_DOUBLE;
-
-  int storage_per_cell = (NUM_FACES + NUM_EDGES) * _num_cmfd_groups;
-
-  int sizes[NUM_FACES];
-  for (int coord=0; coord < 3; coord++) {
-    for (int d=0; d<2; d++) {
-
-      int dir = 2*d-1;
-      int surf = coord + 3*d;
-      int op_surf = surf - 3*dir;
-      int source, dest;
-
-      // Figure out serialized buffer length for this face
-      int size = 0;
-      if (surf == SURFACE_X_MIN) {
-        size = _local_num_y * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_X_MAX) {
-        size = _local_num_y * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_Y_MIN) {
-        size = _local_num_x * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_Y_MAX) {
-        size = _local_num_x * _local_num_z * storage_per_cell;
-      }
-      else if (surf == SURFACE_Z_MIN) {
-        size = _local_num_x * _local_num_y * storage_per_cell;
-      }
-      else if (surf == SURFACE_Z_MAX) {
-        size = _local_num_x * _local_num_y * storage_per_cell;
-      }
-
-      sizes[surf] = size;
-
-      MPI_Cart_shift(_domain_communicator->_MPI_cart, coord, dir, &source, &dest);
-
-      // Post send
-      MPI_Isend(_send_split_currents_array[surf], size, precision,
-          dest, 0, _domain_communicator->_MPI_cart, &requests[2*surf]);
-
-      // Post receive
-      MPI_Irecv(_receive_split_currents_array[op_surf], size, precision,
-          source, 0, _domain_communicator->_MPI_cart, &requests[2*surf+1]);
-    }
-  }
-
-  // Block for communication round to complete
-  MPI_Waitall(12, requests, MPI_STATUSES_IGNORE);
+  MPI_Request request;
+  startNeighborExchange(_send_split_current_data, _receive_split_current_data,
+                        (NUM_FACES + NUM_EDGES) * _num_cmfd_groups, &request);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
 
   unpackSplitCurrents(faces);
 }
@@ -14,6 +14,7 @@
 #include "Python.h"
 #endif
 #include "log.h"
+#include "memory_accounting.h"
 #include "constants.h"
 #include "Universe.h"
 #include "Track.h"
@@ -32,12 +33,6 @@
 /** Forward declaration of Geometry class */
 class Geometry;
 
-/** Comparator for sorting k-nearest stencil std::pair objects */
-inline bool stencilCompare(const std::pair<int, double>& firstElem,
-                           const std::pair<int, double>& secondElem) {
-  return firstElem.second < secondElem.second;
-}
-
 #undef track_flux
 
 /** Indexing macro for the angular fluxes for each polar angle and energy
@@ -92,6 +87,13 @@ private:
   CMFD_PRECISION*** _off_domain_split_currents;
   CMFD_PRECISION*** _received_split_currents;
 
+#ifdef MPIx
+  /** Counts and displacements of the pending neighborhood exchange, in the
+   *  order of the neighbors of the cartesian communicator */
+  int _neighbor_counts[NUM_FACES];
+  int _neighbor_displs[NUM_FACES];
+#endif
+
   /** Vector representing the flux for each cmfd cell and cmfd energy group at
    * the end of a CMFD solve */
   Vector* _new_flux;
@@ -165,6 +167,42 @@ private:
    *  solution on every sweep */
   bool _balance_sigma_t;
 
+  /** Whether the linear solver uses the structured stencil SOR kernel */
+  bool _structured_stencil;
+
+  /** Whether the eigenvalue solve starts from the previous CMFD eigenvector */
+  bool _warm_start;
+
+  /** Maximum number of power iterations of the eigenvalue solve */
+  int _max_power_iterations;
+
+  /** Whether a failed eigenvalue solve returns -1 instead of the previous
+   *  eigenvalue, for a condensed solver which falls back to its parent */
+  bool _return_failures;
+
+  /** Dominance ratio estimate of the previous CMFD eigenvalue solve, negative
+   *  if the previous eigenvector cannot be used as a starting guess */
+  double _dominance_ratio;
+
+  /** Maximum relative change in the collapsed cross-sections for which only
+   *  the current-dependent matrix coefficients are updated, 0 to disable */
+  double _matrix_rebuild_threshold;
+
+  /** Collapsed cross-sections the CMFD matrices were last built with */
+  CMFD_PRECISION* _matrix_xs;
+
+  /** Streaming coefficients added to the diagonal and off-diagonal terms of
+   *  the A matrix in its last construction, by cell, surface and group */
+  CMFD_PRECISION* _streaming_coeffs;
+
+  /** Whether the A and M matrices hold a full construction that may be
+   *  updated in place */
+  bool _matrices_built;
+
+  /** Number of full matrix constructions and current-only updates */
+  int _num_matrix_builds;
+  int _num_matrix_updates;
+
   /** Number of FSRs */
   long _num_FSRs;
 
@@ -262,9 +300,14 @@ private:
   /** Relaxation factor to use for corrected diffusion coefficients */
   double _relaxation_factor;
 
-  /** Map storing the k-nearest stencil for each fsr */
-  std::map<long, std::vector< std::pair<int, double> > >
-    _k_nearest_stencils;
+  /** Offsets of the k-nearest stencil of each FSR in the stencil arrays */
+  long* _k_nearest_offsets;
+
+  /** Local CMFD cells of the k-nearest stencils */
+  int* _k_nearest_cells;
+
+  /** Normalized prolongation weights of the k-nearest stencil cells */
+  float* _k_nearest_weights;
 
   /** OpenMP mutual exclusion locks for atomic CMFD cell operations */
   omp_lock_t* _cell_locks;
@@ -351,13 +394,59 @@ private:
   /** A one-group backup CMFD solver */
   Cmfd* _backup_cmfd;
 
+  /** Number of groups the CMFD group structure is first condensed to, 0 if
+   *  it is not condensed automatically */
+  int _initial_condensed_groups;
+
+  /** Number of groups of the automatically condensed CMFD solver, 0 once the
+   *  regular CMFD solver is used */
+  int _num_condensed_groups;
+
+  /** Ratio of successive MOC source residuals above which the convergence is
+   *  considered stalled */
+  double _condensation_stall_ratio;
+
+  /** Number of successive MOC iterations with a stalled convergence */
+  int _num_stalled_iterations;
+
+  /** Source convergence threshold of the previous MOC iteration */
+  double _previous_source_threshold;
+
+  /** Map of CMFD groups to the automatically condensed group structure */
+  int* _cmfd_group_to_condensed_group;
+
+  /** Number of solves, solve time and sum of the MOC source residual ratios
+   *  with the current condensed group structure */
+  int _num_condensed_solves;
+  double _condensed_solve_time;
+  double _condensed_residual_ratios;
+
+  /** Maximum number of power iterations of a condensed solve */
+  int _condensed_max_iterations;
+
+  /** The CMFD solver on the automatically condensed group structure */
+  Cmfd* _condensed_cmfd;
+
+  /** Whether the edge and vertex currents of the current MOC iteration were
+   *  already split, by a failed condensed solve */
+  bool _currents_split;
+
   /* Private worker functions */
   CMFD_PRECISION computeLarsensEDCFactor(CMFD_PRECISION dif_coef,
                                          CMFD_PRECISION delta);
-  void constructMatrices();
+  void constructMatrices(bool rebuild_xs=true);
+  double computeXSChange(bool record);
+  Cmfd* createCondensedCmfdSolver(std::vector< std::vector<int> >
+                                  group_structure);
+  void copyCurrentsToCondensed(Cmfd* condensed_cmfd, int* group_map,
+                               int num_condensed_groups);
+  void condenseGroupStructure(int num_groups);
+  bool isConvergenceStalled();
+  double computeCondensedKeff(int moc_iteration);
   void collapseXS();
   void updateMOCFlux();
   void rescaleFlux();
+  void splitCurrents();
   void splitVertexCurrents();
   void splitEdgeCurrents();
   void getVertexSplitSurfaces(int cell, int vertex, std::vector<int>* surfaces);
@@ -365,14 +454,18 @@ private:
   void initializeMaterials();
   void initializeCurrents();
   void generateKNearestStencils();
+  int computeKNearestStencil(long fsr_id, int cell_id, int* cells,
+                             float* weights);
   int convertDirectionToSurface(int* direction);
   void convertSurfaceToDirection(int surface, int* direction);
   std::string getSurfaceNameFromDirection(int* direction);
   std::string getSurfaceNameFromSurface(int surface);
+  int rotateSurface(int surface, int boundary);
 
   /* Private getter functions */
   int getCellNext(int cell_id, int surface_id, bool global=true,
                   bool neighbor=false);
+  int getSurfaceNext(int cell_id, int surface_id);
   int getCellByStencil(int cell_id, int stencil_id);
   CMFD_PRECISION getFluxRatio(int cell_id, int group, long fsr);
   CMFD_PRECISION getUpdateRatio(int cell_id, int moc_group, long fsr);
@@ -389,7 +482,10 @@ private:
   int getCellColor(int cmfd_cell); //TODO: optimize, document
   void packBuffers();
 #ifdef MPIx
-  void ghostCellExchange();
+  void startNeighborExchange(CMFD_PRECISION* send_data,
+                             CMFD_PRECISION* recv_data, int storage_per_cell,
+                             MPI_Request* request);
+  void ghostCellExchange(MPI_Request* request);
   void communicateSplits(bool faces);
 #endif
   void unpackSplitCurrents(bool faces);
@@ -476,6 +572,10 @@ public:
                         polar_spacings, int num_azim, int num_polar);
   void setKeff(double k_eff);
   void setBackupGroupStructure(std::vector< std::vector<int> > group_indices);
+  void useAutomaticGroupCondensation(int num_groups,
+                                     double stall_ratio=0.8,
+                                     int max_iterations=
+                                     MAX_LINALG_POWER_ITERATIONS);
 
 #ifdef MPIx
   void setNumDomains(int num_x, int num_y, int num_z);
@@ -489,6 +589,11 @@ public:
   void enforceBalanceOnDiagonal(int cmfd_cell, int group);
   void rebalanceSigmaT(bool balance_sigma_t);
 
+  /* Methods to speed up the CMFD linear solver */
+  void useStructuredStencil(bool structured_stencil);
+  void useWarmStart(bool warm_start);
+  void setMatrixRebuildThreshold(double threshold);
+
   /* Set FSR parameters */
   void setFSRMaterials(Material** FSR_materials);
   void setFSRVolumes(FP_PRECISION* FSR_volumes);
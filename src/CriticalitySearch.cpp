@@ -0,0 +1,375 @@
+#include "CriticalitySearch.h"
+
+/**
+ * @brief Constructor initializes the default search parameters.
+ * @param solver the Solver used for the eigenvalue calculations
+ */
+CriticalitySearch::CriticalitySearch(Solver* solver) {
+
+  if (solver == NULL)
+    log_printf(ERROR, "Unable to create a CriticalitySearch without a "
+               "Solver");
+
+  _solver = solver;
+  _callback = NULL;
+  _callback_data = NULL;
+  _target_keff = 1.;
+  _tolerance = 1E-5;
+  _loose_tolerance = 1E-3;
+  _parameter = 0.;
+  _keff = 0.;
+  _num_solves = 0;
+  _num_sweeps = 0;
+}
+
+
+/**
+ * @brief Destructor.
+ */
+CriticalitySearch::~CriticalitySearch() {
+}
+
+
+/**
+ * @brief Sets a function applying a parameter value to the problem.
+ * @details The function is called before each eigenvalue calculation, after
+ *          the Materials have been interpolated. It may modify any Material
+ *          data, but not the Geometry or the Tracks. From Python, the
+ *          function is any callable taking the parameter value:
+ *
+ * @code
+ *          search.setParameterCallback(lambda ppm: parameters.append(ppm))
+ * @endcode
+ *
+ * @param callback the function, called with the parameter value and data
+ * @param data a pointer passed to the function
+ */
+void CriticalitySearch::setParameterCallback(
+    void (*callback)(double parameter, void* data), void* data) {
+  _callback = callback;
+  _callback_data = data;
+}
+
+
+/**
+ * @brief Returns the data passed to the parameter callback.
+ * @return a pointer to the data, NULL if there is none
+ */
+void* CriticalitySearch::getParameterCallbackData() {
+  return _callback_data;
+}
+
+
+/**
+ * @brief Interpolates the cross sections of a Material linearly between two
+ *        states as a function of the parameter.
+ * @details The states are usually Materials which are not in the Geometry,
+ *          e.g. the moderator at two boron concentrations, and the
+ *          cross sections are extrapolated outside of their parameters. This
+ *          may be called from Python as follows:
+ *
+ * @code
+ *          search.addInterpolatedMaterial(moderator, unborated, 0.,
+ *                                         borated, 1000.)
+ * @endcode
+ *
+ * @param material the Material of the Geometry to modify
+ * @param material_1 the Material at the first parameter value
+ * @param parameter_1 the first parameter value
+ * @param material_2 the Material at the second parameter value
+ * @param parameter_2 the second parameter value
+ */
+void CriticalitySearch::addInterpolatedMaterial(Material* material,
+    Material* material_1, double parameter_1, Material* material_2,
+    double parameter_2) {
+
+  if (parameter_1 == parameter_2)
+    log_printf(ERROR, "Unable to interpolate Material %d between two states "
+               "with the same parameter %f", material->getId(), parameter_1);
+  if (material_1->getNumEnergyGroups() != material->getNumEnergyGroups() ||
+      material_2->getNumEnergyGroups() != material->getNumEnergyGroups())
+    log_printf(ERROR, "Unable to interpolate Material %d between Materials "
+               "with different numbers of energy groups", material->getId());
+
+  _materials.push_back(material);
+  _materials_1.push_back(material_1);
+  _materials_2.push_back(material_2);
+  _parameters_1.push_back(parameter_1);
+  _parameters_2.push_back(parameter_2);
+}
+
+
+/**
+ * @brief Sets the eigenvalue to search for.
+ * @param target_keff the target eigenvalue (1 by default)
+ */
+void CriticalitySearch::setTargetKeff(double target_keff) {
+  if (target_keff <= 0)
+    log_printf(ERROR, "Unable to set a non-positive target eigenvalue %f",
+               target_keff);
+  _target_keff = target_keff;
+}
+
+
+/**
+ * @brief Sets the tolerance on the difference between the eigenvalue and the
+ *        target eigenvalue.
+ * @param tolerance the convergence tolerance (1E-5 by default)
+ */
+void CriticalitySearch::setConvergenceThreshold(double tolerance) {
+  if (tolerance <= 0)
+    log_printf(ERROR, "Unable to set a non-positive search convergence "
+               "threshold %f", tolerance);
+  _tolerance = tolerance;
+}
+
+
+/**
+ * @brief Sets the loosest convergence threshold of the eigenvalue
+ *        calculations.
+ * @details The eigenvalue calculations are converged to a tenth of the
+ *          relative distance to the target eigenvalue, between the Solver's
+ *          convergence threshold and this threshold. The search only
+ *          converges with a calculation at the Solver's threshold.
+ * @param tolerance the loosest convergence threshold (1E-3 by default)
+ */
+void CriticalitySearch::setLooseConvergenceThreshold(double tolerance) {
+  if (tolerance <= 0)
+    log_printf(ERROR, "Unable to set a non-positive loose convergence "
+               "threshold %f", tolerance);
+  _loose_tolerance = tolerance;
+}
+
+
+/**
+ * @brief Applies a parameter value to the Materials and the user callback.
+ * @param parameter the parameter value
+ */
+void CriticalitySearch::setParameter(double parameter) {
+
+  for (size_t m=0; m < _materials.size(); m++) {
+
+    Material* material = _materials[m];
+    Material* material_1 = _materials_1[m];
+    Material* material_2 = _materials_2[m];
+    double w = (parameter - _parameters_1[m]) /
+               (_parameters_2[m] - _parameters_1[m]);
+    int num_groups = material->getNumEnergyGroups();
+
+    std::vector<double> sigma_t(num_groups), sigma_f(num_groups),
+        nu_sigma_f(num_groups), chi(num_groups);
+    std::vector<double> sigma_s(num_groups * num_groups);
+
+    for (int g=1; g <= num_groups; g++) {
+      sigma_t[g-1] = (1. - w) * material_1->getSigmaTByGroup(g) +
+                     w * material_2->getSigmaTByGroup(g);
+      sigma_f[g-1] = (1. - w) * material_1->getSigmaFByGroup(g) +
+                     w * material_2->getSigmaFByGroup(g);
+      nu_sigma_f[g-1] = (1. - w) * material_1->getNuSigmaFByGroup(g) +
+                        w * material_2->getNuSigmaFByGroup(g);
+      chi[g-1] = (1. - w) * material_1->getChiByGroup(g) +
+                 w * material_2->getChiByGroup(g);
+      for (int gp=1; gp <= num_groups; gp++)
+        sigma_s[(g-1)*num_groups + gp-1] =
+            (1. - w) * material_1->getSigmaSByGroup(g, gp) +
+            w * material_2->getSigmaSByGroup(g, gp);
+    }
+
+    material->setSigmaT(&sigma_t[0], num_groups);
+    material->setSigmaS(&sigma_s[0], num_groups * num_groups);
+    material->setSigmaF(&sigma_f[0], num_groups);
+    material->setNuSigmaF(&nu_sigma_f[0], num_groups);
+    material->setChi(&chi[0], num_groups);
+
+    /* Absorption is not updated by the other setters */
+    for (int g=1; g <= num_groups; g++)
+      material->setSigmaAByGroup((1. - w) * material_1->getSigmaAByGroup(g) +
+                                 w * material_2->getSigmaAByGroup(g), g);
+  }
+
+  if (_callback != NULL)
+    _callback(parameter, _callback_data);
+
+  _parameter = parameter;
+}
+
+
+/**
+ * @brief Computes the eigenvalue for a parameter value.
+ * @details The first calculation puts the Solver in restart mode, so that
+ *          the following calculations start from the last solution.
+ * @param parameter the parameter value
+ * @param tolerance the convergence threshold of the calculation
+ * @param max_iters the maximum number of source iterations
+ * @return the difference between the eigenvalue and the target
+ */
+double CriticalitySearch::computeKeff(double parameter, double tolerance,
+                                      int max_iters) {
+
+  setParameter(parameter);
+  _solver->setConvergenceThreshold(tolerance);
+
+  int log_level = get_log_level();
+  if (log_level == NORMAL)
+    set_log_level(WARNING);
+  _solver->computeEigenvalue(max_iters);
+  set_log_level(log_level);
+
+  /* Restarted calculations start counting iterations at 1 */
+  _keff = _solver->getKeff();
+  _num_sweeps += _solver->getNumIterations() - (_num_solves > 0);
+  _num_solves++;
+  if (_num_solves == 1)
+    _solver->setRestartStatus(true);
+
+  log_printf(NORMAL, "Search %d:  parameter = %1.6E  k_eff = %1.6f  "
+             "res = %1.1E", _num_solves, parameter, _keff, tolerance);
+
+  return _keff - _target_keff;
+}
+
+
+/**
+ * @brief Searches the parameter value for which the eigenvalue equals the
+ *        target eigenvalue.
+ * @details The search starts from two parameter values, which do not need
+ *          to bracket the solution. The Materials and the callback are left
+ *          at the last parameter value. This may be called from Python as
+ *          follows:
+ *
+ * @code
+ *          search = openmoc.CriticalitySearch(solver)
+ *          search.addInterpolatedMaterial(moderator, unborated, 0.,
+ *                                         borated, 1000.)
+ *          critical_boron = search.search(500., 1000.)
+ * @endcode
+ *
+ * @param parameter_1 the first parameter value
+ * @param parameter_2 the second parameter value
+ * @param max_searches the maximum number of eigenvalue calculations
+ * @param max_iters the maximum number of source iterations of each
+ *        eigenvalue calculation
+ * @return the parameter value of the target eigenvalue
+ */
+double CriticalitySearch::search(double parameter_1, double parameter_2,
+                                 int max_searches, int max_iters) {
+
+  if (parameter_1 == parameter_2)
+    log_printf(ERROR, "Unable to start a criticality search from two equal "
+               "parameters %f", parameter_1);
+  if (max_searches < 2)
+    log_printf(ERROR, "Unable to search with fewer than 2 eigenvalue "
+               "calculations");
+
+  log_printf(NORMAL, "Searching the parameter for k_eff = %1.6f...",
+             _target_keff);
+
+  _num_solves = 0;
+  _num_sweeps = 0;
+  double final_tolerance = _solver->getConvergenceThreshold();
+  double tolerance = std::max(_loose_tolerance, final_tolerance);
+
+  double x_1 = parameter_1;
+  double x_2 = parameter_2;
+  double f_1 = computeKeff(x_1, tolerance, max_iters);
+  tolerance = std::min(_loose_tolerance,
+                       std::max(final_tolerance, 0.1 * fabs(f_1)));
+  double f_2 = computeKeff(x_2, tolerance, max_iters);
+
+  /* The bracket of the solution, once found */
+  bool bracketed = (f_1 * f_2 <= 0.);
+  double x_low = std::min(x_1, x_2);
+  double x_high = std::max(x_1, x_2);
+  double f_low = (x_low == x_1) ? f_1 : f_2;
+
+  while (fabs(f_2) > _tolerance * _target_keff ||
+         tolerance > final_tolerance) {
+
+    if (_num_solves == max_searches) {
+      log_printf(WARNING, "Unable to converge the criticality search in %d "
+                 "eigenvalue calculations", max_searches);
+      break;
+    }
+
+    /* Secant step, replaced by bisection if it leaves the bracket */
+    double x_3 = 0.5 * (x_low + x_high);
+    if (f_2 != f_1)
+      x_3 = x_2 - f_2 * (x_2 - x_1) / (f_2 - f_1);
+    else if (!bracketed)
+      log_printf(ERROR, "Unable to search the parameter since k_eff does "
+                 "not depend on it");
+    if (bracketed && (x_3 <= x_low || x_3 >= x_high))
+      x_3 = 0.5 * (x_low + x_high);
+
+    tolerance = std::min(_loose_tolerance, std::max(final_tolerance,
+                         0.1 * fabs(f_2) / _target_keff));
+    double f_3 = computeKeff(x_3, tolerance, max_iters);
+
+    /* Update the bracket */
+    if (bracketed) {
+      if (f_3 * f_low > 0.) {
+        x_low = x_3;
+        f_low = f_3;
+      }
+      else
+        x_high = x_3;
+    }
+    else if (f_3 * f_2 <= 0.) {
+      bracketed = true;
+      x_low = std::min(x_2, x_3);
+      x_high = std::max(x_2, x_3);
+      f_low = (x_low == x_2) ? f_2 : f_3;
+    }
+
+    x_1 = x_2;
+    f_1 = f_2;
+    x_2 = x_3;
+    f_2 = f_3;
+  }
+
+  /* Restore the Solver settings */
+  _solver->setConvergenceThreshold(final_tolerance);
+  _solver->setRestartStatus(false);
+
+  log_printf(RESULT, "Parameter = %1.6E for k_eff = %1.6f after %d eigenvalue "
+             "calculations and %d transport sweeps", _parameter, _keff,
+             _num_solves, _num_sweeps);
+
+  return _parameter;
+}
+
+
+/**
+ * @brief Returns the last parameter value applied.
+ * @return the parameter value
+ */
+double CriticalitySearch::getParameter() {
+  return _parameter;
+}
+
+
+/**
+ * @brief Returns the eigenvalue of the last calculation.
+ * @return the eigenvalue
+ */
+double CriticalitySearch::getKeff() {
+  return _keff;
+}
+
+
+/**
+ * @brief Returns the number of eigenvalue calculations of the last search.
+ * @return the number of eigenvalue calculations
+ */
+int CriticalitySearch::getNumSolves() {
+  return _num_solves;
+}
+
+
+/**
+ * @brief Returns the number of transport sweeps of the last search.
+ * @return the number of transport sweeps
+ */
+int CriticalitySearch::getNumTransportSweeps() {
+  return _num_sweeps;
+}
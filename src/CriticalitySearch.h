@@ -0,0 +1,92 @@
+/**
+ * @file CriticalitySearch.h
+ * @brief The CriticalitySearch class.
+ * @date October 18, 2026
+ */
+
+#ifndef CRITICALITYSEARCH_H_
+#define CRITICALITYSEARCH_H_
+
+#ifdef __cplusplus
+#include "Solver.h"
+#endif
+
+
+/**
+ * @class CriticalitySearch CriticalitySearch.h "src/CriticalitySearch.h"
+ * @brief Searches the value of a parameter for which the eigenvalue of a
+ *        problem reaches a target, e.g. a critical boron concentration.
+ * @details The parameter is applied by interpolating Materials between two
+ *          states, e.g. two boron concentrations, and by an optional user
+ *          callback. The search uses the secant method, with bisection steps
+ *          once the root is bracketed. The eigenvalue calculations after the
+ *          first start from the previous fluxes, eigenvalue and CMFD solution,
+ *          and are converged to a loose tolerance that tightens to the
+ *          Solver's convergence threshold as the search converges.
+ */
+class CriticalitySearch {
+
+private:
+
+  /** The Solver used for the eigenvalue calculations */
+  Solver* _solver;
+
+  /** A user function applying a parameter value, and its data */
+  void (*_callback)(double parameter, void* data);
+  void* _callback_data;
+
+  /** The Materials interpolated between two states */
+  std::vector<Material*> _materials;
+
+  /** The two states of the interpolated Materials and their parameters */
+  std::vector<Material*> _materials_1;
+  std::vector<Material*> _materials_2;
+  std::vector<double> _parameters_1;
+  std::vector<double> _parameters_2;
+
+  /** The target eigenvalue */
+  double _target_keff;
+
+  /** The tolerance on the difference to the target eigenvalue */
+  double _tolerance;
+
+  /** The loosest convergence threshold of the eigenvalue calculations */
+  double _loose_tolerance;
+
+  /** The last parameter value and eigenvalue */
+  double _parameter;
+  double _keff;
+
+  /** The number of eigenvalue calculations and transport sweeps */
+  int _num_solves;
+  int _num_sweeps;
+
+  double computeKeff(double parameter, double tolerance, int max_iters);
+
+public:
+
+  CriticalitySearch(Solver* solver);
+  virtual ~CriticalitySearch();
+
+  void setParameterCallback(void (*callback)(double parameter, void* data),
+                            void* data=NULL);
+  void* getParameterCallbackData();
+  void addInterpolatedMaterial(Material* material, Material* material_1,
+                               double parameter_1, Material* material_2,
+                               double parameter_2);
+  void setTargetKeff(double target_keff);
+  void setConvergenceThreshold(double tolerance);
+  void setLooseConvergenceThreshold(double tolerance);
+  void setParameter(double parameter);
+
+  double search(double parameter_1, double parameter_2, int max_searches=20,
+                int max_iters=1000);
+
+  double getParameter();
+  double getKeff();
+  int getNumSolves();
+  int getNumTransportSweeps();
+};
+
+
+#endif /* CRITICALITYSEARCH_H_ */
@@ -0,0 +1,1034 @@
+#include "EigenmodeSolver.h"
+
+/**
+ * @brief Constructor initializes the default solution parameters.
+ * @param solver the Solver whose transport sweeps define the operators
+ */
+EigenmodeSolver::EigenmodeSolver(Solver* solver) {
+
+  if (solver == NULL)
+    log_printf(ERROR, "Unable to create an EigenmodeSolver without a Solver");
+
+  _solver = solver;
+  _size = 0;
+  _num_modes = 0;
+  _num_arnoldi_vectors = 0;
+  _num_gmres_vectors = 10;
+  _tolerance = 1E-5;
+  _inner_tolerance = 1E-6;
+  _max_restarts = 100;
+  _max_inner_iterations = 1000;
+  _num_restarts = 0;
+  _converged = false;
+  _num_fission_sweeps = 0;
+  _num_scatter_sweeps = 0;
+}
+
+
+/**
+ * @brief Destructor.
+ */
+EigenmodeSolver::~EigenmodeSolver() {
+}
+
+
+/**
+ * @brief Sets the number of Arnoldi vectors of the Krylov subspace.
+ * @details The subspace must hold at least two more vectors than the number
+ *          of eigenmodes. By default twice the number of modes plus one are
+ *          used. More vectors reduce the number of restarts at the cost of
+ *          memory, one flux-sized vector each.
+ * @param num_vectors the number of Arnoldi vectors
+ */
+void EigenmodeSolver::setNumArnoldiVectors(int num_vectors) {
+  if (num_vectors < 3)
+    log_printf(ERROR, "Unable to use %d Arnoldi vectors, at least 3 are "
+               "required", num_vectors);
+  _num_arnoldi_vectors = num_vectors;
+}
+
+
+/**
+ * @brief Sets the number of GMRES vectors between restarts of the inner
+ *        solves with the scattering operator.
+ * @param num_vectors the number of GMRES vectors
+ */
+void EigenmodeSolver::setNumGMRESVectors(int num_vectors) {
+  if (num_vectors < 1)
+    log_printf(ERROR, "Unable to use %d GMRES vectors", num_vectors);
+  _num_gmres_vectors = num_vectors;
+}
+
+
+/**
+ * @brief Sets the relative tolerance on the Ritz estimates of the eigenpairs.
+ * @param tolerance the convergence tolerance (1E-5 by default)
+ */
+void EigenmodeSolver::setConvergenceThreshold(double tolerance) {
+  if (tolerance <= 0)
+    log_printf(ERROR, "Unable to set a non-positive convergence threshold %f",
+               tolerance);
+  _tolerance = tolerance;
+}
+
+
+/**
+ * @brief Sets the relative residual tolerance of the inner GMRES solves.
+ * @details The inner tolerance should be tighter than the outer tolerance,
+ *          since the Arnoldi relation only holds up to the inner residuals.
+ * @param tolerance the inner convergence tolerance (1E-6 by default)
+ */
+void EigenmodeSolver::setInnerConvergenceThreshold(double tolerance) {
+  if (tolerance <= 0)
+    log_printf(ERROR, "Unable to set a non-positive inner convergence "
+               "threshold %f", tolerance);
+  _inner_tolerance = tolerance;
+}
+
+
+/**
+ * @brief Sets the maximum number of implicit restarts.
+ * @param max_restarts the maximum number of restarts (100 by default)
+ */
+void EigenmodeSolver::setMaxRestarts(int max_restarts) {
+  if (max_restarts < 0)
+    log_printf(ERROR, "Unable to set a negative number of restarts %d",
+               max_restarts);
+  _max_restarts = max_restarts;
+}
+
+
+/**
+ * @brief Sets the maximum number of scattering operator applications of each
+ *        inner GMRES solve.
+ * @param max_iterations the maximum number of iterations (1000 by default)
+ */
+void EigenmodeSolver::setMaxInnerIterations(int max_iterations) {
+  if (max_iterations < 1)
+    log_printf(ERROR, "Unable to set %d maximum inner iterations",
+               max_iterations);
+  _max_inner_iterations = max_iterations;
+}
+
+
+/**
+ * @brief Computes the eigenmodes of the largest eigenvalues.
+ * @details An Arnoldi factorization of \f$ (I - T_S)^{-1} T_F \f$ is
+ *          started from a flat flux and implicitly restarted with the
+ *          unwanted Ritz values as shifts, until the Ritz estimates of the
+ *          wanted eigenpairs are below the convergence threshold. This may
+ *          be called from Python as follows:
+ *
+ * @code
+ *          eigenmode_solver = openmoc.EigenmodeSolver(solver)
+ *          eigenmode_solver.computeEigenmodes(openmoc.FORWARD, 5)
+ *          k_1 = eigenmode_solver.getEigenvalue(1)
+ * @endcode
+ *
+ * @param solver_mode the type of eigenmodes (FORWARD or ADJOINT)
+ * @param num_modes the number of eigenmodes to compute
+ */
+void EigenmodeSolver::computeEigenmodes(solverMode solver_mode,
+                                        int num_modes) {
+
+  if (num_modes < 1)
+    log_printf(ERROR, "Unable to compute %d eigenmodes", num_modes);
+
+  /* The sweeps are only linear in the flux with vacuum boundaries */
+  Geometry* geometry = _solver->getGeometry();
+  Universe* root = geometry->getRootUniverse();
+  if (root->getMinXBoundaryType() != VACUUM ||
+      root->getMaxXBoundaryType() != VACUUM ||
+      root->getMinYBoundaryType() != VACUUM ||
+      root->getMaxYBoundaryType() != VACUUM ||
+      (_solver->is3D() && (root->getMinZBoundaryType() != VACUUM ||
+                           root->getMaxZBoundaryType() != VACUUM)))
+    log_printf(ERROR, "All boundary conditions must be VACUUM for the "
+               "EigenmodeSolver");
+
+  /* Determine the size of the Krylov subspace */
+  int m = _num_arnoldi_vectors;
+  if (m == 0)
+    m = 2 * num_modes + 1;
+  if (m < num_modes + 2)
+    log_printf(ERROR, "Unable to compute %d eigenmodes with %d Arnoldi "
+               "vectors, at least %d are required", num_modes, m,
+               num_modes + 2);
+
+  /* Initialize the MOC solver, negative fluxes are part of higher modes */
+  _solver->allowNegativeFluxes(true);
+  _solver->initializeSolver(solver_mode);
+  _size = geometry->getNumFSRs() * _solver->getNumEnergyGroups();
+  double global_size = _size;
+  reduce(&global_size, 1);
+  if (m > global_size)
+    log_printf(ERROR, "Unable to use %d Arnoldi vectors for %.0f fluxes",
+               m, global_size);
+
+  log_printf(NORMAL, "Computing %d eigenmodes with %d Arnoldi vectors...",
+             num_modes, m);
+
+  Timer timer;
+  timer.startTimer();
+  _num_modes = num_modes;
+  _num_restarts = 0;
+  _converged = false;
+  _num_fission_sweeps = 0;
+  _num_scatter_sweeps = 0;
+  _gmres_basis.resize((_num_gmres_vectors + 1) * _size);
+
+  /* Arnoldi vectors, the last one is the normalized residual */
+  long n = _size;
+  std::vector<double> V((m + 1) * n);
+  std::vector<double> H(m * m, 0.);
+  std::vector<double> h(m);
+  std::vector<std::complex<double> > ritz(m);
+  std::vector<std::complex<double> > y(m);
+
+  /* Start from a flat flux */
+  double* v0 = &V[0];
+  double norm = 1. / sqrt(global_size);
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < n; i++)
+    v0[i] = norm;
+
+  int num_vectors = 0;
+  double beta = 0.;
+  while (true) {
+
+    /* Extend the Arnoldi factorization to m vectors */
+    for (int j=num_vectors; j < m; j++) {
+      double* w = &V[(j+1) * n];
+      applyOperator(&V[j * n], w);
+      beta = orthogonalize(&V[0], j+1, w, &h[0]);
+      for (int i=0; i <= j; i++)
+        H[i*m + j] = h[i];
+      if (j+1 < m)
+        H[(j+1)*m + j] = beta;
+      if (beta > 0.) {
+#pragma omp parallel for schedule(static)
+        for (long i=0; i < n; i++)
+          w[i] /= beta;
+      }
+    }
+
+    /* Compute the Ritz values in order of decreasing magnitude */
+    computeHessenbergEigenvalues(H, m, ritz);
+
+    /* Keep complex conjugate pairs together in the wanted set */
+    int num_wanted = num_modes;
+    int num_conjugates = 0;
+    for (int i=0; i < num_modes; i++)
+      num_conjugates += (ritz[i].imag() > 0.) - (ritz[i].imag() < 0.);
+    if (num_conjugates != 0)
+      num_wanted++;
+
+    /* Check the Ritz estimates of the wanted eigenpairs, including the
+       conjugate of a complex pair split by the last requested mode */
+    double max_error = 0.;
+    for (int i=0; i < num_wanted; i++) {
+      computeHessenbergEigenvector(H, m, ritz[i], y);
+      double error = beta * std::abs(y[m-1]) / std::abs(ritz[i]);
+      max_error = std::max(max_error, error);
+    }
+    log_printf(NORMAL, "Arnoldi restart %d: k = %.6f  max Ritz estimate = "
+               "%.3E", _num_restarts, ritz[0].real(), max_error);
+
+    _converged = (max_error < _tolerance);
+    if (_converged)
+      break;
+    if (_num_restarts == _max_restarts || num_wanted + 1 >= m) {
+      log_printf(WARNING, "Unable to converge the eigenmodes in %d "
+                 "restarts", _num_restarts);
+      break;
+    }
+
+    /* Filter the unwanted Ritz values out of the subspace */
+    std::vector<double> Q(m * m, 0.);
+    for (int i=0; i < m; i++)
+      Q[i*m + i] = 1.;
+    for (int i=num_wanted; i < m; i++)
+      if (ritz[i].imag() >= 0.)
+        applyShifts(H, Q, m, ritz[i]);
+
+    /* Compress the basis: V <- V Q and the residual of the new factorization
+       f = (V Q)_k H_{k,k-1} + beta v_m Q_{m-1,k-1} is stored in v_m */
+    int k = num_wanted;
+    double h_k = H[k*m + k-1];
+    double sigma = beta * Q[(m-1)*m + k-1];
+    double* v_m = &V[m * n];
+#pragma omp parallel
+    {
+      std::vector<double> row(k + 1);
+
+#pragma omp for schedule(static)
+      for (long i=0; i < n; i++) {
+        for (int c=0; c <= k; c++) {
+          double sum = 0.;
+          for (int j=0; j < m; j++)
+            sum += V[j*n + i] * Q[j*m + c];
+          row[c] = sum;
+        }
+        for (int c=0; c < k; c++)
+          V[c*n + i] = row[c];
+        v_m[i] = row[k] * h_k + sigma * v_m[i];
+      }
+    }
+
+    /* Normalize the residual as the next Arnoldi vector */
+    beta = sqrt(dot(v_m, v_m));
+    double* v_k = &V[k * n];
+#pragma omp parallel for schedule(static)
+    for (long i=0; i < n; i++)
+      v_k[i] = (beta > 0.) ? v_m[i] / beta : 0.;
+
+    /* Truncate the Hessenberg matrix to the wanted block */
+    for (int i=0; i < m; i++)
+      for (int j=0; j < m; j++)
+        if (i > k || j >= k)
+          H[i*m + j] = 0.;
+    H[k*m + k-1] = beta;
+
+    num_vectors = k;
+    _num_restarts++;
+  }
+
+  /* Compute the eigenmodes from the Ritz vectors */
+  _eigenvalues.assign(ritz.begin(), ritz.begin() + num_modes);
+  _eigenmodes.resize(num_modes * n);
+  for (int mode=0; mode < num_modes; mode++) {
+
+    /* Rotate the Ritz vector so its largest component is real */
+    computeHessenbergEigenvector(H, m, ritz[mode], y);
+    int max_index = 0;
+    for (int j=1; j < m; j++)
+      if (std::abs(y[j]) > std::abs(y[max_index]))
+        max_index = j;
+    std::complex<double> phase = std::conj(y[max_index]) /
+        std::abs(y[max_index]);
+
+    double* mode_flux = &_eigenmodes[mode * n];
+#pragma omp parallel for schedule(static)
+    for (long i=0; i < n; i++) {
+      double sum = 0.;
+      for (int j=0; j < m; j++)
+        sum += V[j*n + i] * (phase * y[j]).real();
+      mode_flux[i] = sum;
+    }
+
+    /* Normalize the mode with a positive sum */
+    double sum = 0.;
+    for (long i=0; i < n; i++)
+      sum += mode_flux[i];
+    reduce(&sum, 1);
+    norm = sqrt(dot(mode_flux, mode_flux));
+    if (sum < 0.)
+      norm = -norm;
+#pragma omp parallel for schedule(static)
+    for (long i=0; i < n; i++)
+      mode_flux[i] /= norm;
+  }
+
+  /* Restore the material data */
+  _solver->resetMaterials(solver_mode);
+  _gmres_basis.clear();
+
+  timer.stopTimer();
+  double tot_time = timer.getTime();
+  std::string msg_string = "Total time to solution";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), tot_time);
+  msg_string = "Solution time per mode";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), tot_time / num_modes);
+  log_printf(RESULT, "Fission / scattering operator sweeps = %d / %d",
+             _num_fission_sweeps, _num_scatter_sweeps);
+  for (int mode=0; mode < num_modes; mode++)
+    log_printf(RESULT, "Eigenvalue %d = %.6f %+.6fi", mode,
+               _eigenvalues[mode].real(), _eigenvalues[mode].imag());
+}
+
+
+/**
+ * @brief Applies the fission operator, a transport sweep of the fission
+ *        source of a flux, in place on the Solver's scalar flux.
+ * @param x the flux
+ * @param y the swept flux
+ */
+void EigenmodeSolver::applyFissionOperator(double* x, double* y) {
+
+  FP_PRECISION* flux = _solver->getFluxesArray();
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < _size; i++)
+    flux[i] = x[i];
+
+  _solver->fissionTransportSweep();
+  _num_fission_sweeps++;
+
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < _size; i++)
+    y[i] = flux[i];
+}
+
+
+/**
+ * @brief Applies the scattering operator \f$ I - T_S \f$ in place on the
+ *        Solver's scalar flux.
+ * @param x the flux
+ * @param y the flux minus the transport sweep of its scattering source
+ */
+void EigenmodeSolver::applyScatterOperator(double* x, double* y) {
+
+  FP_PRECISION* flux = _solver->getFluxesArray();
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < _size; i++)
+    flux[i] = x[i];
+
+  _solver->scatterTransportSweep();
+  _num_scatter_sweeps++;
+
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < _size; i++)
+    y[i] = x[i] - flux[i];
+}
+
+
+/**
+ * @brief Applies \f$ (I - T_S)^{-1} T_F \f$ to a flux.
+ * @param x the flux
+ * @param y the result, which may not alias x
+ */
+void EigenmodeSolver::applyOperator(double* x, double* y) {
+  double* b = &_gmres_basis[0];
+  applyFissionOperator(x, b);
+  std::vector<double> rhs(b, b + _size);
+  solveScatterSystem(&rhs[0], y);
+}
+
+
+/**
+ * @brief Solves \f$ (I - T_S) x = b \f$ with restarted GMRES from a zero
+ *        initial guess.
+ * @param b the right hand side
+ * @param x the solution
+ */
+void EigenmodeSolver::solveScatterSystem(double* b, double* x) {
+
+  int m = _num_gmres_vectors;
+  long n = _size;
+  double* W = &_gmres_basis[0];
+  std::vector<double> H((m + 1) * m, 0.);
+  std::vector<double> cs(m), sn(m), g(m + 1), h(m + 1), y(m);
+
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < n; i++) {
+    x[i] = 0.;
+    W[i] = b[i];
+  }
+
+  double b_norm = sqrt(dot(b, b));
+  if (b_norm == 0.)
+    return;
+
+  double beta = b_norm;
+  double residual = b_norm;
+  int num_iterations = 0;
+  while (true) {
+
+    /* Normalize the residual as the first Krylov vector */
+#pragma omp parallel for schedule(static)
+    for (long i=0; i < n; i++)
+      W[i] /= beta;
+    std::fill(g.begin(), g.end(), 0.);
+    g[0] = beta;
+
+    int num_vectors = 0;
+    for (int j=0; j < m; j++) {
+
+      double* w = &W[(j+1) * n];
+      applyScatterOperator(&W[j * n], w);
+      num_iterations++;
+      double h_next = orthogonalize(W, j+1, w, &h[0]);
+
+      /* Apply the previous Givens rotations to the new column */
+      for (int i=0; i <= j; i++)
+        H[i*m + j] = h[i];
+      for (int i=0; i < j; i++) {
+        double t = cs[i] * H[i*m + j] + sn[i] * H[(i+1)*m + j];
+        H[(i+1)*m + j] = -sn[i] * H[i*m + j] + cs[i] * H[(i+1)*m + j];
+        H[i*m + j] = t;
+      }
+
+      /* Rotate out the subdiagonal entry */
+      double r = sqrt(H[j*m + j] * H[j*m + j] + h_next * h_next);
+      cs[j] = (r > 0.) ? H[j*m + j] / r : 1.;
+      sn[j] = (r > 0.) ? h_next / r : 0.;
+      H[j*m + j] = r;
+      g[j+1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+      residual = std::abs(g[j+1]);
+      num_vectors = j + 1;
+
+      if (h_next > 0.) {
+#pragma omp parallel for schedule(static)
+        for (long i=0; i < n; i++)
+          w[i] /= h_next;
+      }
+
+      if (residual <= _inner_tolerance * b_norm || h_next == 0. ||
+          num_iterations >= _max_inner_iterations)
+        break;
+    }
+
+    /* Update the solution with the least squares coefficients */
+    for (int i=num_vectors-1; i >= 0; i--) {
+      y[i] = g[i];
+      for (int j=i+1; j < num_vectors; j++)
+        y[i] -= H[i*m + j] * y[j];
+      y[i] /= H[i*m + i];
+    }
+#pragma omp parallel for schedule(static)
+    for (long i=0; i < n; i++)
+      for (int j=0; j < num_vectors; j++)
+        x[i] += W[j*n + i] * y[j];
+
+    if (residual <= _inner_tolerance * b_norm)
+      break;
+    if (num_iterations >= _max_inner_iterations) {
+      log_printf(WARNING, "Unable to converge the scattering operator solve "
+                 "in %d iterations, relative residual = %.3E",
+                 num_iterations, residual / b_norm);
+      break;
+    }
+
+    /* Restart from the true residual */
+    applyScatterOperator(x, W);
+    num_iterations++;
+#pragma omp parallel for schedule(static)
+    for (long i=0; i < n; i++)
+      W[i] = b[i] - W[i];
+    beta = sqrt(dot(W, W));
+    if (beta <= _inner_tolerance * b_norm)
+      break;
+  }
+}
+
+
+/**
+ * @brief Computes the dot product of two distributed vectors.
+ * @param x the first vector
+ * @param y the second vector
+ * @return the dot product over all domains
+ */
+double EigenmodeSolver::dot(double* x, double* y) {
+
+  double sum = 0.;
+#pragma omp parallel for schedule(static) reduction(+:sum)
+  for (long i=0; i < _size; i++)
+    sum += x[i] * y[i];
+
+  reduce(&sum, 1);
+  return sum;
+}
+
+
+/**
+ * @brief Orthogonalizes a vector against an orthonormal basis with two
+ *        passes of classical Gram-Schmidt.
+ * @details Each pass computes all the projections in a single threaded sweep
+ *          over the vectors and a single reduction across domains.
+ * @param basis the orthonormal basis vectors, stored contiguously
+ * @param num_vectors the number of basis vectors
+ * @param w the vector to orthogonalize
+ * @param h the projections of the vector on the basis
+ * @return the norm of the orthogonalized vector
+ */
+double EigenmodeSolver::orthogonalize(double* basis, int num_vectors,
+                                      double* w, double* h) {
+
+  long n = _size;
+  int num_threads = 1;
+  std::vector<double> c(num_vectors);
+  std::vector<double> thread_sums;
+  std::fill(h, h + num_vectors, 0.);
+
+  for (int pass=0; pass < 2; pass++) {
+
+    /* Project onto the basis, summing the threads in a fixed order */
+#pragma omp parallel
+    {
+#pragma omp single
+      {
+        num_threads = omp_get_num_threads();
+        thread_sums.assign(num_threads * num_vectors, 0.);
+      }
+
+      double* sums = &thread_sums[omp_get_thread_num() * num_vectors];
+#pragma omp for schedule(static)
+      for (long i=0; i < n; i++)
+        for (int k=0; k < num_vectors; k++)
+          sums[k] += basis[k*n + i] * w[i];
+    }
+    for (int k=0; k < num_vectors; k++) {
+      c[k] = 0.;
+      for (int t=0; t < num_threads; t++)
+        c[k] += thread_sums[t * num_vectors + k];
+    }
+    reduce(&c[0], num_vectors);
+
+    /* Remove the projections */
+#pragma omp parallel for schedule(static)
+    for (long i=0; i < n; i++)
+      for (int k=0; k < num_vectors; k++)
+        w[i] -= basis[k*n + i] * c[k];
+
+    for (int k=0; k < num_vectors; k++)
+      h[k] += c[k];
+  }
+
+  return sqrt(dot(w, w));
+}
+
+
+/**
+ * @brief Sums values across all domains.
+ * @param values the values to sum in place
+ * @param num_values the number of values
+ */
+void EigenmodeSolver::reduce(double* values, int num_values) {
+#ifdef MPIx
+  Geometry* geometry = _solver->getGeometry();
+  if (geometry->isDomainDecomposed())
+    MPI_Allreduce(MPI_IN_PLACE, values, num_values, MPI_DOUBLE, MPI_SUM,
+                  geometry->getMPICart());
+#endif
+}
+
+
+/**
+ * @brief Computes the eigenvalues of an upper Hessenberg matrix with the
+ *        shifted QR algorithm.
+ * @details Eigenvalues are sorted by decreasing magnitude, complex conjugate
+ *          pairs with the positive imaginary part first. Imaginary parts at
+ *          the level of round-off are set to zero.
+ * @param H the row-major Hessenberg matrix
+ * @param n the size of the matrix
+ * @param eigs the eigenvalues
+ */
+void EigenmodeSolver::computeHessenbergEigenvalues(std::vector<double>& H,
+    int n, std::vector<std::complex<double> >& eigs) {
+
+  typedef std::complex<double> complex;
+  std::vector<complex> A(H.begin(), H.begin() + n * n);
+  double eps = std::numeric_limits<double>::epsilon();
+
+  double h_norm = 0.;
+  for (int i=0; i < n * n; i++)
+    h_norm = std::max(h_norm, std::abs(A[i]));
+
+  int hi = n - 1;
+  int num_iterations = 0;
+  while (hi >= 0) {
+
+    /* Find the start of the unreduced block ending at hi */
+    int lo = hi;
+    while (lo > 0) {
+      double scale = std::abs(A[(lo-1)*n + lo-1]) + std::abs(A[lo*n + lo]);
+      if (scale == 0.)
+        scale = h_norm;
+      if (std::abs(A[lo*n + lo-1]) <= eps * scale)
+        break;
+      lo--;
+    }
+
+    /* Deflate a converged eigenvalue */
+    if (lo == hi) {
+      eigs[hi] = A[hi*n + hi];
+      hi--;
+      num_iterations = 0;
+      continue;
+    }
+
+    if (++num_iterations > 100 * n)
+      log_printf(ERROR, "Unable to compute the Ritz values of the Arnoldi "
+                 "factorization");
+
+    /* Wilkinson shift from the trailing 2x2 block, exceptional shifts are
+       used to break cycles */
+    complex a = A[(hi-1)*n + hi-1];
+    complex b = A[(hi-1)*n + hi];
+    complex c = A[hi*n + hi-1];
+    complex d = A[hi*n + hi];
+    complex shift;
+    if (num_iterations % 11 == 10)
+      shift = d + std::abs(c);
+    else {
+      complex half_trace = (a + d) / 2.;
+      complex disc = std::sqrt(half_trace * half_trace - (a * d - b * c));
+      complex mu_1 = half_trace + disc;
+      complex mu_2 = half_trace - disc;
+      shift = (std::abs(mu_1 - d) < std::abs(mu_2 - d)) ? mu_1 : mu_2;
+    }
+
+    /* QR step on the active block with Givens rotations */
+    for (int k=lo; k <= hi; k++)
+      A[k*n + k] -= shift;
+
+    std::vector<double> cs(hi - lo);
+    std::vector<complex> sn(hi - lo);
+    for (int k=lo; k < hi; k++) {
+      complex x = A[k*n + k];
+      complex y = A[(k+1)*n + k];
+      double r = sqrt(std::norm(x) + std::norm(y));
+      double c_k = (r > 0.) ? std::abs(x) / r : 1.;
+      complex s_k = 0.;
+      if (r > 0.)
+        s_k = (std::abs(x) > 0.) ? (x / std::abs(x)) * std::conj(y) / r : 1.;
+      cs[k-lo] = c_k;
+      sn[k-lo] = s_k;
+      for (int j=k; j <= hi; j++) {
+        complex u = A[k*n + j];
+        complex v = A[(k+1)*n + j];
+        A[k*n + j] = c_k * u + s_k * v;
+        A[(k+1)*n + j] = -std::conj(s_k) * u + c_k * v;
+      }
+    }
+    for (int k=lo; k < hi; k++) {
+      double c_k = cs[k-lo];
+      complex s_k = sn[k-lo];
+      for (int i=lo; i <= std::min(k+1, hi); i++) {
+        complex u = A[i*n + k];
+        complex v = A[i*n + k+1];
+        A[i*n + k] = c_k * u + std::conj(s_k) * v;
+        A[i*n + k+1] = -s_k * u + c_k * v;
+      }
+    }
+
+    for (int k=lo; k <= hi; k++)
+      A[k*n + k] += shift;
+  }
+
+  /* Remove round-off imaginary parts and sort by decreasing magnitude */
+  for (int i=0; i < n; i++)
+    if (std::abs(eigs[i].imag()) <= 1E-8 * std::abs(eigs[i]))
+      eigs[i] = eigs[i].real();
+
+  for (int i=1; i < n; i++) {
+    complex eig = eigs[i];
+    int j = i;
+    while (j > 0 && (std::abs(eigs[j-1]) < std::abs(eig) ||
+                     (std::abs(eigs[j-1]) == std::abs(eig) &&
+                      eigs[j-1].imag() < eig.imag()))) {
+      eigs[j] = eigs[j-1];
+      j--;
+    }
+    eigs[j] = eig;
+  }
+}
+
+
+/**
+ * @brief Computes the normalized eigenvector of an upper Hessenberg matrix
+ *        for one of its eigenvalues by inverse iteration.
+ * @param H the row-major Hessenberg matrix
+ * @param n the size of the matrix
+ * @param eig the eigenvalue
+ * @param y the eigenvector
+ */
+void EigenmodeSolver::computeHessenbergEigenvector(std::vector<double>& H,
+    int n, std::complex<double> eig, std::vector<std::complex<double> >& y) {
+
+  typedef std::complex<double> complex;
+  double eps = std::numeric_limits<double>::epsilon();
+
+  double h_norm = 0.;
+  for (int i=0; i < n * n; i++)
+    h_norm = std::max(h_norm, std::abs(H[i]));
+  double perturbation = std::max(h_norm, std::abs(eig)) * eps * n;
+  if (perturbation == 0.)
+    perturbation = eps;
+
+  /* LU factorization of the shifted matrix with partial pivoting */
+  std::vector<complex> LU(n * n);
+  std::vector<int> pivots(n);
+  for (int i=0; i < n * n; i++)
+    LU[i] = H[i];
+  for (int i=0; i < n; i++)
+    LU[i*n + i] -= eig;
+
+  for (int k=0; k < n; k++) {
+    int p = k;
+    for (int i=k+1; i < n; i++)
+      if (std::abs(LU[i*n + k]) > std::abs(LU[p*n + k]))
+        p = i;
+    pivots[k] = p;
+    if (p != k)
+      for (int j=0; j < n; j++)
+        std::swap(LU[k*n + j], LU[p*n + j]);
+    if (std::abs(LU[k*n + k]) < perturbation)
+      LU[k*n + k] = perturbation;
+    for (int i=k+1; i < n; i++) {
+      LU[i*n + k] /= LU[k*n + k];
+      for (int j=k+1; j < n; j++)
+        LU[i*n + j] -= LU[i*n + k] * LU[k*n + j];
+    }
+  }
+
+  /* Inverse iterations from a flat vector */
+  std::fill(y.begin(), y.begin() + n, complex(1.));
+  for (int iteration=0; iteration < 3; iteration++) {
+
+    for (int k=0; k < n; k++) {
+      std::swap(y[k], y[pivots[k]]);
+      for (int i=k+1; i < n; i++)
+        y[i] -= LU[i*n + k] * y[k];
+    }
+    for (int i=n-1; i >= 0; i--) {
+      for (int j=i+1; j < n; j++)
+        y[i] -= LU[i*n + j] * y[j];
+      y[i] /= LU[i*n + i];
+    }
+
+    double norm = 0.;
+    for (int i=0; i < n; i++)
+      norm += std::norm(y[i]);
+    norm = sqrt(norm);
+    for (int i=0; i < n; i++)
+      y[i] /= norm;
+  }
+}
+
+
+/**
+ * @brief Applies an implicit QR step with a shift to the Hessenberg matrix
+ *        of the Arnoldi factorization.
+ * @details A real shift is applied with Givens rotations. A complex shift is
+ *          applied together with its conjugate in a double-shift step with
+ *          Householder reflectors, so that all quantities remain real. The
+ *          orthogonal transformations are accumulated in Q.
+ * @param H the row-major Hessenberg matrix
+ * @param Q the accumulated orthogonal transformation
+ * @param n the size of the matrices
+ * @param shift the shift
+ */
+void EigenmodeSolver::applyShifts(std::vector<double>& H,
+                                  std::vector<double>& Q, int n,
+                                  std::complex<double> shift) {
+
+  if (shift.imag() == 0.) {
+
+    /* Bulge chase with Givens rotations */
+    double x = H[0] - shift.real();
+    double y = H[n];
+    for (int k=0; k < n-1; k++) {
+
+      double r = sqrt(x * x + y * y);
+      double c = (r > 0.) ? x / r : 1.;
+      double s = (r > 0.) ? y / r : 0.;
+
+      for (int j=std::max(0, k-1); j < n; j++) {
+        double u = H[k*n + j];
+        double v = H[(k+1)*n + j];
+        H[k*n + j] = c * u + s * v;
+        H[(k+1)*n + j] = -s * u + c * v;
+      }
+      if (k > 0)
+        H[(k+1)*n + k-1] = 0.;
+      for (int i=0; i <= std::min(k+2, n-1); i++) {
+        double u = H[i*n + k];
+        double v = H[i*n + k+1];
+        H[i*n + k] = c * u + s * v;
+        H[i*n + k+1] = -s * u + c * v;
+      }
+      for (int i=0; i < n; i++) {
+        double u = Q[i*n + k];
+        double v = Q[i*n + k+1];
+        Q[i*n + k] = c * u + s * v;
+        Q[i*n + k+1] = -s * u + c * v;
+      }
+
+      if (k < n-2) {
+        x = H[(k+1)*n + k];
+        y = H[(k+2)*n + k];
+      }
+    }
+  }
+  else {
+
+    /* First column of (H - shift I)(H - conj(shift) I) */
+    double s = 2. * shift.real();
+    double t = std::norm(shift);
+    double x = H[0] * H[0] + H[1] * H[n] - s * H[0] + t;
+    double y = H[n] * (H[0] + H[n+1] - s);
+    double z = (n > 2) ? H[n] * H[2*n + 1] : 0.;
+
+    /* Bulge chase with Householder reflectors */
+    for (int k=0; k < n-1; k++) {
+
+      int nr = std::min(3, n-k);
+      double norm = sqrt(x * x + y * y + (nr == 3 ? z * z : 0.));
+      double alpha = (x > 0.) ? -norm : norm;
+      double v[3] = {x - alpha, y, (nr == 3) ? z : 0.};
+      double vtv = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+
+      if (vtv > 0.) {
+        for (int j=std::max(0, k-1); j < n; j++) {
+          double d = 0.;
+          for (int p=0; p < nr; p++)
+            d += v[p] * H[(k+p)*n + j];
+          d *= 2. / vtv;
+          for (int p=0; p < nr; p++)
+            H[(k+p)*n + j] -= d * v[p];
+        }
+        if (k > 0)
+          for (int p=1; p < nr; p++)
+            H[(k+p)*n + k-1] = 0.;
+        for (int i=0; i <= std::min(k+3, n-1); i++) {
+          double d = 0.;
+          for (int p=0; p < nr; p++)
+            d += H[i*n + k+p] * v[p];
+          d *= 2. / vtv;
+          for (int p=0; p < nr; p++)
+            H[i*n + k+p] -= d * v[p];
+        }
+        for (int i=0; i < n; i++) {
+          double d = 0.;
+          for (int p=0; p < nr; p++)
+            d += Q[i*n + k+p] * v[p];
+          d *= 2. / vtv;
+          for (int p=0; p < nr; p++)
+            Q[i*n + k+p] -= d * v[p];
+        }
+      }
+
+      if (k < n-2) {
+        x = H[(k+1)*n + k];
+        y = H[(k+2)*n + k];
+        z = (k < n-3) ? H[(k+3)*n + k] : 0.;
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Returns the number of computed eigenmodes.
+ * @return the number of eigenmodes
+ */
+int EigenmodeSolver::getNumModes() {
+  return _num_modes;
+}
+
+
+/**
+ * @brief Returns the number of implicit restarts of the last calculation.
+ * @return the number of restarts
+ */
+int EigenmodeSolver::getNumRestarts() {
+  return _num_restarts;
+}
+
+
+/**
+ * @brief Returns whether the Ritz estimates of the wanted eigenpairs met the
+ *        tolerance in the last calculation.
+ * @return whether the eigenmodes converged
+ */
+bool EigenmodeSolver::isConverged() {
+  return _converged;
+}
+
+
+/**
+ * @brief Returns the number of fission operator sweeps of the last
+ *        calculation.
+ * @return the number of fission operator sweeps
+ */
+int EigenmodeSolver::getNumFissionSweeps() {
+  return _num_fission_sweeps;
+}
+
+
+/**
+ * @brief Returns the number of scattering operator sweeps of the last
+ *        calculation.
+ * @return the number of scattering operator sweeps
+ */
+int EigenmodeSolver::getNumScatterSweeps() {
+  return _num_scatter_sweeps;
+}
+
+
+/**
+ * @brief Returns the real part of an eigenvalue.
+ * @param mode the index of the mode, 0 for the fundamental mode
+ * @return the real part of the eigenvalue
+ */
+double EigenmodeSolver::getEigenvalue(int mode) {
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenvalue %d, %d eigenmodes were "
+               "computed", mode, _num_modes);
+  return _eigenvalues[mode].real();
+}
+
+
+/**
+ * @brief Returns the imaginary part of an eigenvalue.
+ * @param mode the index of the mode, 0 for the fundamental mode
+ * @return the imaginary part of the eigenvalue
+ */
+double EigenmodeSolver::getEigenvalueImag(int mode) {
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenvalue %d, %d eigenmodes were "
+               "computed", mode, _num_modes);
+  return _eigenvalues[mode].imag();
+}
+
+
+/**
+ * @brief Returns the flux of an eigenmode in an FSR and energy group.
+ * @details Eigenmodes are normalized to a unit norm with a positive sum. The
+ *          real part is returned for complex eigenmodes.
+ * @param mode the index of the mode, 0 for the fundamental mode
+ * @param fsr_id the FSR ID
+ * @param group the energy group, starting at 1
+ * @return the eigenmode flux
+ */
+double EigenmodeSolver::getEigenmodeFlux(int mode, long fsr_id, int group) {
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenmode %d, %d eigenmodes were "
+               "computed", mode, _num_modes);
+  int num_groups = _solver->getNumEnergyGroups();
+  if (group <= 0 || group > num_groups)
+    log_printf(ERROR, "Unable to get the eigenmode flux in group %d, which "
+               "is not between 1 and %d", group, num_groups);
+  if (fsr_id < 0 || fsr_id * num_groups >= _size)
+    log_printf(ERROR, "Unable to get the eigenmode flux in FSR %ld", fsr_id);
+  return _eigenmodes[mode * _size + fsr_id * num_groups + group - 1];
+}
+
+
+/**
+ * @brief Copies an eigenmode into an array indexed by FSR and group.
+ * @details This may be called from Python to retrieve a NumPy array:
+ *
+ * @code
+ *          num_fluxes = geometry.getNumFSRs() * geometry.getNumEnergyGroups()
+ *          mode = eigenmode_solver.getEigenmode(1, num_fluxes)
+ * @endcode
+ *
+ * @param mode the index of the mode, 0 for the fundamental mode
+ * @param eigenmode the array of fluxes to fill
+ * @param num_fluxes the number of fluxes, FSRs times energy groups
+ */
+void EigenmodeSolver::getEigenmode(int mode, double* eigenmode,
+                                   int num_fluxes) {
+  if (mode < 0 || mode >= _num_modes)
+    log_printf(ERROR, "Unable to get eigenmode %d, %d eigenmodes were "
+               "computed", mode, _num_modes);
+  if (num_fluxes != _size)
+    log_printf(ERROR, "Unable to get eigenmode %d of %ld fluxes in an array "
+               "of %d fluxes", mode, _size, num_fluxes);
+  std::copy(&_eigenmodes[mode * _size], &_eigenmodes[mode * _size] + _size,
+            eigenmode);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file EigenmodeSolver.h
+ * @brief The EigenmodeSolver class.
+ * @date October 18, 2026
+ */
+
+#ifndef EIGENMODESOLVER_H_
+#define EIGENMODESOLVER_H_
+
+#ifdef __cplusplus
+#include "Solver.h"
+#include <complex>
+#include <limits>
+#endif
+
+
+/**
+ * @class EigenmodeSolver EigenmodeSolver.h "src/EigenmodeSolver.h"
+ * @brief Computes the dominant eigenmodes of a criticality problem with the
+ *        implicitly restarted Arnoldi method.
+ * @details The eigenvalues k of the problem are those of the operator
+ *          \f$ (I - T_S)^{-1} T_F \f$, where \f$ T_S \f$ and \f$ T_F \f$ are
+ *          transport sweeps of the scattering and fission sources of a flux.
+ *          The operators are applied in place on the scalar flux of the
+ *          Solver, and the inverse is applied with restarted GMRES. Krylov
+ *          vectors are distributed like the scalar flux with domain
+ *          decomposition. Only vacuum boundary conditions are supported, since
+ *          the sweeps are otherwise not linear operators of the flux.
+ */
+class EigenmodeSolver {
+
+private:
+
+  /** The Solver whose transport sweeps define the operators */
+  Solver* _solver;
+
+  /** The number of local scalar fluxes, i.e. FSRs times energy groups */
+  long _size;
+
+  /** The number of eigenmodes to compute */
+  int _num_modes;
+
+  /** The number of Arnoldi vectors, 0 to use twice the number of modes */
+  int _num_arnoldi_vectors;
+
+  /** The number of GMRES vectors between restarts of the inner solves */
+  int _num_gmres_vectors;
+
+  /** The relative tolerance on the Ritz estimates of the eigenpairs */
+  double _tolerance;
+
+  /** The relative residual tolerance of the inner GMRES solves */
+  double _inner_tolerance;
+
+  /** The maximum number of implicit restarts */
+  int _max_restarts;
+
+  /** The maximum number of scattering operator applications per solve */
+  int _max_inner_iterations;
+
+  /** The number of implicit restarts of the last calculation */
+  int _num_restarts;
+
+  /** Whether the eigenpairs of the last calculation converged */
+  bool _converged;
+
+  /** The number of fission and scattering operator applications */
+  int _num_fission_sweeps;
+  int _num_scatter_sweeps;
+
+  /** The eigenvalues in order of decreasing magnitude */
+  std::vector<std::complex<double> > _eigenvalues;
+
+  /** The eigenmodes indexed by mode, FSR and group */
+  std::vector<double> _eigenmodes;
+
+  /** The Krylov vectors of the inner GMRES solves */
+  std::vector<double> _gmres_basis;
+
+  /* Operators */
+  void applyFissionOperator(double* x, double* y);
+  void applyScatterOperator(double* x, double* y);
+  void applyOperator(double* x, double* y);
+  void solveScatterSystem(double* b, double* x);
+
+  /* Distributed and threaded vector kernels */
+  double dot(double* x, double* y);
+  double orthogonalize(double* basis, int num_vectors, double* w, double* h);
+  void reduce(double* values, int num_values);
+
+  /* Dense kernels on the projected Hessenberg matrix */
+  void computeHessenbergEigenvalues(std::vector<double>& H, int n,
+                                    std::vector<std::complex<double> >& eigs);
+  void computeHessenbergEigenvector(std::vector<double>& H, int n,
+                                    std::complex<double> eig,
+                                    std::vector<std::complex<double> >& y);
+  void applyShifts(std::vector<double>& H, std::vector<double>& Q, int n,
+                   std::complex<double> shift);
+
+public:
+
+  EigenmodeSolver(Solver* solver);
+  virtual ~EigenmodeSolver();
+
+  void setNumArnoldiVectors(int num_vectors);
+  void setNumGMRESVectors(int num_vectors);
+  void setConvergenceThreshold(double tolerance);
+  void setInnerConvergenceThreshold(double tolerance);
+  void setMaxRestarts(int max_restarts);
+  void setMaxInnerIterations(int max_iterations);
+
+  void computeEigenmodes(solverMode solver_mode=FORWARD, int num_modes=5);
+
+  int getNumModes();
+  int getNumRestarts();
+  bool isConverged();
+  int getNumFissionSweeps();
+  int getNumScatterSweeps();
+  double getEigenvalue(int mode);
+  double getEigenvalueImag(int mode);
+  double getEigenmodeFlux(int mode, long fsr_id, int group);
+  void getEigenmode(int mode, double* eigenmode, int num_fluxes);
+};
+
+
+#endif /* EIGENMODESOLVER_H_ */
@@ -30,6 +30,7 @@ ExpEvaluator::ExpEvaluator() {
 ExpEvaluator::~ExpEvaluator() {
   if (_exp_table != NULL)
     free(_exp_table);
+  release_memory(this);
 }
 
 
@@ -257,6 +258,8 @@ void ExpEvaluator::initialize(int azim_index, int polar_index, bool solve_3D) {
 
   /* Allocate array for the table */
   _table_size = num_array_values * _num_exp_terms * _num_polar_terms;
+  account_memory(this, "interpolation table", EXP_TABLE_MEMORY,
+                 _table_size * sizeof(FP_PRECISION));
   _exp_table = (FP_PRECISION*) memalign(VEC_ALIGNMENT, 
                _table_size * sizeof(FP_PRECISION));
 
@@ -11,6 +11,7 @@
 #ifdef __cplusplus
 #define _USE_MATH_DEFINES
 #include "log.h"
+#include "memory_accounting.h"
 #include "Quadrature.h"
 #include <malloc.h>
 #include <math.h>
@@ -83,10 +83,6 @@ Geometry::~Geometry() {
 
     ExtrudedFSR **extruded_fsrs = _extruded_FSR_keys_map.values();
     for (int i=0; i<_extruded_FSR_keys_map.size(); i++) {
-      if (extruded_fsrs[i]->_mesh != NULL)
-        delete [] extruded_fsrs[i]->_mesh;
-      delete [] extruded_fsrs[i]->_fsr_ids;
-      delete [] extruded_fsrs[i]->_materials;
       delete extruded_fsrs[i]->_coords;
       delete extruded_fsrs[i];
     }
@@ -99,6 +95,8 @@ Geometry::~Geometry() {
   }
   if (_overlaid_mesh != NULL)
     delete _overlaid_mesh;
+
+  release_memory(this);
 }
 
 
@@ -545,16 +543,7 @@ void Geometry::loadSPHFactors(double* sph_factors, int num_domains_groups,
       /* Use sph factors */
       double* sph = &sph_factors[i*num_groups];
 
-      for (int g=1; g<=num_groups; g++) {
-
-        mat->setSigmaTByGroup(mat->getSigmaTByGroup(g) * sph[g-1], g);
-        mat->setSigmaAByGroup(mat->getSigmaAByGroup(g) * sph[g-1], g);
-        mat->setSigmaFByGroup(mat->getSigmaFByGroup(g) * sph[g-1], g);
-        mat->setNuSigmaFByGroup(mat->getNuSigmaFByGroup(g) * sph[g-1], g);
-        for (int g2=1; g2<=num_groups; g2++) {
-          mat->setSigmaSByGroup(mat->getSigmaSByGroup(g, g2) * sph[g-1], g, g2);
-        }
-      }
+      mat->scaleCrossSections(sph, num_groups);
     }
   }
   /* SPH factors by cells */
@@ -576,16 +565,7 @@ void Geometry::loadSPHFactors(double* sph_factors, int num_domains_groups,
       /* Use sph factors */
       double* sph = &sph_factors[i*num_groups];
 
-      for (int g=1; g<=num_groups; g++) {
-
-        mat->setSigmaTByGroup(mat->getSigmaTByGroup(g) * sph[g-1], g);
-        mat->setSigmaAByGroup(mat->getSigmaAByGroup(g) * sph[g-1], g);
-        mat->setSigmaFByGroup(mat->getSigmaFByGroup(g) * sph[g-1], g);
-        mat->setNuSigmaFByGroup(mat->getNuSigmaFByGroup(g) * sph[g-1], g);
-        for (int g2=1; g2<=num_groups; g2++) {
-          mat->setSigmaSByGroup(mat->getSigmaSByGroup(g, g2) * sph[g-1], g, g2);
-        }
-      }
+      mat->scaleCrossSections(sph, num_groups);
     }
   }
 }
@@ -834,6 +814,48 @@ void Geometry::useSymmetry(bool X_symmetry, bool Y_symmetry, bool Z_symmetry) {
 }
 
 
+/**
+ * @brief Take into account a 90 degree rotational symmetry about the z-axis
+ *        through the center of the domain to reduce the problem domain.
+ * @details The domain is restricted to the quadrant with x and y above their
+ *          mid-planes, which are given ROTATIONAL boundary conditions.
+ */
+void Geometry::useRotationalSymmetry() {
+
+  if (_root_universe->getCells().size() > 1)
+    log_printf(ERROR, "To take advantage of the problem symmetries, use a root"
+               " universe AND a root cell to contain the CSG.");
+
+#ifdef ONLYVACUUMBC
+  log_printf(ERROR, "Using symmetries requires rotational boundary conditions"
+             ", re-compile without the ONLYVACUUMBC flag.");
+#endif
+
+  // Keep track of symmetries used
+  _symmetries[0] = true;
+  _symmetries[1] = true;
+
+  // Get center planes
+  double mid_x = (_root_universe->getMaxX() + _root_universe->getMinX()) / 2;
+  double mid_y = (_root_universe->getMaxY() + _root_universe->getMinY()) / 2;
+  XPlane* symX = new XPlane(mid_x);
+  YPlane* symY = new YPlane(mid_y);
+  symX->setBoundaryType(ROTATIONAL);
+  symY->setBoundaryType(ROTATIONAL);
+
+  // Add planes to root cell
+  Cell* root_cell = _root_universe->getCells().begin()->second;
+  root_cell->addSurface(+1, symX);
+  root_cell->addSurface(+1, symY);
+  log_printf(NORMAL, "Using rotational symmetry to restrict domain to [%.3f "
+             "%.3f] x [%.3f %.3f] cm", mid_x, _root_universe->getMaxX(),
+             mid_y, _root_universe->getMaxY());
+
+  // Reset boundaries to trigger boundary calculation again
+  _root_universe->resetBoundaries();
+}
+
+
 /**
  * @brief Get the symmetries used to restrict the domain
  * @return a boolean indicating if the symmetry along this axis is used
@@ -1157,14 +1179,42 @@ Material* Geometry::findFSRMaterial(long fsr_id) {
  * @return a pointer to a Cell if found, NULL if no Cell found
  */
 Cell* Geometry::findNextCell(LocalCoords* coords, double azim, double polar) {
+  Direction direction;
+  direction.setAngles(azim, polar);
+  return findNextCell(coords, &direction);
+}
+
+
+/**
+ * @brief Finds the next Cell for a LocalCoords object travelling along a
+ *        unit direction.
+ * @details The direction cosines are rotated by a matrix product when a
+ *          rotated Cell is crossed, so that no trigonometric function is
+ *          evaluated while tracing. Lattice distances use the cell indices
+ *          stored in the LocalCoords, and after a step only the levels below
+ *          the highest crossed Cell or Lattice cell boundary are searched
+ *          again, so that a ray steps between Lattice cells without
+ *          descending from the root Universe. If the LocalCoords is outside
+ *          the bounds of the Geometry or on the boundaries this method will
+ *          return NULL; otherwise it will return a pointer to the Cell that
+ *          the LocalCoords will reach next along its trajectory.
+ * @param coords pointer to a LocalCoords object
+ * @param direction the unit direction of the trajectory
+ * @return a pointer to a Cell if found, NULL if no Cell found
+ */
+Cell* Geometry::findNextCell(LocalCoords* coords, const Direction* direction) {
 
-  Cell* cell = NULL;
   double dist;
   double min_dist = std::numeric_limits<double>::infinity();
 
-  /* Save angles in case of a rotated cell */
-  double old_azim = azim;
-  double old_polar = polar;
+  /* Distances to the boundaries at each level of the nested universes */
+  double level_dist[LOCAL_COORDS_LEN];
+  int num_levels = 0;
+
+  /* Direction in the frame of the current universe level, which differs
+   * from the track direction below a rotated cell */
+  const Direction* level_direction = direction;
+  Direction rotated_direction;
 
   /* Get highest level coords */
   coords = coords->getHighestLevel();
@@ -1186,88 +1236,129 @@ Cell* Geometry::findNextCell(LocalCoords* coords, double azim, double polar) {
     /* Descend universes/coord until at the lowest level.
      * At each universe/lattice level get distance to next
      * universe or lattice cell. Compare to get new min_dist. */
-    while (coords != NULL) {
+    LocalCoords* level = coords;
+    while (level != NULL) {
 
       /* If we reach a LocalCoord in a Lattice, find the distance to the
-       * nearest lattice cell boundary */
-      if (coords->getType() == LAT) {
-        Lattice* lattice = coords->getLattice();
-        dist = lattice->minSurfaceDist(coords->getPoint(), azim, polar);
+       * nearest lattice cell boundary from the stored lattice indices */
+      if (level->getType() == LAT) {
+        Lattice* lattice = level->getLattice();
+        dist = lattice->minSurfaceDist(level, level_direction);
       }
       /* If we reach a LocalCoord in a Universe, find the distance to the
        * nearest cell surface */
       else {
-        Cell* cell = coords->getCell();
-        dist = cell->minSurfaceDist(coords->getPoint(), azim, polar);
+        Cell* cell = level->getCell();
+        dist = cell->minSurfaceDist(level->getPoint(), level_direction);
 
         /* Apply rotation to direction. Position has already been modified by
            universe->findCell() in findCellContainingCoords() */
         if (cell->isRotated()) {
-
           double* matrix = cell->getRotationMatrix();
-          double uvw[3] = {sin(polar)*cos(azim), sin(polar)*sin(azim),
-                           cos(polar)};
-          double rot_uvw[3] = {matrix[0]*uvw[0] + matrix[1]*uvw[1] +
-                               matrix[2]*uvw[2], matrix[3]*uvw[0] +
-                               matrix[4]*uvw[1] + matrix[5]*uvw[2],
-                               matrix[6]*uvw[0] + matrix[7]*uvw[1] +
-                               matrix[8]*uvw[2]};
-          polar = acos(rot_uvw[2]);
-          azim = atan2(rot_uvw[1], rot_uvw[0]);
-          if (azim < 0)
-            azim += 2 * M_PI;
+          const double* uvw = level_direction->_uvw;
+          rotated_direction.setComponents(
+               matrix[0]*uvw[0] + matrix[1]*uvw[1] + matrix[2]*uvw[2],
+               matrix[3]*uvw[0] + matrix[4]*uvw[1] + matrix[5]*uvw[2],
+               matrix[6]*uvw[0] + matrix[7]*uvw[1] + matrix[8]*uvw[2]);
+          level_direction = &rotated_direction;
         }
       }
 
       /* Recheck min distance */
+      if (num_levels < LOCAL_COORDS_LEN)
+        level_dist[num_levels] = dist;
+      num_levels++;
       min_dist = std::min(dist, min_dist);
 
-      /* Descend one level, exit if at the lowest level of coordinates */
-      if (coords->getNext() == NULL)
-        break;
-      else
-        coords = coords->getNext();
+      /* Descend one level */
+      level = level->getNext();
     }
 
-    /* Reset coords direction in case there was a rotated cell */
-    coords = coords->getHighestLevel();
-    coords->prune();
-    azim = old_azim;
-    polar = old_polar;
-
     /* Check for distance to an overlaid mesh */
     if (_overlaid_mesh != NULL) {
-      dist = _overlaid_mesh->minSurfaceDist(coords->getPoint(), azim, polar);
+      dist = _overlaid_mesh->minSurfaceDist(coords->getPoint(), direction);
       min_dist = std::min(dist, min_dist);
     }
 
     /* Check for distance to nearest CMFD mesh cell boundary */
     if (_cmfd != NULL) {
       Lattice* lattice = _cmfd->getLattice();
-      dist = lattice->minSurfaceDist(coords->getPoint(), azim, polar);
+      dist = lattice->minSurfaceDist(coords->getPoint(), direction);
       min_dist = std::min(dist, min_dist);
     }
 
     /* Check for distance to nearest domain boundary */
     bool domain_boundary = false;
     if (_domain_decomposed) {
-      dist = _domain_bounds->minSurfaceDist(coords->getPoint(), azim, polar);
+      dist = _domain_bounds->minSurfaceDist(coords->getPoint(), direction);
       if (dist - min_dist < ON_SURFACE_THRESH) {
         min_dist = dist;
         domain_boundary = true;
       }
     }
 
-    /* Move point and get next cell */
-    double delta_x = cos(azim) * sin(polar) * (min_dist + TINY_MOVE);
-    double delta_y = sin(azim) * sin(polar) * (min_dist + TINY_MOVE);
-    double delta_z = cos(polar) * (min_dist + TINY_MOVE);
-    coords->adjustCoords(delta_x, delta_y, delta_z);
+    /* Move point just past the nearest boundary */
+    double step = min_dist + TINY_MOVE;
+
+    /* Leaving the domain or too deeply nested, search from the root */
+    if (domain_boundary || num_levels > LOCAL_COORDS_LEN) {
+      coords->prune();
+      coords->adjustCoords(direction->_uvw[0] * step,
+                           direction->_uvw[1] * step,
+                           direction->_uvw[2] * step);
+      if (domain_boundary)
+        return NULL;
+      else
+        return findCellContainingCoords(coords);
+    }
+
+    /* Move each level along its own direction down to the highest level
+     * whose boundary is crossed. The cells and lattice indices above that
+     * level are unchanged, so the search resumes from the crossed level */
+    LocalCoords* crossed = NULL;
+    level_direction = direction;
+    level = coords;
+    for (int i=0; i < num_levels; i++) {
+
+      Point* point = level->getPoint();
+      point->setCoords(point->getX() + level_direction->_uvw[0] * step,
+                       point->getY() + level_direction->_uvw[1] * step,
+                       point->getZ() + level_direction->_uvw[2] * step);
+
+      if (level_dist[i] < step + TINY_MOVE) {
+        crossed = level;
+        break;
+      }
+
+      /* Rotate the direction below a rotated cell */
+      if (level->getType() == UNIV && level->getCell()->isRotated()) {
+        double* matrix = level->getCell()->getRotationMatrix();
+        const double* uvw = level_direction->_uvw;
+        rotated_direction.setComponents(
+             matrix[0]*uvw[0] + matrix[1]*uvw[1] + matrix[2]*uvw[2],
+             matrix[3]*uvw[0] + matrix[4]*uvw[1] + matrix[5]*uvw[2],
+             matrix[6]*uvw[0] + matrix[7]*uvw[1] + matrix[8]*uvw[2]);
+        level_direction = &rotated_direction;
+      }
+
+      level = level->getNext();
+    }
+
+    /* Only a mesh boundary was crossed, the Cell is unchanged */
+    if (crossed == NULL)
+      return coords->getLowestLevel()->getCell();
 
-    if (domain_boundary)
-      return NULL;
-    else
-      return findCellContainingCoords(coords);
+    /* Find the Cell below the crossed level */
+    crossed->prune();
+    Cell* cell = findCellContainingCoords(crossed);
+
+    /* Fall back on a search from the root Universe */
+    if (cell == NULL && crossed != coords) {
+      coords->prune();
+      cell = findCellContainingCoords(coords);
+    }
+
+    return cell;
   }
 }
 
@@ -1308,14 +1399,12 @@ long Geometry::findFSRId(LocalCoords* coords) {
       fsr_data* fsr = new fsr_data;
       fsr->_fsr_id = fsr_id;
       _FSR_keys_map.update(fsr_key, fsr);
-      Point* point = new Point();
-      point->setCoords(coords->getHighestLevel()->getX(),
-                       coords->getHighestLevel()->getY(),
-                       coords->getHighestLevel()->getZ());
+      fsr->_point.setCoords(coords->getHighestLevel()->getX(),
+                            coords->getHighestLevel()->getY(),
+                            coords->getHighestLevel()->getZ());
 
       /* Get the cell that contains coords */
       Cell* cell = findCellContainingCoords(curr);
-      fsr->_point = point;
       fsr->_mat_id = cell->getFillMaterial()->getId();
 
       /* If CMFD acceleration is on, add FSR CMFD cell to FSR data */
@@ -1331,6 +1420,11 @@ long Geometry::findFSRId(LocalCoords* coords) {
       fsr = _FSR_keys_map.at(fsr_key);
     } while (fsr == NULL);
 
+    /* Descend into the FSRs split off by adaptive axial refinement */
+    double z = coords->getHighestLevel()->getZ();
+    while (fsr->_upper != NULL && z >= fsr->_split_z)
+      fsr = fsr->_upper;
+
     fsr_id = fsr->_fsr_id;
   }
 
@@ -1419,7 +1513,13 @@ long Geometry::getFSRId(LocalCoords* coords, bool err_check) {
     getFSRKeyFast(coords, fsr_key);
     if (!_FSR_keys_map.contains(fsr_key) && !err_check)
       return -1;
-    fsr_id = _FSR_keys_map.at(fsr_key)->_fsr_id;
+    fsr_data* fsr = _FSR_keys_map.at(fsr_key);
+
+    /* Descend into the FSRs split off by adaptive axial refinement */
+    double z = coords->getHighestLevel()->getZ();
+    while (fsr->_upper != NULL && z >= fsr->_split_z)
+      fsr = fsr->_upper;
+    fsr_id = fsr->_fsr_id;
   }
   catch(std::exception &e) {
     if (err_check) {
@@ -1536,11 +1636,15 @@ long Geometry::getGlobalFSRId(LocalCoords* coords, bool err_check) {
  */
 Point* Geometry::getFSRPoint(long fsr_id) {
 
+  /* Use the point table once the FSR lookup vectors are initialized */
+  if (fsr_id >= 0 && fsr_id < long(_FSRs_to_points.size()))
+    return &_FSRs_to_points[fsr_id];
+
   Point* point;
 
   try {
     std::string& key = _FSRs_to_keys[fsr_id];
-    point = _FSR_keys_map.at(key)->_point;
+    point = &_FSR_keys_map.at(key)->_point;
   }
   catch(std::exception &e) {
     log_printf(ERROR, "Could not find characteristic point in FSR: %d", fsr_id);
@@ -2089,6 +2193,8 @@ void Geometry::segmentize2D(Track* track, double z_coord) {
   double y0 = track->getStart()->getY();
   double z0 = z_coord;
   double phi = track->getPhi();
+  Direction direction;
+  direction.setAngles(phi);
   double delta_x, delta_y, delta_z;
 
   /* Length of each segment */
@@ -2120,7 +2226,7 @@ void Geometry::segmentize2D(Track* track, double z_coord) {
 
     /* Find the next Cell along the Track's trajectory */
     prev = curr;
-    curr = findNextCell(&end, phi);
+    curr = findNextCell(&end, &direction);
 
     /* Checks that segment does not have the same start and end Points */
     if (fabs(start.getX() - end.getX()) < FLT_EPSILON
@@ -2237,6 +2343,8 @@ void Geometry::segmentize3D(Track3D* track, bool OTF_setup) {
   double z0 = track->getStart()->getZ();
   double phi = track->getPhi();
   double theta = track->getTheta();
+  Direction direction;
+  direction.setAngles(phi, theta);
 
   /* Length of each segment */
   double length;
@@ -2269,7 +2377,7 @@ void Geometry::segmentize3D(Track3D* track, bool OTF_setup) {
 
     /* Find the next Cell along the Track's trajectory */
     prev = curr;
-    curr = findNextCell(&end, phi, theta);
+    curr = findNextCell(&end, &direction);
 
     /* Checks to make sure that new Segment does not have the same start
      * and end Points */
@@ -2375,6 +2483,8 @@ void Geometry::segmentizeExtruded(Track* flattened_track,
   double y0 = flattened_track->getStart()->getY();
   double z0 = z_coords[0];
   double phi = flattened_track->getPhi();
+  Direction direction;
+  direction.setAngles(phi);
   double delta_x, delta_y, delta_z;
 
   /* Length of each segment */
@@ -2435,7 +2545,7 @@ void Geometry::segmentizeExtruded(Track* flattened_track,
       start.copyCoords(&end);
 
       /* Find the next Cell along the Track's trajectory */
-      curr = findNextCell(&end, phi);
+      curr = findNextCell(&end, &direction);
 
       /* Checks that segment does not have the same start and end Points */
       if (fabs(start.getX() - end.getX()) < FLT_EPSILON &&
@@ -2519,7 +2629,7 @@ void Geometry::segmentizeExtruded(Track* flattened_track,
 
     /* Move the coordinates to the next intersection */
     start.copyCoords(&end);
-    curr = findNextCell(&end, phi, M_PI_2);
+    curr = findNextCell(&end, &direction);
 
     log_printf(DEBUG, "segment start x = %f, y = %f; end x = %f, y = %f",
                start.getX(), start.getY(), end.getX(), end.getY());
@@ -2730,10 +2840,14 @@ void Geometry::initializeAxialFSRs(std::vector<double> global_z_mesh) {
     MPI_Barrier(_MPI_cart);
 #endif
 
+  /* Gather the axial data of all extruded FSRs in contiguous tables */
+  packExtrudedFSRs();
+
   // Output the extruded FSR storage requirement
   float size = total_number_fsrs_in_stack * (sizeof(double) + sizeof(long) +
              sizeof(Material*)) + _extruded_FSR_keys_map.size() * (sizeof(
              _extruded_FSR_keys_map.keys()[0]) + sizeof(ExtrudedFSR) +
+             sizeof(long) + sizeof(double) +
              (LOCAL_COORDS_LEN + 1) * sizeof(LocalCoords));
   float max_size = size;
 #ifdef MPIX
@@ -2750,6 +2864,236 @@ void Geometry::initializeAxialFSRs(std::vector<double> global_z_mesh) {
 }
 
 
+/**
+ * @brief Splits 3D FSRs of the axially extruded regions in two halves along z.
+ * @details Each FSR is split at the mid-height of its axial extent over all
+ *          the ExtrudedFSRs that it spans. The lower half keeps the FSR data
+ *          while the upper half is added as a new FSR, chained to the lower
+ *          half so that FSR lookups by coordinates still resolve. The FSR IDs
+ *          are then re-ordered and the FSR lookup vectors rebuilt. This
+ *          requires the local axial meshes of on-the-fly ray tracing.
+ * @param fsr_ids the IDs of the FSRs to split
+ * @return a vector indexed by new FSR ID of the FSR ID it derives from
+ */
+std::vector<long> Geometry::splitAxialFSRs(std::vector<long>& fsr_ids) {
+
+  long num_FSRs = getNumFSRs();
+  size_t num_extruded_FSRs = _extruded_FSR_lookup.size();
+
+  /* Check that every extruded FSR has its own axial mesh */
+  if (num_extruded_FSRs == 0)
+    log_printf(ERROR, "Unable to split FSRs axially since the Geometry does "
+               "not contain axially extruded FSRs");
+  for (size_t i=0; i < num_extruded_FSRs; i++)
+    if (_extruded_FSR_lookup[i]->_mesh == NULL)
+      log_printf(ERROR, "Unable to split FSRs axially with a global z-mesh, "
+                 "local axial meshes are required");
+
+  /* Flag the FSRs to split */
+  std::vector<bool> split(num_FSRs, false);
+  for (size_t i=0; i < fsr_ids.size(); i++)
+    split.at(fsr_ids[i]) = true;
+
+  /* Find the axial extent of the FSRs over all the extruded FSRs */
+  std::vector<double> z_min(num_FSRs, std::numeric_limits<double>::max());
+  std::vector<double> z_max(num_FSRs, -std::numeric_limits<double>::max());
+  for (size_t i=0; i < num_extruded_FSRs; i++) {
+    ExtrudedFSR* extruded_FSR = _extruded_FSR_lookup[i];
+    for (size_t s=0; s < extruded_FSR->_num_fsrs; s++) {
+      long r = extruded_FSR->_fsr_ids[s];
+      z_min[r] = std::min(z_min[r], extruded_FSR->_mesh[s]);
+      z_max[r] = std::max(z_max[r], extruded_FSR->_mesh[s+1]);
+    }
+  }
+
+  /* Gather FSR data and create the upper halves at the end of the IDs */
+  std::vector<fsr_data*> fsrs(num_FSRs);
+  std::vector<long> parents(num_FSRs);
+  std::vector<fsr_data*> upper(num_FSRs, NULL);
+  std::vector<double> split_z(num_FSRs);
+  std::vector<bool> point_found(num_FSRs, true);
+  std::vector<bool> upper_point_found(num_FSRs, false);
+  for (long r=0; r < num_FSRs; r++) {
+
+    fsrs[r] = _FSR_keys_map.at(_FSRs_to_keys[r]);
+    parents[r] = r;
+    if (!split[r])
+      continue;
+
+    /* Chain the upper half to the FSR below the split height */
+    fsr_data* fsr = fsrs[r];
+    fsr_data* half = new fsr_data;
+    split_z[r] = (z_min[r] + z_max[r]) / 2;
+    half->_fsr_id = fsrs.size();
+    half->_cmfd_cell = fsr->_cmfd_cell;
+    half->_mat_id = fsr->_mat_id;
+    half->_split_z = fsr->_split_z;
+    half->_upper = fsr->_upper;
+    fsr->_split_z = split_z[r];
+    fsr->_upper = half;
+
+    /* Characteristic points are re-computed from the new axial intervals */
+    point_found[r] = (fsr->_point.getZ() < split_z[r]);
+
+    std::stringstream key;
+    key << _FSRs_to_keys[r] << " : SPLIT = " << half->_fsr_id;
+    _FSR_keys_map.insert(key.str(), half);
+    fsrs.push_back(half);
+    parents.push_back(r);
+    upper[r] = half;
+  }
+
+  /* Split the axial intervals of the FSRs in each extruded FSR */
+  for (size_t i=0; i < num_extruded_FSRs; i++) {
+
+    ExtrudedFSR* extruded_FSR = _extruded_FSR_lookup[i];
+    double x0 = extruded_FSR->_coords->getX();
+    double y0 = extruded_FSR->_coords->getY();
+
+    std::vector<double> mesh(1, extruded_FSR->_mesh[0]);
+    std::vector<long> ids;
+    std::vector<Material*> materials;
+    for (size_t s=0; s < extruded_FSR->_num_fsrs; s++) {
+
+      long r = extruded_FSR->_fsr_ids[s];
+      Material* material = extruded_FSR->_materials[s];
+      double z_low = extruded_FSR->_mesh[s];
+      double z_high = extruded_FSR->_mesh[s+1];
+
+      if (!split[r]) {
+        mesh.push_back(z_high);
+        ids.push_back(r);
+        materials.push_back(material);
+        continue;
+      }
+
+      /* Lower part of the interval keeps the original FSR */
+      double z_mid = split_z[r];
+      bool has_upper = z_high - z_mid > FLT_EPSILON;
+      bool has_lower = z_mid - z_low > FLT_EPSILON || !has_upper;
+      if (has_lower) {
+        double z_top = has_upper ? z_mid : z_high;
+        mesh.push_back(z_top);
+        ids.push_back(r);
+        materials.push_back(material);
+        if (!point_found[r]) {
+          fsrs[r]->_point.setCoords(x0, y0, (z_low + z_top) / 2);
+          point_found[r] = true;
+        }
+      }
+
+      /* Upper part of the interval belongs to the new FSR */
+      if (has_upper) {
+        double z_bottom = has_lower ? z_mid : z_low;
+        mesh.push_back(z_high);
+        ids.push_back(upper[r]->_fsr_id);
+        materials.push_back(material);
+        if (!upper_point_found[r]) {
+          upper[r]->_point.setCoords(x0, y0, (z_bottom + z_high) / 2);
+          upper_point_found[r] = true;
+        }
+      }
+    }
+
+    /* Replace the axial mesh of the extruded FSR, the previous arrays are
+       owned by the axial tables which are re-packed below */
+    size_t num_regions = ids.size();
+    extruded_FSR->_num_fsrs = num_regions;
+    extruded_FSR->_mesh = new double[num_regions+1];
+    extruded_FSR->_fsr_ids = new long[num_regions];
+    extruded_FSR->_materials = new Material*[num_regions];
+    std::copy(mesh.begin(), mesh.end(), extruded_FSR->_mesh);
+    std::copy(ids.begin(), ids.end(), extruded_FSR->_fsr_ids);
+    std::copy(materials.begin(), materials.end(), extruded_FSR->_materials);
+  }
+  packExtrudedFSRs();
+
+  /* Re-order FSR IDs so they are sequential in the axial direction */
+  reorderFSRIDs();
+
+  /* Map the new FSR IDs to the FSRs they derive from */
+  std::vector<long> fsr_parents(fsrs.size());
+  for (size_t r=0; r < fsrs.size(); r++)
+    fsr_parents.at(fsrs[r]->_fsr_id) = parents[r];
+
+  /* Rebuild the FSR lookup vectors and CMFD cell to FSR maps */
+  if (_cmfd != NULL)
+    _cmfd->initializeCellMap();
+  initializeFSRVectors();
+
+  return fsr_parents;
+}
+
+
+/**
+ * @brief Gathers the axial meshes, FSR IDs and materials of all extruded FSRs
+ *        into contiguous tables.
+ * @details Extruded FSRs are given individually allocated arrays while they
+ *          are ray traced or read from file. These are copied into tables in
+ *          a compressed sparse row layout ordered by extruded FSR ID, and
+ *          freed. Each ExtrudedFSR then points into the tables, so the axial
+ *          data of successive extruded FSRs is adjacent in memory.
+ */
+void Geometry::packExtrudedFSRs() {
+
+  /* Order the extruded FSRs by ID */
+  size_t num_extruded_FSRs = _extruded_FSR_keys_map.size();
+  ExtrudedFSR** extruded_value_list = _extruded_FSR_keys_map.values();
+  std::vector<ExtrudedFSR*> extruded_FSRs(num_extruded_FSRs);
+  for (size_t i=0; i < num_extruded_FSRs; i++)
+    extruded_FSRs.at(extruded_value_list[i]->_fsr_id) = extruded_value_list[i];
+  delete [] extruded_value_list;
+
+  /* Compute the offsets of each extruded FSR in the tables */
+  std::vector<long> offsets(num_extruded_FSRs + 1, 0);
+  bool local_meshes = false;
+  for (size_t i=0; i < num_extruded_FSRs; i++) {
+    offsets[i+1] = offsets[i] + extruded_FSRs[i]->_num_fsrs;
+    if (extruded_FSRs[i]->_mesh != NULL)
+      local_meshes = true;
+  }
+
+  /* Allocate the tables */
+  long num_axial_FSRs = offsets[num_extruded_FSRs];
+  std::vector<long> fsr_ids(num_axial_FSRs);
+  std::vector<Material*> materials(num_axial_FSRs);
+  std::vector<double> meshes;
+  if (local_meshes)
+    meshes.resize(num_axial_FSRs + num_extruded_FSRs);
+
+  /* Copy the axial data and point the extruded FSRs into the tables */
+#pragma omp parallel for
+  for (size_t i=0; i < num_extruded_FSRs; i++) {
+
+    ExtrudedFSR* extruded_FSR = extruded_FSRs[i];
+    size_t num_fsrs = extruded_FSR->_num_fsrs;
+    long offset = offsets[i];
+
+    std::copy(extruded_FSR->_fsr_ids, extruded_FSR->_fsr_ids + num_fsrs,
+              fsr_ids.data() + offset);
+    std::copy(extruded_FSR->_materials, extruded_FSR->_materials + num_fsrs,
+              materials.data() + offset);
+    delete [] extruded_FSR->_fsr_ids;
+    delete [] extruded_FSR->_materials;
+    extruded_FSR->_fsr_ids = fsr_ids.data() + offset;
+    extruded_FSR->_materials = materials.data() + offset;
+
+    if (extruded_FSR->_mesh != NULL) {
+      std::copy(extruded_FSR->_mesh, extruded_FSR->_mesh + num_fsrs + 1,
+                meshes.data() + offset + i);
+      delete [] extruded_FSR->_mesh;
+      extruded_FSR->_mesh = meshes.data() + offset + i;
+    }
+  }
+
+  /* Swapping keeps the addresses of the table elements */
+  _axial_offsets.swap(offsets);
+  _axial_FSR_ids.swap(fsr_ids);
+  _axial_materials.swap(materials);
+  _axial_meshes.swap(meshes);
+}
+
+
 /**
  * @brief Reorders FSRs so that they are contiguous in the axial direction.
  */
@@ -2832,6 +3176,7 @@ void Geometry::initializeFSRVectors() {
   size_t num_FSRs = _FSR_keys_map.size();
   _FSRs_to_keys = std::vector<std::string>(num_FSRs);
   _FSRs_to_centroids = std::vector<Point*>(num_FSRs, NULL);
+  _FSRs_to_points = std::vector<Point>(num_FSRs);
   _FSRs_to_material_IDs = std::vector<int>(num_FSRs);
   _FSRs_to_CMFD_cells = std::vector<int>(num_FSRs);
   _contains_FSR_centroids = false;
@@ -2843,6 +3188,7 @@ void Geometry::initializeFSRVectors() {
     fsr_data* fsr = value_list[i];
     long fsr_id = fsr->_fsr_id;
     _FSRs_to_keys.at(fsr_id) = key;
+    _FSRs_to_points.at(fsr_id).copyCoords(&fsr->_point);
     _FSRs_to_material_IDs.at(fsr_id) = fsr->_mat_id;
   }
 
@@ -2859,7 +3205,7 @@ void Geometry::initializeFSRVectors() {
   /* Output approximate storage for various FSR maps, locks, volumes... */
   long size = num_FSRs * (sizeof(fsr_data) + sizeof(omp_lock_t) +
        sizeof(FP_PRECISION) + sizeof(fsr_data*) + 2 * sizeof(key_list[0]) +
-       sizeof(Point*) + sizeof(Point) + 2*sizeof(int));
+       sizeof(Point*) + 2 * sizeof(Point) + 2*sizeof(int));
   long max_size = size;
 #ifdef MPIX
   if (isDomainDecomposed())
@@ -2867,12 +3213,16 @@ void Geometry::initializeFSRVectors() {
 #endif
   log_printf(INFO_ONCE, "Max FSR, maps and data, storage per domain = %.2f MB",
              max_size / float(1e6));
+  account_memory(this, "fsr maps", FSR_MEMORY, size);
 
   /* Check if extruded FSRs are present */
   size_t num_extruded_FSRs = _extruded_FSR_keys_map.size();
   if (num_extruded_FSRs > 0) {
 
     /* Allocate extruded FSR lookup vector and fill with extruded FSRs by ID */
+    account_memory(this, "extruded fsrs", FSR_MEMORY, num_extruded_FSRs *
+                   (sizeof(ExtrudedFSR) + sizeof(LocalCoords) +
+                   2 * sizeof(ExtrudedFSR*)));
     _extruded_FSR_lookup = std::vector<ExtrudedFSR*>(num_extruded_FSRs);
     ExtrudedFSR **extruded_value_list = _extruded_FSR_keys_map.values();
 #pragma omp parallel for
@@ -3440,8 +3790,7 @@ bool Geometry::withinGlobalBounds(LocalCoords* coords) {
  */
 Cell* Geometry::findCellContainingFSR(long fsr_id) {
 
-  std::string& key = _FSRs_to_keys[fsr_id];
-  Point* point = _FSR_keys_map.at(key)->_point;
+  Point* point = getFSRPoint(fsr_id);
   LocalCoords coords(point->getX(), point->getY(), point->getZ(), true);
   coords.setUniverse(_root_universe);
   Cell* cell = findCellContainingCoords(&coords);
@@ -3452,22 +3801,29 @@ Cell* Geometry::findCellContainingFSR(long fsr_id) {
 
 /**
  * @brief Sets the centroid for an FSR.
- * @details The _FSR_keys_map stores a hash of a std::string representing
- *          the Lattice/Cell/Universe hierarchy for a unique region
- *          and the associated FSR data. _centroid is a point that represents
- *          the numerical centroid of an FSR computed using all segments
- *          contained in the FSR. This method is used by the TrackGenerator
- *          to set the centroid after segments have been created. It is
- *          important to note that this method is a helper function for the
- *          TrackGenerator and should not be explicitly called by the user.
+ * @details The centroid is a point that represents the numerical centroid
+ *          of an FSR computed using all segments contained in the FSR. It
+ *          is copied into a contiguous centroid table indexed by FSR ID, the
+ *          caller keeps ownership of the given Point. This method is used by
+ *          the TrackGenerator to set the centroid after segments have been
+ *          created. It is important to note that this method is a helper
+ *          function for the TrackGenerator and should not be explicitly
+ *          called by the user.
  * @param fsr a FSR id
  * @param centroid a Point representing the FSR centroid
  */
 void Geometry::setFSRCentroid(long fsr, Point* centroid) {
+
+  /* Allocate the centroid table for the current number of FSRs */
+  if (_FSR_centroids.size() != _FSRs_to_centroids.size()) {
+    _FSR_centroids = std::vector<Point>(_FSRs_to_centroids.size());
+    std::fill(_FSRs_to_centroids.begin(), _FSRs_to_centroids.end(),
+              (Point*) NULL);
+  }
+
   _contains_FSR_centroids = true;
-  std::string& key = _FSRs_to_keys[fsr];
-  _FSR_keys_map.at(key)->_centroid = centroid;
-  _FSRs_to_centroids[fsr] = centroid;
+  _FSR_centroids[fsr].copyCoords(centroid);
+  _FSRs_to_centroids[fsr] = &_FSR_centroids[fsr];
 }
 
 
@@ -3528,7 +3884,7 @@ std::vector<double> Geometry::getUniqueZHeights(bool include_overlaid_mesh) {
 
     /* Check if universe is actually a lattice */
     universeType type = curr_universe->getType();
-    if (type == LATTICE) {
+    if (type == LATTICE || type == HEX_LATTICE) {
 
       /* Get lattice dimensions */
       Lattice* lattice = static_cast<Lattice*>(curr_universe);
@@ -3550,6 +3906,8 @@ std::vector<double> Geometry::getUniqueZHeights(bool include_overlaid_mesh) {
         for (int j=0; j<ny; j++) {
           for (int k=0; k<nz; k++) {
             Universe* new_universe = lattice->getUniverse(i, j, k);
+            if (new_universe == NULL)
+              continue;
             universes.push_back(new_universe);
             offsets.push_back(z_offset);
           }
@@ -4050,6 +4408,39 @@ void Geometry::dumpToFile(std::string filename) {
         fwrite(&universe_id, sizeof(int), 1, out);
       }
     }
+    else if (ut == HEX_LATTICE) {
+      /* Print hexagonal lattice information */
+      HexLattice* lattice = static_cast<HexLattice*>(universe);
+      int num_rings = lattice->getNumRings();
+      int num_z = lattice->getNumZ();
+      double pitch = lattice->getPitch();
+      double width_z = lattice->getWidthZ();
+      double* offset = lattice->getOffset()->getXYZ();
+      fwrite(&num_rings, sizeof(int), 1, out);
+      fwrite(&num_z, sizeof(int), 1, out);
+      fwrite(&pitch, sizeof(double), 1, out);
+      fwrite(&width_z, sizeof(double), 1, out);
+      fwrite(offset, sizeof(double), 3, out);
+      bool non_uniform = lattice->getNonUniform();
+      fwrite(&non_uniform, sizeof(bool), 1, out);
+      if (non_uniform) {
+        const std::vector<double> widths_z = lattice->getWidthsZ();
+        fwrite(&widths_z[0], sizeof(double), num_z, out);
+      }
+
+      /* Print universes in the input order of HexLattice::setUniverses */
+      for (int k = num_z-1; k > -1; k--) {
+        for (int r = num_rings-1; r > -num_rings; r--) {
+          int q_min = std::max(-(num_rings-1), -(num_rings-1) - r);
+          int q_max = std::min(num_rings-1, num_rings-1 - r);
+          for (int q = q_min; q <= q_max; q++) {
+            int universe_id = lattice->getUniverse(q + num_rings-1,
+                                                   r + num_rings-1, k)->getId();
+            fwrite(&universe_id, sizeof(int), 1, out);
+          }
+        }
+      }
+    }
   }
 
   /* Close the output file */
@@ -4085,6 +4476,7 @@ void Geometry::loadFromFile(std::string filename, bool twiddle) {
   std::map<int, int> fill_cell_universes;
   std::map<int, int> cell_parent;
   std::map<int, int*> lattice_universes;
+  std::map<int, int> hex_lattice_rings;
 
   /* Read number of energy groups */
   int num_groups;
@@ -4458,6 +4850,43 @@ void Geometry::loadFromFile(std::string filename, bool twiddle) {
         lattice_universes[key][j] = universe_id;
       }
     }
+    else if (ut == HEX_LATTICE) {
+
+      /* Read hexagonal lattice information */
+      int num_rings, num_z;
+      double pitch, width_z;
+      double offset[3];
+      ret = twiddleRead(&num_rings, sizeof(int), 1, in);
+      ret = twiddleRead(&num_z, sizeof(int), 1, in);
+      ret = twiddleRead(&pitch, sizeof(double), 1, in);
+      ret = twiddleRead(&width_z, sizeof(double), 1, in);
+      ret = twiddleRead(offset, sizeof(double), 3, in);
+
+      bool non_uniform = false;
+      ret = twiddleRead(&non_uniform, sizeof(bool), 1, in);
+
+      /* Create lattice */
+      HexLattice* new_lattice = new HexLattice(id, name);
+      all_universes[key] = new_lattice;
+      new_lattice->setPitch(pitch, width_z);
+      new_lattice->setNumZ(num_z);
+      if (non_uniform) {
+        std::vector<double> widths_z(num_z);
+        ret = twiddleRead(&widths_z[0], sizeof(double), num_z, in);
+        new_lattice->setWidthsZ(widths_z);
+      }
+      new_lattice->setOffset(offset[0], offset[1], offset[2]);
+
+      /* Get universes */
+      int num_cells = num_z * (3 * num_rings * (num_rings - 1) + 1);
+      hex_lattice_rings[key] = num_rings;
+      lattice_universes[key] = new int[num_cells];
+      for (int j=0; j < num_cells; j++) {
+        int universe_id;
+        ret = twiddleRead(&universe_id, sizeof(int), 1, in);
+        lattice_universes[key][j] = universe_id;
+      }
+    }
     if (strcmp(name, "") != 0)
       delete [] name;
 
@@ -4485,6 +4914,20 @@ void Geometry::loadFromFile(std::string filename, bool twiddle) {
        lattice_iter != lattice_universes.end(); ++lattice_iter) {
     int id = lattice_iter->first;
     int* array = lattice_iter->second;
+
+    /* Set the universes of hexagonal lattices in their input order */
+    if (hex_lattice_rings.find(id) != hex_lattice_rings.end()) {
+      HexLattice* lattice = static_cast<HexLattice*>(all_universes[id]);
+      int num_rings = hex_lattice_rings[id];
+      int num_cells = lattice->getNumZ() * (3 * num_rings * (num_rings-1) + 1);
+      std::vector<Universe*> universes(num_cells);
+      for (int i=0; i < num_cells; i++)
+        universes[i] = all_universes[array[i]];
+      lattice->setUniverses(lattice->getNumZ(), num_rings, &universes[0]);
+      delete [] lattice_iter->second;
+      continue;
+    }
+
     Lattice* lattice = static_cast<Lattice*>(all_universes[id]);
     int num_x = lattice->getNumX();
     int num_y = lattice->getNumY();
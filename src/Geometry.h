@@ -44,8 +44,8 @@ class Cmfd;
 struct fsr_data {
 
   /** Constructor for FSR data object */
-  fsr_data() : _fsr_id(0), _cmfd_cell(0), _mat_id(0), _point(NULL),
-    _centroid(NULL){}
+  fsr_data() : _fsr_id(0), _cmfd_cell(0), _mat_id(0), _split_z(0.),
+    _upper(NULL){}
 
   /** The FSR ID */
   long _fsr_id;
@@ -57,19 +57,13 @@ struct fsr_data {
   int _mat_id;
 
   /** Characteristic point in Root Universe that lies in FSR */
-  Point* _point;
+  Point _point;
 
-  /** Global numerical centroid in Root Universe */
-  Point* _centroid;
+  /** Height above which the FSR was split off by axial refinement */
+  double _split_z;
 
-  /** Destructor for fsr_data */
-  ~fsr_data() {
-    if (_point != NULL)
-      delete _point;
-
-    if (_centroid != NULL)
-      delete _centroid;
-  }
+  /** The FSR split off above _split_z, NULL if the FSR was never split */
+  fsr_data* _upper;
 };
 
 
@@ -79,7 +73,8 @@ struct fsr_data {
  *        plane for axial on-the-fly ray tracing. It contains a characteristic
  *        point that lies within the FSR, an axial mesh, and an array of 3D
  *        FSR IDs contained within the extruded region along with their
- *        corresponding materials.
+ *        corresponding materials. The axial mesh, FSR IDs and materials
+ *        point into contiguous tables owned by the Geometry.
  */
 struct ExtrudedFSR {
 
@@ -133,6 +128,12 @@ private:
   /** An vector of FSR centroids indexed by FSR ID */
   std::vector<Point*> _FSRs_to_centroids;
 
+  /** Contiguous storage of the FSR centroids indexed by FSR ID */
+  std::vector<Point> _FSR_centroids;
+
+  /** Contiguous table of FSR characteristic points indexed by FSR ID */
+  std::vector<Point> _FSRs_to_points;
+
   /** A boolean indicating whether any centroids have been set */
   bool _contains_FSR_centroids;
 
@@ -142,6 +143,20 @@ private:
   /** A vector of ExtrudedFSR pointers indexed by extruded FSR ID */
   std::vector<ExtrudedFSR*> _extruded_FSR_lookup;
 
+  /** Offsets of each extruded FSR's axial FSRs in the axial tables, indexed
+   *  by extruded FSR ID (compressed sparse row layout) */
+  std::vector<long> _axial_offsets;
+
+  /** FSR IDs of all extruded FSRs, stored contiguously */
+  std::vector<long> _axial_FSR_ids;
+
+  /** Materials of all extruded FSRs, stored contiguously */
+  std::vector<Material*> _axial_materials;
+
+  /** Axial meshes of all extruded FSRs, the mesh of extruded FSR i starts
+   *  at _axial_offsets[i] + i */
+  std::vector<double> _axial_meshes;
+
   /** An vector of CMFD cell IDs indexed by FSR ID */
   std::vector<int> _FSRs_to_CMFD_cells;
 
@@ -220,6 +235,7 @@ public:
 
   /* Handle symmetry axis used to restrict the computation domain */
   void useSymmetry(bool X_symmetry, bool Y_symmetry, bool Z_symmetry);
+  void useRotationalSymmetry();
   bool getSymmetry(int axis);
 
   /* Get parameters */
@@ -305,12 +321,15 @@ public:
   int findExtrudedFSR(LocalCoords* coords);
   Cell* findCellContainingFSR(long fsr_id);
   Cell* findNextCell(LocalCoords* coords, double azim, double polar=M_PI_2);
+  Cell* findNextCell(LocalCoords* coords, const Direction* direction);
 
   /* Other worker methods */
   void setNumThreads(int num_threads);
   void reserveKeyStrings(int num_threads);
   void subdivideCells();
   void initializeAxialFSRs(std::vector<double> global_z_mesh);
+  std::vector<long> splitAxialFSRs(std::vector<long>& fsr_ids);
+  void packExtrudedFSRs();
   void reorderFSRIDs();
   void initializeFlatSourceRegions();
   void segmentize2D(Track* track, double z_coord);
@@ -133,141 +133,6 @@ void MOCKernel::setMaxOpticalLength(FP_PRECISION max_tau) {
 }
 
 
-/**
- * @brief Adds segment contribution to the FSR volume.
- * @details The VolumeKernel execute function adds the product of the
- *          track length and track weight to the buffer array at index
- *          id, referring to the array of FSR volumes.
- * @param length segment length
- * @param mat Material associated with the segment
- * @param fsr_id the FSR ID of the FSR associated with the segment
- */
-void VolumeKernel::execute(FP_PRECISION length, Material* mat, long fsr_id,
-                           int track_idx, int cmfd_surface_fwd,
-                           int cmfd_surface_bwd, FP_PRECISION x_start,
-                           FP_PRECISION y_start, FP_PRECISION z_start,
-                           FP_PRECISION phi, FP_PRECISION theta) {
-
-  /* Set omp lock for FSRs */
-  omp_set_lock(&_FSR_locks[fsr_id]);
-
-  /* Add value to buffer */
-  _FSR_volumes[fsr_id] += _weight * length;
-
-  /* Unset lock */
-  omp_unset_lock(&_FSR_locks[fsr_id]);
-
-  /* Increment the count of the number of times the kernel is executed */
-  _count++;
-}
-
-
-/**
- * @brief Increments the counter for the number of segments on the track.
- * @details The CounterKernel execute function counts the number of segments
- *          in a track by incrementing the counter variable upon execution. Due
- *          to restrictions on maximum optical path length, the counter may be
- *          incremented by more than one to account for splitting of the
- *          segment into segments of allowed optical path length.
- * @param length segment length
- * @param mat Material associated with the segment
- * @param fsr_id the FSR ID of the FSR associated with the segment
- */
-void CounterKernel::execute(FP_PRECISION length, Material* mat, long fsr_id,
-                            int track_idx, int cmfd_surface_fwd,
-                            int cmfd_surface_bwd, FP_PRECISION x_start,
-                            FP_PRECISION y_start, FP_PRECISION z_start,
-                            FP_PRECISION phi, FP_PRECISION theta) {
-
-  /* Determine the number of cuts on the segment */
-  FP_PRECISION sin_theta = sin(theta);
-  FP_PRECISION max_sigma_t = mat->getMaxSigmaT();
-
-  int num_cuts = 1;
-  if (length * max_sigma_t * sin_theta > _max_tau)
-    num_cuts = length * max_sigma_t * sin_theta / _max_tau + 1;
-
-  /* Increment segment count */
-  _count += num_cuts;
-}
-
-
-/**
- * @brief Writes segment information to the segmentation data array.
- * @details The SegmentationKernel execute function writes segment information
- *          to the segmentation data referenced by _segments. Due to
- *          restrictions on maximum optical path length, the counter may be
- *          incremented by more than one to account for splitting of the
- *          segment into segments of allowed optical path length.
- * @param length segment length
- * @param mat Material associated with the segment
- * @param fsr_id the FSR ID of the FSR associated with the segment
- * @param track_idx the track index in stack
- * @param cmfd_surface_fwd CMFD surface at the end of the segment in the forward
- *        direction
- * @param cmfd_surface_bwd CMFD surface at the end of the segment in the
- *        backward direction
- * @param x_start x coordinate of the start of the segment
- * @param y_start y coordinate of the start of the segment
- * @param z_start z coordinate of the start of the sement
- * @param phi azimuthal angle of this segment
- * @param theta polar angle of this segment
- */
-void SegmentationKernel::execute(FP_PRECISION length, Material* mat, long fsr_id,
-                                int track_idx, int cmfd_surface_fwd,
-                                int cmfd_surface_bwd, FP_PRECISION x_start,
-                                FP_PRECISION y_start, FP_PRECISION z_start,
-                                FP_PRECISION phi, FP_PRECISION theta) {
-
-  /* Check if segments have not been set, if so return */
-  if (_segments == NULL)
-    return;
-
-  /* Determine the number of cuts on the segment */
-  FP_PRECISION sin_theta = sin(theta);
-  FP_PRECISION max_sigma_t = mat->getMaxSigmaT();
-
-  int num_cuts = 1;
-  if (length * max_sigma_t * sin_theta > _max_tau)
-    num_cuts = length * max_sigma_t * sin_theta / _max_tau + 1;
-  FP_PRECISION temp_length = _max_tau / (max_sigma_t * sin_theta);
-
-  /* Add segment information */
-  for (int i=0; i < num_cuts-1; i++) {
-    _segments[_count]._length = temp_length;
-    _segments[_count]._material = mat;
-    _segments[_count]._region_id = fsr_id;
-    _segments[_count]._track_idx = track_idx;
-    _segments[_count]._starting_position[0] = x_start;
-    _segments[_count]._starting_position[1] = y_start;
-    _segments[_count]._starting_position[2] = z_start;
-    _segments[_count]._cmfd_surface_fwd = -1;
-    if (i == 0)
-      _segments[_count]._cmfd_surface_bwd = cmfd_surface_bwd;
-    else
-      _segments[_count]._cmfd_surface_bwd = -1;
-    length -= temp_length;
-    x_start += temp_length * sin_theta * cos(phi);
-    y_start += temp_length * sin_theta * sin(phi);
-    z_start += temp_length * cos(theta);
-    _count++;
-  }
-  _segments[_count]._length = length;
-  _segments[_count]._material = mat;
-  _segments[_count]._region_id = fsr_id;
-  _segments[_count]._track_idx = track_idx;
-  _segments[_count]._starting_position[0] = x_start;
-  _segments[_count]._starting_position[1] = y_start;
-  _segments[_count]._starting_position[2] = z_start;
-  _segments[_count]._cmfd_surface_fwd = cmfd_surface_fwd;
-  if (num_cuts > 1)
-    _segments[_count]._cmfd_surface_bwd = -1;
-  else
-    _segments[_count]._cmfd_surface_bwd = cmfd_surface_bwd;
-  _count++;
-}
-
-
 /**
  * @brief Constructor for the TransportKernel.
  * @param track_generator the TrackGenerator used to pull relevant tracking
@@ -304,10 +169,12 @@ void TransportKernel::setCPUSolver(CPUSolver* cpu_solver) {
 
 /**
  * @brief Create a new track3D from an existing one.
+ * @details TransportKernels are only used for 3D on-the-fly ray tracing, so
+ *          the Track is always a Track3D.
  * @param track track to create the new track from
  */
 void TransportKernel::newTrack(Track* track) {
-  Track3D* track_3D = dynamic_cast<Track3D*>(track);
+  Track3D* track_3D = static_cast<Track3D*>(track);
   _azim_index = track_3D->getAzimIndex();
   _xy_index = track_3D->getXYIndex();
   _polar_index = track_3D->getPolarIndex();
@@ -416,6 +283,86 @@ void TransportKernel::execute(FP_PRECISION length, Material* mat, long fsr_id,
 }
 
 
+/**
+ * @brief Applies the MOC equations to a band of consecutive 3D Tracks of a
+ *        z-stack that all cross the same segment.
+ * @details The Tracks of a z-stack crossing the entire 2D length of an FSR
+ *          share the same segment length and material, so the angular
+ *          fluxes of the whole band are attenuated in lockstep, one cut at a
+ *          time, and the scalar flux contribution is accumulated once for
+ *          the band. Only the CMFD surfaces differ between the Tracks.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @param fsr_id the FSR ID of the FSR associated with the segment
+ * @param first_track_idx the index of the first Track of the band in the
+ *        z-stack
+ * @param num_tracks the number of Tracks in the band
+ * @param cmfd_surfaces_fwd the CMFD surfaces at the end of the segment for
+ *        each Track of the band
+ * @param theta the polar angle of the Tracks
+ */
+void TransportKernel::executeStack(FP_PRECISION length, Material* mat,
+                                   long fsr_id, int first_track_idx,
+                                   int num_tracks, int* cmfd_surfaces_fwd,
+                                   FP_PRECISION theta) {
+
+  /* Update lower and upper bounds for this track */
+  int last_track_idx = first_track_idx + num_tracks - 1;
+  _min_track_idx = std::min(_min_track_idx, first_track_idx);
+  _max_track_idx = std::max(_max_track_idx, last_track_idx);
+
+  /* Determine the number of cuts on the segment */
+  FP_PRECISION sin_theta = sin(theta);
+  FP_PRECISION max_sigma_t = mat->getMaxSigmaT();
+
+  int num_cuts = 1;
+  if (length * max_sigma_t * sin_theta > _max_tau)
+    num_cuts = length * max_sigma_t * sin_theta / _max_tau + 1;
+
+  /* Handle the length of possible cuts of segment */
+  FP_PRECISION remain_length = length;
+  FP_PRECISION segment_length = std::min(_max_tau / (sin_theta * max_sigma_t),
+                                         length);
+
+  /* Get the track flux of the first track of the band */
+  long first_track_id = _track_id + first_track_idx;
+  float* track_flux = _cpu_solver->getBoundaryFlux(first_track_id,
+                                                   _direction);
+
+  /* Allocate a buffer to store flux contribution of all cuts in this fsr */
+  FP_PRECISION fsr_flux[_num_groups] __attribute__ ((aligned (VEC_ALIGNMENT)));
+  memset(fsr_flux, 0, _num_groups * sizeof(FP_PRECISION));
+
+  /* Apply MOC equations to segments */
+  segment curr_segment;
+  curr_segment._material = mat;
+  curr_segment._region_id = fsr_id;
+  for (int i=0; i < num_cuts; i++) {
+
+    /* Apply MOC equations to all tracks of the band */
+    curr_segment._length = std::min(segment_length, remain_length);
+    _cpu_solver->tallyScalarFluxStack(&curr_segment, num_tracks, fsr_flux,
+                                      track_flux);
+
+    /* Shorten remaining 3D length */
+    remain_length -= segment_length;
+  }
+
+  /* Tally the currents of each track on the segment end */
+  for (int t=0; t < num_tracks; t++) {
+    curr_segment._cmfd_surface_fwd = cmfd_surfaces_fwd[t];
+    _cpu_solver->tallyCurrent(&curr_segment, _azim_index, _polar_index,
+                              _cpu_solver->getBoundaryFlux(first_track_id + t,
+                              _direction), true);
+  }
+
+  /* Accumulate contribution of all cuts to FSR scalar flux */
+  FP_PRECISION wgt = _track_generator->getQuadrature()->getWeightInline(
+       _azim_index, _polar_index);
+  _cpu_solver->accumulateScalarFluxContribution(fsr_id, wgt, fsr_flux);
+}
+
+
 /**
  * @brief Obtain and transfer the boundary track angular fluxes.
  */  //TODO Optimize, create a postTwoWay
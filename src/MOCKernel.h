@@ -36,7 +36,10 @@ class CPUSolver;
  *          code. This class is the parent class of CounterKernel,
  *          VolumeKernel, and SegmentationKernel. A generic MOCKernel should
  *          not be explicity instantiated. Instead, an inhereting class should
- *          be instantiated which describes the "execute" function.
+ *          be instantiated which describes the "execute" function. The
+ *          inheriting kernels are final, so that the segment traversals of
+ *          TraverseSegments, which are templated on the kernel type, call
+ *          their "execute" function directly and may inline it.
  */
 class MOCKernel {
 
@@ -82,7 +85,7 @@ public:
  *          _count variable by the number of legitimate segment lengths
  *          (less than the max optical path length) in the input length.
  */
-class CounterKernel: public MOCKernel {
+class CounterKernel final: public MOCKernel {
 
 public:
   CounterKernel(TrackGenerator* track_generator);
@@ -102,7 +105,7 @@ public:
  *          at an input index. The weight corresponds to the weight of the
  *          track associated with the segments.
  */
-class VolumeKernel: public MOCKernel {
+class VolumeKernel final: public MOCKernel {
 
 private:
 
@@ -137,7 +140,7 @@ public:
  *          "execute" function is saved to the segment data, forming explicit
  *          segments.
  */
-class SegmentationKernel: public MOCKernel {
+class SegmentationKernel final: public MOCKernel {
 
 private:
 
@@ -159,7 +162,7 @@ public:
  *          is initialized with a pointer to a CPU Solver. Input data of the
  *          "execute" function is used to apply the MOC equations in CPUSolver.
  */
-class TransportKernel: public MOCKernel {
+class TransportKernel final: public MOCKernel {
 private:
 
   /** Pointer to CPUSolver enabling use of transport functions */
@@ -203,8 +206,143 @@ public:
                int track_idx, int cmfd_surface_fwd, int cmfd_surface_bwd,
                FP_PRECISION x_start, FP_PRECISION y_start, FP_PRECISION z_start,
                FP_PRECISION phi, FP_PRECISION theta);
+  void executeStack(FP_PRECISION length, Material* mat, long fsr_id,
+                    int first_track_idx, int num_tracks,
+                    int* cmfd_surfaces_fwd, FP_PRECISION theta);
   void post();
 };
 
 
+/**
+ * @brief Adds segment contribution to the FSR volume.
+ * @details The VolumeKernel execute function adds the product of the
+ *          track length and track weight to the buffer array at index
+ *          id, referring to the array of FSR volumes.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @param fsr_id the FSR ID of the FSR associated with the segment
+ */
+inline void VolumeKernel::execute(FP_PRECISION length, Material* mat,
+    long fsr_id, int track_idx, int cmfd_surface_fwd, int cmfd_surface_bwd,
+    FP_PRECISION x_start, FP_PRECISION y_start, FP_PRECISION z_start,
+    FP_PRECISION phi, FP_PRECISION theta) {
+
+  /* Set omp lock for FSRs */
+  omp_set_lock(&_FSR_locks[fsr_id]);
+
+  /* Add value to buffer */
+  _FSR_volumes[fsr_id] += _weight * length;
+
+  /* Unset lock */
+  omp_unset_lock(&_FSR_locks[fsr_id]);
+
+  /* Increment the count of the number of times the kernel is executed */
+  _count++;
+}
+
+
+/**
+ * @brief Increments the counter for the number of segments on the track.
+ * @details The CounterKernel execute function counts the number of segments
+ *          in a track by incrementing the counter variable upon execution. Due
+ *          to restrictions on maximum optical path length, the counter may be
+ *          incremented by more than one to account for splitting of the
+ *          segment into segments of allowed optical path length.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @param fsr_id the FSR ID of the FSR associated with the segment
+ */
+inline void CounterKernel::execute(FP_PRECISION length, Material* mat,
+    long fsr_id, int track_idx, int cmfd_surface_fwd, int cmfd_surface_bwd,
+    FP_PRECISION x_start, FP_PRECISION y_start, FP_PRECISION z_start,
+    FP_PRECISION phi, FP_PRECISION theta) {
+
+  /* Determine the number of cuts on the segment */
+  FP_PRECISION sin_theta = sin(theta);
+  FP_PRECISION max_sigma_t = mat->getMaxSigmaT();
+
+  int num_cuts = 1;
+  if (length * max_sigma_t * sin_theta > _max_tau)
+    num_cuts = length * max_sigma_t * sin_theta / _max_tau + 1;
+
+  /* Increment segment count */
+  _count += num_cuts;
+}
+
+
+/**
+ * @brief Writes segment information to the segmentation data array.
+ * @details The SegmentationKernel execute function writes segment information
+ *          to the segmentation data referenced by _segments. Due to
+ *          restrictions on maximum optical path length, the counter may be
+ *          incremented by more than one to account for splitting of the
+ *          segment into segments of allowed optical path length.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @param fsr_id the FSR ID of the FSR associated with the segment
+ * @param track_idx the track index in stack
+ * @param cmfd_surface_fwd CMFD surface at the end of the segment in the forward
+ *        direction
+ * @param cmfd_surface_bwd CMFD surface at the end of the segment in the
+ *        backward direction
+ * @param x_start x coordinate of the start of the segment
+ * @param y_start y coordinate of the start of the segment
+ * @param z_start z coordinate of the start of the sement
+ * @param phi azimuthal angle of this segment
+ * @param theta polar angle of this segment
+ */
+inline void SegmentationKernel::execute(FP_PRECISION length, Material* mat,
+    long fsr_id, int track_idx, int cmfd_surface_fwd, int cmfd_surface_bwd,
+    FP_PRECISION x_start, FP_PRECISION y_start, FP_PRECISION z_start,
+    FP_PRECISION phi, FP_PRECISION theta) {
+
+  /* Check if segments have not been set, if so return */
+  if (_segments == NULL)
+    return;
+
+  /* Determine the number of cuts on the segment */
+  FP_PRECISION sin_theta = sin(theta);
+  FP_PRECISION max_sigma_t = mat->getMaxSigmaT();
+
+  int num_cuts = 1;
+  if (length * max_sigma_t * sin_theta > _max_tau)
+    num_cuts = length * max_sigma_t * sin_theta / _max_tau + 1;
+  FP_PRECISION temp_length = _max_tau / (max_sigma_t * sin_theta);
+
+  /* Add segment information */
+  for (int i=0; i < num_cuts-1; i++) {
+    _segments[_count]._length = temp_length;
+    _segments[_count]._material = mat;
+    _segments[_count]._region_id = fsr_id;
+    _segments[_count]._track_idx = track_idx;
+    _segments[_count]._starting_position[0] = x_start;
+    _segments[_count]._starting_position[1] = y_start;
+    _segments[_count]._starting_position[2] = z_start;
+    _segments[_count]._cmfd_surface_fwd = -1;
+    if (i == 0)
+      _segments[_count]._cmfd_surface_bwd = cmfd_surface_bwd;
+    else
+      _segments[_count]._cmfd_surface_bwd = -1;
+    length -= temp_length;
+    x_start += temp_length * sin_theta * cos(phi);
+    y_start += temp_length * sin_theta * sin(phi);
+    z_start += temp_length * cos(theta);
+    _count++;
+  }
+  _segments[_count]._length = length;
+  _segments[_count]._material = mat;
+  _segments[_count]._region_id = fsr_id;
+  _segments[_count]._track_idx = track_idx;
+  _segments[_count]._starting_position[0] = x_start;
+  _segments[_count]._starting_position[1] = y_start;
+  _segments[_count]._starting_position[2] = z_start;
+  _segments[_count]._cmfd_surface_fwd = cmfd_surface_fwd;
+  if (num_cuts > 1)
+    _segments[_count]._cmfd_surface_bwd = -1;
+  else
+    _segments[_count]._cmfd_surface_bwd = cmfd_surface_bwd;
+  _count++;
+}
+
+
 #endif /* MOCKERNEL_H_ */
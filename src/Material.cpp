@@ -947,6 +947,46 @@ void Material::setSigmaAByGroup(double xs, int group) {
 }
 
 
+/**
+ * @brief Multiplies the cross-sections of each energy group by a factor.
+ * @details The total, absorption, fission, nu-fission and outgoing
+ *          scattering cross-sections of each group are scaled in a single
+ *          pass, e.g. to apply SPH factors. The fission matrix is rebuilt by
+ *          the Solver before the next calculation.
+ * @param factors the array of factors indexed by energy group
+ * @param num_groups the number of energy groups
+ */
+void Material::scaleCrossSections(double* factors, int num_groups) {
+
+  if (_num_groups != num_groups)
+    log_printf(ERROR, "Unable to scale the cross-sections with %d groups for "
+               "Material %d which contains %d energy groups", num_groups, _id,
+               _num_groups);
+
+  /* Compute the absorption cross-section before scaling if needed */
+  getSigmaA();
+
+  _max_sigma_t = 0.;
+  for (int g=0; g < _num_groups; g++) {
+
+    _sigma_t[g] *= factors[g];
+    if (fabs(_sigma_t[g]) < ZERO_SIGMA_T)
+      _sigma_t[g] = FP_PRECISION(ZERO_SIGMA_T);
+    _max_sigma_t = std::max(_max_sigma_t, _sigma_t[g]);
+
+    _sigma_a[g] *= factors[g];
+    if (_sigma_f != NULL)
+      _sigma_f[g] *= factors[g];
+    if (_nu_sigma_f != NULL)
+      _nu_sigma_f[g] *= factors[g];
+
+    /* Scattering is scaled by the factor of its origin group */
+    for (int gp=0; gp < _num_groups; gp++)
+      _sigma_s[_num_groups*gp + g] *= factors[g];
+  }
+}
+
+
 /**
  * @brief Builds the fission matrix from chi and the fission cross-section.
  * @details The fission matrix is constructed as the outer product of the
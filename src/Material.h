@@ -150,6 +150,7 @@ public:
   void setSigmaSByGroup(double xs, int origin, int destination);
   void setChiByGroup(double xs, int group);
   void setSigmaAByGroup(double xs, int group);
+  void scaleCrossSections(double* factors, int num_groups);
 
   void buildFissionMatrix();
   void transposeProductionMatrices();
@@ -36,6 +36,12 @@ Matrix::Matrix(omp_lock_t* cell_locks, int num_x, int num_y, int num_z,
   _DIAG = NULL;
   _modified = true;
 
+  _use_stencil = false;
+  _stencil_valid = false;
+  _stencil_cells = NULL;
+  _stencil_coeffs = NULL;
+  _block_coeffs = NULL;
+
   /* Set OpenMP locks for each Matrix cell */
   if (cell_locks == NULL)
     log_printf(ERROR, "Unable to create a Matrix without an array of cell "
@@ -63,6 +69,8 @@ Matrix::~Matrix() {
   if (_DIAG != NULL)
     delete [] _DIAG;
 
+  freeStencil();
+
   for (int i=0; i < _num_rows; i++)
     _LIL[i].clear();
   _LIL.clear();
@@ -227,12 +235,124 @@ void Matrix::convertToCSR() {
 
   _IA[_num_rows] = NNZ;
 
+  /* Form the structured stencil arrays used by the SOR kernel */
+  if (_use_stencil)
+    convertToStencil();
+
   /* Reset flat indicating whether the CSR objects have the same values as the
    * LIL object */
   _modified = false;
 }
 
 
+/**
+ * @brief Convert the matrix lists of lists to a structured stencil form.
+ * @details The structured form splits the matrix into the coupling of each
+ *          cell to its (up to) NUM_FACES neighbor cells, which is diagonal in
+ *          energy, and the dense group-to-group block of each cell. The
+ *          neighbor couplings are stored as [cell][face][group] and the blocks
+ *          as [cell][group_from][group_to] with a zeroed diagonal, so that
+ *          the SOR kernel can update all the groups of a cell with unit
+ *          stride loops. Unused neighbor slots point to the cell itself with
+ *          zero coefficients. If the matrix does not have this structure, the
+ *          stencil is marked invalid and the CSR form is used instead.
+ */
+void Matrix::convertToStencil() {
+
+  freeStencil();
+
+  int num_cells = _num_x * _num_y * _num_z;
+  int ng = _num_groups;
+
+  _stencil_cells = new int[num_cells * NUM_FACES];
+  _stencil_coeffs = (CMFD_PRECISION*) memalign(VEC_ALIGNMENT,
+                    num_cells * NUM_FACES * ng * sizeof(CMFD_PRECISION));
+  _block_coeffs = (CMFD_PRECISION*) memalign(VEC_ALIGNMENT,
+                  num_cells * ng * ng * sizeof(CMFD_PRECISION));
+  memset(_stencil_coeffs, 0, num_cells * NUM_FACES * ng *
+         sizeof(CMFD_PRECISION));
+  memset(_block_coeffs, 0, num_cells * ng * ng * sizeof(CMFD_PRECISION));
+
+  log_printf(INFO_ONCE, "Matrix stencil format storage %6.2f MB",
+             num_cells * (NUM_FACES * (sizeof(int) + ng *
+             sizeof(CMFD_PRECISION)) + ng * ng * sizeof(CMFD_PRECISION))
+             / float(1e6));
+
+  bool valid = true;
+#pragma omp parallel for reduction(&&:valid)
+  for (int cell=0; cell < num_cells; cell++) {
+
+    int* cells = &_stencil_cells[cell*NUM_FACES];
+    int num_neighbors = 0;
+    for (int f=0; f < NUM_FACES; f++)
+      cells[f] = cell;
+
+    for (int g=0; g < ng; g++) {
+      int row = cell * ng + g;
+      for (int i = _IA[row]; i < _IA[row+1]; i++) {
+
+        int cell_from = _JA[i] / ng;
+        int group_from = _JA[i] % ng;
+
+        /* In-cell group to group coupling, the diagonal is kept in _DIAG */
+        if (cell_from == cell) {
+          if (group_from != g)
+            _block_coeffs[(cell*ng + group_from)*ng + g] = _A[i];
+          continue;
+        }
+
+        /* Couplings between cells must be diagonal in energy */
+        if (group_from != g) {
+          valid = false;
+          break;
+        }
+
+        /* Find or assign the stencil slot of the neighbor cell */
+        int f = 0;
+        while (f < num_neighbors && cells[f] != cell_from)
+          f++;
+        if (f == num_neighbors) {
+          if (num_neighbors == NUM_FACES) {
+            valid = false;
+            break;
+          }
+          cells[f] = cell_from;
+          num_neighbors++;
+        }
+        _stencil_coeffs[(cell*NUM_FACES + f)*ng + g] = _A[i];
+      }
+    }
+  }
+
+  if (!valid) {
+    log_printf(INFO_ONCE, "Matrix does not have a 7-point stencil structure, "
+               "using the CSR form");
+    freeStencil();
+  }
+  _stencil_valid = valid;
+}
+
+
+/**
+ * @brief Deallocate the structured stencil arrays.
+ */
+void Matrix::freeStencil() {
+
+  if (_stencil_cells != NULL)
+    delete [] _stencil_cells;
+
+  if (_stencil_coeffs != NULL)
+    free(_stencil_coeffs);
+
+  if (_block_coeffs != NULL)
+    free(_block_coeffs);
+
+  _stencil_cells = NULL;
+  _stencil_coeffs = NULL;
+  _block_coeffs = NULL;
+  _stencil_valid = false;
+}
+
 
 /**
  * @brief Print the matrix object to the log file.
@@ -333,6 +453,76 @@ CMFD_PRECISION* Matrix::getDiag() {
 }
 
 
+/**
+ * @brief Returns whether the structured stencil form of the matrix is in use.
+ * @details The stencil form is only available if it was requested with
+ *          useStructuredStencil() and the matrix has a 7-point structure.
+ * @return whether the structured stencil arrays can be used
+ */
+bool Matrix::hasStructuredStencil() {
+
+  if (_modified)
+    convertToCSR();
+
+  return _use_stencil && _stencil_valid;
+}
+
+
+/**
+ * @brief Get the neighbor cells of the structured stencil form.
+ * @return A pointer to the NUM_FACES neighbor cells of each cell
+ */
+int* Matrix::getStencilCells() {
+
+  if (_modified)
+    convertToCSR();
+
+  return _stencil_cells;
+}
+
+
+/**
+ * @brief Get the neighbor coupling coefficients of the structured stencil.
+ * @return A pointer to the coefficients, ordered by cell, face and group
+ */
+CMFD_PRECISION* Matrix::getStencilCoeffs() {
+
+  if (_modified)
+    convertToCSR();
+
+  return _stencil_coeffs;
+}
+
+
+/**
+ * @brief Get the in-cell group-to-group blocks of the structured stencil.
+ * @details The diagonal of each block is zero, it is stored in getDiag().
+ * @return A pointer to the blocks, ordered by cell, group from and group to
+ */
+CMFD_PRECISION* Matrix::getBlockCoeffs() {
+
+  if (_modified)
+    convertToCSR();
+
+  return _block_coeffs;
+}
+
+
+/**
+ * @brief Sets whether to form the structured stencil arrays.
+ * @details The structured stencil is used by the linear solver instead of the
+ *          CSR form, it allows vectorization of the SOR update over groups.
+ * @param use_stencil whether to form and use the structured stencil
+ */
+void Matrix::useStructuredStencil(bool use_stencil) {
+
+  if (use_stencil != _use_stencil)
+    _modified = true;
+
+  _use_stencil = use_stencil;
+}
+
+
 /**
  * @brief Get the number of cells in the x dimension.
  * @return The number of cells in the x dimension.
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <stdlib.h>
 #include <iomanip>
+#include <malloc.h>
 #include "log.h"
 #include "constants.h"
 #endif
@@ -36,6 +37,13 @@ private:
   int* _JA;
   CMFD_PRECISION* _DIAG;
 
+  /** The structured stencil variables, cell-major and group-minor */
+  bool _use_stencil;
+  bool _stencil_valid;
+  int* _stencil_cells;
+  CMFD_PRECISION* _stencil_coeffs;
+  CMFD_PRECISION* _block_coeffs;
+
   bool _modified;
   int _num_x;
   int _num_y;
@@ -47,6 +55,8 @@ private:
   omp_lock_t* _cell_locks;
 
   void convertToCSR();
+  void convertToStencil();
+  void freeStencil();
   void setNumX(int num_x);
   void setNumY(int num_y);
   void setNumZ(int num_z);
@@ -78,8 +88,13 @@ public:
   int getNumRows();
   int getNNZ();
   omp_lock_t* getCellLocks();
+  bool hasStructuredStencil();
+  int* getStencilCells();
+  CMFD_PRECISION* getStencilCoeffs();
+  CMFD_PRECISION* getBlockCoeffs();
 
   /* Setter functions */
+  void useStructuredStencil(bool use_stencil);
   void setValue(int cell_from, int group_from, int cell_to, int group_to,
                 CMFD_PRECISION val);
 };
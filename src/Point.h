@@ -47,6 +47,32 @@ public:
 };
 
 
+/**
+ * @struct Direction
+ * @brief A unit direction of travel with its precomputed reciprocals.
+ * @details The direction cosines of a track are computed once from its
+ *          azimuthal and polar angles so that the surface and lattice
+ *          distance routines used during ray tracing need neither
+ *          trigonometric functions nor divisions by the direction cosines.
+ */
+struct Direction {
+
+  /** The x, y and z direction cosines */
+  double _uvw[3];
+
+  /** The reciprocals of the x, y and z direction cosines */
+  double _inv_uvw[3];
+
+  /** Constructor initializes a direction along the positive x-axis */
+  Direction() {
+    setComponents(1., 0., 0.);
+  }
+
+  void setAngles(const double azim, const double polar=M_PI_2);
+  void setComponents(const double u, const double v, const double w);
+};
+
+
 /**
  * @brief Initializes a Point with two-dimensional coordinates.
  * @param x x-coordinate
@@ -173,4 +199,32 @@ inline void Point::copyCoords(Point* point) {
 }
 
 
+/**
+ * @brief Sets the direction cosines from an azimuthal and polar angle.
+ * @param azim the azimuthal angle (in radians from \f$[0,2\pi]\f$)
+ * @param polar the polar angle (in radians from \f$[0,\pi]\f$)
+ */
+inline void Direction::setAngles(const double azim, const double polar) {
+  setComponents(cos(azim) * sin(polar), sin(azim) * sin(polar), cos(polar));
+}
+
+
+/**
+ * @brief Sets the direction cosines and their reciprocals.
+ * @details Null components have an infinite reciprocal.
+ * @param u the x direction cosine
+ * @param v the y direction cosine
+ * @param w the z direction cosine
+ */
+inline void Direction::setComponents(const double u, const double v,
+                                     const double w) {
+  _uvw[0] = u;
+  _uvw[1] = v;
+  _uvw[2] = w;
+  _inv_uvw[0] = 1. / u;
+  _inv_uvw[1] = 1. / v;
+  _inv_uvw[2] = 1. / w;
+}
+
+
 #endif /* POINT_H_ */
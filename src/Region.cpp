@@ -613,6 +613,22 @@ double Region::minSurfaceDist(LocalCoords* coords) {
  * @return distance to nearest intersection with the region's boundaries
  */
 double Region::minSurfaceDist(Point* point, double azim, double polar) {
+  Direction direction;
+  direction.setAngles(azim, polar);
+  return minSurfaceDist(point, &direction);
+}
+
+
+/**
+ * @brief Computes the minimum distance to a Surface in the Region from
+ *        a point travelling along a given unit direction.
+ * @details If the trajectory will not intersect any of the Surfaces in the
+ *          Region returns INFINITY.
+ * @param point the Point of interest
+ * @param direction the unit direction of the trajectory
+ * @return distance to nearest intersection with the region's boundaries
+ */
+double Region::minSurfaceDist(Point* point, const Direction* direction) {
 
   double curr_dist;
   double min_dist = INFINITY;
@@ -620,7 +636,7 @@ double Region::minSurfaceDist(Point* point, double azim, double polar) {
   /* Find the minimum distance to one of the Region's nodes */
   std::vector<Region*>::iterator iter;
   for (iter = _nodes.begin(); iter != _nodes.end(); ++iter) {
-    curr_dist = (*iter)->minSurfaceDist(point, azim, polar);
+    curr_dist = (*iter)->minSurfaceDist(point, direction);
 
     /* If the distance to Cell is less than current min distance, update */
     if (curr_dist < min_dist)
@@ -960,6 +976,20 @@ double Halfspace::minSurfaceDist(Point* point, double azim, double polar) {
 }
 
 
+/**
+ * @brief Computes the minimum distance to the Surface in the Halfspace from
+ *        a point travelling along a given unit direction.
+ * @details If the trajectory will not intersect the Surface in the
+ *          Halfspace returns INFINITY.
+ * @param point the Point of interest
+ * @param direction the unit direction of the trajectory
+ * @return distance to the Surface in the Halfspace
+ */
+double Halfspace::minSurfaceDist(Point* point, const Direction* direction) {
+  return _surface->intersectionDistance(point, direction);
+}
+
+
 /**
  * @brief Computes the minimum distance to the Surface in the Halfspace from
  *        a point with a given trajectory at a certain angle stored in a
@@ -85,6 +85,7 @@ public:
   virtual bool containsPoint(Point* point) =0;
   virtual double minSurfaceDist(LocalCoords* coords);
   virtual double minSurfaceDist(Point* point, double azim, double polar=M_PI_2);
+  virtual double minSurfaceDist(Point* point, const Direction* direction);
   virtual Region* clone();
 };
 
@@ -157,6 +158,7 @@ public:
   bool containsPoint(Point* point);
   double minSurfaceDist(LocalCoords* coords);
   double minSurfaceDist(Point* point, double azim, double polar=M_PI_2);
+  double minSurfaceDist(Point* point, const Direction* direction);
 };
 
 /**
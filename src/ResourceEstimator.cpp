@@ -0,0 +1,326 @@
+#include "ResourceEstimator.h"
+#include "TrackTraversingAlgorithms.h"
+
+/** The names of the memory categories of a resource estimate */
+static const char* memory_categories[NUM_MEMORY_CATEGORIES] =
+  {"tracks", "segments", "angular fluxes", "fsr data", "linear source",
+   "cmfd"};
+
+
+/**
+ * @brief Constructor initializes the default estimate parameters.
+ * @param track_generator the TrackGenerator of the calculation, with its
+ *        Geometry, quadrature, spacings and segment formation set
+ */
+ResourceEstimator::ResourceEstimator(TrackGenerator* track_generator) {
+
+  if (track_generator == NULL)
+    log_printf(ERROR, "Unable to create a ResourceEstimator without a "
+               "TrackGenerator");
+
+  _track_generator = track_generator;
+  _sample_fraction = 0.1;
+  _linear_source = false;
+  _integration_time = 0.;
+  _num_FSRs = 0;
+  _num_tracks = 0;
+  _num_segments = 0;
+  _sweep_time = 0.;
+  for (int c=0; c < NUM_MEMORY_CATEGORIES; c++)
+    _memory[c] = 0.;
+}
+
+
+/**
+ * @brief Destructor.
+ */
+ResourceEstimator::~ResourceEstimator() {
+}
+
+
+/**
+ * @brief Sets the fraction of 2D Tracks whose 3D Tracks are traced to count
+ *        the 3D segments.
+ * @param fraction the sampled fraction of 2D Tracks (0.1 by default)
+ */
+void ResourceEstimator::setSampleFraction(double fraction) {
+  if (fraction <= 0 || fraction > 1)
+    log_printf(ERROR, "Unable to set the sampled fraction of Tracks to %f, "
+               "which is not between 0 and 1", fraction);
+  _sample_fraction = fraction;
+}
+
+
+/**
+ * @brief Sets whether the calculation uses a linear source approximation.
+ * @param linear_source whether the CPULSSolver is used (false by default)
+ */
+void ResourceEstimator::useLinearSource(bool linear_source) {
+  _linear_source = linear_source;
+}
+
+
+/**
+ * @brief Sets the transport sweep time per segment, group and thread.
+ * @details This is the "Integration time by segment-group-thread (sweep)"
+ *          of the timing report of a calculation with the same solver and
+ *          segment formation on the same machine. By default, it is the time
+ *          measured on a small 7-group lattice with on-the-fly ray tracing,
+ *          1.5E-8 seconds with flat sources and 2E-8 seconds with linear
+ *          sources.
+ * @param time the integration time per segment, group and thread in seconds
+ */
+void ResourceEstimator::setIntegrationTime(double time) {
+  if (time <= 0)
+    log_printf(ERROR, "Unable to set a non-positive integration time %f",
+               time);
+  _integration_time = time;
+}
+
+
+/**
+ * @brief Estimates the memory and transport sweep time of the calculation.
+ * @details The TrackGenerator lays down the Tracks and the FSRs in a dry run,
+ *          and must generate the Tracks again before a calculation. This may
+ *          be called from Python as follows:
+ *
+ * @code
+ *          estimator = openmoc.ResourceEstimator(track_generator)
+ *          estimator.setSampleFraction(0.05)
+ *          estimator.estimate()
+ *          memory = estimator.getTotalMemory()
+ * @endcode
+ */
+void ResourceEstimator::estimate() {
+
+  Geometry* geometry = _track_generator->getGeometry();
+  TrackGenerator3D* track_generator_3D =
+    dynamic_cast<TrackGenerator3D*>(_track_generator);
+  segmentationType segment_formation = _track_generator->getSegmentFormation();
+  int num_threads = _track_generator->getNumThreads();
+
+  /* Lay down the Tracks and the FSRs, 3D segments are formed on-the-fly */
+  if (segment_formation == EXPLICIT_3D)
+    track_generator_3D->setSegmentFormation(OTF_TRACKS);
+  _track_generator->setDryRun(true);
+  _track_generator->generateTracks();
+  _track_generator->setDryRun(false);
+
+  log_printf(NORMAL, "Estimating the resources of the calculation...");
+
+  long num_FSRs = geometry->getNumFSRs();
+  int num_groups = geometry->getNumEnergyGroups();
+  long num_2D_tracks = _track_generator->getNum2DTracks();
+  long num_2D_segments = _track_generator->getNum2DSegments();
+
+  double memory[NUM_MEMORY_CATEGORIES] = {0.};
+  memory[0] = num_2D_tracks * sizeof(Track);
+
+  /* Count the segments, and the memory of the Tracks and segments */
+  long num_tracks;
+  long num_segments;
+  int fluxes_per_track;
+  if (track_generator_3D == NULL) {
+    num_tracks = num_2D_tracks;
+    num_segments = num_2D_segments;
+    fluxes_per_track = num_groups *
+      _track_generator->getQuadrature()->getNumPolarAngles() / 2;
+    memory[1] = num_segments * sizeof(segment);
+  }
+  else {
+
+    /* Scale the segments of the sampled 3D Tracks to all 3D Tracks */
+    int stride = std::max(1, int(round(1. / _sample_fraction)));
+    SegmentSampler sampler(_track_generator, stride);
+    sampler.execute();
+    num_tracks = track_generator_3D->getNum3DTracks();
+    num_segments = 0;
+    if (sampler.getNumSampledTracks() > 0)
+      num_segments = sampler.getNumSampledSegments() * double(num_tracks) /
+                     sampler.getNumSampledTracks();
+    fluxes_per_track = num_groups;
+
+    if (segment_formation == EXPLICIT_3D) {
+      track_generator_3D->setSegmentFormation(EXPLICIT_3D);
+      memory[0] += num_tracks * sizeof(Track3D);
+      memory[1] = num_segments * sizeof(segment);
+    }
+    else {
+
+      /* Extruded segments and temporary segments of each thread, bounded for
+         z-stacks by the maximum number of segments of a sampled Track */
+      long max_num_segments = sampler.getMaxNumSegments();
+      if (segment_formation == OTF_STACKS) {
+        int max_stack = track_generator_3D->getMaxNumTracksPerStack();
+        memory[0] += num_threads * max_stack * sizeof(Track3D);
+        max_num_segments *= max_stack;
+      }
+      memory[1] = (num_2D_segments + num_threads * max_num_segments) *
+                  sizeof(segment);
+    }
+  }
+
+  /* Boundary and starting angular fluxes and boundary leakages */
+  memory[2] = num_tracks * (4 * fluxes_per_track + 1) * sizeof(float);
+
+  /* Scalar fluxes, sources, volumes, locks and centroids */
+  memory[3] = num_FSRs * (3 * num_groups * sizeof(FP_PRECISION) +
+              sizeof(FP_PRECISION) + sizeof(omp_lock_t) + sizeof(Point) +
+              sizeof(Material*));
+
+  /* Flux and source moments, source constants and matrices */
+  if (_linear_source) {
+    int num_dims = (track_generator_3D == NULL) ? 1 : 2;
+    memory[4] = num_FSRs * ((6 + 3 * num_dims) * num_groups *
+                sizeof(FP_PRECISION) + 3 * num_dims * sizeof(double));
+  }
+
+  /* CMFD currents, tallies, matrices and vectors of the local cells */
+  Cmfd* cmfd = geometry->getCmfd();
+  if (cmfd != NULL) {
+    int num_domains = 1;
+#ifdef MPIx
+    if (geometry->isDomainDecomposed())
+      MPI_Comm_size(geometry->getMPICart(), &num_domains);
+#endif
+    long num_cells = (cmfd->getNumCells() + num_domains - 1) / num_domains;
+    int num_cmfd_groups = cmfd->getNumCmfdGroups();
+    if (num_cmfd_groups == 0)
+      num_cmfd_groups = num_groups;
+    long cell_size = num_cmfd_groups * (2 * NUM_FACES + 14 +
+                                        2 * num_cmfd_groups);
+    memory[5] = num_cells * (cell_size * sizeof(CMFD_PRECISION) +
+                sizeof(omp_lock_t)) + num_FSRs * sizeof(long);
+  }
+
+  /* Transport sweep time of an iteration */
+  double integration_time = _integration_time;
+  if (integration_time == 0.)
+    integration_time = _linear_source ? 2.0E-8 : 1.5E-8;
+  double sweep_time = 2. * fluxes_per_track * num_segments * integration_time
+                      / num_threads;
+
+  /* Sum the counts and take the largest domain */
+  _num_FSRs = num_FSRs;
+  _num_tracks = num_tracks;
+  _num_segments = num_segments;
+  _sweep_time = sweep_time;
+  for (int c=0; c < NUM_MEMORY_CATEGORIES; c++)
+    _memory[c] = memory[c] / 1e6;
+#ifdef MPIx
+  if (geometry->isDomainDecomposed()) {
+    MPI_Comm MPI_cart = geometry->getMPICart();
+    MPI_Allreduce(&num_FSRs, &_num_FSRs, 1, MPI_LONG, MPI_SUM, MPI_cart);
+    MPI_Allreduce(&num_tracks, &_num_tracks, 1, MPI_LONG, MPI_SUM, MPI_cart);
+    MPI_Allreduce(&num_segments, &_num_segments, 1, MPI_LONG, MPI_SUM,
+                  MPI_cart);
+    MPI_Allreduce(&sweep_time, &_sweep_time, 1, MPI_DOUBLE, MPI_MAX,
+                  MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, _memory, NUM_MEMORY_CATEGORIES, MPI_DOUBLE,
+                  MPI_MAX, MPI_cart);
+  }
+#endif
+
+  printReport();
+}
+
+
+/**
+ * @brief Prints the last resource estimate.
+ */
+void ResourceEstimator::printReport() {
+
+  std::string msg_string;
+
+  log_printf(TITLE, "RESOURCE ESTIMATE");
+  log_printf(RESULT, "FSRs = %ld, Tracks = %ld, segments = %ld", _num_FSRs,
+             _num_tracks, _num_segments);
+
+  for (int c=0; c < NUM_MEMORY_CATEGORIES; c++) {
+    msg_string = std::string("  Max ") + memory_categories[c] +
+                 " storage per domain";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%6.2f MB", msg_string.c_str(), _memory[c]);
+  }
+
+  msg_string = "Max total storage per domain";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%6.2f MB", msg_string.c_str(), getTotalMemory());
+
+  msg_string = "Transport sweep time per iteration";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), _sweep_time);
+}
+
+
+/**
+ * @brief Returns the index of a memory category.
+ * @param category the name of the memory category
+ * @return the index of the memory category
+ */
+int ResourceEstimator::getCategoryIndex(const char* category) {
+  for (int c=0; c < NUM_MEMORY_CATEGORIES; c++)
+    if (strcmp(category, memory_categories[c]) == 0)
+      return c;
+  log_printf(ERROR, "Unknown memory category %s", category);
+  return -1;
+}
+
+
+/**
+ * @brief Returns the number of FSRs of the last estimate.
+ * @return the number of FSRs, summed over the domains
+ */
+long ResourceEstimator::getNumFSRs() {
+  return _num_FSRs;
+}
+
+
+/**
+ * @brief Returns the number of Tracks of the last estimate.
+ * @return the number of 3D Tracks in 3D, summed over the domains
+ */
+long ResourceEstimator::getNumTracks() {
+  return _num_tracks;
+}
+
+
+/**
+ * @brief Returns the estimated number of segments.
+ * @return the number of 3D segments in 3D, summed over the domains
+ */
+long ResourceEstimator::getNumSegments() {
+  return _num_segments;
+}
+
+
+/**
+ * @brief Returns the estimated memory of a category.
+ * @param category "tracks", "segments", "angular fluxes", "fsr data",
+ *        "linear source" or "cmfd"
+ * @return the memory of the largest domain in MB
+ */
+double ResourceEstimator::getMemory(const char* category) {
+  return _memory[getCategoryIndex(category)];
+}
+
+
+/**
+ * @brief Returns the estimated total memory.
+ * @return the sum of the memory categories of the largest domains in MB
+ */
+double ResourceEstimator::getTotalMemory() {
+  double total = 0.;
+  for (int c=0; c < NUM_MEMORY_CATEGORIES; c++)
+    total += _memory[c];
+  return total;
+}
+
+
+/**
+ * @brief Returns the estimated transport sweep time of an iteration.
+ * @return the sweep time of the slowest domain in seconds
+ */
+double ResourceEstimator::getSweepTime() {
+  return _sweep_time;
+}
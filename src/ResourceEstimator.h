@@ -0,0 +1,82 @@
+/**
+ * @file ResourceEstimator.h
+ * @brief The ResourceEstimator class.
+ * @date October 18, 2026
+ */
+
+#ifndef RESOURCEESTIMATOR_H_
+#define RESOURCEESTIMATOR_H_
+
+#ifdef __cplusplus
+#include "TrackGenerator3D.h"
+#endif
+
+
+/** The number of memory categories of a resource estimate */
+#define NUM_MEMORY_CATEGORIES 6
+
+
+/**
+ * @class ResourceEstimator ResourceEstimator.h "src/ResourceEstimator.h"
+ * @brief Estimates the memory and the transport sweep time of a calculation
+ *        before running it.
+ * @details The estimate is made from a dry run of the TrackGenerator, which
+ *          lays down the 2D Tracks and the FSRs without forming the 3D
+ *          segments. The segments of the 3D Tracks are counted on the
+ *          z-stacks of a sample of the 2D Tracks. The memory of each domain
+ *          is predicted for the Tracks, the segments, the angular and scalar
+ *          fluxes, the linear source arrays and the CMFD solver, and the
+ *          sweep time from a calibrated integration time per segment, group
+ *          and thread.
+ */
+class ResourceEstimator {
+
+private:
+
+  /** The TrackGenerator of the calculation */
+  TrackGenerator* _track_generator;
+
+  /** The fraction of 2D Tracks whose 3D Tracks are traced */
+  double _sample_fraction;
+
+  /** Whether the calculation uses a linear source approximation */
+  bool _linear_source;
+
+  /** The integration time per segment, group and thread */
+  double _integration_time;
+
+  /** The number of FSRs, Tracks and segments, summed over the domains */
+  long _num_FSRs;
+  long _num_tracks;
+  long _num_segments;
+
+  /** The memory of each category in MB, maximum over the domains */
+  double _memory[NUM_MEMORY_CATEGORIES];
+
+  /** The transport sweep time of an iteration, maximum over the domains */
+  double _sweep_time;
+
+  int getCategoryIndex(const char* category);
+
+public:
+
+  ResourceEstimator(TrackGenerator* track_generator);
+  virtual ~ResourceEstimator();
+
+  void setSampleFraction(double fraction);
+  void useLinearSource(bool linear_source);
+  void setIntegrationTime(double time);
+
+  void estimate();
+  void printReport();
+
+  long getNumFSRs();
+  long getNumTracks();
+  long getNumSegments();
+  double getMemory(const char* category);
+  double getTotalMemory();
+  double getSweepTime();
+};
+
+
+#endif /* RESOURCEESTIMATOR_H_ */
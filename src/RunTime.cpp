@@ -141,8 +141,21 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
       arg_index++;
       _geo_filename = std::string(argv[arg_index++]);
     }
+    else if(strcmp(argv[arg_index], "-synthetic_core") == 0) {
+      arg_index++;
+      _synthetic_core.clear();
+      char *buf = argv[arg_index];
+      char *outer_ptr = NULL;
+      char *p;
+      while((p = strtok_r(buf, ",", &outer_ptr)) != NULL) {
+        _synthetic_core.push_back(atoi(p));
+        buf = NULL;
+      }
+      arg_index++;
+    }
     else if(strcmp(argv[arg_index], "-widths_x") == 0) {
       arg_index++;
+      _cell_widths_x.clear();
       char *buf = argv[arg_index];
       char *outer_ptr = NULL;
       char *p;
@@ -161,6 +174,7 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
     }
     else if(strcmp(argv[arg_index], "-widths_y") == 0) {
       arg_index++;
+      _cell_widths_y.clear();
       char *buf = argv[arg_index];
       char *outer_ptr = NULL;
       char *p;
@@ -179,6 +193,7 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
     }
     else if(strcmp(argv[arg_index], "-widths_z") == 0) {
       arg_index++;
+      _cell_widths_z.clear();
       char *buf = argv[arg_index];
       char *outer_ptr = NULL;
       char *p;
@@ -201,6 +216,7 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
     }
     else if(strcmp(argv[arg_index], "-seg_zones") == 0) {
       arg_index++;
+      _seg_zones.clear();
       char *buf = argv[arg_index];
       char *outer_ptr = NULL;
       char *p;
@@ -235,6 +251,7 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
     }
     else if(strcmp(argv[arg_index], "-CMFD_group_structure") == 0) {
       arg_index++;
+      _CMFD_group_structure.clear();
       char *buf = argv[arg_index];
       char *outer_ptr = NULL;
       char *inner_ptr = NULL;
@@ -275,6 +292,58 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
       arg_index++;
       _quadraturetype = atoi(argv[arg_index++]);
     } 
+    else if(strcmp(argv[arg_index], "-segment_statistics") == 0) {
+      arg_index++;
+      _segment_statistics_filename = std::string(argv[arg_index++]);
+    }
+    else if(strcmp(argv[arg_index], "-memory_budget") == 0) {
+      arg_index++;
+      _memory_budget = atof(argv[arg_index++]);
+    }
+    else if(strcmp(argv[arg_index], "-batch_filename") == 0) {
+      arg_index++;
+      _batch_filename = std::string(argv[arg_index++]);
+    }
+    else if(strcmp(argv[arg_index], "-perturb_material_xs") == 0) {
+      arg_index++;
+      std::string perturbation(argv[arg_index]);
+      char *buf = argv[arg_index];
+      char *outer_ptr = NULL;
+      char *id = strtok_r(buf, ",", &outer_ptr);
+      char *xs = strtok_r(NULL, ",", &outer_ptr);
+      char *factor = strtok_r(NULL, ",", &outer_ptr);
+      char *id_end = NULL;
+      char *factor_end = NULL;
+      if (factor != NULL && strtok_r(NULL, ",", &outer_ptr) == NULL) {
+        _perturbed_material_ids.push_back(strtol(id, &id_end, 10));
+        _perturbed_xs.push_back(std::string(xs));
+        _perturbation_factors.push_back(strtod(factor, &factor_end));
+      }
+      if (id_end == NULL || *id_end != '\0' || *factor_end != '\0')
+        log_printf(ERROR, "Unable to parse the cross section perturbation "
+                   "%s, expected material,xs,factor", perturbation.c_str());
+      arg_index++;
+    }
+    else if(strcmp(argv[arg_index], "-fixed_source") == 0) {
+      arg_index++;
+      std::string source(argv[arg_index]);
+      char *buf = argv[arg_index];
+      char *outer_ptr = NULL;
+      char *p;
+      char *end;
+      bool parsed = true;
+      std::vector<double> tmp;
+      while((p = strtok_r(buf, ",", &outer_ptr)) != NULL) {
+        tmp.push_back(strtod(p, &end));
+        parsed = parsed && *end == '\0';
+        buf = NULL;
+      }
+      if (!parsed || tmp.size() != 3)
+        log_printf(ERROR, "Unable to parse the fixed source %s, expected "
+                   "material,group,source", source.c_str());
+      _fixed_sources.push_back(tmp);
+      arg_index++;
+    }
     else if(strcmp(argv[arg_index], "-non_uniform_output") == 0) {
       arg_index++;
       char *buf = argv[arg_index];
@@ -306,7 +375,7 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
       arg_index++;
     }
   }
-  int myid;
+  int myid = 0;
 #ifdef MPIx
   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
 #endif
@@ -350,6 +419,7 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
       "-non_uniform_output      1.26*3/1*3/4.*3/-1.,1.,-1. -output_type 1  \\\n"
       "-verbose_report          1                                          \\\n"
       "-time_report             1                                          \\\n"
+      "-batch_filename          cases.txt                                  \\\n"
     );
 
     printf("\n");
@@ -363,6 +433,17 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
     printf("-log_filename           : (NULL) the file name of the log file\n");
     printf("-geo_filename           : (NULL) the file name of the geometry "
            "file\n");
+    printf("-synthetic_core         : (NULL) builds a synthetic core instead "
+           "of loading the\n"
+           "                          geometry file, from pins per assembly,"
+           " assemblies,\n"
+           "                          fuel rings, moderator rings, sectors, "
+           "axial zones,\n"
+           "                          groups, reflector and lattice depth, "
+           "e.g.\n"
+           "                          17,3,1,1,4,1,7,0,2\n");
+    printf("-memory_budget          : (0) memory budget of each domain in MB, "
+           "0 for no budget\n");
     printf("\n");
 
     printf("Track generating parameters\n");
@@ -435,6 +516,32 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
            "report\n");
     printf("-time_report            : (1) switch of the time report\n");
     printf("-test_run               : (0) switch of the test running mode\n");
+    printf("-segment_statistics     : (NULL) the file name of the segment "
+           "length, optical length and\n"
+           "                          segment count statistics, computed "
+           "after the track generation\n");
+    printf("\n");
+
+    printf("Batch parameters\n");
+    printf("-batch_filename         : (NULL) the file name of a list of cases, "
+           "with the run time options\n"
+           "                          of one case per line, which override the "
+           "command line options.\n"
+           "                          The geometry, tracks and solver are "
+           "shared by consecutive cases\n"
+           "                          with the same parameters. Lines starting "
+           "with '#' are ignored\n");
+    printf("-perturb_material_xs    : (NULL) multiply a cross section of a "
+           "material, e.g. 2,nu_sigma_f,1.01.\n"
+           "                          The cross sections are sigma_t, sigma_a, "
+           "sigma_s, sigma_f and nu_sigma_f,\n"
+           "                          sigma_a is recomputed when sigma_t or "
+           "sigma_s is perturbed\n");
+    printf("-fixed_source           : (NULL) set a fixed source in a material "
+           "and group, e.g. 1,1,0.5,\n"
+           "                          for a fixed source calculation with a "
+           "TOTAL_SOURCE residual instead\n"
+           "                          of an eigenvalue calculation\n");
 
     printf("\n");
   }
@@ -445,4 +552,79 @@ int RuntimeParameters::setRuntimeParameters(int argc, char *argv[]) {
 #endif
     return 0;
   }
+
+  return 0;
+}
+
+
+/**
+ * @brief Reads the cases of the batch file.
+ * @details Each line of the batch file holds the run time options of a case,
+ *          separated by spaces, which override the options of this
+ *          RuntimeParameters. Empty lines and lines starting with '#' are
+ *          ignored.
+ * @return the run time options of each case
+ */
+std::vector<std::vector<std::string> > RuntimeParameters::readBatchFile() {
+
+  std::vector<std::vector<std::string> > cases;
+  std::ifstream batch_file(_batch_filename.c_str());
+  if (!batch_file.is_open()) {
+    printf("Unable to open the batch file %s\n", _batch_filename.c_str());
+    return cases;
+  }
+
+  std::string line;
+  while (std::getline(batch_file, line)) {
+    std::istringstream words(line);
+    std::vector<std::string> options;
+    std::string word;
+    while (words >> word)
+      options.push_back(word);
+    if (!options.empty() && options[0][0] != '#')
+      cases.push_back(options);
+  }
+
+  return cases;
+}
+
+
+/**
+ * @brief Checks whether the Geometry of a case can be reused for another.
+ * @details The Geometry and its FSRs depend on the geometry file, the domain
+ *          decomposition, the modules and the CMFD mesh and group structure.
+ * @param other the run time options of the other case
+ * @return whether the two cases have the same Geometry
+ */
+bool RuntimeParameters::hasSameGeometry(RuntimeParameters& other) {
+  return _geo_filename == other._geo_filename &&
+         _synthetic_core == other._synthetic_core &&
+         _NDx == other._NDx && _NDy == other._NDy && _NDz == other._NDz &&
+         _NMx == other._NMx && _NMy == other._NMy && _NMz == other._NMz &&
+         _NCx == other._NCx && _NCy == other._NCy && _NCz == other._NCz &&
+         _cell_widths_x == other._cell_widths_x &&
+         _cell_widths_y == other._cell_widths_y &&
+         _cell_widths_z == other._cell_widths_z &&
+         _CMFD_group_structure == other._CMFD_group_structure;
+}
+
+
+/**
+ * @brief Checks whether the Tracks and segments of a case can be reused for
+ *        another.
+ * @details The Tracks depend on the Geometry, the quadrature, the track
+ *          spacings, the segmentation and the number of threads.
+ * @param other the run time options of the other case
+ * @return whether the two cases have the same Tracks
+ */
+bool RuntimeParameters::hasSameTracks(RuntimeParameters& other) {
+  return hasSameGeometry(other) &&
+         _azim_spacing == other._azim_spacing &&
+         _num_azim == other._num_azim &&
+         _polar_spacing == other._polar_spacing &&
+         _num_polar == other._num_polar &&
+         _quadraturetype == other._quadraturetype &&
+         _segmentation_type == other._segmentation_type &&
+         _seg_zones == other._seg_zones &&
+         _num_threads == other._num_threads;
 }
@@ -17,7 +17,10 @@
 #ifdef SWIG
 #include "Python.h"
 #endif
+#include "log.h"
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <string.h>
 #include <vector>
 #endif
@@ -42,10 +45,11 @@ struct RuntimeParameters {
     _num_threads(1), _azim_spacing(0.05), _num_azim(64), _polar_spacing(0.75),
     _num_polar(10), _tolerance(1.0E-4), _max_iters(1000), _knearest(1),
     _CMFD_flux_update_on(true), _CMFD_centroid_update_on(false),
-    _use_axial_interpolation(0), _log_filename(NULL), _linear_solver(true),
-    _MOC_src_residual_type(1), _SOR_factor(1.0), _CMFD_relaxation_factor(1.0),
-    _segmentation_type(3), _verbose_report(true), _time_report(true),
-    _log_level((char*)"NORMAL"), _quadraturetype(2), _test_run(false) {}
+    _use_axial_interpolation(0), _log_filename(NULL), _memory_budget(0.),
+    _linear_solver(true), _MOC_src_residual_type(1), _SOR_factor(1.0),
+    _CMFD_relaxation_factor(1.0), _segmentation_type(3), _verbose_report(true),
+    _time_report(true), _log_level((char*)"NORMAL"), _quadraturetype(2),
+    _test_run(false) {}
 
   /* To debug or not when running, dead while loop */
   bool _debug_flag;
@@ -63,9 +67,15 @@ struct RuntimeParameters {
   /* Log file name */
   char* _log_filename;
 
+  /* Memory budget of each domain in MB, 0 for no budget */
+  double _memory_budget;
+
   /* Geometry file name */
   std::string _geo_filename;
 
+  /* Parameters of a synthetic core built instead of loading the geometry */
+  std::vector<int> _synthetic_core;
+
   /* Space and angle quadrature parameters */
   double _azim_spacing;
   int _num_azim;
@@ -136,8 +146,28 @@ struct RuntimeParameters {
   /* whether to run the code for test */
   bool _test_run;
 
+  /* Segment statistics file name, empty to skip the statistics */
+  std::string _segment_statistics_filename;
+
+  /* Batch file name, with the run time options of one case per line */
+  std::string _batch_filename;
+
+  /* Material cross section perturbations, by Material ID, cross section
+     name and multiplication factor */
+  std::vector<int> _perturbed_material_ids;
+  std::vector<std::string> _perturbed_xs;
+  std::vector<double> _perturbation_factors;
+
+  /* Fixed sources, by Material ID, energy group and source */
+  std::vector<std::vector<double> > _fixed_sources;
+
   /* Setter, can be used from command line */
   int setRuntimeParameters(int argc, char *argv[]);
+
+  /* Batch mode utilities */
+  std::vector<std::vector<std::string> > readBatchFile();
+  bool hasSameGeometry(RuntimeParameters& other);
+  bool hasSameTracks(RuntimeParameters& other);
 };
 
 #endif /* RUNTIME_H_ */
@@ -0,0 +1,323 @@
+#include "SPHSolver.h"
+
+/**
+ * @brief Constructor initializes the default iteration parameters.
+ * @param solver the Solver used for the fixed source calculations
+ */
+SPHSolver::SPHSolver(Solver* solver) {
+
+  if (solver == NULL)
+    log_printf(ERROR, "Unable to create an SPHSolver without a Solver");
+
+  _solver = solver;
+  _domain_type = "material";
+  _tolerance = 1E-5;
+  _loose_tolerance = 1E-3;
+  _relaxation_factor = 1.;
+  _warm_start = true;
+  _num_iterations = 0;
+  _num_sweeps = 0;
+  _residual = 0.;
+}
+
+
+/**
+ * @brief Destructor.
+ */
+SPHSolver::~SPHSolver() {
+}
+
+
+/**
+ * @brief Sets the domains in which SPH factors are computed.
+ * @details This may be called from Python as follows:
+ *
+ * @code
+ *          sph_solver.setSPHDomains(numpy.double(domain_ids), "cell")
+ * @endcode
+ *
+ * @param sph_to_domain_ids the IDs of the Materials or Cells, as doubles
+ * @param num_sph_domains the number of SPH domains
+ * @param domain_type the type of domains, "material" or "cell"
+ */
+void SPHSolver::setSPHDomains(double* sph_to_domain_ids, int num_sph_domains,
+                              const char* domain_type) {
+
+  if (strcmp(domain_type, "material") != 0 && strcmp(domain_type, "cell") != 0)
+    log_printf(ERROR, "Domain type %s is not supported for SPH factors",
+               domain_type);
+
+  _domain_type = domain_type;
+  _domain_ids.assign(sph_to_domain_ids, sph_to_domain_ids + num_sph_domains);
+}
+
+
+/**
+ * @brief Sets the reference fluxes the SPH factors should preserve.
+ * @details The reference fluxes are indexed by SPH domain, in the order of
+ *          the domain IDs, with the energy group in the inner loop. They are
+ *          normalized like the fixed sources, e.g. reference fluxes from
+ *          a Monte Carlo tally normalized to the reference sources.
+ * @param reference_fluxes the reference fluxes
+ * @param num_domains_groups the number of SPH domains times energy groups
+ */
+void SPHSolver::setReferenceFluxes(double* reference_fluxes,
+                                   int num_domains_groups) {
+  _reference_fluxes.assign(reference_fluxes,
+                           reference_fluxes + num_domains_groups);
+}
+
+
+/**
+ * @brief Sets the tolerance on the relative change of the SPH factors.
+ * @param tolerance the convergence tolerance (1E-5 by default)
+ */
+void SPHSolver::setConvergenceThreshold(double tolerance) {
+  if (tolerance <= 0)
+    log_printf(ERROR, "Unable to set a non-positive SPH convergence "
+               "threshold %f", tolerance);
+  _tolerance = tolerance;
+}
+
+
+/**
+ * @brief Sets the loosest convergence threshold of the fixed source
+ *        calculations.
+ * @details The fixed source calculations are converged to a tenth of the
+ *          last change of the SPH factors, between the Solver's convergence
+ *          threshold and this threshold. The SPH factors are only converged
+ *          once a calculation used the Solver's threshold.
+ * @param tolerance the loosest convergence threshold (1E-3 by default)
+ */
+void SPHSolver::setLooseConvergenceThreshold(double tolerance) {
+  if (tolerance <= 0)
+    log_printf(ERROR, "Unable to set a non-positive loose convergence "
+               "threshold %f", tolerance);
+  _loose_tolerance = tolerance;
+}
+
+
+/**
+ * @brief Sets the relaxation factor on the SPH factor updates.
+ * @details Relaxation factors below 1 dampen the fixed point iteration, which
+ *          helps convergence with many SPH domains.
+ * @param relaxation_factor the relaxation factor (1 by default)
+ */
+void SPHSolver::setRelaxationFactor(double relaxation_factor) {
+  if (relaxation_factor <= 0 || relaxation_factor > 1)
+    log_printf(ERROR, "Unable to set the SPH relaxation factor to %f, which "
+               "is not between 0 and 1", relaxation_factor);
+  _relaxation_factor = relaxation_factor;
+}
+
+
+/**
+ * @brief Sets whether each fixed source calculation starts from the boundary
+ *        angular fluxes of the previous one.
+ * @details The scalar fluxes are computed from the fixed sources only, so the
+ *          angular fluxes are the only initial guess of a calculation. Cold
+ *          starts re-initialize them at each SPH iteration, which is mostly
+ *          useful to compare with warm starts.
+ * @param warm_start whether to warm start the calculations (true by default)
+ */
+void SPHSolver::setWarmStart(bool warm_start) {
+  _warm_start = warm_start;
+}
+
+
+/**
+ * @brief Iterates the SPH factors until their relative change is below the
+ *        convergence threshold.
+ * @details The SPH factors are loaded into the cross sections of the
+ *          Geometry after each iteration, so the cross sections of the SPH
+ *          domains include the final factors on return. This may be called
+ *          from Python as follows:
+ *
+ * @code
+ *          sph_solver = openmoc.SPHSolver(solver)
+ *          sph_solver.setSPHDomains(numpy.double(domain_ids), "material")
+ *          sph_solver.setReferenceFluxes(reference_fluxes.flatten())
+ *          sph_solver.computeSPHFactors(max_sph_iters=30)
+ * @endcode
+ *
+ * @param max_sph_iters the maximum number of SPH iterations
+ * @param max_flux_iters the maximum number of source iterations of each fixed
+ *        source calculation
+ */
+void SPHSolver::computeSPHFactors(int max_sph_iters, int max_flux_iters) {
+
+  Geometry* geometry = _solver->getGeometry();
+  int num_groups = geometry->getNumEnergyGroups();
+  int num_domains = _domain_ids.size();
+  int size = num_domains * num_groups;
+
+  if (num_domains == 0)
+    log_printf(ERROR, "Unable to compute SPH factors without SPH domains");
+  if ((int)_reference_fluxes.size() != size)
+    log_printf(ERROR, "Unable to compute SPH factors in %d domains and %d "
+               "groups with %d reference fluxes", num_domains, num_groups,
+               (int)_reference_fluxes.size());
+
+  log_printf(NORMAL, "Computing SPH factors for %d %s domains...",
+             num_domains, _domain_type.c_str());
+
+  /* Map the FSRs to the SPH domains */
+  std::map<int, int> domain_indexes;
+  for (int d=0; d < num_domains; d++)
+    domain_indexes[int(_domain_ids[d])] = d;
+
+  long num_FSRs = geometry->getNumFSRs();
+  std::vector<int> FSR_domains(num_FSRs, -1);
+  bool by_material = (_domain_type == "material");
+  for (long r=0; r < num_FSRs; r++) {
+    Cell* cell = geometry->findCellContainingFSR(r);
+    int id = by_material ? cell->getFillMaterial()->getId() : cell->getId();
+    std::map<int, int>::iterator iter = domain_indexes.find(id);
+    if (iter != domain_indexes.end())
+      FSR_domains[r] = iter->second;
+  }
+
+  _sph_factors.assign(size, 1.);
+  std::vector<double> domain_fluxes(size);
+  std::vector<double> domain_volumes(num_domains);
+  std::vector<double> sph_updates(size);
+
+  double final_tolerance = _solver->getConvergenceThreshold();
+  double tolerance = std::max(_loose_tolerance, final_tolerance);
+  int log_level = get_log_level();
+  _num_sweeps = 0;
+
+  for (_num_iterations=1; _num_iterations <= max_sph_iters;
+       _num_iterations++) {
+
+    /* Converge the fluxes with the current cross sections. The sources are
+       the fixed reference sources only, so the boundary angular fluxes of the
+       previous calculation are the initial guess */
+    _solver->setConvergenceThreshold(tolerance);
+    if (log_level == NORMAL)
+      set_log_level(WARNING);
+    _solver->computeFlux(max_flux_iters);
+    set_log_level(log_level);
+    _num_sweeps += std::min(_solver->getNumIterations() + 1, max_flux_iters);
+    if (_num_iterations == 1 && _warm_start)
+      _solver->setRestartStatus(true);
+
+    /* Compute the volume-averaged fluxes of the SPH domains */
+    FP_PRECISION* fluxes = _solver->getFluxesArray();
+    std::fill(domain_fluxes.begin(), domain_fluxes.end(), 0.);
+    std::fill(domain_volumes.begin(), domain_volumes.end(), 0.);
+    for (long r=0; r < num_FSRs; r++) {
+      int d = FSR_domains[r];
+      if (d < 0)
+        continue;
+      double volume = _solver->getFSRVolume(r);
+      domain_volumes[d] += volume;
+      for (int g=0; g < num_groups; g++)
+        domain_fluxes[d*num_groups + g] += fluxes[r*num_groups + g] * volume;
+    }
+#ifdef MPIx
+    if (geometry->isDomainDecomposed()) {
+      MPI_Allreduce(MPI_IN_PLACE, &domain_fluxes[0], size, MPI_DOUBLE,
+                    MPI_SUM, geometry->getMPICart());
+      MPI_Allreduce(MPI_IN_PLACE, &domain_volumes[0], num_domains, MPI_DOUBLE,
+                    MPI_SUM, geometry->getMPICart());
+    }
+#endif
+
+    /* Update the SPH factors */
+    _residual = 0.;
+    for (int d=0; d < num_domains; d++) {
+      for (int g=0; g < num_groups; g++) {
+        int i = d*num_groups + g;
+        double sph = 1.;
+        if (domain_volumes[d] > 0. && domain_fluxes[i] > 0.)
+          sph = _reference_fluxes[i] * domain_volumes[d] / domain_fluxes[i];
+        if (sph == 0.)
+          sph = 1.;
+
+        double old_sph = _sph_factors[i];
+        _residual = std::max(_residual, fabs(sph - old_sph) / old_sph);
+        sph = _relaxation_factor * sph + (1. - _relaxation_factor) * old_sph;
+        sph_updates[i] = sph / old_sph;
+        _sph_factors[i] = sph;
+      }
+    }
+
+    /* Scale the cross sections by the change of the SPH factors */
+    geometry->loadSPHFactors(&sph_updates[0], size, &_domain_ids[0],
+                             num_domains, _domain_type.c_str());
+
+    log_printf(NORMAL, "SPH Iteration %d:\tres = %1.3E\tflux tolerance = "
+               "%1.1E", _num_iterations, _residual, tolerance);
+
+    /* Only converge once the fluxes used the final tolerance */
+    if (_num_iterations > 1 && _residual < _tolerance &&
+        tolerance <= final_tolerance)
+      break;
+
+    tolerance = std::min(_loose_tolerance,
+                         std::max(final_tolerance, 0.1 * _residual));
+  }
+
+  if (_num_iterations > max_sph_iters) {
+    _num_iterations = max_sph_iters;
+    log_printf(WARNING, "SPH factors did not converge");
+  }
+
+  /* Restore the Solver settings */
+  _solver->setConvergenceThreshold(final_tolerance);
+  _solver->setRestartStatus(false);
+
+  log_printf(RESULT, "SPH factors converged in %d iterations and %d "
+             "transport sweeps", _num_iterations, _num_sweeps);
+}
+
+
+/**
+ * @brief Returns the number of SPH iterations of the last calculation.
+ * @return the number of SPH iterations
+ */
+int SPHSolver::getNumIterations() {
+  return _num_iterations;
+}
+
+
+/**
+ * @brief Returns the total number of transport sweeps of the fixed source
+ *        calculations of the last calculation.
+ * @return the number of transport sweeps
+ */
+int SPHSolver::getNumTransportSweeps() {
+  return _num_sweeps;
+}
+
+
+/**
+ * @brief Returns the maximum relative change of the SPH factors at the last
+ *        iteration.
+ * @return the SPH factor residual
+ */
+double SPHSolver::getResidual() {
+  return _residual;
+}
+
+
+/**
+ * @brief Copies the SPH factors into an array indexed by SPH domain and
+ *        group.
+ * @details This may be called from Python to retrieve a NumPy array:
+ *
+ * @code
+ *          sph = sph_solver.getSPHFactors(num_domains * num_groups)
+ * @endcode
+ *
+ * @param out_sph_factors the array of SPH factors to fill
+ * @param num_domains_groups the number of SPH domains times energy groups
+ */
+void SPHSolver::getSPHFactors(double* out_sph_factors,
+                              int num_domains_groups) {
+  if (num_domains_groups != (int)_sph_factors.size())
+    log_printf(ERROR, "Unable to get %d SPH factors in an array of size %d",
+               (int)_sph_factors.size(), num_domains_groups);
+  std::copy(_sph_factors.begin(), _sph_factors.end(), out_sph_factors);
+}
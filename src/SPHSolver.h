@@ -0,0 +1,93 @@
+/**
+ * @file SPHSolver.h
+ * @brief The SPHSolver class.
+ * @date October 18, 2026
+ */
+
+#ifndef SPHSOLVER_H_
+#define SPHSOLVER_H_
+
+#ifdef __cplusplus
+#include "Solver.h"
+#endif
+
+
+/**
+ * @class SPHSolver SPHSolver.h "src/SPHSolver.h"
+ * @brief Computes SuPerHomogenization (SPH) factors with fixed source
+ *        calculations.
+ * @details The SPH factor of a domain and group is the ratio of a reference
+ *          flux to the volume-averaged MOC flux in the domain. The factors are
+ *          iterated to a fixed point with fixed source calculations of the
+ *          Solver, each loading the updated factors into the cross sections
+ *          with Geometry::loadSPHFactors. The angular fluxes of each
+ *          calculation are the initial guess for the next, and the
+ *          calculations are converged to a loose tolerance that tightens to
+ *          the Solver's convergence threshold as the factors converge. The
+ *          fixed sources, e.g. the reference scattering and fission sources,
+ *          must be set in the Solver beforehand.
+ */
+class SPHSolver {
+
+private:
+
+  /** The Solver used for the fixed source calculations */
+  Solver* _solver;
+
+  /** The type of SPH domains, "material" or "cell" */
+  std::string _domain_type;
+
+  /** The IDs of the SPH domains, as doubles for Geometry::loadSPHFactors */
+  std::vector<double> _domain_ids;
+
+  /** The reference fluxes indexed by SPH domain and group */
+  std::vector<double> _reference_fluxes;
+
+  /** The SPH factors indexed by SPH domain and group */
+  std::vector<double> _sph_factors;
+
+  /** The tolerance on the relative change of the SPH factors */
+  double _tolerance;
+
+  /** The loosest tolerance of the fixed source calculations */
+  double _loose_tolerance;
+
+  /** The relaxation factor on the SPH factor updates */
+  double _relaxation_factor;
+
+  /** Whether each calculation starts from the angular fluxes of the previous
+   *  one */
+  bool _warm_start;
+
+  /** The number of SPH iterations of the last calculation */
+  int _num_iterations;
+
+  /** The number of transport sweeps of the last calculation */
+  int _num_sweeps;
+
+  /** The maximum relative change of the SPH factors at the last iteration */
+  double _residual;
+
+public:
+
+  SPHSolver(Solver* solver);
+  virtual ~SPHSolver();
+
+  void setSPHDomains(double* sph_to_domain_ids, int num_sph_domains,
+                     const char* domain_type);
+  void setReferenceFluxes(double* reference_fluxes, int num_domains_groups);
+  void setConvergenceThreshold(double tolerance);
+  void setLooseConvergenceThreshold(double tolerance);
+  void setRelaxationFactor(double relaxation_factor);
+  void setWarmStart(bool warm_start);
+
+  void computeSPHFactors(int max_sph_iters=30, int max_flux_iters=1000);
+
+  int getNumIterations();
+  int getNumTransportSweeps();
+  double getResidual();
+  void getSPHFactors(double* out_sph_factors, int num_domains_groups);
+};
+
+
+#endif /* SPHSOLVER_H_ */
@@ -74,9 +74,15 @@ Solver::Solver(TrackGenerator* track_generator) {
   _fixed_sources_initialized = false;
   _correct_xs = false;
   _stabilize_transport = false;
+  _axial_refinement_tolerance = 0.;
+  _axial_refinement_interval = 10;
+  _max_axial_refinements = 0;
+  _num_axial_refinements = 0;
   _verbose = false;
   _calculate_initial_spectrum = false;
   _initial_spectrum_thresh = 1.0;
+  _diffusion_initial_guess = false;
+  _diffusion_guess_thresh = 1E-5;
   _load_initial_FSR_fluxes = false;
   _calculate_residuals_by_reference = false;
   _negative_fluxes_allowed = false;
@@ -152,6 +158,7 @@ Solver::~Solver() {
   }
 
   delete _timer;
+  release_memory(this);
 }
 
 
@@ -681,6 +688,43 @@ void Solver::stabilizeTransport(double stabilization_factor,
 }
 
 
+/**
+ * @brief Instructs the eigenvalue solver to refine the axial mesh of the FSRs
+ *        where the axial flux shape is poorly resolved.
+ * @details The calculation starts on the axial mesh set up by the geometry
+ *          and the TrackGenerator3D, which can therefore be coarse. Every
+ *          num_iterations source iterations, and when the source converges,
+ *          the axial flux shape error of each FSR is estimated and the FSRs
+ *          above the tolerance are split in two halves axially, up to
+ *          max_refinements times. Fluxes are remapped onto the refined FSRs
+ *          and the source iteration continues. Refinement requires 3D
+ *          on-the-fly ray tracing (OTF_TRACKS or OTF_STACKS) without a global
+ *          z-mesh.
+ *
+ * @code
+ *          solver.useAdaptiveAxialMesh(0.02, 10, 3)
+ * @endcode
+ *
+ * @param tolerance the relative axial flux shape error to refine beyond
+ * @param num_iterations the number of source iterations between refinements
+ * @param max_refinements the maximum number of refinements
+ */
+void Solver::useAdaptiveAxialMesh(double tolerance, int num_iterations,
+                                  int max_refinements) {
+
+  if (tolerance <= 0.)
+    log_printf(ERROR, "Unable to use an adaptive axial mesh with a "
+               "non-positive tolerance %f", tolerance);
+  if (num_iterations < 1)
+    log_printf(ERROR, "Unable to refine the axial mesh every %d iterations",
+               num_iterations);
+
+  _axial_refinement_tolerance = tolerance;
+  _axial_refinement_interval = num_iterations;
+  _max_axial_refinements = max_refinements;
+}
+
+
 /**
  * @brief Instructs OpenMOC to perform an initial spectrum calculation
  * @param threshold The convergence threshold of the spectrum calculation
@@ -691,6 +735,25 @@ void Solver::setInitialSpectrumCalculation(double threshold) {
 }
 
 
+/**
+ * @brief Instructs OpenMOC to start eigenvalue calculations from the solution
+ *        of the diffusion problem on the CMFD mesh.
+ * @details The cross sections of each CMFD cell are homogenized with its
+ *          infinite medium spectrum, and the diffusion eigenvalue problem is
+ *          solved without transport corrections. The CMFD solution is
+ *          prolonged to the FSRs as the starting scalar flux and eigenvalue.
+ *          This requires CMFD acceleration.
+ * @param threshold the convergence threshold of the diffusion solve
+ */
+void Solver::useDiffusionInitialGuess(double threshold) {
+  if (threshold <= 0)
+    log_printf(ERROR, "Unable to set a non-positive convergence threshold %f "
+               "for the diffusion initial guess", threshold);
+  _diffusion_initial_guess = true;
+  _diffusion_guess_thresh = threshold;
+}
+
+
 /**
  * @brief Determines which log level to set cross-section warnings
  * @details The default log level is ERROR
@@ -1252,6 +1315,339 @@ void Solver::calculateInitialSpectrum(double threshold) {
 }
 
 
+/**
+ * @brief Solves the diffusion problem on the CMFD mesh to compute a starting
+ *        guess of the scalar fluxes and eigenvalue.
+ * @details The scalar flux of each CMFD cell is first set to the infinite
+ *          medium spectrum of the cell, solution of
+ *          \f$ (\Sigma_t - \Sigma_s) \phi = \chi \f$ with volume-homogenized
+ *          cross sections. Since the fission matrix of the cell is the outer
+ *          product of \f$ \chi \f$ and \f$ \nu\Sigma_f \f$, this is its
+ *          fundamental mode. Cells without fissionable materials use the
+ *          average fission spectrum of the problem. The cross sections are
+ *          then collapsed with this spectrum by the CMFD solver, and the
+ *          diffusion eigenvalue problem without transport corrections is
+ *          solved and prolonged to the FSRs.
+ * @param threshold the convergence threshold of the diffusion solve
+ */
+void Solver::computeDiffusionInitialGuess(double threshold) {
+
+  if (_cmfd == NULL || !_cmfd->isFluxUpdateOn())
+    log_printf(ERROR, "Unable to compute a diffusion initial guess without "
+               "CMFD acceleration");
+
+  log_printf(NORMAL, "Computing the diffusion initial guess...");
+
+  int num_groups = _num_groups;
+
+  /* Compute the average fission spectrum with a flat flux */
+  std::vector<double> average_chi(num_groups, 0.);
+  for (long r=0; r < _num_FSRs; r++) {
+    Material* material = _FSR_materials[r];
+    if (!material->isFissionable())
+      continue;
+    FP_PRECISION* nu_sigma_f = material->getNuSigmaF();
+    FP_PRECISION* chi = material->getChi();
+    double fission = 0.;
+    for (int g=0; g < num_groups; g++)
+      fission += nu_sigma_f[g];
+    for (int g=0; g < num_groups; g++)
+      average_chi[g] += _FSR_volumes[r] * fission * chi[g];
+  }
+#ifdef MPIx
+  if (_geometry->isDomainDecomposed())
+    MPI_Allreduce(MPI_IN_PLACE, &average_chi[0], num_groups, MPI_DOUBLE,
+                  MPI_SUM, _geometry->getMPICart());
+#endif
+  double total_chi = 0.;
+  for (int g=0; g < num_groups; g++)
+    total_chi += average_chi[g];
+  if (total_chi == 0.)
+    log_printf(ERROR, "Unable to compute a diffusion initial guess without "
+               "fissionable materials");
+  for (int g=0; g < num_groups; g++)
+    average_chi[g] /= total_chi;
+
+  /* Set the flux of each CMFD cell to its infinite medium spectrum */
+  std::vector<std::vector<long> >* cell_fsrs = _cmfd->getCellFSRs();
+  int num_cells = cell_fsrs->size();
+
+#pragma omp parallel
+  {
+    std::vector<double> A(num_groups * num_groups);
+    std::vector<double> phi(num_groups);
+
+#pragma omp for schedule(dynamic)
+    for (int i=0; i < num_cells; i++) {
+
+      std::vector<long>& fsrs = cell_fsrs->at(i);
+      if (fsrs.empty())
+        continue;
+
+      /* Homogenize the removal matrix and the fission spectrum */
+      std::fill(A.begin(), A.end(), 0.);
+      std::fill(phi.begin(), phi.end(), 0.);
+      double fission = 0.;
+      for (size_t j=0; j < fsrs.size(); j++) {
+        long r = fsrs[j];
+        Material* material = _FSR_materials[r];
+        FP_PRECISION volume = _FSR_volumes[r];
+        FP_PRECISION* sigma_t = material->getSigmaT();
+        FP_PRECISION* sigma_s = material->getSigmaS();
+        for (int g=0; g < num_groups; g++) {
+          A[g*num_groups + g] += volume * sigma_t[g];
+          for (int gp=0; gp < num_groups; gp++)
+            A[g*num_groups + gp] -= volume * sigma_s[g*num_groups + gp];
+        }
+        if (material->isFissionable()) {
+          FP_PRECISION* nu_sigma_f = material->getNuSigmaF();
+          FP_PRECISION* chi = material->getChi();
+          double fsr_fission = 0.;
+          for (int g=0; g < num_groups; g++)
+            fsr_fission += volume * nu_sigma_f[g];
+          for (int g=0; g < num_groups; g++)
+            phi[g] += fsr_fission * chi[g];
+          fission += fsr_fission;
+        }
+      }
+      for (int g=0; g < num_groups; g++)
+        phi[g] = (fission > 0.) ? phi[g] / fission : average_chi[g];
+
+      /* Solve for the spectrum by Gaussian elimination with pivoting */
+      bool singular = false;
+      for (int k=0; k < num_groups && !singular; k++) {
+        int p = k;
+        for (int g=k+1; g < num_groups; g++)
+          if (fabs(A[g*num_groups + k]) > fabs(A[p*num_groups + k]))
+            p = g;
+        if (A[p*num_groups + k] == 0.) {
+          singular = true;
+          break;
+        }
+        if (p != k) {
+          for (int gp=0; gp < num_groups; gp++)
+            std::swap(A[k*num_groups + gp], A[p*num_groups + gp]);
+          std::swap(phi[k], phi[p]);
+        }
+        for (int g=k+1; g < num_groups; g++) {
+          double factor = A[g*num_groups + k] / A[k*num_groups + k];
+          for (int gp=k; gp < num_groups; gp++)
+            A[g*num_groups + gp] -= factor * A[k*num_groups + gp];
+          phi[g] -= factor * phi[k];
+        }
+      }
+      for (int g=num_groups-1; g >= 0 && !singular; g--) {
+        for (int gp=g+1; gp < num_groups; gp++)
+          phi[g] -= A[g*num_groups + gp] * phi[gp];
+        phi[g] /= A[g*num_groups + g];
+        if (!(phi[g] > 0.))
+          singular = true;
+      }
+
+      /* Keep the flat flux if the cell has no physical spectrum */
+      if (singular)
+        continue;
+
+      for (size_t j=0; j < fsrs.size(); j++)
+        for (int g=0; g < num_groups; g++)
+          _scalar_flux(fsrs[j], g) = phi[g];
+    }
+  }
+
+  /* Solve the diffusion problem and prolong its solution to the FSRs */
+  _cmfd->setSourceConvergenceThreshold(threshold);
+  _k_eff = _cmfd->computeKeff(0);
+  _cmfd->setSourceConvergenceThreshold(_converge_thresh*1.e-1);
+  normalizeFluxes();
+
+  log_printf(NORMAL, "Computed diffusion initial guess with k-eff = %6.6f",
+             _k_eff);
+}
+
+
+/**
+ * @brief Splits the FSRs whose axial flux shape is poorly resolved.
+ * @details The axial flux shape error of an FSR is estimated in every
+ *          extruded FSR as the jump of the reconstructed scalar flux across
+ *          its axial interfaces, relative to the volume-averaged flux of the
+ *          energy group so that low flux regions are not over-refined.
+ *          With flat sources this measures the flux variation over the FSR,
+ *          with linear sources the curvature left by the axial flux moments.
+ *          FSRs above the tolerance are split in two halves, the solver
+ *          arrays are re-initialized and the fluxes remapped from the FSRs
+ *          they derive from. Track angular fluxes are kept, so that source
+ *          iterations continue on the refined axial mesh without restart.
+ * @return whether any FSR was split
+ */
+bool Solver::refineAxialMesh() {
+
+  TrackGenerator3D* track_generator_3D =
+    dynamic_cast<TrackGenerator3D*>(_track_generator);
+  if (track_generator_3D == NULL || !_SOLVE_3D)
+    log_printf(ERROR, "Adaptive axial refinement requires a 3D calculation");
+  if (_segment_formation != OTF_TRACKS && _segment_formation != OTF_STACKS)
+    log_printf(ERROR, "Adaptive axial refinement requires on-the-fly axial "
+               "ray tracing, use the OTF_TRACKS or OTF_STACKS segmentation");
+  if (_user_fluxes)
+    log_printf(ERROR, "Unable to refine the axial mesh with a user-provided "
+               "scalar flux array");
+
+  _num_axial_refinements++;
+
+  /* Compute the volume-averaged scalar flux in each group */
+  std::vector<double> average_flux(_num_groups, 0.);
+  double total_volume = 0.;
+  for (long r=0; r < _num_FSRs; r++) {
+    total_volume += _FSR_volumes[r];
+    for (int e=0; e < _num_groups; e++)
+      average_flux[e] += _scalar_flux(r, e) * _FSR_volumes[r];
+  }
+#ifdef MPIx
+  if (_geometry->isDomainDecomposed()) {
+    double domain_volume = total_volume;
+    MPI_Allreduce(&domain_volume, &total_volume, 1, MPI_DOUBLE, MPI_SUM,
+                  _geometry->getMPICart());
+    std::vector<double> domain_flux(average_flux);
+    MPI_Allreduce(&domain_flux[0], &average_flux[0], _num_groups, MPI_DOUBLE,
+                  MPI_SUM, _geometry->getMPICart());
+  }
+#endif
+  for (int e=0; e < _num_groups; e++)
+    average_flux[e] /= total_volume;
+
+  /* Estimate the axial flux shape error from the flux jumps between FSRs */
+  std::vector<double> errors(_num_FSRs, 0.);
+  std::vector<ExtrudedFSR*>& extruded_FSRs = _geometry->getExtrudedFSRLookup();
+  for (size_t i=0; i < extruded_FSRs.size(); i++) {
+
+    ExtrudedFSR* extruded_FSR = extruded_FSRs[i];
+    if (extruded_FSR->_mesh == NULL)
+      log_printf(ERROR, "Adaptive axial refinement requires local axial "
+                 "meshes, it cannot be used with a global z-mesh");
+
+    for (size_t s=1; s < extruded_FSR->_num_fsrs; s++) {
+
+      long fsr_below = extruded_FSR->_fsr_ids[s-1];
+      long fsr_above = extruded_FSR->_fsr_ids[s];
+      double z = extruded_FSR->_mesh[s];
+      double dz_below = z - _geometry->getFSRCentroid(fsr_below)->getZ();
+      double dz_above = z - _geometry->getFSRCentroid(fsr_above)->getZ();
+
+      /* Find the largest normalized flux jump across the interface */
+      double jump = 0.;
+      for (int e=0; e < _num_groups; e++) {
+        double flux_below = _scalar_flux(fsr_below, e) +
+            getAxialFluxSlope(fsr_below, e) * dz_below;
+        double flux_above = _scalar_flux(fsr_above, e) +
+            getAxialFluxSlope(fsr_above, e) * dz_above;
+        if (average_flux[e] > 0.)
+          jump = std::max(jump, std::abs(flux_above - flux_below) /
+                          average_flux[e]);
+      }
+
+      errors[fsr_below] = std::max(errors[fsr_below], jump);
+      errors[fsr_above] = std::max(errors[fsr_above], jump);
+    }
+  }
+
+  /* Select the FSRs to split */
+  std::vector<long> fsr_ids;
+  double max_error = 0.;
+  for (long r=0; r < _num_FSRs; r++) {
+    max_error = std::max(max_error, errors[r]);
+    if (errors[r] > _axial_refinement_tolerance)
+      fsr_ids.push_back(r);
+  }
+
+  long num_split = fsr_ids.size();
+  long total_split = num_split;
+#ifdef MPIx
+  if (_geometry->isDomainDecomposed()) {
+    MPI_Allreduce(&num_split, &total_split, 1, MPI_LONG, MPI_SUM,
+                  _geometry->getMPICart());
+    double domain_max_error = max_error;
+    MPI_Allreduce(&domain_max_error, &max_error, 1, MPI_DOUBLE, MPI_MAX,
+                  _geometry->getMPICart());
+  }
+#endif
+
+  log_printf(NORMAL, "Axial refinement %d: max axial flux shape error = "
+             "%1.3E, splitting %ld FSRs", _num_axial_refinements, max_error,
+             total_split);
+
+  if (total_split == 0)
+    return false;
+
+  /* Split the FSRs and re-initialize the FSR arrays on the refined mesh */
+  std::vector<long> parents = track_generator_3D->splitAxialFSRs(fsr_ids);
+  initializeFSRs();
+  countFissionableFSRs();
+  remapFSRFluxes(parents);
+  initializeSourceArrays();
+  initializeCmfd();
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn() && _is_restart)
+    _cmfd->initialize();
+
+  long total_FSRs = _num_FSRs;
+#ifdef MPIx
+  if (_geometry->isDomainDecomposed())
+    MPI_Allreduce(&_num_FSRs, &total_FSRs, 1, MPI_LONG, MPI_SUM,
+                  _geometry->getMPICart());
+#endif
+  log_printf(NORMAL, "Total number of FSRs %ld", total_FSRs);
+
+  return true;
+}
+
+
+/**
+ * @brief Remaps the scalar fluxes after the FSRs were split axially.
+ * @details Each FSR takes the scalar flux of the FSR it derives from. The
+ *          stabilizing flux is re-computed at the next iteration.
+ * @param parents the ID of the FSR each new FSR derives from
+ */
+void Solver::remapFSRFluxes(std::vector<long>& parents) {
+
+  long num_FSRs = parents.size();
+  long size = num_FSRs * _num_groups;
+  account_memory(this, "scalar fluxes", FLUX_MEMORY, (2 +
+                 (_stabilizing_flux != NULL)) * size * sizeof(FP_PRECISION));
+  FP_PRECISION* scalar_flux = new FP_PRECISION[size];
+  FP_PRECISION* old_scalar_flux = new FP_PRECISION[size];
+
+#pragma omp parallel for
+  for (long r=0; r < num_FSRs; r++) {
+    for (int e=0; e < _num_groups; e++) {
+      scalar_flux[r*_num_groups + e] = _scalar_flux(parents[r], e);
+      old_scalar_flux[r*_num_groups + e] = _old_scalar_flux(parents[r], e);
+    }
+  }
+
+  delete [] _scalar_flux;
+  delete [] _old_scalar_flux;
+  _scalar_flux = scalar_flux;
+  _old_scalar_flux = old_scalar_flux;
+
+  if (_stabilizing_flux != NULL) {
+    delete [] _stabilizing_flux;
+    _stabilizing_flux = new FP_PRECISION[size]();
+  }
+}
+
+
+/**
+ * @brief Returns the axial slope of the scalar flux in an FSR.
+ * @details The flux is flat in each FSR, the slope is zero unless a linear
+ *          source solver reconstructs it from the flux moments.
+ * @param fsr_id the ID of the FSR
+ * @param group the energy group
+ * @return the axial derivative of the scalar flux
+ */
+FP_PRECISION Solver::getAxialFluxSlope(long, int) {
+  return 0.;
+}
+
+
 /**
  * @brief Returns the Material data to its original state.
  * @details In an adjoint calculation, the scattering and fission matrices
@@ -1281,7 +1677,7 @@ void Solver::resetMaterials(solverMode mode) {
  */
 void Solver::fissionTransportSweep() {
   computeFSRFissionSources();
-  transportSweep();
+  operatorTransportSweep();
   addSourceToScalarFlux();
 }
 
@@ -1292,11 +1688,89 @@ void Solver::fissionTransportSweep() {
  */
 void Solver::scatterTransportSweep() {
   computeFSRScatterSources();
-  transportSweep();
+  operatorTransportSweep();
   addSourceToScalarFlux();
 }
 
 
+/**
+ * @brief Transports the current source for the Krylov operator sweeps.
+ * @details The angular fluxes are zeroed first so that the result does not
+ *          depend on the previous operator application. With domain
+ *          decomposition, the angular fluxes leaving a domain only enter its
+ *          neighbors on the next sweep, so the sweep is repeated until they
+ *          have crossed every domain a Track can traverse.
+ */
+void Solver::operatorTransportSweep() {
+
+  zeroTrackFluxes();
+
+  int num_sweeps = 1;
+#ifdef MPIx
+  if (_geometry->isDomainDecomposed()) {
+    int structure[3];
+    _geometry->getDomainStructure(structure);
+    num_sweeps = structure[0] + structure[1] + structure[2] - 2;
+  }
+#endif
+
+  for (int i=0; i < num_sweeps; i++)
+    transportSweep();
+}
+
+
+/**
+ * @brief Runs the source iterations of an eigenvalue calculation in a single
+ *        parallel region, if the solver supports it.
+ * @details By default, the iterations are run by computeEigenvalue(...).
+ * @param max_iters the maximum number of source iterations
+ * @param res_type the type of residual used for the convergence criterion
+ * @param convergence_data the CMFD convergence data of the iteration reports
+ * @return whether the source iterations were run
+ */
+bool Solver::iterateInParallelRegion(int, residualType, ConvergenceData*) {
+  return false;
+}
+
+
+/**
+ * @brief Prints the report of a source iteration.
+ * @details The CMFD convergence data is reported as well in verbose mode.
+ * @param iteration the source iteration number
+ * @param residual the residual of the source iteration
+ * @param dk the change in the eigenvalue (pcm)
+ * @param dr the apparent dominance ratio
+ * @param convergence_data the CMFD convergence data of the source iteration
+ */
+void Solver::printIterationReport(int iteration, double residual, int dk,
+                                  double dr,
+                                  ConvergenceData* convergence_data) {
+
+  if (_verbose && _cmfd != NULL) {
+
+    /* Unpack convergence data */
+    double pf = convergence_data->pf;
+    double cmfd_res_1 = convergence_data->cmfd_res_1;
+    double cmfd_res_end = convergence_data->cmfd_res_end;
+    double linear_res_1 = convergence_data->linear_res_1;
+    double linear_res_end = convergence_data->linear_res_end;
+    int cmfd_iters = convergence_data->cmfd_iters;
+    int linear_iters_1 = convergence_data->linear_iters_1;
+    int linear_iters_end = convergence_data->linear_iters_end;
+    log_printf(NORMAL, "%3d  %1.6f  %5d  %1.6f  %1.3f  %1.6f  %1.6f"
+               "  %3d  %1.6f  %1.6f  %3d  %3d    %.4e", iteration, _k_eff,
+               dk, residual, dr, cmfd_res_1, cmfd_res_end,
+               cmfd_iters, linear_res_1, linear_res_end,
+               linear_iters_1, linear_iters_end, pf);
+  }
+  else {
+    log_printf(NORMAL, "Iteration %d:  k_eff = %1.6f   "
+               "res = %1.3E  delta-k (pcm) = %d D.R. = %1.4f", iteration,
+               _k_eff, residual, dk, dr);
+  }
+}
+
+
 /**
  * @brief Computes the scalar flux distribution by performing a series of
  *        transport sweeps.
@@ -1552,6 +2026,7 @@ void Solver::computeEigenvalue(int max_iters, residualType res_type) {
 
   /* Reset number of iterations, start at 1 if restarting */
   _num_iterations = _is_restart;
+  _num_axial_refinements = 0;
 
   /* Start the timers to record the total solve and initialization times */
   _timer->startTimer();
@@ -1610,8 +2085,11 @@ void Solver::computeEigenvalue(int max_iters, residualType res_type) {
   /* Record the starting eigenvalue guess */
   double k_prev = _k_eff;
 
-  /* Source iteration loop */
-  for (int i=0; i < max_iters; i++) {
+  /* Source iteration loop, unless the iterations are run by the solver in a
+     single parallel region */
+  bool iterated = iterateInParallelRegion(max_iters, res_type,
+                                          &convergence_data);
+  for (int i=0; i < max_iters && !iterated; i++) {
 
     /* Compute the stabilizing flux if necessary */
     if (i > 0 && _stabilize_transport) {
@@ -1645,28 +2123,7 @@ void Solver::computeEigenvalue(int max_iters, residualType res_type) {
     k_prev = _k_eff;
 
     /* Ouptut iteration report */
-    if (_verbose && _cmfd != NULL) {
-
-      /* Unpack convergence data */
-      double pf = convergence_data.pf;
-      double cmfd_res_1 = convergence_data.cmfd_res_1;
-      double cmfd_res_end = convergence_data.cmfd_res_end;
-      double linear_res_1 = convergence_data.linear_res_1;
-      double linear_res_end = convergence_data.linear_res_end;
-      int cmfd_iters = convergence_data.cmfd_iters;
-      int linear_iters_1 = convergence_data.linear_iters_1;
-      int linear_iters_end = convergence_data.linear_iters_end;
-      log_printf(NORMAL, "%3d  %1.6f  %5d  %1.6f  %1.3f  %1.6f  %1.6f"
-                 "  %3d  %1.6f  %1.6f  %3d  %3d    %.4e", i, _k_eff,
-                 dk, residual, dr, cmfd_res_1, cmfd_res_end,
-                 cmfd_iters, linear_res_1, linear_res_end,
-                 linear_iters_1, linear_iters_end, pf);
-    }
-    else {
-      log_printf(NORMAL, "Iteration %d:  k_eff = %1.6f   "
-                 "res = %1.3E  delta-k (pcm) = %d D.R. = %1.4f", i, _k_eff,
-                 residual, dk, dr);
-    }
+    printIterationReport(i, residual, dk, dr, &convergence_data);
 
     if (_cmfd != NULL) {
       if (residual <= 0)
@@ -1676,8 +2133,18 @@ void Solver::computeEigenvalue(int max_iters, residualType res_type) {
     storeFSRFluxes();
     _num_iterations++;
 
+    /* Refine the axial mesh periodically and before stopping at convergence */
+    bool converged = (residual < _converge_thresh && std::abs(dk) < 1);
+    if (_axial_refinement_tolerance > 0. &&
+        _num_axial_refinements < _max_axial_refinements &&
+        (converged || (i+1) % _axial_refinement_interval == 0)) {
+      if (refineAxialMesh())
+        continue;
+      _num_axial_refinements = _max_axial_refinements;
+    }
+
     /* Check for convergence of the fission source distribution */
-    if (residual < _converge_thresh && std::abs(dk) < 1)
+    if (converged)
       break;
   }
 
@@ -1727,6 +2194,10 @@ void Solver::computeInitialFluxGuess(bool is_source_computation) {
     /* Normalize flux guess for eigenvalue computations */
     if (!is_source_computation)
       normalizeFluxes();
+
+    /* Start eigenvalue computations from the diffusion solution */
+    if (_diffusion_initial_guess && !is_source_computation)
+      computeDiffusionInitialGuess(_diffusion_guess_thresh);
   }
   storeFSRFluxes();
 
@@ -1779,6 +2250,7 @@ void Solver::clearTimerSplits() {
   _timer->clearSplit("Total CMFD time");
   _timer->clearSplit("Total collapse time");
   _timer->clearSplit("Matrix construction time");
+  _timer->clearSplit("Matrix update time");
 #ifdef MPIx
   _timer->clearSplit("CMFD MPI communication time");
 #endif
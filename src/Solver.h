@@ -219,6 +219,13 @@ protected:
   /** Convergence threshold for the initial spectrum calculation */
   double _initial_spectrum_thresh;
 
+  /** Boolean for whether to solve the CMFD diffusion problem for the initial
+   *  flux guess */
+  bool _diffusion_initial_guess;
+
+  /** Convergence threshold for the diffusion initial guess */
+  double _diffusion_guess_thresh;
+
   /** Boolean for whether to load initial FSR flux profile from file */
   bool _load_initial_FSR_fluxes;
 
@@ -305,6 +312,19 @@ protected:
   /** The type of source iteration stabilization */
   stabilizationType _stabilization_type;
 
+  /** The tolerance on the estimated axial flux shape error of the FSRs for
+   *  adaptive axial refinement, refinement is off if not positive */
+  double _axial_refinement_tolerance;
+
+  /** The number of source iterations between two axial refinements */
+  int _axial_refinement_interval;
+
+  /** The maximum number of axial refinements */
+  int _max_axial_refinements;
+
+  /** The number of axial refinements performed in the current solve */
+  int _num_axial_refinements;
+
   /** A matrix of ExpEvaluators to compute exponentials in the transport
     * equation. The matrix is indexed by azimuthal index and polar index */
   ExpEvaluator*** _exp_evaluators;
@@ -350,6 +370,12 @@ protected:
   void checkXS();
   virtual void initializeCmfd();
   void calculateInitialSpectrum(double threshold);
+  void computeDiffusionInitialGuess(double threshold);
+
+  /* Adaptive axial refinement of the FSRs */
+  bool refineAxialMesh();
+  virtual void remapFSRFluxes(std::vector<long>& parents);
+  virtual FP_PRECISION getAxialFluxSlope(long fsr_id, int group);
 
   /**
    * @brief Zero each Track's boundary fluxes for each energy group and polar
@@ -430,6 +456,13 @@ protected:
    */
   virtual void transportSweep() =0;
 
+  virtual bool iterateInParallelRegion(int max_iters, residualType res_type,
+                                       ConvergenceData* convergence_data);
+  void printIterationReport(int iteration, double residual, int dk, double dr,
+                            ConvergenceData* convergence_data);
+
+  void operatorTransportSweep();
+
   /** To stop and reset all timer splits */
   void clearTimerSplits();
 
@@ -497,9 +530,14 @@ public:
   void stabilizeTransport(double stabilization_factor,
                           stabilizationType stabilization_type=DIAGONAL);
 
+  /* Adaptive axial meshing */
+  void useAdaptiveAxialMesh(double tolerance, int num_iterations=10,
+                            int max_refinements=3);
+
   /* Initial guesses for the flux */
   void setRestartStatus(bool is_restart);
   void setInitialSpectrumCalculation(double threshold);
+  void useDiffusionInitialGuess(double threshold=1E-5);
   void setCheckXSLogLevel(logLevel log_level);
   void setChiSpectrumMaterial(Material* material);
   void resetMaterials(solverMode mode);
@@ -281,34 +281,8 @@ bool Surface::isCoordOnSurface(LocalCoords* coord) {
  */
 double Surface::getMinDistance(LocalCoords* coords) {
 
-  Point* point = coords->getPoint();
-  double phi = coords->getPhi();
-  double polar = coords->getPolar();
-
-  /* Point array for intersections with this Surface */
-  Point intersections[2];
-
-  /* Find the intersection Point(s) */
-  int num_inters = this->intersection(point, phi, polar, intersections);
-  double distance = INFINITY;
-
-  /* If there is one intersection Point */
-  if (num_inters == 1)
-    distance = intersections[0].distanceToPoint(point);
-
-  /* If there are two intersection Points */
-  else if (num_inters == 2) {
-    double dist1 = intersections[0].distanceToPoint(point);
-    double dist2 = intersections[1].distanceToPoint(point);
-
-    /* Determine which intersection Point is nearest */
-    if (dist1 < dist2)
-      distance = dist1;
-    else
-      distance = dist2;
-  }
-
-  return distance;
+  return getMinDistance(coords->getPoint(), coords->getPhi(),
+                        coords->getPolar());
 }
 
 
@@ -483,6 +457,29 @@ int Plane::intersection(Point* point, double azim, double polar, Point* points)
 }
 
 
+/**
+ * @brief Finds the distance along a direction to this Plane.
+ * @param point pointer to the Point of interest
+ * @param direction pointer to the unit direction of travel
+ * @return the distance to the Plane, INFINITY if the direction is parallel
+ *         to the Plane or points away from it
+ */
+double Plane::intersectionDistance(Point* point, const Direction* direction) {
+
+  /* The track and plane are parallel */
+  double dot = _A * direction->_uvw[0] + _B * direction->_uvw[1] +
+               _C * direction->_uvw[2];
+  if (fabs(dot) < 1.e-10)
+    return INFINITY;
+
+  double l = - evaluate(point) / dot;
+  if (l > 0.0)
+    return l;
+  else
+    return INFINITY;
+}
+
+
 /**
  * @brief Converts this Plane's attributes to a character array.
  * @details The character array returned conatins the type of Plane (ie,
@@ -562,6 +559,29 @@ double XPlane::getMaxX(int halfspace) {
 }
 
 
+/**
+ * @brief Finds the distance along a direction to this XPlane.
+ * @details Uses the reciprocal of the x direction cosine so that no
+ *          division is needed.
+ * @param point pointer to the Point of interest
+ * @param direction pointer to the unit direction of travel
+ * @return the distance to the XPlane, INFINITY if the direction is
+ *         parallel to the XPlane or points away from it
+ */
+double XPlane::intersectionDistance(Point* point, const Direction* direction) {
+
+  /* The track and plane are parallel */
+  if (fabs(direction->_uvw[0]) < 1.e-10)
+    return INFINITY;
+
+  double l = (_x - point->getX()) * direction->_inv_uvw[0];
+  if (l > 0.0)
+    return l;
+  else
+    return INFINITY;
+}
+
+
 /**
  * @brief Converts this XPlane's attributes to a character array.
  * @details The character array returned conatins the type of Plane (ie,
@@ -644,6 +664,29 @@ double YPlane::getMaxY(int halfspace) {
 }
 
 
+/**
+ * @brief Finds the distance along a direction to this YPlane.
+ * @details Uses the reciprocal of the y direction cosine so that no
+ *          division is needed.
+ * @param point pointer to the Point of interest
+ * @param direction pointer to the unit direction of travel
+ * @return the distance to the YPlane, INFINITY if the direction is
+ *         parallel to the YPlane or points away from it
+ */
+double YPlane::intersectionDistance(Point* point, const Direction* direction) {
+
+  /* The track and plane are parallel */
+  if (fabs(direction->_uvw[1]) < 1.e-10)
+    return INFINITY;
+
+  double l = (_y - point->getY()) * direction->_inv_uvw[1];
+  if (l > 0.0)
+    return l;
+  else
+    return INFINITY;
+}
+
+
 /**
  * @brief Converts this YPlane's attributes to a character array.
  * @details The character array returned conatins the type of Plane (ie,
@@ -725,6 +768,29 @@ double ZPlane::getMaxZ(int halfspace) {
 }
 
 
+/**
+ * @brief Finds the distance along a direction to this ZPlane.
+ * @details Uses the reciprocal of the z direction cosine so that no
+ *          division is needed.
+ * @param point pointer to the Point of interest
+ * @param direction pointer to the unit direction of travel
+ * @return the distance to the ZPlane, INFINITY if the direction is
+ *         parallel to the ZPlane or points away from it
+ */
+double ZPlane::intersectionDistance(Point* point, const Direction* direction) {
+
+  /* The track and plane are parallel */
+  if (fabs(direction->_uvw[2]) < 1.e-10)
+    return INFINITY;
+
+  double l = (_z - point->getZ()) * direction->_inv_uvw[2];
+  if (l > 0.0)
+    return l;
+  else
+    return INFINITY;
+}
+
+
 /**
  * @brief Converts this ZPlane's attributes to a character array.
  * @details The character array returned conatins the type of Plane (ie,
@@ -1018,6 +1084,60 @@ int ZCylinder::intersection(Point* point, double azim, double polar, Point* poin
 }
 
 
+/**
+ * @brief Finds the distance along a direction to this ZCylinder.
+ * @details Substitutes the parametric line \f$ (x_0 + tu, y_0 + tv) \f$
+ *          into the ZCylinder's quadratic equation and returns the smallest
+ *          positive root \f$ t \f$.
+ * @param point pointer to the Point of interest
+ * @param direction pointer to the unit direction of travel
+ * @return the distance to the ZCylinder, INFINITY if it is not intersected
+ */
+double ZCylinder::intersectionDistance(Point* point,
+                                       const Direction* direction) {
+
+  double x0 = point->getX();
+  double y0 = point->getY();
+  double u = direction->_uvw[0];
+  double v = direction->_uvw[1];
+
+  /* Vertical tracks only intersect Z cylinders at infinity */
+  if (u * u + v * v < FLT_EPSILON * FLT_EPSILON)
+    return INFINITY;
+
+  double a = _A * u * u + _B * v * v;
+  double b = 2 * (_A * u * x0 + _B * v * y0) + _C * u + _D * v;
+  double c = evaluate(point);
+  double discr = b*b - 4*a*c;
+
+  /* There are no intersections */
+  if (discr <= -ON_SURFACE_THRESH)
+    return INFINITY;
+
+  /* There is one intersection (ie on the Surface) */
+  else if (fabs(discr) < ON_SURFACE_THRESH) {
+    double t = -b / (2*a);
+    if (t > 0.0)
+      return t;
+    else
+      return INFINITY;
+  }
+
+  /* There are two intersections, return the nearest one ahead of the point */
+  else {
+    double sqrt_discr = sqrt(discr);
+    double t1 = (-b - sqrt_discr) / (2*a);
+    double t2 = (-b + sqrt_discr) / (2*a);
+    if (t1 > 0.0)
+      return t1;
+    else if (t2 > 0.0)
+      return t2;
+    else
+      return INFINITY;
+  }
+}
+
+
 /**
  * @brief Converts this ZCylinder's attributes to a character array.
  * @details The character array returned contains the type of Plane (ie,
@@ -190,6 +190,16 @@ public:
   virtual int intersection(Point* point, double azim, double polar,
                            Point* points) = 0;
 
+  /**
+   * @brief Finds the distance along a direction to the nearest intersection
+   *        with this Surface.
+   * @param point pointer to the Point of interest
+   * @param direction pointer to the unit direction of travel
+   * @return the distance to the Surface, INFINITY if it is not intersected
+   */
+  virtual double intersectionDistance(Point* point,
+                                      const Direction* direction) = 0;
+
   bool isPointOnSurface(Point* point);
   bool isCoordOnSurface(LocalCoords* coord);
   double getMinDistance(Point* point, double azim, double polar);
@@ -251,6 +261,7 @@ public:
 
   double evaluate(const Point* point) const;
   int intersection(Point* point, double azim, double polar, Point* points);
+  double intersectionDistance(Point* point, const Direction* direction);
 
   std::string toString();
 };
@@ -275,6 +286,7 @@ public:
   double getX();
   double getMinX(int halfspace);
   double getMaxX(int halfspace);
+  double intersectionDistance(Point* point, const Direction* direction);
 
   std::string toString();
 };
@@ -299,6 +311,7 @@ public:
   double getY();
   double getMinY(int halfspace);
   double getMaxY(int halfspace);
+  double intersectionDistance(Point* point, const Direction* direction);
 
   std::string toString();
 };
@@ -323,6 +336,7 @@ public:
   double getZ();
   double getMinZ(int halfspace);
   double getMaxZ(int halfspace);
+  double intersectionDistance(Point* point, const Direction* direction);
 
   std::string toString();
 };
@@ -379,6 +393,7 @@ public:
 
   double evaluate(const Point* point) const;
   int intersection(Point* point, double azim, double polar, Point* points);
+  double intersectionDistance(Point* point, const Direction* direction);
 
   std::string toString();
 };
@@ -395,31 +410,9 @@ public:
  * @return the minimum distance to the Surface
  */
 inline double Surface::getMinDistance(Point* point, double azim, double polar) {
-
-  /* Point array for intersections with this Surface */
-  Point intersections[2];
-
-  /* Find the intersection Point(s) */
-  int num_inters = intersection(point, azim, polar, intersections);
-  double distance = INFINITY;
-
-  /* If there is one intersection Point */
-  if (num_inters == 1)
-    distance = intersections[0].distanceToPoint(point);
-
-  /* If there are two intersection Points */
-  else if (num_inters == 2) {
-    double dist1 = intersections[0].distanceToPoint(point);
-    double dist2 = intersections[1].distanceToPoint(point);
-
-    /* Determine which intersection Point is nearest */
-    if (dist1 < dist2)
-      distance = dist1;
-    else
-      distance = dist2;
-  }
-
-  return distance;
+  Direction direction;
+  direction.setAngles(azim, polar);
+  return intersectionDistance(point, &direction);
 }
 
 
@@ -24,10 +24,12 @@ TrackGenerator::TrackGenerator(Geometry* geometry, int num_azim,
   _max_num_segments = 0;
   _FSR_volumes = NULL;
   _dump_segments = true;
+  _dry_run = false;
   _segments_centered = false;
   _FSR_locks = NULL;
   _tracks_2D_array = NULL;
   _tracks_per_azim = NULL;
+  _rotational = false;
   _timer = new Timer();
 }
 
@@ -62,6 +64,7 @@ TrackGenerator::~TrackGenerator() {
 
   delete _quadrature;
   delete _timer;
+  release_memory(this);
 }
 
 
@@ -783,6 +786,28 @@ void TrackGenerator::checkBoundaryConditions() {
     _periodic = true;
   else
     _periodic = false;
+
+  /* Check that a ROTATIONAL bc pairs the minimum x and y surfaces */
+  _rotational = (min_x_bound == ROTATIONAL || min_y_bound == ROTATIONAL ||
+                 max_x_bound == ROTATIONAL || max_y_bound == ROTATIONAL);
+  if (_rotational) {
+    if (min_x_bound != ROTATIONAL || min_y_bound != ROTATIONAL ||
+        max_x_bound == ROTATIONAL || max_y_bound == ROTATIONAL)
+      log_printf(ERROR, "Rotational boundaries must be set on both the "
+                 "minimum x and the minimum y boundaries, and on no other "
+                 "x or y boundary");
+
+    if (fabs(_geometry->getWidthX() - _geometry->getWidthY()) > FLT_EPSILON)
+      log_printf(ERROR, "Rotational boundaries require a square geometry but "
+                 "the x-width is %f cm and the y-width is %f cm",
+                 _geometry->getWidthX(), _geometry->getWidthY());
+
+    if (_geometry->isDomainDecomposed() ||
+        _geometry->getNumXModules() != _geometry->getNumYModules())
+      log_printf(ERROR, "Rotational boundaries are not supported for domain "
+                 "decomposition or for different numbers of x and y "
+                 "modules");
+  }
 }
 
 
@@ -993,6 +1018,18 @@ void TrackGenerator::initializeTracks() {
     _num_x[a] *= _geometry->getNumXModules();
     _num_y[a] *= _geometry->getNumYModules();
 
+    /* Mirror the track laydown about 45 degrees so that rotating the tracks
+     * of an angle by 90 degrees gives the tracks of another angle */
+    int am = _num_azim/4 - a - 1;
+    if (_rotational && am < a) {
+      _num_x[a] = _num_y[am];
+      _num_y[a] = _num_x[am];
+    }
+    else if (_rotational && am == a) {
+      _num_x[a] = std::max(_num_x[a], _num_y[a]);
+      _num_y[a] = _num_x[a];
+    }
+
     /* Save number of intersections for supplementary angles */
     _num_x[_num_azim/2 - a - 1] = _num_x[a];
     _num_y[_num_azim/2 - a - 1] = _num_y[a];
@@ -1012,6 +1049,13 @@ void TrackGenerator::initializeTracks() {
     dy_eff[_num_azim/2 - a - 1] = dy_eff[a];
   }
 
+  /* Account the 2D Tracks before allocating them */
+  long num_2D_tracks = 0;
+  for (int a=0; a < _num_azim/2; a++)
+    num_2D_tracks += _num_x[a] + _num_y[a];
+  account_memory(this, "2D tracks", TRACK_MEMORY, num_2D_tracks *
+                 (sizeof(Track) + sizeof(Track*)));
+
   /* Generate 2D tracks */
   for (int a=0; a < _num_azim/2; a++) {
 
@@ -1215,6 +1259,37 @@ void TrackGenerator::initializeTrackReflections() {
         else
           track->setTrackNextBwd(get2DTrackID(ac, i - _num_x[a]));
       }
+
+      /* Link the tracks leaving through a rotational boundary to the tracks
+       * rotated by 90 degrees about the (x_min, y_min) corner, which enter
+       * through the other rotational boundary */
+      if (_rotational) {
+        int q = _num_azim/4;
+
+        /* Leaving through the y-min boundary */
+        if (i < _num_x[a]) {
+          if (a < q) {
+            track->setTrackNextBwd(get2DTrackID(a + q, _num_x[a] - i - 1));
+            track->setNextBwdFwd(false);
+          }
+          else {
+            track->setTrackNextBwd(get2DTrackID(a - q, _num_x[a - q] + i));
+            track->setNextBwdFwd(true);
+          }
+        }
+
+        /* Leaving through the x-min boundary backwards */
+        else if (a < q) {
+          track->setTrackNextBwd(get2DTrackID(a + q, i - _num_x[a]));
+          track->setNextBwdFwd(true);
+        }
+
+        /* Leaving through the x-min boundary forwards */
+        if (a >= q && i < _num_y[a]) {
+          track->setTrackNextFwd(get2DTrackID(a - q, _num_y[a] - i - 1));
+          track->setNextFwdFwd(true);
+        }
+      }
     }
   }
 }
@@ -1298,11 +1373,21 @@ void TrackGenerator::segmentize() {
   std::string msg = "Segmenting 2D tracks";
   Progress progress(_num_2D_tracks, msg, 0.1, _geometry, true);
 
-  /* Loop over all Tracks */
-#pragma omp parallel for schedule(dynamic)
-  for (int t=0; t < _num_2D_tracks; t++) {
-    _geometry->segmentize2D(_tracks_2D_array[t], _z_coord);
-    progress.incrementCounter();
+  /* Loop over all Tracks, checking the projected segment storage against the
+   * memory budget after each azimuthal angle */
+  long num_traced_tracks = 0;
+  long num_segments = 0;
+  for (int a=0; a < _num_azim/2; a++) {
+    long first_track = num_traced_tracks;
+    num_traced_tracks += _num_x[a] + _num_y[a];
+#pragma omp parallel for schedule(dynamic) reduction(+:num_segments)
+    for (long t=first_track; t < num_traced_tracks; t++) {
+      _geometry->segmentize2D(_tracks_2D_array[t], _z_coord);
+      num_segments += _tracks_2D_array[t]->getNumSegments();
+      progress.incrementCounter();
+    }
+    accountProjectedSegments("2D segments", num_segments, num_traced_tracks,
+                             _num_2D_tracks);
   }
 
   _geometry->initializeFSRVectors();
@@ -1313,6 +1398,32 @@ void TrackGenerator::segmentize() {
 }
 
 
+/**
+ * @brief Accounts the storage of the segments of all Tracks, projected from
+ *        the segments of the Tracks traced so far.
+ * @details The number of segments is only known once the Geometry is ray
+ *          traced. Segmentation accounts this projection after each
+ *          azimuthal angle, so that a memory budget which the segments would
+ *          exceed is reported before the other angles are traced. The
+ *          projection is replaced by the actual storage at the end.
+ * @param label the label of the segment allocation
+ * @param num_segments the number of segments of the traced Tracks
+ * @param num_traced_tracks the number of traced Tracks
+ * @param num_tracks the total number of Tracks
+ */
+void TrackGenerator::accountProjectedSegments(const char* label,
+                                              long num_segments,
+                                              long num_traced_tracks,
+                                              long num_tracks) {
+  if (num_traced_tracks == 0)
+    return;
+  double projected_segments = double(num_segments) * num_tracks /
+                              num_traced_tracks;
+  account_memory(this, label, SEGMENT_MEMORY,
+                 projected_segments * sizeof(segment));
+}
+
+
 /**
  * @brief This method creates a directory to store Track files, and reads
  *        in ray tracing data for Tracks and segments from a Track file
@@ -1446,9 +1557,9 @@ void TrackGenerator::dumpSegmentsToFile() {
     fwrite(fsr_key.c_str(), sizeof(char)*string_length, 1, out);
 
     fsr_id = fsr_data_list[i]->_fsr_id;
-    x = fsr_data_list[i]->_point->getX();
-    y = fsr_data_list[i]->_point->getY();
-    z = fsr_data_list[i]->_point->getZ();
+    x = fsr_data_list[i]->_point.getX();
+    y = fsr_data_list[i]->_point.getY();
+    z = fsr_data_list[i]->_point.getZ();
     fwrite(&fsr_id, sizeof(long), 1, out);
     fwrite(&x, sizeof(double), 1, out);
     fwrite(&y, sizeof(double), 1, out);
@@ -1582,9 +1693,7 @@ bool TrackGenerator::readSegmentsFromFile() {
     ret = _geometry->twiddleRead(&z, sizeof(double), 1, in);
     fsr_data* fsr = new fsr_data;
     fsr->_fsr_id = fsr_key_id;
-    Point* point = new Point();
-    point->setCoords(x,y,z);
-    fsr->_point = point;
+    fsr->_point.setCoords(x,y,z);
     FSR_keys_map.insert(fsr_key, fsr);
 
     /* Read data from file for FSR_to_materials_IDs */
@@ -1682,12 +1791,8 @@ void TrackGenerator::generateFSRCentroids(FP_PRECISION* FSR_volumes) {
 
   long num_FSRs = _geometry->getNumFSRs();
 
-  /* Create temporary array of centroids and initialize to origin */
-  Point** centroids = new Point*[num_FSRs];
-  for (long r=0; r < num_FSRs; r++) {
-    centroids[r] = new Point();
-    centroids[r]->setCoords(0.0, 0.0, 0.0);
-  }
+  /* Create temporary contiguous array of centroids initialized to origin */
+  Point* centroids = new Point[num_FSRs];
 
   /* Generate FSR centroids by looping over all Tracks */
   CentroidGenerator centroid_generator(this);
@@ -1696,7 +1801,7 @@ void TrackGenerator::generateFSRCentroids(FP_PRECISION* FSR_volumes) {
 
   /* Set the centroid for the FSR */
   for (long r=0; r < num_FSRs; r++)
-    _geometry->setFSRCentroid(r, centroids[r]);
+    _geometry->setFSRCentroid(r, &centroids[r]);
 
   /* Recenter the segments around FSR centroid */
   if ((_segment_formation == EXPLICIT_2D || _segment_formation == EXPLICIT_3D)
@@ -1715,16 +1820,16 @@ void TrackGenerator::generateFSRCentroids(FP_PRECISION* FSR_volumes) {
 
   for (long r=0; r < num_FSRs; r++) {
     total_volume[0] += _FSR_volumes[r];
-    total_volume[1] += _FSR_volumes[r] * centroids[r]->getX();
-    total_volume[2] += _FSR_volumes[r] * centroids[r]->getY();
-    total_volume[3] += _FSR_volumes[r] * centroids[r]->getZ();
+    total_volume[1] += _FSR_volumes[r] * centroids[r].getX();
+    total_volume[2] += _FSR_volumes[r] * centroids[r].getY();
+    total_volume[3] += _FSR_volumes[r] * centroids[r].getZ();
 
     min_volume = std::min(_FSR_volumes[r], min_volume);
     max_volume = std::max(_FSR_volumes[r], max_volume);
 
     log_printf(DEBUG, "FSR ID = %d has volume = %.6f, centroid"
-               " (%.3f %.3f %.3f)", r, _FSR_volumes[r], centroids[r]->getX(),
-               centroids[r]->getY(), centroids[r]->getZ());
+               " (%.3f %.3f %.3f)", r, _FSR_volumes[r], centroids[r].getX(),
+               centroids[r].getY(), centroids[r].getZ());
   }
 
   log_printf(DEBUG, "Total volume %.6f cm3, moments of volume "
@@ -1827,6 +1932,15 @@ bool TrackGenerator::getPeriodic() {
 }
 
 
+/**
+ * @brief Returns whether the minimum x and y boundaries are rotational.
+ * @return a boolean value - true if rotational; false otherwise
+ */
+bool TrackGenerator::getRotational() {
+  return _rotational;
+}
+
+
 /**
  * @brief Sets a flag to record all segment information in the tracking file.
  * @param dump_segments whether or not to record segment information in the
@@ -1837,6 +1951,18 @@ void TrackGenerator::setDumpSegments(bool dump_segments) {
 }
 
 
+/**
+ * @brief Sets whether Track generation only lays down the Tracks and FSRs.
+ * @details In a dry run, the segments of 3D Tracks are not counted, so that a
+ *          ResourceEstimator can sample them. The Tracks must be generated
+ *          again without a dry run before a calculation.
+ * @param dry_run whether to only lay down the Tracks and FSRs
+ */
+void TrackGenerator::setDryRun(bool dry_run) {
+  _dry_run = dry_run;
+}
+
+
 /**
  * @brief Resets the TrackGenerator to not contain tracks or segments.
  */
@@ -1912,4 +2038,5 @@ void TrackGenerator::printMemoryReport() {
              track_storage / float(1e6));
   log_printf(INFO_ONCE, "Max 2D explicit segment storage per domain %.2f MB",
              max_segment_storage / float(1e6));
+  account_memory(this, "2D segments", SEGMENT_MEMORY, segment_storage);
 }
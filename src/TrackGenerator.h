@@ -95,6 +95,10 @@ protected:
   /** Boolen to indicate whether a periodic BC exists */
   bool _periodic;
 
+  /** Boolean to indicate whether the minimum x and y surfaces are linked by
+   *  a rotational BC */
+  bool _rotational;
+
   /** Determines the type of track segmentation to use */
   segmentationType _segment_formation;
 
@@ -107,6 +111,10 @@ protected:
   /** Boolean to indicate whether the segments should be dumped to file */
   bool _dump_segments;
 
+  /** Boolean to indicate whether only the Tracks and FSRs are laid down, for
+   *  resource estimates */
+  bool _dry_run;
+
   /** Boolean to indicate whether the segments have been centered around their
    * centroid or not */
   bool _segments_centered;
@@ -129,6 +137,8 @@ protected:
   virtual void initializeTracks();
   void initializeTrackReflections();
   virtual void segmentize();
+  void accountProjectedSegments(const char* label, long num_segments,
+                                long num_traced_tracks, long num_tracks);
   virtual void setContainsSegments(bool contains_segments);
   virtual void allocateTemporarySegments();
   virtual void resetStatus();
@@ -152,6 +162,7 @@ public:
   long getNum2DSegments();
   void countSegments();
   bool getPeriodic();
+  bool getRotational();
   Track** get2DTracksArray();
   Track** getTracksArray();
   Track** get2DTracks();
@@ -186,6 +197,7 @@ public:
   void setMaxOpticalLength(FP_PRECISION tau);
   void setMaxNumSegments(int max_num_segments);
   void setDumpSegments(bool dump_segments);
+  void setDryRun(bool dry_run);
 
   /* Worker functions */
   virtual void retrieveTrackCoords(double* coords, long num_tracks);
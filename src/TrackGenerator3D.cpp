@@ -466,6 +466,44 @@ void TrackGenerator3D::useGlobalZMesh() {
 }
 
 
+/**
+ * @brief Splits FSRs axially in two halves for adaptive axial refinement.
+ * @details The axial meshes of the extruded FSRs are refined by the Geometry,
+ *          after which the FSR locks are re-allocated and the segments are
+ *          counted again to size the temporary segment storage. Tracks are
+ *          left unchanged. Only on-the-fly axial ray tracing with local axial
+ *          meshes can be refined.
+ * @param fsr_ids the IDs of the FSRs to split
+ * @return a vector indexed by new FSR ID of the FSR ID it derives from
+ */
+std::vector<long> TrackGenerator3D::splitAxialFSRs(std::vector<long>& fsr_ids) {
+
+  if (_segment_formation != OTF_TRACKS && _segment_formation != OTF_STACKS)
+    log_printf(ERROR, "Unable to split FSRs axially without on-the-fly axial "
+               "ray tracing, use the OTF_TRACKS or OTF_STACKS segmentation");
+
+  if (_contains_global_z_mesh)
+    log_printf(ERROR, "Unable to split FSRs axially with a global z-mesh");
+
+  std::vector<long> parents = _geometry->splitAxialFSRs(fsr_ids);
+
+  /* Re-allocate the mutex locks for the new number of FSRs */
+  long num_FSRs = _geometry->getNumFSRs();
+  if (_FSR_locks != NULL)
+    delete [] _FSR_locks;
+  _FSR_locks = new omp_lock_t[num_FSRs];
+
+#pragma omp parallel for schedule(guided)
+  for (long r=0; r < num_FSRs; r++)
+    omp_init_lock(&_FSR_locks[r]);
+
+  /* Count the segments on the refined axial meshes */
+  countSegments();
+
+  return parents;
+}
+
+
 /**
  * @brief Provides the global z-mesh and size if available.
  * @details For some cases, a global z-mesh is generated for the Geometry. If
@@ -773,6 +811,28 @@ void TrackGenerator3D::initializeTracks() {
       _num_l[i][j] *= _geometry->getNumYModules();
       _num_z[i][j] *= _geometry->getNumZModules();
 
+      /* With rotational boundaries, split half the distance between two x
+       * boundary crossings of a chain into a whole number of l spacings.
+       * The 3D Tracks then cross the x and y boundaries at the same heights,
+       * and angles related by a 90 degree rotation share their spacings */
+      if (_rotational) {
+        int am = _num_azim/4 - i - 1;
+        int num_splits;
+        if (am < i) {
+          num_splits = _num_l[am][j] / (2 * _num_y[am]);
+          _num_z[i][j] = _num_z[am][j];
+        }
+        else {
+          double half_link = width_x / (2 * _num_x[i] * cos(phi));
+          num_splits = int(ceil(half_link * tan(M_PI_2 - theta)
+                                / _z_spacing));
+          _num_z[i][j] = (int) ceil(module_width_z * num_splits * tan(theta)
+                                    / half_link);
+          _num_z[i][j] *= _geometry->getNumZModules();
+        }
+        _num_l[i][j] = 2 * num_splits * _num_y[i];
+      }
+
       /* Effective track spacing */
       _dl_eff[i][j] = width_y / (sin(phi) * _num_l[i][j]);
       _dz_eff[i][j] = width_z / _num_z[i][j];
@@ -1260,13 +1320,23 @@ void TrackGenerator3D::segmentizeExtruded() {
   else
     z_coords = _geometry->getUniqueZPlanes();
 
-  /* Loop over all extruded Tracks */
+  /* Loop over all extruded Tracks, checking the projected segment storage
+   * against the memory budget after each azimuthal angle */
   Progress progress(_num_2D_tracks, "Segmenting 2D Tracks", 0.1, _geometry,
                     true);
-#pragma omp parallel for schedule(dynamic)
-  for (int index=0; index < _num_2D_tracks; index++) {
-    progress.incrementCounter();
-    _geometry->segmentizeExtruded(_tracks_2D_array[index], z_coords);
+  long num_traced_tracks = 0;
+  long num_segments = 0;
+  for (int a=0; a < _num_azim/2; a++) {
+    long first_track = num_traced_tracks;
+    num_traced_tracks += _num_x[a] + _num_y[a];
+#pragma omp parallel for schedule(dynamic) reduction(+:num_segments)
+    for (long index=first_track; index < num_traced_tracks; index++) {
+      progress.incrementCounter();
+      _geometry->segmentizeExtruded(_tracks_2D_array[index], z_coords);
+      num_segments += _tracks_2D_array[index]->getNumSegments();
+    }
+    accountProjectedSegments("2D segments", num_segments, num_traced_tracks,
+                             _num_2D_tracks);
   }
 
   /* Output memory consumption of 2D explicit ray tracing */
@@ -1286,8 +1356,9 @@ void TrackGenerator3D::segmentizeExtruded() {
   _geometry->initializeAxialFSRs(_global_z_mesh);
   _geometry->initializeFSRVectors();
 
-  /* Count the number of segments in each track */
-  countSegments();
+  /* Count the number of segments in each track, unless they are sampled */
+  if (!_dry_run)
+    countSegments();
 }
 
 
@@ -1305,6 +1376,7 @@ void TrackGenerator3D::segmentize() {
   log_printf(NORMAL, "Ray tracing for 3D track segmentation...");
 
   long num_segments = 0;
+  long num_traced_tracks = 0;
   Progress progress(_num_3D_tracks, "Segmenting 3D Tracks", 0.1, _geometry,
                     true);
 
@@ -1336,12 +1408,21 @@ void TrackGenerator3D::segmentize() {
         }
       }
     }
+
+    /* Check the projected segment storage against the memory budget */
+    for (int i=0; i < _num_x[a] + _num_y[a]; i++)
+      for (int p=0; p < _num_polar; p++)
+        num_traced_tracks += _tracks_per_stack[a][i][p];
+    accountProjectedSegments("3D segments", num_segments, num_traced_tracks,
+                             _num_3D_tracks);
   }
   _geometry->initializeFSRVectors();
   _contains_3D_segments = true;
 
   log_printf(INFO, "Explicit 3D segments storage = %.2f MB", num_segments *
              sizeof(segment) / 1e6);
+  account_memory(this, "3D segments", SEGMENT_MEMORY,
+                 num_segments * sizeof(segment));
 }
 
 
@@ -1425,6 +1506,8 @@ void TrackGenerator3D::create3DTracksArrays() {
 
     log_printf(NORMAL, "Explicit 3D Track storage = %.2f MB", num_tracks *
                sizeof(Track3D) / 1e6);
+    account_memory(this, "3D tracks", TRACK_MEMORY,
+                   num_tracks * sizeof(Track3D));
 
     _tracks_3D = new Track3D***[_num_azim/2];
     for (int a=0; a < _num_azim/2; a++) {
@@ -1612,6 +1695,8 @@ void TrackGenerator3D::allocateTemporarySegments() {
 
   log_printf(INFO_ONCE, "Max temporary segment storage per domain = %6.2f MB",
              max_size_mb);
+  account_memory(this, "temporary segments", SEGMENT_MEMORY,
+                 _num_seg_matrix_columns * _num_threads * sizeof(segment));
 
   /* Allocate new temporary segments */
   for (int t = 0; t < _num_threads; t++)
@@ -1642,6 +1727,8 @@ void TrackGenerator3D::allocateTemporaryTracks() {
         * sizeof(Track3D)) / (double) 1e6;
   log_printf(INFO_ONCE, "Temporary Track storage per domain = %6.2f MB",
              size_mb);
+  account_memory(this, "temporary tracks", TRACK_MEMORY, _num_threads *
+                 _max_num_tracks_per_stack * (sizeof(Track3D) + sizeof(Track*)));
 
   /* Allocate new temporary tracks arrays */
   for (int t = 0; t < _num_threads; t++) {
@@ -1853,6 +1940,28 @@ int TrackGenerator3D::getNum3DTrackChainLinks(TrackChainIndexes* tci) {
 }
 
 
+/**
+ * @brief Calculates the number of l spacings along a 3D Track chain before
+ *        the start of one of its 2D Track links.
+ * @details This is only used with rotational boundaries, for which the 2D
+ *          Track links span a whole number of l spacings.
+ * @param azim The azimuthal index of the chain
+ * @param x The x index of the chain
+ * @param polar The polar index of the chain
+ * @param link The index of the 2D Track link in the chain
+ * @return the number of l spacings before the start of the link
+ */
+int TrackGenerator3D::getNumChainSpacings(int azim, int x, int polar,
+                                          int link) {
+
+  double length = 0.0;
+  for (int i=0; i < link; i++)
+    length += _tracks_2D_chains[azim][x][i]->getLength();
+
+  return int(round(length / _dl_eff[azim][polar]));
+}
+
+
 /**
  * @brief Fills the provided 3D Track with its linking information.
  * @param tsi The stack indexes
@@ -2341,6 +2450,57 @@ void TrackGenerator3D::setLinkingTracks(TrackStackIndexes* tsi,
     }
   }
 
+  /* Link the Tracks leaving through a rotational boundary to the 3D Track of
+   * the rotated 2D Track which crosses the boundary at the same height */
+  if (bc == ROTATIONAL) {
+
+    Track* track_2D_next;
+    if (outgoing) {
+      track_2D_next = _tracks_2D_array[track_2D->getTrackNextFwd()];
+      next_fwd = track_2D->getNextFwdFwd();
+    }
+    else {
+      track_2D_next = _tracks_2D_array[track_2D->getTrackNextBwd()];
+      next_fwd = track_2D->getNextBwdFwd();
+    }
+
+    /* The polar angle is unchanged if the direction along the Tracks is */
+    tci_next._azim = track_2D_next->getAzimIndex();
+    tci_next._x = track_2D_next->getXYIndex() % _num_x[tci_next._azim];
+    if (next_fwd == outgoing)
+      tci_next._polar = tci->_polar;
+    else
+      tci_next._polar = pc;
+
+    /* Find the axial level of the boundary crossing, the crossings lying at
+     * z_min + (level + 0.5) * dz */
+    int link_out = track_2D->getLinkIndex();
+    if (outgoing)
+      link_out++;
+    int l_out = getNumChainSpacings(tci->_azim, tci->_x, tci->_polar,
+                                    link_out);
+    int level;
+    if (tci->_polar < _num_polar / 2)
+      level = lz + l_out - nl;
+    else
+      level = lz - l_out;
+
+    /* Find the l-z index of the Track crossing the rotated point there */
+    int link_in = track_2D_next->getLinkIndex();
+    if (!next_fwd)
+      link_in++;
+    int l_in = getNumChainSpacings(tci_next._azim, tci_next._x,
+                                   tci_next._polar, link_in);
+    if (tci_next._polar < _num_polar / 2)
+      tci_next._lz = level - l_in + _num_l[tci_next._azim][tci_next._polar];
+    else
+      tci_next._lz = level + l_in;
+
+    tsi_next._azim = tci_next._azim;
+    tsi_next._xy = track_2D_next->getXYIndex();
+    setLinkIndex(&tci_next, &tsi_next);
+  }
+
   convertTCItoTSI(&tci_next, &tsi_next);
   convertTCItoTSI(&tci_prdc, &tsi_prdc);
   convertTCItoTSI(&tci_refl, &tsi_refl);
@@ -2564,6 +2724,9 @@ void TrackGenerator3D::readExtrudedFSRInfo(FILE* in) {
       extruded_FSR_lookup[extruded_fsr_id] = extruded_fsr;
     }
 
+    /* Gather the axial data of all extruded FSRs in contiguous tables */
+    _geometry->packExtrudedFSRs();
+
     /* Record 2D track info */
     int num_2D_tracks;
     ret = _geometry->twiddleRead(&num_2D_tracks, sizeof(int), 1, in);
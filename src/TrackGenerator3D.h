@@ -212,6 +212,7 @@ public:
   void convertTSItoTCI(TrackStackIndexes* tsi, TrackChainIndexes* tci);
   int getLinkIndex(TrackChainIndexes* tci);
   int getNum3DTrackChainLinks(TrackChainIndexes* tci);
+  int getNumChainSpacings(int azim, int x, int polar, int link);
   void getTSIByIndex(long id, TrackStackIndexes* tsi);
 
   void getTrackOTF(Track3D* track, TrackStackIndexes* tsi);
@@ -235,6 +236,7 @@ public:
   void retrieve3DSegmentCoords(double* coords, long num_segments);
   void create3DTracksArrays();
   void checkBoundaryConditions();
+  std::vector<long> splitAxialFSRs(std::vector<long>& fsr_ids);
 };
 
 #endif /* TRACKGENERATOR3D_H_ */
@@ -33,7 +33,7 @@ void MaxOpticalLength::execute() {
     // OTF ray tracing requires segmentation of tracks
     if (_segment_formation != EXPLICIT_2D &&
         _segment_formation != EXPLICIT_3D) {
-      MOCKernel* kernel = getKernel<SegmentationKernel>();
+      SegmentationKernel* kernel = getKernel<SegmentationKernel>();
       loopOverTracks(kernel);
     }
     else
@@ -114,7 +114,7 @@ void SegmentCounter::execute() {
   _total_segments_counted = false;
 #pragma omp parallel
   {
-    MOCKernel* kernel = getKernel<CounterKernel>();
+    CounterKernel* kernel = getKernel<CounterKernel>();
     loopOverTracks(kernel);
   }
   _track_generator->setMaxNumSegments(_max_num_segments);
@@ -164,6 +164,724 @@ void SegmentCounter::onTrack(Track* track, segment* segments) {
 }
 
 
+/**
+ * @brief Constructor for SegmentSampler calls the TraverseSegments
+ *        constructor and sets the sampling stride.
+ * @param track_generator The TrackGenerator to pull tracking information from
+ * @param stride The number of flattened 2D Tracks per sampled 2D Track
+ */
+SegmentSampler::SegmentSampler(TrackGenerator* track_generator, int stride)
+                               : TraverseSegments(track_generator) {
+  if (_track_generator_3D == NULL || _segment_formation == EXPLICIT_3D)
+    log_printf(ERROR, "Unable to sample 3D segments without on-the-fly "
+               "segment formation");
+  _stride = std::max(stride, 1);
+  _num_sampled_tracks = 0;
+  _num_sampled_segments = 0;
+  _max_num_segments = 0;
+}
+
+
+/**
+ * @brief Counts the segments of the 3D Tracks above the sampled 2D Tracks.
+ * @details The 3D Tracks of each sampled z-stack are traced in order by a
+ *          single thread.
+ */
+void SegmentSampler::execute() {
+
+  Track** tracks_2D = _track_generator_3D->get2DTracksArray();
+  long num_2D_tracks = _track_generator_3D->getNum2DTracks();
+  int*** tracks_per_stack = _track_generator_3D->getTracksPerStack();
+  int num_polar = _track_generator_3D->getNumPolar();
+
+  /* List the 3D Tracks of the sampled z-stacks */
+  std::vector<TrackStackIndexes> tracks;
+  std::vector<long> stack_offsets(1, 0);
+  for (long t=0; t < num_2D_tracks; t += _stride) {
+    TrackStackIndexes tsi;
+    tsi._azim = tracks_2D[t]->getAzimIndex();
+    tsi._xy = tracks_2D[t]->getXYIndex();
+    for (int p=0; p < num_polar; p++) {
+      tsi._polar = p;
+      for (int z=0; z < tracks_per_stack[tsi._azim][tsi._xy][p]; z++) {
+        tsi._z = z;
+        tracks.push_back(tsi);
+      }
+      stack_offsets.push_back(tracks.size());
+    }
+  }
+
+  _num_sampled_tracks = tracks.size();
+  _num_sampled_segments = 0;
+  _max_num_segments = 0;
+  if (tracks.empty())
+    return;
+
+#pragma omp parallel
+  {
+    CounterKernel* kernel = getKernel<CounterKernel>();
+    loopOverTracksByCycle(kernel, &tracks[0], &stack_offsets[0],
+                          stack_offsets.size() - 1);
+  }
+}
+
+
+/**
+ * @brief Adds the number of segments of a sampled Track to the tallies.
+ * @param track The Track whose segments are counted
+ * @param segments The segments associated with the Track
+ */
+void SegmentSampler::onTrack(Track* track, segment* segments) {
+
+  int num_segments = track->getNumSegments();
+#pragma omp atomic update
+  _num_sampled_segments += num_segments;
+
+#pragma omp critical
+  {
+    if (num_segments > _max_num_segments)
+      _max_num_segments = num_segments;
+  }
+}
+
+
+/**
+ * @brief Returns the number of sampled 3D Tracks.
+ * @return the number of sampled 3D Tracks
+ */
+long SegmentSampler::getNumSampledTracks() {
+  return _num_sampled_tracks;
+}
+
+
+/**
+ * @brief Returns the number of segments of the sampled 3D Tracks.
+ * @return the number of sampled segments
+ */
+long SegmentSampler::getNumSampledSegments() {
+  return _num_sampled_segments;
+}
+
+
+/**
+ * @brief Returns the maximum number of segments of a sampled 3D Track.
+ * @return the maximum number of segments per sampled Track
+ */
+int SegmentSampler::getMaxNumSegments() {
+  return _max_num_segments;
+}
+
+
+/**
+ * @brief Constructor for SegmentStatistics calls the TraverseSegments
+ *        constructor and computes the logarithms of the cross sections.
+ * @param track_generator The TrackGenerator to pull tracking information from
+ */
+SegmentStatistics::SegmentStatistics(TrackGenerator* track_generator)
+                                     : TraverseSegments(track_generator) {
+
+  Geometry* geometry = _track_generator->getGeometry();
+  _num_groups = geometry->getNumEnergyGroups();
+  _num_bins = SEGMENT_BINS_PER_DECADE * SEGMENT_NUM_DECADES;
+  _thread_imbalance = 1.;
+  _domain_imbalance = 1.;
+
+  /* Index the Materials by ID, the IDs being ordered in the map */
+  std::map<int, Material*> materials = geometry->getAllMaterials();
+  std::map<int, Material*>::iterator iter;
+  _num_materials = materials.size();
+  _min_material_id = 0;
+  _material_indexes.clear();
+  if (!materials.empty()) {
+    _min_material_id = materials.begin()->first;
+    _material_indexes.resize(materials.rbegin()->first - _min_material_id + 1,
+                             -1);
+  }
+
+  /* Materials without cross section in a group fall in the lowest bin */
+  int index = 0;
+  for (iter = materials.begin(); iter != materials.end(); ++iter) {
+    _material_indexes[iter->first - _min_material_id] = index++;
+    FP_PRECISION* sigma_t = iter->second->getSigmaT();
+    for (int g=0; g < _num_groups; g++)
+      _log_sigma_t.push_back(log10(std::max(double(sigma_t[g]), 1E-30)));
+  }
+
+  /* Number the z-stacks by azimuthal angle and xy index */
+  if (_track_generator_3D != NULL) {
+    _stack_offsets.push_back(0);
+    for (int a=0; a < _track_generator->getNumAzim()/2; a++)
+      _stack_offsets.push_back(_stack_offsets.back() +
+          _track_generator->getNumX(a) + _track_generator->getNumY(a));
+  }
+}
+
+
+/**
+ * @brief Tallies the segment statistics of all the Tracks.
+ * @details The segments are formed as for a transport sweep, split by the
+ *          maximum optical length of the TrackGenerator if it was set. The
+ *          cost is about that of a transport sweep of a single group plus
+ *          the binning of the optical lengths of each group.
+ */
+void SegmentStatistics::execute() {
+
+  int num_threads = omp_get_max_threads();
+  long num_FSRs = _track_generator->getGeometry()->getNumFSRs();
+
+  /* Reset the tallies */
+  SegmentTallies empty_tallies;
+  empty_tallies._lengths.resize(_num_bins, 0);
+  empty_tallies._material_lengths.resize(_num_materials * _num_bins *
+                                         SEGMENT_SUB_BINS, 0);
+  empty_tallies._track_segments.resize(SEGMENT_NUM_COUNT_BINS, 0);
+  empty_tallies._num_tracks = 0;
+  empty_tallies._num_segments = 0;
+  empty_tallies._sum_length = 0.;
+  empty_tallies._min_length = std::numeric_limits<double>::max();
+  empty_tallies._max_length = 0.;
+  empty_tallies._max_optical_length = 0.;
+  empty_tallies._max_track_segments = 0;
+  _thread_tallies.assign(num_threads, empty_tallies);
+  _tallies = empty_tallies;
+  _tallies._optical_lengths.resize(_num_groups * _num_bins, 0);
+  _FSR_visits.assign(num_FSRs, 0);
+  _stack_segments.clear();
+  if (_track_generator_3D != NULL)
+    _stack_segments.resize(_stack_offsets.back() *
+                           _track_generator_3D->getNumPolar(), 0);
+
+#pragma omp parallel
+  {
+    if (_segment_formation != EXPLICIT_2D &&
+        _segment_formation != EXPLICIT_3D) {
+      SegmentationKernel* kernel = getKernel<SegmentationKernel>();
+      loopOverTracks(kernel);
+    }
+    else
+      loopOverTracks(NULL);
+  }
+
+  reduceTallies();
+}
+
+
+/**
+ * @brief Tallies the segments of a Track, or of a z-stack of Tracks with
+ *        on-the-fly z-stack segment formation.
+ * @param track The Track, or the first Track of the z-stack
+ * @param segments The segments associated with the Track or z-stack
+ */
+void SegmentStatistics::onTrack(Track* track, segment* segments) {
+
+  SegmentTallies& tallies = _thread_tallies[omp_get_thread_num()];
+  int num_segments = track->getNumSegments();
+  long* FSR_visits = &_FSR_visits[0];
+
+  double sin_theta = 1.;
+  Track3D* track_3D = dynamic_cast<Track3D*>(track);
+  if (track_3D != NULL)
+    sin_theta = sin(track_3D->getTheta());
+  double log_sin_theta = log10(sin_theta);
+
+  /* Tally the lengths and projected lengths of the segments, the length
+   * statistics being accumulated locally since the tallies of the threads
+   * share cache lines */
+  long* lengths = &tallies._lengths[0];
+  long* material_lengths = &tallies._material_lengths[0];
+  int num_sub_bins = _num_bins * SEGMENT_SUB_BINS;
+  double sum_length = 0.;
+  double min_length = tallies._min_length;
+  double max_length = tallies._max_length;
+  double max_optical_length = tallies._max_optical_length;
+  for (int s=0; s < num_segments; s++) {
+
+    /* Segments of zero length fall in the lowest bins */
+    double length = segments[s]._length;
+    int length_bin = 0;
+    int sub_bin = 0;
+    if (length > 0.) {
+      double log_length = log10(length);
+      length_bin = getLengthBin(log_length);
+      sub_bin = getSubBin(log_length + log_sin_theta);
+    }
+    lengths[length_bin]++;
+    sum_length += length;
+    min_length = std::min(min_length, length);
+    max_length = std::max(max_length, length);
+
+    Material* material = segments[s]._material;
+    long id = material->getId() - _min_material_id;
+    if (id < 0 || id >= long(_material_indexes.size()) ||
+        _material_indexes[id] < 0)
+      log_printf(ERROR, "Unable to tally the optical length of a segment in "
+                 "Material %d which is not in the Geometry", material->getId());
+    material_lengths[_material_indexes[id] * num_sub_bins + sub_bin]++;
+    max_optical_length = std::max(max_optical_length,
+        length * sin_theta * material->getMaxSigmaT());
+
+#pragma omp atomic update
+    FSR_visits[segments[s]._region_id]++;
+  }
+  tallies._sum_length += sum_length;
+  tallies._min_length = min_length;
+  tallies._max_length = max_length;
+  tallies._max_optical_length = max_optical_length;
+
+  /* Tally the segments per Track, a z-stack holding several Tracks */
+  int num_tracks = 1;
+  if (_segment_formation == OTF_STACKS) {
+    int*** tracks_per_stack = _track_generator_3D->getTracksPerStack();
+    num_tracks = tracks_per_stack[track->getAzimIndex()][track->getXYIndex()]
+                 [track_3D->getPolarIndex()];
+    std::vector<int>& track_segments = tallies._stack_track_segments;
+    track_segments.assign(num_tracks, 0);
+    for (int s=0; s < num_segments; s++)
+      track_segments[segments[s]._track_idx]++;
+    for (int i=0; i < num_tracks; i++) {
+      tallies._track_segments[getCountBin(track_segments[i])]++;
+      tallies._max_track_segments = std::max(tallies._max_track_segments,
+                                             track_segments[i]);
+    }
+  }
+  else {
+    tallies._track_segments[getCountBin(num_segments)]++;
+    tallies._max_track_segments = std::max(tallies._max_track_segments,
+                                           num_segments);
+  }
+  tallies._num_tracks += num_tracks;
+  tallies._num_segments += num_segments;
+
+  /* Tally the segments per z-stack */
+  if (track_3D != NULL) {
+    long stack = (_stack_offsets[track->getAzimIndex()] + track->getXYIndex())
+                 * _track_generator_3D->getNumPolar() +
+                 track_3D->getPolarIndex();
+#pragma omp atomic update
+    _stack_segments[stack] += num_segments;
+  }
+}
+
+
+/**
+ * @brief Returns the bin of a length or optical length.
+ * @param log_length the decimal logarithm of the length
+ * @return the logarithmic bin, the extreme bins holding the lengths outside
+ *         of the histogram range
+ */
+int SegmentStatistics::getLengthBin(double log_length) {
+  int bin = int(floor(SEGMENT_BINS_PER_DECADE *
+                      (log_length - SEGMENT_MIN_DECADE)));
+  return std::max(0, std::min(bin, _num_bins - 1));
+}
+
+
+/**
+ * @brief Returns the sub-bin of a projected length.
+ * @param log_length the decimal logarithm of the projected length
+ * @return the logarithmic sub-bin, the extreme sub-bins holding the lengths
+ *         outside of the histogram range
+ */
+int SegmentStatistics::getSubBin(double log_length) {
+  int bin = int(floor(SEGMENT_BINS_PER_DECADE * SEGMENT_SUB_BINS *
+                      (log_length - SEGMENT_MIN_DECADE)));
+  return std::max(0, std::min(bin, _num_bins * SEGMENT_SUB_BINS - 1));
+}
+
+
+/**
+ * @brief Returns the bin of a number of segments.
+ * @param count the number of segments
+ * @return 0 for no segment, else 1 + the base 2 logarithm of the number
+ */
+int SegmentStatistics::getCountBin(long count) {
+  if (count <= 0)
+    return 0;
+  return std::min(1 + ilogb(double(count)), SEGMENT_NUM_COUNT_BINS - 1);
+}
+
+
+/**
+ * @brief Sums the tallies of the threads and the domains, and computes the
+ *        imbalances of the segments.
+ */
+void SegmentStatistics::reduceTallies() {
+
+  /* Sum the tallies of the threads */
+  long max_thread_segments = 0;
+  for (size_t t=0; t < _thread_tallies.size(); t++) {
+    SegmentTallies& tallies = _thread_tallies[t];
+    for (int b=0; b < _num_bins; b++)
+      _tallies._lengths[b] += tallies._lengths[b];
+    for (size_t b=0; b < tallies._material_lengths.size(); b++)
+      _tallies._material_lengths[b] += tallies._material_lengths[b];
+    for (int b=0; b < SEGMENT_NUM_COUNT_BINS; b++)
+      _tallies._track_segments[b] += tallies._track_segments[b];
+    _tallies._num_tracks += tallies._num_tracks;
+    _tallies._num_segments += tallies._num_segments;
+    _tallies._sum_length += tallies._sum_length;
+    _tallies._min_length = std::min(_tallies._min_length,
+                                    tallies._min_length);
+    _tallies._max_length = std::max(_tallies._max_length,
+                                    tallies._max_length);
+    _tallies._max_optical_length = std::max(_tallies._max_optical_length,
+                                            tallies._max_optical_length);
+    _tallies._max_track_segments = std::max(_tallies._max_track_segments,
+                                            tallies._max_track_segments);
+    max_thread_segments = std::max(max_thread_segments,
+                                   tallies._num_segments);
+  }
+  _thread_tallies.clear();
+
+  /* Bin the optical lengths from the centers of the projected length
+   * sub-bins of each Material */
+  int num_sub_bins = _num_bins * SEGMENT_SUB_BINS;
+  for (int m=0; m < _num_materials; m++) {
+    for (int b=0; b < num_sub_bins; b++) {
+      long count = _tallies._material_lengths[m * num_sub_bins + b];
+      if (count == 0)
+        continue;
+      double log_length = SEGMENT_MIN_DECADE + (b + 0.5) /
+                          (SEGMENT_BINS_PER_DECADE * SEGMENT_SUB_BINS);
+      for (int g=0; g < _num_groups; g++)
+        _tallies._optical_lengths[g * _num_bins + getLengthBin(
+            log_length + _log_sigma_t[m * _num_groups + g])] += count;
+    }
+  }
+
+  /* Histogram the segments per z-stack, skipping the empty z-stacks */
+  _stack_histogram.assign(SEGMENT_NUM_COUNT_BINS, 0);
+  if (_track_generator_3D != NULL) {
+    int*** tracks_per_stack = _track_generator_3D->getTracksPerStack();
+    int num_polar = _track_generator_3D->getNumPolar();
+    for (int a=0; a < _track_generator->getNumAzim()/2; a++) {
+      for (long i=0; i < _stack_offsets[a+1] - _stack_offsets[a]; i++) {
+        for (int p=0; p < num_polar; p++) {
+          if (tracks_per_stack[a][i][p] > 0)
+            _stack_histogram[getCountBin(_stack_segments[
+                (_stack_offsets[a] + i) * num_polar + p])]++;
+        }
+      }
+    }
+  }
+
+  /* Imbalance of the segments over the threads of the domain */
+  double num_segments = _tallies._num_segments;
+  int num_threads = omp_get_max_threads();
+  _thread_imbalance = 1.;
+  if (num_segments > 0)
+    _thread_imbalance = max_thread_segments * num_threads / num_segments;
+  _domain_imbalance = 1.;
+
+#ifdef MPIx
+  Geometry* geometry = _track_generator->getGeometry();
+  if (geometry->isDomainDecomposed()) {
+    MPI_Comm MPI_cart = geometry->getMPICart();
+    int num_domains;
+    MPI_Comm_size(MPI_cart, &num_domains);
+
+    /* Imbalance of the segments over the domains */
+    double max_segments, sum_segments;
+    MPI_Allreduce(&num_segments, &max_segments, 1, MPI_DOUBLE, MPI_MAX,
+                  MPI_cart);
+    MPI_Allreduce(&num_segments, &sum_segments, 1, MPI_DOUBLE, MPI_SUM,
+                  MPI_cart);
+    if (sum_segments > 0)
+      _domain_imbalance = max_segments * num_domains / sum_segments;
+    MPI_Allreduce(MPI_IN_PLACE, &_thread_imbalance, 1, MPI_DOUBLE, MPI_MAX,
+                  MPI_cart);
+
+    /* Sum the histograms and counts, and take the extrema */
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._lengths[0], _num_bins, MPI_LONG,
+                  MPI_SUM, MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._optical_lengths[0],
+                  _num_groups * _num_bins, MPI_LONG, MPI_SUM, MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._track_segments[0],
+                  SEGMENT_NUM_COUNT_BINS, MPI_LONG, MPI_SUM, MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_stack_histogram[0], SEGMENT_NUM_COUNT_BINS,
+                  MPI_LONG, MPI_SUM, MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._num_tracks, 1, MPI_LONG, MPI_SUM,
+                  MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._num_segments, 1, MPI_LONG, MPI_SUM,
+                  MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._sum_length, 1, MPI_DOUBLE, MPI_SUM,
+                  MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._min_length, 1, MPI_DOUBLE, MPI_MIN,
+                  MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._max_length, 1, MPI_DOUBLE, MPI_MAX,
+                  MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._max_optical_length, 1, MPI_DOUBLE,
+                  MPI_MAX, MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &_tallies._max_track_segments, 1, MPI_INT,
+                  MPI_MAX, MPI_cart);
+  }
+#endif
+}
+
+
+/**
+ * @brief Prints a summary of the segment statistics.
+ */
+void SegmentStatistics::printReport() {
+
+  std::string msg_string;
+
+  /* Count the FSRs crossed by few segments in the domain */
+  long num_FSRs = _FSR_visits.size();
+  long min_visits = 0;
+  long num_poor_FSRs = 0;
+  if (num_FSRs > 0)
+    min_visits = *std::min_element(_FSR_visits.begin(), _FSR_visits.end());
+  for (long r=0; r < num_FSRs; r++)
+    if (_FSR_visits[r] < 10)
+      num_poor_FSRs++;
+
+#ifdef MPIx
+  Geometry* geometry = _track_generator->getGeometry();
+  if (geometry->isDomainDecomposed()) {
+    MPI_Comm MPI_cart = geometry->getMPICart();
+    MPI_Allreduce(MPI_IN_PLACE, &num_FSRs, 1, MPI_LONG, MPI_SUM, MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &min_visits, 1, MPI_LONG, MPI_MIN, MPI_cart);
+    MPI_Allreduce(MPI_IN_PLACE, &num_poor_FSRs, 1, MPI_LONG, MPI_SUM,
+                  MPI_cart);
+  }
+#endif
+
+  log_printf(TITLE, "SEGMENT STATISTICS");
+  log_printf(RESULT, "Tracks = %ld, segments = %ld, FSRs = %ld",
+             _tallies._num_tracks, _tallies._num_segments, num_FSRs);
+
+  msg_string = "Segment length min / mean / max";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%1.2E / %1.2E / %1.2E cm", msg_string.c_str(),
+             _tallies._min_length, getMeanSegmentLength(),
+             _tallies._max_length);
+
+  msg_string = "Optical length median / 99% / max";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%1.2E / %1.2E / %1.2E", msg_string.c_str(),
+             getOpticalLengthQuantile(0.5), getOpticalLengthQuantile(0.99),
+             getMaxOpticalLength());
+
+  msg_string = "Segments per Track mean / max";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%.1f / %d", msg_string.c_str(),
+             getMeanSegmentsPerTrack(), getMaxSegmentsPerTrack());
+
+  msg_string = "Segments per FSR min, FSRs with fewer than 10";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%ld, %ld", msg_string.c_str(), min_visits,
+             num_poor_FSRs);
+
+  msg_string = "Max / mean segments over the threads";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%.3f", msg_string.c_str(), _thread_imbalance);
+
+  msg_string = "Max / mean segments over the domains";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%.3f", msg_string.c_str(), _domain_imbalance);
+}
+
+
+/**
+ * @brief Writes the histograms and the FSR visits to a text file.
+ * @details The histograms are summed over the domains and the FSR visits
+ *          are those of the domain. With domain decomposition, the file is
+ *          a directory holding a file per domain, as for the FSR fluxes.
+ * @param filename the name of the statistics file
+ */
+void SegmentStatistics::exportStatistics(std::string filename) {
+
+  Geometry* geometry = _track_generator->getGeometry();
+  if (geometry->isDomainDecomposed()) {
+    int indexes[3];
+    if (geometry->isRootDomain())
+      mkdir(filename.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+#ifdef MPIx
+    MPI_Barrier(geometry->getMPICart());
+#endif
+    filename += "/node";
+    geometry->getDomainIndexes(indexes);
+    for (int i=0; i < 3; i++)
+      filename += "_" + std::to_string(indexes[i]);
+  }
+
+  FILE* out = fopen(filename.c_str(), "w");
+  if (out == NULL)
+    log_printf(ERROR, "Segment statistics file %s could not be written",
+               filename.c_str());
+
+  fprintf(out, "# Tracks segments FSRs thread_imbalance domain_imbalance\n");
+  fprintf(out, "%ld %ld %ld %.6f %.6f\n", _tallies._num_tracks,
+          _tallies._num_segments, (long) _FSR_visits.size(),
+          _thread_imbalance, _domain_imbalance);
+
+  /* Length histograms, by lower and upper bin edges */
+  fprintf(out, "\n# Segment lengths (cm): lower upper segments\n");
+  for (int b=0; b < _num_bins; b++)
+    fprintf(out, "%1.6E %1.6E %ld\n",
+            pow(10., SEGMENT_MIN_DECADE + double(b) / SEGMENT_BINS_PER_DECADE),
+            pow(10., SEGMENT_MIN_DECADE + double(b+1) /
+                SEGMENT_BINS_PER_DECADE), _tallies._lengths[b]);
+  for (int g=0; g < _num_groups; g++) {
+    fprintf(out, "\n# Optical lengths of group %d: lower upper segments\n",
+            g+1);
+    for (int b=0; b < _num_bins; b++)
+      fprintf(out, "%1.6E %1.6E %ld\n", pow(10., SEGMENT_MIN_DECADE +
+              double(b) / SEGMENT_BINS_PER_DECADE), pow(10.,
+              SEGMENT_MIN_DECADE + double(b+1) / SEGMENT_BINS_PER_DECADE),
+              _tallies._optical_lengths[g * _num_bins + b]);
+  }
+
+  /* Segment count histograms, by smallest and largest count of each bin */
+  fprintf(out, "\n# Segments per Track: min max Tracks\n");
+  for (int b=0; b < SEGMENT_NUM_COUNT_BINS; b++)
+    fprintf(out, "%ld %ld %ld\n", (b == 0) ? 0 : 1L << (b-1),
+            (b == 0) ? 0 : (1L << b) - 1, _tallies._track_segments[b]);
+  fprintf(out, "\n# Segments per z-stack: min max z-stacks\n");
+  for (int b=0; b < SEGMENT_NUM_COUNT_BINS; b++)
+    fprintf(out, "%ld %ld %ld\n", (b == 0) ? 0 : 1L << (b-1),
+            (b == 0) ? 0 : (1L << b) - 1, _stack_histogram[b]);
+
+  fprintf(out, "\n# Segments per FSR: FSR segments\n");
+  for (size_t r=0; r < _FSR_visits.size(); r++)
+    fprintf(out, "%ld %ld\n", (long) r, _FSR_visits[r]);
+
+  fclose(out);
+  log_printf(NORMAL, "Segment statistics written to %s", filename.c_str());
+}
+
+
+/**
+ * @brief Returns the number of segments.
+ * @return the number of segments, summed over the domains
+ */
+long SegmentStatistics::getNumSegments() {
+  return _tallies._num_segments;
+}
+
+
+/**
+ * @brief Returns the mean segment length.
+ * @return the mean segment length (cm)
+ */
+double SegmentStatistics::getMeanSegmentLength() {
+  if (_tallies._num_segments == 0)
+    return 0.;
+  return _tallies._sum_length / _tallies._num_segments;
+}
+
+
+/**
+ * @brief Returns the maximum optical length of a segment.
+ * @details This is the maximum optical length that the TrackGenerator would
+ *          compute for the exponential evaluators.
+ * @return the maximum projected optical length over the energy groups
+ */
+double SegmentStatistics::getMaxOpticalLength() {
+  return _tallies._max_optical_length;
+}
+
+
+/**
+ * @brief Returns an upper bound of the optical length of a fraction of the
+ *        segments.
+ * @details This may be used to choose a maximum optical length smaller than
+ *          the largest one, splitting only a small fraction of the segments
+ *          to reduce the exponential tables. The bound is the upper edge of
+ *          the histogram bin reaching the fraction of the segments.
+ * @param fraction the fraction of the segments, between 0 and 1
+ * @param group the energy group starting at 1, or -1 for all the groups
+ * @return the optical length of the fraction of the segments
+ */
+double SegmentStatistics::getOpticalLengthQuantile(double fraction,
+                                                   int group) {
+
+  if (fraction < 0. || fraction > 1.)
+    log_printf(ERROR, "Unable to compute the optical length of a fraction %f "
+               "of the segments, which is not between 0 and 1", fraction);
+  if (group == 0 || group > _num_groups)
+    log_printf(ERROR, "Unable to compute the optical lengths of group %d in "
+               "a %d energy group problem", group, _num_groups);
+
+  int first_group = (group < 0) ? 0 : group - 1;
+  int last_group = (group < 0) ? _num_groups : group;
+
+  /* Count the segments of the groups */
+  std::vector<long> histogram(_num_bins, 0);
+  long total = 0;
+  for (int g=first_group; g < last_group; g++) {
+    for (int b=0; b < _num_bins; b++) {
+      histogram[b] += _tallies._optical_lengths[g * _num_bins + b];
+      total += _tallies._optical_lengths[g * _num_bins + b];
+    }
+  }
+
+  long cumulative = 0;
+  for (int b=0; b < _num_bins; b++) {
+    cumulative += histogram[b];
+    if (cumulative >= fraction * total)
+      return std::min(getMaxOpticalLength(), pow(10., SEGMENT_MIN_DECADE +
+                      double(b+1) / SEGMENT_BINS_PER_DECADE));
+  }
+  return getMaxOpticalLength();
+}
+
+
+/**
+ * @brief Returns the mean number of segments per Track.
+ * @return the mean number of segments per Track
+ */
+double SegmentStatistics::getMeanSegmentsPerTrack() {
+  if (_tallies._num_tracks == 0)
+    return 0.;
+  return double(_tallies._num_segments) / _tallies._num_tracks;
+}
+
+
+/**
+ * @brief Returns the maximum number of segments of a Track.
+ * @return the maximum number of segments per Track
+ */
+int SegmentStatistics::getMaxSegmentsPerTrack() {
+  return _tallies._max_track_segments;
+}
+
+
+/**
+ * @brief Returns the number of segments crossing an FSR.
+ * @param fsr_id the ID of the FSR in the domain
+ * @return the number of segments crossing the FSR
+ */
+long SegmentStatistics::getFSRVisits(long fsr_id) {
+  if (fsr_id < 0 || fsr_id >= (long) _FSR_visits.size())
+    log_printf(ERROR, "Unable to return the segments of FSR %ld with only "
+               "%ld FSRs tallied", fsr_id, (long) _FSR_visits.size());
+  return _FSR_visits[fsr_id];
+}
+
+
+/**
+ * @brief Returns the imbalance of the segments over the threads.
+ * @details The imbalance is for the dynamic schedule of this traversal, it
+ *          is an estimate of the imbalance of the transport sweeps.
+ * @return the maximum over the mean number of segments of a thread, maximum
+ *         over the domains
+ */
+double SegmentStatistics::getThreadImbalance() {
+  return _thread_imbalance;
+}
+
+
+/**
+ * @brief Returns the imbalance of the segments over the domains.
+ * @return the maximum over the mean number of segments of a domain
+ */
+double SegmentStatistics::getDomainImbalance() {
+  return _domain_imbalance;
+}
+
+
 /**
  * @brief Constructor for SegmentSplitter calls the TraverseSegments
  *        constructor.
@@ -287,7 +1005,7 @@ VolumeCalculator::VolumeCalculator(TrackGenerator* track_generator)
 void VolumeCalculator::execute() {
 #pragma omp parallel
   {
-    MOCKernel* kernel = getKernel<VolumeKernel>();
+    VolumeKernel* kernel = getKernel<VolumeKernel>();
     loopOverTracks(kernel);
   }
 }
@@ -351,7 +1069,7 @@ void CentroidGenerator::execute() {
     // OTF ray tracing requires segmentation of tracks
     if (_segment_formation != EXPLICIT_2D &&
         _segment_formation != EXPLICIT_3D) {
-      MOCKernel* kernel = getKernel<SegmentationKernel>();
+      SegmentationKernel* kernel = getKernel<SegmentationKernel>();
       loopOverTracks(kernel);
     }
     else
@@ -362,9 +1080,9 @@ void CentroidGenerator::execute() {
 
 /**
  * @brief Specifies an array to save calculated FSR centroids
- * @param centroids The array of pointer to FSR centroids
+ * @param centroids The array of FSR centroids
  */
-void CentroidGenerator::setCentroids(Point** centroids) {
+void CentroidGenerator::setCentroids(Point* centroids) {
   _centroids = centroids;
 }
 
@@ -431,16 +1149,16 @@ void CentroidGenerator::onTrack(Track* track, segment* segments) {
     /* Set the lock for this FSR */
     omp_set_lock(&_FSR_locks[fsr]);
 
-    _centroids[fsr]->
-        setX(_centroids[fsr]->getX() + wgt *
+    _centroids[fsr].
+        setX(_centroids[fsr].getX() + wgt *
         (x + cos_phi * sin_theta * curr_segment->_length / 2.0)
         * curr_segment->_length / _FSR_volumes[fsr]);
-    _centroids[fsr]->
-        setY(_centroids[fsr]->getY() + wgt *
+    _centroids[fsr].
+        setY(_centroids[fsr].getY() + wgt *
         (y + sin_phi * sin_theta * curr_segment->_length / 2.0)
         * curr_segment->_length / _FSR_volumes[fsr]);
-    _centroids[fsr]->
-        setZ(_centroids[fsr]->getZ() + wgt *
+    _centroids[fsr].
+        setZ(_centroids[fsr].getZ() + wgt *
         (z + cos_theta * curr_segment->_length / 2.0)
         * curr_segment->_length / _FSR_volumes[fsr]);
 
@@ -537,7 +1255,7 @@ void LinearExpansionGenerator::execute() {
     // OTF ray tracing requires segmentation of tracks
     if (_segment_formation != EXPLICIT_2D &&
         _segment_formation != EXPLICIT_3D) {
-      MOCKernel* kernel = getKernel<SegmentationKernel>();
+      SegmentationKernel* kernel = getKernel<SegmentationKernel>();
       loopOverTracks(kernel);
     }
     else
@@ -859,22 +1577,45 @@ TransportSweep::~TransportSweep() {
 
 /**
  * @brief MOC equations are applied to every segment in the TrackGenerator
- * @details SegmentationKernels are allocated to temporarily save segments. Then
- *          onTrack(...) applies the MOC equations to each segment and
- *          transfers boundary fluxes for the corresponding Track.
+ * @details A team of threads sweeps the Tracks, see sweep().
  */
 void TransportSweep::execute() {
 #pragma omp parallel
-  {
-    // OTF ray tracing requires segmentation of tracks
-    if (_segment_formation != EXPLICIT_2D &&
-        _segment_formation != EXPLICIT_3D) {
-      MOCKernel* kernel = getKernel<SegmentationKernel>();
-      loopOverTracks(kernel);
-    }
-    else
-      loopOverTracks(NULL);
+  sweep();
+}
+
+
+/**
+ * @brief MOC equations are applied to every segment in the TrackGenerator
+ *        by the calling team of threads.
+ * @details SegmentationKernels are allocated to temporarily save segments. Then
+ *          onTrack(...) applies the MOC equations to each segment and
+ *          transfers boundary fluxes for the corresponding Track. For cycle
+ *          ordered sweeps, the Tracks are traversed cycle by cycle. This must
+ *          be called by all the threads of a parallel region, which share
+ *          the Tracks.
+ */
+void TransportSweep::sweep() {
+
+  /* Sweep the Tracks along their cycles for in-place flux transfers */
+  if (_cpu_solver->isCycleOrderedSweep()) {
+    SegmentationKernel* kernel = getKernel<SegmentationKernel>();
+    loopOverTracksByCycle(kernel, _cpu_solver->getCycleTracks(),
+                          _cpu_solver->getCycleOffsets(),
+                          _cpu_solver->getNumCycles());
+  }
+
+  // OTF ray tracing requires segmentation of tracks
+  else if (_segment_formation != EXPLICIT_2D &&
+      _segment_formation != EXPLICIT_3D) {
+    SegmentationKernel* kernel = getKernel<SegmentationKernel>();
+    loopOverTracks(kernel);
   }
+  else
+    loopOverTracks(NULL);
+
+  /* Order the boundary fluxes written around the cache by this thread */
+  _cpu_solver->fenceStreamingStores();
 }
 
 
@@ -902,7 +1643,9 @@ void TransportSweep::onTrack(Track* track, segment* segments) {
   /* Extract the polar index and quadrature weight if a 3D track */
   int polar_index = 0;
   FP_PRECISION weight = 1;
-  Track3D* track_3D = dynamic_cast<Track3D*>(track);
+  Track3D* track_3D = NULL;
+  if (_segment_formation != EXPLICIT_2D)
+    track_3D = static_cast<Track3D*>(track);
   if (track_3D != NULL) {
     polar_index = track_3D->getPolarIndex();
     weight = _track_generator->getQuadrature()->getWeightInline(azim_index,
@@ -934,6 +1677,11 @@ void TransportSweep::onTrack(Track* track, segment* segments) {
     tracks_array = _track_generator_3D->getTemporaryTracksArray(tid);
   }
 
+  /* Prefetch the boundary fluxes of the next Track in the sweep order */
+  int prefetch_distance = _cpu_solver->getPrefetchDistance();
+  if (prefetch_distance > 0)
+    _cpu_solver->prefetchTrackFlux(track_id + max_track_index + 1);
+
   /* Allocate a temporary flux buffer on the stack (free) and initialize it */
   /* Select right size for buffer */
 #ifndef NGROUPS
@@ -961,6 +1709,10 @@ void TransportSweep::onTrack(Track* track, segment* segments) {
   /* Loop over each Track segment in forward direction */
   for (int s=0; s < num_segments; s++) {
 
+    /* Prefetch the FSR data of an upcoming segment */
+    if (prefetch_distance > 0 && s + prefetch_distance < num_segments)
+      _cpu_solver->prefetchSegment(&segments[s + prefetch_distance]);
+
     /* Get the forward track flux */
     segment* curr_segment = &segments[s];
     long curr_track_id = track_id + curr_segment->_track_idx;
@@ -1009,6 +1761,10 @@ void TransportSweep::onTrack(Track* track, segment* segments) {
   /* Loop over each Track segment in reverse direction */
   for (int s=num_segments-1; s >= 0; s--) {
 
+    /* Prefetch the FSR data of an upcoming segment */
+    if (prefetch_distance > 0 && s - prefetch_distance >= 0)
+      _cpu_solver->prefetchSegment(&segments[s - prefetch_distance]);
+
     /* Get the backward track flux */
     segment* curr_segment = &segments[s];
     long curr_track_id = track_id + curr_segment->_track_idx;
@@ -1074,7 +1830,7 @@ void DumpSegments::execute() {
   // OTF ray tracing requires segmentation of tracks
   if (_segment_formation != EXPLICIT_2D &&
       _segment_formation != EXPLICIT_3D) {
-    MOCKernel* kernel = getKernel<SegmentationKernel>();
+    SegmentationKernel* kernel = getKernel<SegmentationKernel>();
     loopOverTracks(kernel);
   }
   else
@@ -1304,7 +2060,7 @@ void RecenterSegments::execute() {
     // OTF ray tracing requires segmentation of tracks
     if (_segment_formation != EXPLICIT_2D &&
         _segment_formation != EXPLICIT_3D) {
-      MOCKernel* kernel = getKernel<SegmentationKernel>();
+      SegmentationKernel* kernel = getKernel<SegmentationKernel>();
       loopOverTracks(kernel);
     }
     else
@@ -1355,7 +2111,7 @@ void PrintSegments::execute() {
   // OTF ray tracing requires segmentation of tracks
   if (_segment_formation != EXPLICIT_2D &&
       _segment_formation != EXPLICIT_3D) {
-    MOCKernel* kernel = getKernel<SegmentationKernel>();
+    SegmentationKernel* kernel = getKernel<SegmentationKernel>();
     loopOverTracks(kernel);
   }
   else
@@ -28,11 +28,61 @@
 #define _NUM_COEFFS 6
 #endif
 
+/** The number of logarithmic bins per decade of the length histograms */
+#define SEGMENT_BINS_PER_DECADE 5
+
+/** The decades of the length histograms, from 1E-6 to 1E3 */
+#define SEGMENT_MIN_DECADE -6
+#define SEGMENT_NUM_DECADES 9
+
+/** The number of sub-bins of the projected length histograms of each bin */
+#define SEGMENT_SUB_BINS 10
+
+/** The number of power of two bins of the segment count histograms */
+#define SEGMENT_NUM_COUNT_BINS 32
+
 /** Forward declaration of CPUSolver class */
 class CPUSolver;
 class CPULSSolver;
 
 
+/**
+ * @struct SegmentTallies
+ * @brief The segment statistics tallied by one thread.
+ */
+struct SegmentTallies {
+
+  /** The histogram of the segment lengths */
+  std::vector<long> _lengths;
+
+  /** The histograms of the optical lengths, by energy group */
+  std::vector<long> _optical_lengths;
+
+  /** The histograms of the projected segment lengths on sub-bins, by
+   *  Material index */
+  std::vector<long> _material_lengths;
+
+  /** The histogram of the number of segments per Track */
+  std::vector<long> _track_segments;
+
+  /** The number of segments of each Track of the current z-stack */
+  std::vector<int> _stack_track_segments;
+
+  /** The number of Tracks and segments */
+  long _num_tracks;
+  long _num_segments;
+
+  /** The sum, minimum and maximum of the segment lengths */
+  double _sum_length;
+  double _min_length;
+  double _max_length;
+
+  /** The maximum optical length and number of segments of a Track */
+  double _max_optical_length;
+  int _max_track_segments;
+};
+
+
 /**
  * @class MaxOpticalLength TrackTraversingAlgorithms.h
  *        "src/TrackTraversingAlgorithms.h"
@@ -82,6 +132,112 @@ public:
 };
 
 
+/**
+ * @class SegmentSampler TrackTraversingAlgorithms.h
+ *        "src/TrackTraversingAlgorithms.h"
+ * @brief A class used to count the segments on a sample of the 3D Tracks.
+ * @details A SegmentSampler traces the z-stacks above one in every few
+ *          flattened 2D Tracks on-the-fly with CounterKernels, so that the
+ *          number of 3D segments can be estimated without tracing every
+ *          Track. It requires on-the-fly segment formation.
+ */
+class SegmentSampler: public TraverseSegments {
+private:
+  int _stride;
+  long _num_sampled_tracks;
+  long _num_sampled_segments;
+  int _max_num_segments;
+
+public:
+
+  SegmentSampler(TrackGenerator* track_generator, int stride);
+  void execute();
+  void onTrack(Track* track, segment* segments);
+  long getNumSampledTracks();
+  long getNumSampledSegments();
+  int getMaxNumSegments();
+};
+
+
+/**
+ * @class SegmentStatistics TrackTraversingAlgorithms.h
+ *        "src/TrackTraversingAlgorithms.h"
+ * @brief A class used to compute statistics of the segments, to tune the
+ *        ray tracing and the evaluation of the exponentials.
+ * @details A SegmentStatistics traverses all the Tracks once, forming the
+ *          segments on-the-fly if necessary, and tallies histograms of the
+ *          segment lengths, of the optical lengths in each energy group and
+ *          of the number of segments per Track and per z-stack, as well as
+ *          the number of segments crossing each FSR. The histograms are
+ *          tallied by thread and summed over the domains, and the imbalance
+ *          of the segments between the threads and the domains is reported.
+ *          The optical lengths are projected on the radial plane, as the
+ *          maximum optical length of the TrackGenerator. They are binned
+ *          from histograms of the projected lengths in each Material, on
+ *          sub-bins of the length histograms, once the Tracks are traversed.
+ */
+class SegmentStatistics: public TraverseSegments {
+
+private:
+
+  /** The number of energy groups and of bins of the length histograms */
+  int _num_groups;
+  int _num_bins;
+
+  /** The number of Materials and the index of each Material, by ID from
+   *  the smallest ID, or -1 for the IDs of no Material */
+  int _num_materials;
+  int _min_material_id;
+  std::vector<int> _material_indexes;
+
+  /** The logarithms of the total cross sections, by Material index */
+  std::vector<double> _log_sigma_t;
+
+  /** The index of the first z-stack of each azimuthal angle */
+  std::vector<long> _stack_offsets;
+
+  /** The number of segments of each z-stack */
+  std::vector<long> _stack_segments;
+
+  /** The number of segments crossing each FSR of the domain */
+  std::vector<long> _FSR_visits;
+
+  /** The tallies of each thread */
+  std::vector<SegmentTallies> _thread_tallies;
+
+  /** The tallies summed over the threads and domains */
+  SegmentTallies _tallies;
+  std::vector<long> _stack_histogram;
+
+  /** The maximum over the mean segments per thread and per domain */
+  double _thread_imbalance;
+  double _domain_imbalance;
+
+  int getLengthBin(double log_length);
+  int getSubBin(double log_length);
+  int getCountBin(long count);
+  void reduceTallies();
+
+public:
+
+  SegmentStatistics(TrackGenerator* track_generator);
+  void execute();
+  void onTrack(Track* track, segment* segments);
+  void printReport();
+  void exportStatistics(std::string filename);
+
+  long getNumSegments();
+  double getMeanSegmentLength();
+  double getMaxOpticalLength();
+  double getOpticalLengthQuantile(double fraction, int group=-1);
+  double getMeanSegmentsPerTrack();
+  int getMaxSegmentsPerTrack();
+  long getFSRVisits(long fsr_id);
+  double getThreadImbalance();
+  double getDomainImbalance();
+};
+
+
 /**
  * @class SegmentSplitter TrackTraversingAlgorithms.h
  *        "src/TrackTraversingAlgorithms.h"
@@ -135,7 +291,7 @@ class CentroidGenerator: public TraverseSegments {
 
 private:
 
-  Point** _centroids;
+  Point* _centroids;
   FP_PRECISION* _FSR_volumes;
   omp_lock_t* _FSR_locks;
   Quadrature* _quadrature;
@@ -145,7 +301,7 @@ public:
 
   CentroidGenerator(TrackGenerator* track_generator);
   virtual ~CentroidGenerator();
-  void setCentroids(Point** centroids);
+  void setCentroids(Point* centroids);
   void execute();
   void onTrack(Track* track, segment* segments);
 };
@@ -213,6 +369,7 @@ public:
   TransportSweep(CPUSolver* cpu_solver);
   virtual ~TransportSweep();
   void execute();
+  void sweep();
   void onTrack(Track* track, segment* segments);
 
 };
@@ -33,10 +33,13 @@ TraverseSegments::~TraverseSegments() {
  * @details The segment formation method imported from the TrackGenerator
  *          during construction is used to redirect to the appropriate looping
  *          scheme. If a kernel is provided (not NULL) then it is deleted at
- *          the end of the looping scheme.
+ *          the end of the looping scheme. The looping scheme is compiled for
+ *          the type of the kernel, so that the kernel is applied to the
+ *          segments without virtual calls.
  * @param kernel MOCKernel to apply to all segments
  */
-void TraverseSegments::loopOverTracks(MOCKernel* kernel) {
+template <class KernelType>
+void TraverseSegments::loopOverTracks(KernelType* kernel) {
 
   switch (_segment_formation) {
     case EXPLICIT_2D:
@@ -58,6 +61,95 @@ void TraverseSegments::loopOverTracks(MOCKernel* kernel) {
 }
 
 
+/**
+ * @brief Loops over Tracks, applying the provided kernel of any type to all
+ *        segments and the functionality described in onTrack(...) to all
+ *        Tracks.
+ * @details This generic looping scheme is used when no kernel (NULL) is
+ *          provided, and calls the "execute" function of the kernel
+ *          virtually otherwise.
+ * @param kernel MOCKernel to apply to all segments
+ */
+void TraverseSegments::loopOverTracks(MOCKernel* kernel) {
+  loopOverTracks<MOCKernel>(kernel);
+}
+
+
+/**
+ * @brief Loops over the Tracks grouped in cycles, each cycle being traversed
+ *        in order by a single thread.
+ * @details The onTrack(...) function is applied to all Tracks of a cycle in
+ *          the provided order and the specified kernel is applied to all
+ *          segments. If NULL is provided for the kernel, only the
+ *          onTrack(...) functionality is applied. Tracks are traced one by
+ *          one, so this loop does not apply to OTF_STACKS segmentation.
+ * @param kernel The MOCKernel dictating the functionality to apply to
+ *        segments
+ * @param tracks the indexes of the Tracks, in traversal order
+ * @param cycle_offsets the offsets of each cycle into the Track indexes
+ * @param num_cycles the number of cycles
+ */
+template <class KernelType>
+void TraverseSegments::loopOverTracksByCycle(KernelType* kernel,
+                                             TrackStackIndexes* tracks,
+                                             long* cycle_offsets,
+                                             long num_cycles) {
+
+  Track** tracks_2D = _track_generator->get2DTracks();
+  int tid = omp_get_thread_num();
+
+#pragma omp for schedule(dynamic)
+  for (long c=0; c < num_cycles; c++) {
+    for (long t=cycle_offsets[c]; t < cycle_offsets[c+1]; t++) {
+
+      /* Extract the Track */
+      TrackStackIndexes* tsi = &tracks[t];
+      Track* track;
+      Track3D track_3D;
+      segment* segments;
+      if (_segment_formation == EXPLICIT_2D)
+        track = &tracks_2D[tsi->_azim][tsi->_xy];
+      else if (_segment_formation == EXPLICIT_3D)
+        track = &_track_generator_3D->get3DTracks()[tsi->_azim][tsi->_xy]
+                                                  [tsi->_polar][tsi->_z];
+      else {
+        _track_generator_3D->getTrackOTF(&track_3D, tsi);
+        track = &track_3D;
+      }
+
+      /* Operate on segments if necessary */
+      if (kernel != NULL) {
+
+        /* Reset kernel for a new Track */
+        kernel->newTrack(track);
+
+        /* Trace the segments on the track */
+        if (_segment_formation == EXPLICIT_2D ||
+            _segment_formation == EXPLICIT_3D)
+          traceSegmentsExplicit(track, kernel);
+        else {
+          Track* flattened_track = &tracks_2D[tsi->_azim][tsi->_xy];
+          traceSegmentsOTF(flattened_track, track_3D.getStart(),
+                           track_3D.getTheta(), kernel);
+          track_3D.setNumSegments(kernel->getCount());
+        }
+      }
+
+      /* Operate on the Track */
+      if (_segment_formation == EXPLICIT_2D ||
+          _segment_formation == EXPLICIT_3D)
+        segments = track->getSegments();
+      else
+        segments = _track_generator_3D->getTemporarySegments(tid);
+      onTrack(track, segments);
+    }
+  }
+
+  if (kernel != NULL)
+    delete kernel;
+}
+
+
 /**
  * @brief Loops over all explicit 2D Tracks.
  * @details The onTrack(...) function is applied to all 2D Tracks and the
@@ -66,7 +158,8 @@ void TraverseSegments::loopOverTracks(MOCKernel* kernel) {
  * @param kernel The MOCKernel dictating the functionality to apply to
  *        segments
  */
-void TraverseSegments::loopOverTracks2D(MOCKernel* kernel) {
+template <class KernelType>
+void TraverseSegments::loopOverTracks2D(KernelType* kernel) {
 
   /* Loop over all parallel tracks for each azimuthal angle */
   Track** tracks_2D = _track_generator->get2DTracksArray();
@@ -98,7 +191,8 @@ void TraverseSegments::loopOverTracks2D(MOCKernel* kernel) {
  * @param kernel The MOCKernel dictating the functionality to apply to
  *        segments
  */
-void TraverseSegments::loopOverTracksExplicit(MOCKernel* kernel) {
+template <class KernelType>
+void TraverseSegments::loopOverTracksExplicit(KernelType* kernel) {
 
   Track3D**** tracks_3D = _track_generator_3D->get3DTracks();
   int num_azim = _track_generator_3D->getNumAzim();
@@ -148,7 +242,8 @@ void TraverseSegments::loopOverTracksExplicit(MOCKernel* kernel) {
  * @param kernel The MOCKernel dictating the functionality to apply to
  *        segments
  */
-void TraverseSegments::loopOverTracksByTrackOTF(MOCKernel* kernel) {
+template <class KernelType>
+void TraverseSegments::loopOverTracksByTrackOTF(KernelType* kernel) {
 
   int num_2D_tracks = _track_generator_3D->getNum2DTracks();
   Track** tracks_2D = _track_generator_3D->get2DTracksArray();
@@ -210,7 +305,8 @@ void TraverseSegments::loopOverTracksByTrackOTF(MOCKernel* kernel) {
  * @param kernel The MOCKernel dictating the functionality to apply to
  *        segments
  */
-void TraverseSegments::loopOverTracksByStackOTF(MOCKernel* kernel) {
+template <class KernelType>
+void TraverseSegments::loopOverTracksByStackOTF(KernelType* kernel) {
 
   int num_2D_tracks = _track_generator_3D->getNum2DTracks();
   Track** flattened_tracks = _track_generator_3D->get2DTracksArray();
@@ -267,14 +363,15 @@ void TraverseSegments::loopOverTracksByStackOTF(MOCKernel* kernel) {
  * @param track The Track whose segments will be traversed
  * @param kernel The kernel to apply to all segments
  */
-void TraverseSegments::traceSegmentsExplicit(Track* track, MOCKernel* kernel) {
+template <class KernelType>
+void TraverseSegments::traceSegmentsExplicit(Track* track,
+                                             KernelType* kernel) {
 
   /* Get direction of the track */
   double phi = track->getPhi();
   double theta = M_PI_2;
-  Track3D* track_3D = dynamic_cast<Track3D*>(track);
-  if (track_3D != NULL)
-    theta = track_3D->getTheta();
+  if (_segment_formation != EXPLICIT_2D)
+    theta = static_cast<Track3D*>(track)->getTheta();
 
   for (int s=0; s < track->getNumSegments(); s++) {
     segment* seg = track->getSegment(s);
@@ -301,8 +398,9 @@ void TraverseSegments::traceSegmentsExplicit(Track* track, MOCKernel* kernel) {
  * @param theta the polar angle of the 3D track
  * @param kernel An MOCKernel object to apply to the calculated 3D segments
  */
+template <class KernelType>
 void TraverseSegments::traceSegmentsOTF(Track* flattened_track, Point* start,
-                                        double theta, MOCKernel* kernel) {
+                                        double theta, KernelType* kernel) {
 
   /* Create unit vector */
   double phi = flattened_track->getPhi();
@@ -520,8 +618,9 @@ void TraverseSegments::traceSegmentsOTF(Track* flattened_track, Point* start,
  *        the polar angle of the z-stack
  * @param kernel The MOCKernel to apply to the calculated 3D segments
  */
+template <class KernelType>
 void TraverseSegments::traceStackOTF(Track* flattened_track, int polar_index,
-                                     MOCKernel* kernel) {
+                                     KernelType* kernel) {
 
   /* Extract information about the z-stack */
   int azim_index = flattened_track->getAzimIndex();
@@ -562,8 +661,7 @@ void TraverseSegments::traceStackOTF(Track* flattened_track, int polar_index,
 
   /* Adapt for traceStackTwoWay reverse direction */
   //NOTE If more applications for this arise, make 'reverse' an argument
-  if (dynamic_cast<TransportKernel*>(kernel) &&
-      !dynamic_cast<TransportKernel*>(kernel)->getDirection()) {
+  if (isReversed(kernel)) {
     phi += M_PI;
     cos_phi *= -1;
     sin_phi *= -1;
@@ -588,6 +686,9 @@ void TraverseSegments::traceStackOTF(Track* flattened_track, int polar_index,
   Geometry* geometry = _track_generator_3D->getGeometry();
   Cmfd* cmfd = geometry->getCmfd();
 
+  /* Get the kernel sweeping the tracks of the z-stack in lockstep, if any */
+  TransportKernel* stack_kernel = getStackKernel(kernel);
+
   /* Extract the appropriate starting mesh */
   int num_fsrs;
   double* axial_mesh;
@@ -742,7 +843,26 @@ void TraverseSegments::traceStackOTF(Track* flattened_track, int polar_index,
         double seg_len_3D = seg_length_2D / sin_theta;
 
         /* Determine if segment length is large enough to operate on */
-        if (seg_len_3D > TINY_MOVE) {
+        if (seg_len_3D > TINY_MOVE && stack_kernel != NULL) {
+
+          /* Find the CMFD surfaces at the end of each track of the band */
+          int num_tracks = end_full - start_full;
+          int cmfd_surfaces_fwd[num_tracks];
+          for (int i = start_full; i < end_full; i++) {
+            int cmfd_surface_fwd = segments_2D[s]._cmfd_surface_fwd;
+            if (cmfd != NULL) {
+              double end_z = first_end_z + i * z_spacing;
+              cmfd_surface_fwd = cmfd->findCmfdSurfaceOTF(cmfd_cell, end_z,
+                                                          cmfd_surface_fwd);
+            }
+            cmfd_surfaces_fwd[i - start_full] = cmfd_surface_fwd;
+          }
+
+          /* Sweep all the tracks that cross the entire 2D length at once */
+          stack_kernel->executeStack(seg_len_3D, material, fsr_id, start_full,
+                                     num_tracks, cmfd_surfaces_fwd, theta);
+        }
+        else if (seg_len_3D > TINY_MOVE) {
 
           /* Treat tracks that do cross the entire 2D length */
           for (int i = start_full; i < end_full; i++) {
@@ -1033,11 +1153,10 @@ void TraverseSegments::traceStackTwoWay(Track* flattened_track, int polar_index,
 
   /* Get segments from flattened track */
   segment* segments = flattened_track->getSegments();
-  MOCKernel* moc_kernel = dynamic_cast<MOCKernel*>(kernel);
 
   /* Trace stack forwards */
   kernel->setDirection(true);
-  traceStackOTF(flattened_track, polar_index, moc_kernel);
+  traceStackOTF(flattened_track, polar_index, kernel);
   kernel->post();
 
   /* Reverse segments in flattened track */
@@ -1057,7 +1176,7 @@ void TraverseSegments::traceStackTwoWay(Track* flattened_track, int polar_index,
 
   /* Trace stack backwards */
   kernel->setDirection(false);
-  traceStackOTF(flattened_track, polar_index, moc_kernel);
+  traceStackOTF(flattened_track, polar_index, kernel);
   kernel->post();
 
   /* Reverse segments in flattened track */
@@ -1074,3 +1193,61 @@ void TraverseSegments::traceStackTwoWay(Track* flattened_track, int polar_index,
     segments[s]._cmfd_surface_bwd = tmp_surface;
   }
 }
+
+
+/**
+ * @brief Returns whether a kernel traces the Tracks backwards.
+ * @details Only TransportKernels may trace Tracks backwards, when the z-stacks
+ *          are traced both ways.
+ * @param kernel the kernel applied to the segments
+ * @return whether the Tracks are traced backwards
+ */
+bool TraverseSegments::isReversed(MOCKernel* kernel) {
+  TransportKernel* transport_kernel = dynamic_cast<TransportKernel*>(kernel);
+  return transport_kernel != NULL && !transport_kernel->getDirection();
+}
+
+
+/**
+ * @brief Returns whether a TransportKernel traces the Tracks backwards.
+ * @param kernel the TransportKernel applied to the segments
+ * @return whether the Tracks are traced backwards
+ */
+bool TraverseSegments::isReversed(TransportKernel* kernel) {
+  return !kernel->getDirection();
+}
+
+
+/**
+ * @brief Returns the TransportKernel to which the bands of Tracks of a
+ *        z-stack crossing an entire 2D segment are handed in one call.
+ * @param kernel the kernel applied to the segments
+ * @return the kernel as a TransportKernel, NULL for other kernels
+ */
+TransportKernel* TraverseSegments::getStackKernel(MOCKernel* kernel) {
+  return dynamic_cast<TransportKernel*>(kernel);
+}
+
+
+/**
+ * @brief Returns the TransportKernel to which the bands of Tracks of a
+ *        z-stack crossing an entire 2D segment are handed in one call.
+ * @param kernel the TransportKernel applied to the segments
+ * @return the TransportKernel
+ */
+TransportKernel* TraverseSegments::getStackKernel(TransportKernel* kernel) {
+  return kernel;
+}
+
+
+/* Instantiate the looping schemes for the kernels applied by the Track
+ * traversing algorithms */
+template void TraverseSegments::loopOverTracks(CounterKernel* kernel);
+template void TraverseSegments::loopOverTracks(VolumeKernel* kernel);
+template void TraverseSegments::loopOverTracks(SegmentationKernel* kernel);
+template void TraverseSegments::loopOverTracksByCycle(
+    CounterKernel* kernel, TrackStackIndexes* tracks,
+    long* cycle_offsets, long num_cycles);
+template void TraverseSegments::loopOverTracksByCycle(
+    SegmentationKernel* kernel, TrackStackIndexes* tracks,
+    long* cycle_offsets, long num_cycles);
@@ -30,28 +30,46 @@
  *          abstract the looping procedure and apply a function onTrack(...) to
  *          each Track and apply the supplied MOCKernel to each segment. If
  *          NULL is provided for the MOCKernel, only the functionality defined
- *          in onTrack(...) is applied to each Track.
+ *          in onTrack(...) is applied to each Track. The loops and segment
+ *          traversals are templated on the kernel type, so that a traversal
+ *          is compiled for each kernel with its "execute" function called
+ *          directly on every segment.
  */
 class TraverseSegments {
 
 private:
 
   /* Functions defining how to loop over Tracks */
-  void loopOverTracks2D(MOCKernel* kernel);
-  void loopOverTracksExplicit(MOCKernel* kernel);
-  void loopOverTracksByTrackOTF(MOCKernel* kernel);
-  void loopOverTracksByStackOTF(MOCKernel* kernel);
+  template <class KernelType>
+  void loopOverTracks2D(KernelType* kernel);
+  template <class KernelType>
+  void loopOverTracksExplicit(KernelType* kernel);
+  template <class KernelType>
+  void loopOverTracksByTrackOTF(KernelType* kernel);
+  template <class KernelType>
+  void loopOverTracksByStackOTF(KernelType* kernel);
 
   /* Functions defining how to traverse segments */
-  void traceSegmentsExplicit(Track* track, MOCKernel* kernel);
+  template <class KernelType>
+  void traceSegmentsExplicit(Track* track, KernelType* kernel);
+  template <class KernelType>
   void traceSegmentsOTF(Track* flattened_track, Point* start,
-                        double theta, MOCKernel* kernel);
+                        double theta, KernelType* kernel);
+  template <class KernelType>
   void traceStackOTF(Track* flattened_track, int polar_index,
-                     MOCKernel* kernel);
+                     KernelType* kernel);
 
   void traceStackTwoWay(Track* flattened_track, int polar_index,
                         TransportKernel* kernel);
 
+  /* Functions returning whether a kernel traces Tracks backwards */
+  bool isReversed(MOCKernel* kernel);
+  bool isReversed(TransportKernel* kernel);
+
+  /* Functions returning the kernel sweeping z-stack bands in lockstep */
+  TransportKernel* getStackKernel(MOCKernel* kernel);
+  TransportKernel* getStackKernel(TransportKernel* kernel);
+
 
   int findMeshIndex(double* values, int size, double val, int sign);
 
@@ -74,7 +92,12 @@ protected:
   virtual ~TraverseSegments();
 
   /* Functions defining how to loop over and operate on Tracks */
+  template <class KernelType>
+  void loopOverTracks(KernelType* kernel);
   void loopOverTracks(MOCKernel* kernel);
+  template <class KernelType>
+  void loopOverTracksByCycle(KernelType* kernel, TrackStackIndexes* tracks,
+                             long* cycle_offsets, long num_cycles);
   virtual void onTrack(Track* track, segment* segments) = 0;
 
   //FIXME Rework function calls to make this private
@@ -82,7 +105,7 @@ protected:
 
   /* Returns a kernel of the requested type */
   template <class KernelType>
-  MOCKernel* getKernel() {
+  KernelType* getKernel() {
 
     /* Check for segmentation kernel in explicit methods */
     if ((typeid(KernelType) != typeid(SegmentationKernel)) ||
@@ -90,7 +113,7 @@ protected:
         (_segment_formation != EXPLICIT_3D))) {
 
       /* Allocate kernel */
-      MOCKernel* kernel = new KernelType(_track_generator);
+      KernelType* kernel = new KernelType(_track_generator);
       return kernel;
     }
     else
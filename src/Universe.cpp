@@ -1,4 +1,5 @@
 #include "Universe.h"
+#include <algorithm>
 #include <set>
 
 
@@ -125,7 +126,7 @@ char* Universe::getName() const {
 
 
 /**
- * @brief Return the Universe type (SIMPLE or LATTICE).
+ * @brief Return the Universe type (SIMPLE, LATTICE or HEX_LATTICE).
  * @return the Universe type
  */
 universeType Universe::getType() {
@@ -1334,7 +1335,8 @@ std::map<int, Universe*> Lattice::getUniqueUniverses() {
     for (int j = _universes.at(k).size()-1; j > -1;  j--) {
       for (int i = 0; i < _universes.at(k).at(j).size(); i++) {
         universe = _universes.at(k).at(j).at(i).second;
-        unique_universes[universe->getId()] = universe;
+        if (universe != NULL)
+          unique_universes[universe->getId()] = universe;
       }
     }
   }
@@ -1365,6 +1367,8 @@ std::map<int, double> Lattice::getUniqueRadius
     for (int j = _universes.at(k).size()-1; j > -1;  j--) {
       for (int i = 0; i < _universes.at(k).at(j).size(); i++) {
         universe = _universes.at(k).at(j).at(i).second;
+        if (universe == NULL)
+          continue;
         unique_radius[universe->getId()] =
           std::max(unique_radius[universe->getId()],
           sqrt(_widths_x[i]*_widths_x[i]/4.0 + _widths_y[j]*_widths_y[j]/4.0));
@@ -1670,7 +1674,8 @@ void Lattice::removeUniverse(Universe* universe) {
   for (int k=0; k < _num_z; k++) {
     for (int j=0; j < _num_y; j++) {
       for (int i=0; i < _num_x; i++) {
-        if (universe->getId() == getUniverse(i,j,k)->getId())
+        Universe* curr = getUniverse(i,j,k);
+        if (curr != NULL && universe->getId() == curr->getId())
           _universes.at(k).at(j).at(i) = std::pair<int,Universe*>(-1, null);
       }
     }
@@ -1848,17 +1853,60 @@ Cell* Lattice::findCell(LocalCoords* coords) {
  * @return the distance to the nearest Lattice cell boundary
  */
 double Lattice::minSurfaceDist(Point* point, double azim, double polar) {
+  Direction direction;
+  direction.setAngles(azim, polar);
+  return minSurfaceDist(point, &direction);
+}
+
+
+/**
+ * @brief Finds the distance to the nearest surface along a unit direction.
+ * @details The distances to the next lattice cell boundaries are computed
+ *          with the reciprocals of the direction cosines.
+ * @param point a pointer to a starting point
+ * @param direction the unit direction of the track
+ * @return the distance to the nearest Lattice cell boundary
+ */
+double Lattice::minSurfaceDist(Point* point, const Direction* direction) {
+  return distanceToCellBoundary(point, direction, getLatX(point),
+                                getLatY(point), getLatZ(point));
+}
 
-  /* Compute the x, y, and z indices for the Lattice cell this point is in */
-  int lat_x = getLatX(point);
-  int lat_y = getLatY(point);
-  int lat_z = getLatZ(point);
+
+/**
+ * @brief Finds the distance to the nearest surface from a LocalCoords in this
+ *        Lattice.
+ * @details The Lattice cell indices stored in the LocalCoords by findCell()
+ *          are reused, so that stepping through the Lattice does not search
+ *          for the cell containing the point again.
+ * @param coords a pointer to a LocalCoords of LAT type in this Lattice
+ * @param direction the unit direction of the track
+ * @return the distance to the nearest Lattice cell boundary
+ */
+double Lattice::minSurfaceDist(LocalCoords* coords, const Direction* direction) {
+  return distanceToCellBoundary(coords->getPoint(), direction,
+                                coords->getLatticeX(), coords->getLatticeY(),
+                                coords->getLatticeZ());
+}
+
+
+/**
+ * @brief Finds the distance from a point in a given Lattice cell to the
+ *        boundaries of that cell along a unit direction.
+ * @param point a pointer to a starting point
+ * @param direction the unit direction of the track
+ * @param lat_x the x index of the Lattice cell containing the point
+ * @param lat_y the y index of the Lattice cell containing the point
+ * @param lat_z the z index of the Lattice cell containing the point
+ * @return the distance to the nearest Lattice cell boundary
+ */
+double Lattice::distanceToCellBoundary(Point* point, const Direction* direction,
+                                       int lat_x, int lat_y, int lat_z) {
 
   /* Get unit vector components */
-  double u_xy = sin(polar);
-  double u_x = u_xy * cos(azim);
-  double u_y = u_xy * sin(azim);
-  double u_z = cos(polar);
+  double u_x = direction->_uvw[0];
+  double u_y = direction->_uvw[1];
+  double u_z = direction->_uvw[2];
 
   /* Determine the appropriate boundaries */
   if (u_x > 0)
@@ -1872,7 +1920,7 @@ double Lattice::minSurfaceDist(Point* point, double azim, double polar) {
   double dist_x;
   if (fabs(u_x) > FLT_EPSILON) {
     double plane_x = _accumulate_x[lat_x] + getMinX();
-    dist_x = (plane_x - point->getX()) / u_x;
+    dist_x = (plane_x - point->getX()) * direction->_inv_uvw[0];
   }
   else {
     dist_x = std::numeric_limits<double>::infinity();
@@ -1882,7 +1930,7 @@ double Lattice::minSurfaceDist(Point* point, double azim, double polar) {
   double dist_y;
   if (fabs(u_y) > FLT_EPSILON) {
     double plane_y = _accumulate_y[lat_y] + getMinY();
-    dist_y = (plane_y - point->getY()) / u_y;
+    dist_y = (plane_y - point->getY()) * direction->_inv_uvw[1];
   }
   else {
     dist_y = std::numeric_limits<double>::infinity();
@@ -1893,7 +1941,7 @@ double Lattice::minSurfaceDist(Point* point, double azim, double polar) {
   if (fabs(u_z) > FLT_EPSILON &&
       _width_z != std::numeric_limits<double>::infinity()) {
     double plane_z = _accumulate_z[lat_z] + getMinZ();
-    dist_z = (plane_z - point->getZ()) / u_z;
+    dist_z = (plane_z - point->getZ()) * direction->_inv_uvw[2];
   }
   else {
     dist_z = std::numeric_limits<double>::infinity();
@@ -1917,12 +1965,7 @@ int Lattice::getLatX(Point* point) {
   double dist_to_left = point->getX() - getMinX();
 
   /* Compute the x index for the Lattice cell this point is in */
-  for (int i=0; i<_num_x; i++) {
-    if (dist_to_left >= _accumulate_x[i] && dist_to_left < _accumulate_x[i+1]) {
-      lat_x = i;
-      break;
-    }
-  }
+  lat_x = findAccumulatedIndex(_accumulate_x, _num_x, _width_x, dist_to_left);
 
   /* Check if the Point is on the Lattice boundaries and if so adjust
    * x Lattice cell index */
@@ -1952,13 +1995,8 @@ int Lattice::getLatY(Point* point) {
   double dist_to_bottom = point->getY() - getMinY();
 
   /* Compute the y index for the Lattice cell this point is in */
-  for (int i=0; i<_num_y; i++) {
-    if (dist_to_bottom >= _accumulate_y[i] &&
-      dist_to_bottom < _accumulate_y[i+1]) {
-      lat_y = i;
-      break;
-    }
-  }
+  lat_y = findAccumulatedIndex(_accumulate_y, _num_y, _width_y,
+                               dist_to_bottom);
 
   /* Check if the Point is on the Lattice boundaries and if so adjust
    * y Lattice cell index */
@@ -1991,14 +2029,9 @@ int Lattice::getLatZ(Point* point) {
   /* get the distance to the bottom surface */
   double dist_to_bottom = point->getZ() - getMinZ();
 
-  /* Compute the y index for the Lattice cell this point is in */
-  for (int i=0; i<_num_z; i++) {
-    if (dist_to_bottom >= _accumulate_z[i] &&
-        dist_to_bottom < _accumulate_z[i+1]) {
-      lat_z = i;
-      break;
-    }
-  }
+  /* Compute the z index for the Lattice cell this point is in */
+  lat_z = findAccumulatedIndex(_accumulate_z, _num_z, _width_z,
+                               dist_to_bottom);
 
   /* Check if the Point is on the Lattice boundaries and if so adjust
    * z Lattice cell index */
@@ -2015,6 +2048,51 @@ int Lattice::getLatZ(Point* point) {
 }
 
 
+/**
+ * @brief Finds the Lattice cell index along an axis from the distance to the
+ *        lower Lattice boundary.
+ * @details The index of a uniform Lattice is computed directly from the cell
+ *          width and a non-uniform Lattice is bisected, rather than scanning
+ *          all cells along the axis.
+ * @param accumulate the accumulated cell widths along the axis
+ * @param num_cells the number of Lattice cells along the axis
+ * @param width the cell width along the axis (uniform lattices only)
+ * @param distance the distance from the lower Lattice boundary
+ * @return the index i with accumulate[i] <= distance < accumulate[i+1], or -1
+ *         if the distance is outside the Lattice
+ */
+int Lattice::findAccumulatedIndex(const std::vector<double>& accumulate,
+                                  int num_cells, double width,
+                                  double distance) {
+
+  int index;
+
+  if (!_non_uniform && width > 0.) {
+
+    /* Guess the index from the uniform width, then correct for round-off in
+     * the accumulated widths */
+    double guess = std::max(0., std::min(floor(distance / width),
+                                         num_cells - 1.));
+    index = guess;
+    while (index > 0 && distance < accumulate[index])
+      index--;
+    while (index < num_cells - 1 && distance >= accumulate[index+1])
+      index++;
+    if (distance < accumulate[index] || distance >= accumulate[index+1])
+      index = -1;
+  }
+  else {
+    index = std::upper_bound(accumulate.begin(),
+                             accumulate.begin() + num_cells + 1, distance)
+            - accumulate.begin() - 1;
+    if (index >= num_cells)
+      index = -1;
+  }
+
+  return index;
+}
+
+
 /**
  * @brief Converts a Lattice's attributes to a character array representation.
  * @return character array of this Lattice's attributes
@@ -2417,3 +2495,434 @@ void Lattice::printLatticeSizes() {
     printf("i=%d, %f; ",i, _accumulate_z[i]);
   printf("\n");
 }
+
+
+/**
+ * @brief Constructor sets the user-specified and unique IDs for this
+ *        HexLattice.
+ * @param id the user-specified optional Lattice (Universe) ID
+ * @param name the user-specified optional Lattice (Universe) name
+ */
+HexLattice::HexLattice(const int id, const char* name): Lattice(id, name) {
+
+  _type = HEX_LATTICE;
+  _num_rings = 0;
+  _pitch = 0.;
+}
+
+
+/**
+ * @brief Return the number of rings of cells, including the central cell.
+ * @return the number of rings
+ */
+int HexLattice::getNumRings() const {
+  return _num_rings;
+}
+
+
+/**
+ * @brief Return the flat-to-flat width of the hexagonal cells.
+ * @return the pitch of the HexLattice (cm)
+ */
+double HexLattice::getPitch() const {
+  return _pitch;
+}
+
+
+/**
+ * @brief Returns the minimum reachable x-coordinate in the HexLattice.
+ * @return the minimum reachable x-coordinate
+ */
+double HexLattice::getMinX() {
+  return _offset.getX() - (_num_rings - 0.5) * _pitch;
+}
+
+
+/**
+ * @brief Returns the maximum reachable x-coordinate in the HexLattice.
+ * @return the maximum reachable x-coordinate
+ */
+double HexLattice::getMaxX() {
+  return _offset.getX() + (_num_rings - 0.5) * _pitch;
+}
+
+
+/**
+ * @brief Returns the minimum reachable y-coordinate in the HexLattice.
+ * @details The top and bottom rows end with a vertex of their cells.
+ * @return the minimum reachable y-coordinate
+ */
+double HexLattice::getMinY() {
+  return _offset.getY() - ((_num_rings - 1) * sqrt(3.) / 2. + 1. / sqrt(3.))
+         * _pitch;
+}
+
+
+/**
+ * @brief Returns the maximum reachable y-coordinate in the HexLattice.
+ * @details The top and bottom rows end with a vertex of their cells.
+ * @return the maximum reachable y-coordinate
+ */
+double HexLattice::getMaxY() {
+  return _offset.getY() + ((_num_rings - 1) * sqrt(3.) / 2. + 1. / sqrt(3.))
+         * _pitch;
+}
+
+
+/**
+ * @brief Get the equivalent radius of each unique universe, which is the
+ *        distance from a hexagonal cell center to its vertices.
+ * @param unique_universes The unique universes of this HexLattice
+ * @return a map of unique radius keyed by the universe ID.
+ */
+std::map<int, double> HexLattice::getUniqueRadius
+                    (std::map<int, Universe*> unique_universes) {
+
+  std::map<int, double> unique_radius;
+  std::map<int, Universe*>::iterator iter;
+
+  for (iter = unique_universes.begin(); iter != unique_universes.end(); ++iter)
+    unique_radius[iter->first] = _pitch / sqrt(3.);
+
+  return unique_radius;
+}
+
+
+/**
+ * @brief Set the flat-to-flat width of the hexagonal cells and their height.
+ * @details The pitch must be set before the Universes are assigned with
+ *          HexLattice::setUniverses(...).
+ * @param pitch the flat-to-flat width of the cells in centimeters
+ * @param width_z the width along the z-axis in centimeters
+ */
+void HexLattice::setPitch(double pitch, double width_z) {
+
+  if (pitch <= 0 || width_z <= 0)
+    log_printf(ERROR, "Unable to set the pitch of HexLattice ID = %d to %f "
+               "and its z width to %f since they are not positive values",
+               _id, pitch, width_z);
+
+  _pitch = pitch;
+  setWidth(pitch, pitch, width_z);
+}
+
+
+/**
+ * @brief Sets the array of Universe pointers filling each hexagonal cell.
+ * @details The Universes of each axial level, from the top level down, are
+ *          listed row by row from the top row (largest y) to the bottom row,
+ *          and from left to right within each row. A HexLattice with
+ *          \f$ n \f$ rings has \f$ 2n-1 \f$ rows and \f$ 3n(n-1)+1 \f$ cells
+ *          in each axial level, and the middle row holds \f$ 2n-1 \f$ cells.
+ *          For example, a HexLattice with 2 rings is input as:
+ *
+ * @code
+ *          lattice.setUniverses([[   [u1, u1],
+ *                                  [u1, u2, u1],
+ *                                    [u1, u1]   ]])
+ * @endcode
+ *
+ * @param num_z the number of Lattice cells along z
+ * @param num_rings the number of rings of cells, including the central cell
+ * @param universes the array of Universes for each Lattice cell
+ */
+void HexLattice::setUniverses(int num_z, int num_rings, Universe** universes) {
+
+  if (num_rings < 1)
+    log_printf(ERROR, "Unable to set the Universes of HexLattice ID = %d with "
+               "%d rings", _id, num_rings);
+  if (_pitch <= 0)
+    log_printf(ERROR, "Unable to set the Universes of HexLattice ID = %d "
+               "before its pitch", _id);
+
+  std::map<int, Universe*> unique_universes = getUniqueUniverses();
+  std::map<int, Universe*>::iterator iter;
+
+  /* Remove all Universes in the Lattice */
+  for (iter = unique_universes.begin(); iter != unique_universes.end(); ++iter)
+    removeUniverse(iter->second);
+
+  /* Set the Lattice dimensions, cells are indexed by shifted axial
+   * coordinates within a rhombus of (2 * num_rings - 1)^2 cells */
+  _num_rings = num_rings;
+  int num_xy = 2 * num_rings - 1;
+  setNumX(num_xy);
+  setNumY(num_xy);
+  setNumZ(num_z);
+
+  Universe* null = NULL;
+  std::vector< std::pair<int, Universe*> >
+       empty_row(num_xy, std::pair<int, Universe*>(-1, null));
+  _universes.assign(num_z, std::vector< std::vector< std::pair<int, Universe*> > >
+                    (num_xy, empty_row));
+
+  /* The Lattice cells are input from the top row of the top level */
+  int index = 0;
+  for (int k = _num_z-1; k > -1; k--) {
+    for (int r = num_rings-1; r > -num_rings; r--) {
+      int q_min = std::max(-(num_rings-1), -(num_rings-1) - r);
+      int q_max = std::min(num_rings-1, num_rings-1 - r);
+      for (int q = q_min; q <= q_max; q++) {
+        Universe* universe = universes[index++];
+        _universes.at(k).at(r + num_rings-1).at(q + num_rings-1) =
+             std::pair<int, Universe*>(universe->getId(), universe);
+      }
+    }
+  }
+
+  /* Non-uniform lattices only vary the heights of hexagonal cells */
+  if (_non_uniform) {
+    _widths_x.assign(num_xy, _pitch);
+    _widths_y.assign(num_xy, _pitch);
+  }
+  computeSizes();
+}
+
+
+/**
+ * @brief Finds the hexagonal cell containing a Point.
+ * @details The fractional axial coordinates of the Point are rounded to the
+ *          nearest cell center in cube coordinates \f$ (q, r, -q-r) \f$, in
+ *          constant time.
+ * @param point a pointer to the Point of interest
+ * @param lat_x the Lattice cell x index (q), -1 outside the HexLattice
+ * @param lat_y the Lattice cell y index (r), -1 outside the HexLattice
+ */
+void HexLattice::findHexCell(Point* point, int& lat_x, int& lat_y) {
+
+  double x = point->getX() - _offset.getX();
+  double y = point->getY() - _offset.getY();
+
+  /* Fractional axial coordinates */
+  double r_f = 2. * y / (sqrt(3.) * _pitch);
+  double q_f = x / _pitch - r_f / 2.;
+  double s_f = -q_f - r_f;
+
+  /* Round to the nearest cell center, keeping q + r + s = 0 */
+  double q = round(q_f);
+  double r = round(r_f);
+  double s = round(s_f);
+  double dq = fabs(q - q_f);
+  double dr = fabs(r - r_f);
+  double ds = fabs(s - s_f);
+  if (dq > dr && dq > ds)
+    q = -r - s;
+  else if (dr > ds)
+    r = -q - s;
+
+  /* Check that the cell is within the rings */
+  if (std::max(fabs(q), std::max(fabs(r), fabs(q + r))) > _num_rings - 1) {
+    lat_x = -1;
+    lat_y = -1;
+  }
+  else {
+    lat_x = q + _num_rings - 1;
+    lat_y = r + _num_rings - 1;
+  }
+}
+
+
+/**
+ * @brief Computes the center of a hexagonal cell.
+ * @param lat_x the Lattice cell x index
+ * @param lat_y the Lattice cell y index
+ * @param center_x the x-coordinate of the cell center
+ * @param center_y the y-coordinate of the cell center
+ */
+void HexLattice::getCellCenter(int lat_x, int lat_y, double& center_x,
+                               double& center_y) {
+  double q = lat_x - (_num_rings - 1);
+  double r = lat_y - (_num_rings - 1);
+  center_x = _offset.getX() + _pitch * (q + r / 2.);
+  center_y = _offset.getY() + _pitch * sqrt(3.) / 2. * r;
+}
+
+
+/**
+ * @brief Finds the HexLattice cell x index that a point lies in.
+ * @param point a pointer to a point being evaluated.
+ * @return the HexLattice cell x index.
+ */
+int HexLattice::getLatX(Point* point) {
+
+  int lat_x, lat_y;
+  findHexCell(point, lat_x, lat_y);
+
+  if (lat_x == -1)
+    log_printf(ERROR, "Trying to get HexLattice x index for point(x = %f, "
+               "y = %f) that is outside lattice bounds", point->getX(),
+               point->getY());
+
+  return lat_x;
+}
+
+
+/**
+ * @brief Finds the HexLattice cell y index that a point lies in.
+ * @param point a pointer to a point being evaluated.
+ * @return the HexLattice cell y index.
+ */
+int HexLattice::getLatY(Point* point) {
+
+  int lat_x, lat_y;
+  findHexCell(point, lat_x, lat_y);
+
+  if (lat_y == -1)
+    log_printf(ERROR, "Trying to get HexLattice y index for point(x = %f, "
+               "y = %f) that is outside lattice bounds", point->getX(),
+               point->getY());
+
+  return lat_y;
+}
+
+
+/**
+ * @brief Checks if a Point is within the rings of a HexLattice.
+ * @param point a pointer to the Point of interest
+ * @return true if the Point is in the bounds, false if not
+ */
+bool HexLattice::containsPoint(Point* point) {
+
+  int lat_x, lat_y;
+  findHexCell(point, lat_x, lat_y);
+  if (lat_x == -1)
+    return false;
+
+  double z = point->getZ();
+  return (z <= getMaxZ() && z >= getMinZ());
+}
+
+
+/**
+ * @brief Finds the Cell within this HexLattice that a LocalCoords is in.
+ * @details This method first finds the hexagonal cell, then searches the
+ *          Universe inside that cell. If LocalCoords is outside the rings of
+ *          the HexLattice, this method will return NULL.
+ * @param coords the LocalCoords of interest. Coordinates of coords and
+ *        lattice._offset share the same origin.
+ * @return a pointer to the Cell this LocalCoord is in or NULL
+ */
+Cell* HexLattice::findCell(LocalCoords* coords) {
+
+  /* Set the LocalCoord to be a LAT type at this level */
+  coords->setType(LAT);
+
+  /* Compute the indices for the Lattice cell this coord is in */
+  int lat_x, lat_y;
+  findHexCell(coords->getPoint(), lat_x, lat_y);
+  if (lat_x == -1)
+    return NULL;
+  int lat_z = getLatZ(coords->getPoint());
+  if (lat_z < 0 || lat_z >= _num_z)
+    return NULL;
+
+  /* Compute local position of Point in the next level Universe */
+  double center_x, center_y;
+  getCellCenter(lat_x, lat_y, center_x, center_y);
+  double next_x = coords->getX() - center_x;
+  double next_y = coords->getY() - center_y;
+  double next_z = coords->getZ()
+                  - (getMinZ() + _widths_z[lat_z]/2. + _accumulate_z[lat_z]);
+
+  /* Check for 2D problem or 2D lattice */
+  if (_width_z > FLT_INFINITY)
+    next_z = coords->getZ();
+
+  /* Create a new LocalCoords object for the next level Universe */
+  LocalCoords* next_coords = coords->getNextCreate(next_x, next_y, next_z);
+  Universe* univ = getUniverse(lat_x, lat_y, lat_z);
+  next_coords->setUniverse(univ);
+
+  /* Set Lattice indices */
+  coords->setLattice(this);
+  coords->setLatticeX(lat_x);
+  coords->setLatticeY(lat_y);
+  coords->setLatticeZ(lat_z);
+
+  /* Search the next lowest level Universe for the Cell */
+  return univ->findCell(next_coords);
+}
+
+
+/**
+ * @brief Finds the distance from a point in a given hexagonal cell to the
+ *        boundaries of that cell along a unit direction.
+ * @details The distance to each of the three pairs of parallel sides is
+ *          found from the projections of the position and direction on the
+ *          side normal, at angles of 0, 60 and 120 degrees from the x-axis.
+ * @param point a pointer to a starting point
+ * @param direction the unit direction of the track
+ * @param lat_x the x index of the Lattice cell containing the point
+ * @param lat_y the y index of the Lattice cell containing the point
+ * @param lat_z the z index of the Lattice cell containing the point
+ * @return the distance to the nearest Lattice cell boundary
+ */
+double HexLattice::distanceToCellBoundary(Point* point,
+                                          const Direction* direction,
+                                          int lat_x, int lat_y, int lat_z) {
+
+  double center_x, center_y;
+  getCellCenter(lat_x, lat_y, center_x, center_y);
+  double x = point->getX() - center_x;
+  double y = point->getY() - center_y;
+
+  double u_x = direction->_uvw[0];
+  double u_y = direction->_uvw[1];
+  double u_z = direction->_uvw[2];
+
+  /* Get the min distance to the sides of the hexagonal cell */
+  const double normals[3][2] = {{1., 0.}, {0.5, sqrt(3.) / 2.},
+                                {-0.5, sqrt(3.) / 2.}};
+  double apothem = _pitch / 2.;
+  double dist = std::numeric_limits<double>::infinity();
+  for (int i=0; i < 3; i++) {
+    double proj_u = normals[i][0] * u_x + normals[i][1] * u_y;
+    double proj = normals[i][0] * x + normals[i][1] * y;
+    if (proj_u > FLT_EPSILON)
+      dist = std::min(dist, (apothem - proj) / proj_u);
+    else if (proj_u < -FLT_EPSILON)
+      dist = std::min(dist, (-apothem - proj) / proj_u);
+  }
+
+  /* Get the min distance for Z PLANE  */
+  if (fabs(u_z) > FLT_EPSILON &&
+      _width_z != std::numeric_limits<double>::infinity()) {
+    if (u_z > 0)
+      lat_z++;
+    double plane_z = _accumulate_z[lat_z] + getMinZ();
+    dist = std::min(dist, (plane_z - point->getZ()) * direction->_inv_uvw[2]);
+  }
+
+  return dist;
+}
+
+
+/**
+ * @brief Converts a HexLattice's attributes to a character array
+ *        representation.
+ * @return character array of this HexLattice's attributes
+ */
+std::string HexLattice::toString() {
+
+  std::stringstream string;
+
+  string << "HexLattice ID = " << _id
+         << ", name = " << _name
+         << ", # rings = " << _num_rings
+         << ", # cells along z = " << _num_z
+         << ", pitch = " << _pitch
+         << ", z width = " << _width_z;
+
+  string << "\n\t\tUniverse IDs within this Lattice: ";
+
+  for (int k = _num_z-1; k > -1;  k--) {
+    for (int r = _num_rings-1; r > -_num_rings; r--) {
+      for (int q = 0; q < _num_x; q++)
+        if (_universes.at(k).at(r + _num_rings-1).at(q).second != NULL)
+          string << _universes.at(k).at(r + _num_rings-1).at(q).first << ", ";
+      string << "\n\t\t";
+    }
+  }
+
+  return string.str();
+}
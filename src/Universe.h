@@ -43,7 +43,10 @@ enum universeType{
   SIMPLE,
 
   /** A collection of Universes in a rectangular Lattice */
-  LATTICE
+  LATTICE,
+
+  /** A collection of Universes in a hexagonal Lattice */
+  HEX_LATTICE
 };
 
 
@@ -71,7 +74,7 @@ protected:
   /** A user-defined name for the Surface */
   char* _name;
 
-  /** The type of Universe (ie, SIMPLE or LATTICE) */
+  /** The type of Universe (ie, SIMPLE, LATTICE or HEX_LATTICE) */
   universeType _type;
 
   /** A collection of Cell IDs and Cell pointers in this Universe */
@@ -155,7 +158,7 @@ public:
  */
 class Lattice: public Universe {
 
-private:
+protected:
 
   /** The number of Lattice cells along the x-axis */
   int _num_x;
@@ -200,6 +203,12 @@ private:
   std::vector< std::vector< std::vector< std::pair<int, Universe*> > > >
       _universes;
 
+  int findAccumulatedIndex(const std::vector<double>& accumulate,
+                           int num_cells, double width, double distance);
+  virtual double distanceToCellBoundary(Point* point,
+                                        const Direction* direction,
+                                        int lat_x, int lat_y, int lat_z);
+
 public:
 
   Lattice(const int id=-1, const char* name="");
@@ -220,10 +229,10 @@ public:
   const std::vector<double>& getAccumulateX() const;
   const std::vector<double>& getAccumulateY() const;
   const std::vector<double>& getAccumulateZ() const;
-  double getMinX();
-  double getMaxX();
-  double getMinY();
-  double getMaxY();
+  virtual double getMinX();
+  virtual double getMaxX();
+  virtual double getMinY();
+  virtual double getMaxY();
   double getMinZ();
   double getMaxZ();
 
@@ -231,7 +240,8 @@ public:
   std::vector< std::vector< std::vector< std::pair<int, Universe*> > > >*
       getUniverses();
   std::map<int, Universe*> getUniqueUniverses();
-  std::map<int, double> getUniqueRadius(std::map<int, Universe*> unique_universes);
+  virtual std::map<int, double> getUniqueRadius(std::map<int, Universe*>
+                                                unique_universes);
   std::map<int, Cell*> getAllCells();
   std::map<int, Universe*> getAllUniverses();
 
@@ -253,12 +263,15 @@ public:
   void subdivideCells(double max_radius=INFINITY);
   void buildNeighbors();
 
-  bool containsPoint(Point* point);
-  Cell* findCell(LocalCoords* coords);
+  virtual bool containsPoint(Point* point);
+  virtual Cell* findCell(LocalCoords* coords);
   double minSurfaceDist(Point* point, double azim, double polar=M_PI/2.0);
+  virtual double minSurfaceDist(Point* point, const Direction* direction);
+  virtual double minSurfaceDist(LocalCoords* coords,
+                                const Direction* direction);
 
-  int getLatX(Point* point);
-  int getLatY(Point* point);
+  virtual int getLatX(Point* point);
+  virtual int getLatY(Point* point);
   int getLatZ(Point* point);
 
   int getLatticeCell(Point* point);
@@ -278,6 +291,60 @@ public:
 
 };
 
+
+/**
+ * @class HexLattice Universe.h "src/Universe.h"
+ * @brief Represents a repeating 3D Lattice of hexagonal prisms.
+ * @details The hexagonal cells have two sides parallel to the y-axis and are
+ *          arranged in rings around a central cell. Cells are indexed by the
+ *          axial coordinates (q, r) of their center, shifted by the number
+ *          of rings minus one so that the indices stored in a LocalCoords
+ *          are non-negative. Lattice cell x and y indices are respectively
+ *          q and r, and the remaining corners of the rhombus of indices do
+ *          not belong to the Lattice.
+ */
+class HexLattice: public Lattice {
+
+private:
+
+  /** The number of rings of cells, including the central cell */
+  int _num_rings;
+
+  /** The flat-to-flat width of each hexagonal cell (cm) */
+  double _pitch;
+
+  void findHexCell(Point* point, int& lat_x, int& lat_y);
+  void getCellCenter(int lat_x, int lat_y, double& center_x,
+                     double& center_y);
+  double distanceToCellBoundary(Point* point, const Direction* direction,
+                                int lat_x, int lat_y, int lat_z);
+
+public:
+
+  HexLattice(const int id=-1, const char* name="");
+
+  int getNumRings() const;
+  double getPitch() const;
+  double getMinX();
+  double getMaxX();
+  double getMinY();
+  double getMaxY();
+  std::map<int, double> getUniqueRadius(std::map<int, Universe*>
+                                        unique_universes);
+
+  void setPitch(double pitch,
+                double width_z=std::numeric_limits<double>::infinity());
+  void setUniverses(int num_z, int num_rings, Universe** universes);
+
+  bool containsPoint(Point* point);
+  Cell* findCell(LocalCoords* coords);
+
+  int getLatX(Point* point);
+  int getLatY(Point* point);
+
+  std::string toString();
+};
+
 /**
  * @brief A helper struct for the Universe::findCell() method.
  * @details This is used to insert a Universe's Cells to the back of a vector
@@ -26,7 +26,11 @@ enum boundaryType {
   INTERFACE,
 
   /** No boundary type (typically an interface between flat source regions) */
-  BOUNDARY_NONE
+  BOUNDARY_NONE,
+
+  /** A rotational boundary condition, pairing the minimum x and y surfaces
+   *  through a 90 degree rotation about their common edge */
+  ROTATIONAL
 };
 
 #endif /* BOUNDARY_TYPE_H_ */
@@ -74,12 +74,23 @@
 #define MIN_LINALG_POWER_ITERATIONS 25
 #define MAX_LINALG_POWER_ITERATIONS 25000
 
+/** The minimum number of power iterations for an eigenvalue solve started
+ *  from the eigenvector of a previous solve */
+#define MIN_LINALG_WARM_POWER_ITERATIONS 5
+
 #define MIN_LINALG_TOLERANCE LINALG_TOL
 
 /** The maximum number of iterations allowed for a linear solve in linalg.cpp */
 #define MIN_LINEAR_SOLVE_ITERATIONS 25
 #define MAX_LINEAR_SOLVE_ITERATIONS 10000
 
+/** The number of successive MOC iterations with a stalled convergence after
+ *  which an automatically condensed CMFD group structure is refined */
+#define CMFD_CONDENSATION_STALLED_ITERATIONS 3
+
+/** The size of a cache line in bytes, used to space software prefetches */
+#define CACHE_LINE_SIZE 64
+
 #ifdef MPIx
 //TODO Make tracks per buffer dependent on number of processes, and groups
 #define TRACKS_PER_BUFFER 2000
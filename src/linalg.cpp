@@ -20,12 +20,19 @@
  * @param SOR_factor the successive over-relaxation factor
  * @param convergence_data a summary of how to solver converged
  * @param comm an MPI communicator for the domain-decomposed solver
- * @return k_eff the dominant eigenvalue
+ * @param dominance_ratio the dominance ratio estimate of a previous solve
+ *        when X is warm-started from its eigenvector, a negative value
+ *        otherwise. On return it is set to the estimate of this solve.
+ * @param max_iterations the maximum number of power iterations. A solve
+ *        limited below the default maximum returns -1 if it does not
+ *        converge, like a diverged solve, instead of reporting an error.
+ * @return k_eff the dominant eigenvalue, -1 if the solve failed
  */
 double eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, double k_eff,
                              double tol, double SOR_factor,
                              ConvergenceData* convergence_data,
-                             DomainCommunicator* comm) {
+                             DomainCommunicator* comm,
+                             double* dominance_ratio, int max_iterations) {
 
   log_printf(INFO, "Computing the Matrix-Vector eigenvalue...");
   tol = std::max(MIN_LINALG_TOLERANCE, tol);
@@ -78,10 +85,18 @@ double eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, double k_eff,
   old_source.scaleByValue(num_rows / old_source_sum);
   X->scaleByValue(num_rows * k_eff / old_source_sum);
 
+  /* A warm start uses the dominance ratio of the previous solve until the
+   * residuals of this solve provide an estimate */
+  bool warm_start = (dominance_ratio != NULL && *dominance_ratio > 0);
+  double dr = 0;
+  if (warm_start)
+    dr = *dominance_ratio;
+
   /* Power iteration Matrix-Vector solver */
   double initial_residual = 0;
+  double previous_residual = 0;
   bool solver_failure = false;
-  for (iter = 0; iter < MAX_LINALG_POWER_ITERATIONS; iter++) {
+  for (iter = 0; iter < max_iterations; iter++) {
 
     /* Solve X = A^-1 * old_source */
     bool converged = false;
@@ -132,15 +147,26 @@ double eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, double k_eff,
       }
     }
 
+    /* Update the dominance ratio estimate from the residual decay */
+    else if (previous_residual > 0 && residual < previous_residual)
+      dr = residual / previous_residual;
+    previous_residual = residual;
+
     /* Copy the new source to the old source */
     new_source.copyTo(&old_source);
 
     log_printf(INFO_ONCE, "Matrix-Vector eigenvalue iter: %d, keff: %f, residual: "
                "%3.2e", iter, k_eff, residual);
 
-    /* Check for convergence */
-    if ((residual / initial_residual < 0.03 || residual < MIN_LINALG_TOLERANCE)
-        && iter > MIN_LINALG_POWER_ITERATIONS) {
+    /* Check for convergence. When warm-started, the distance to the converged
+     * source is estimated from the residual and the dominance ratio */
+    bool source_converged = (residual / initial_residual < 0.03 ||
+                             residual < MIN_LINALG_TOLERANCE)
+                            && iter > MIN_LINALG_POWER_ITERATIONS;
+    if (warm_start && iter >= MIN_LINALG_WARM_POWER_ITERATIONS && dr < 1)
+      source_converged |= residual * dr / (1 - dr) < tol;
+
+    if (source_converged) {
       if (convergence_data != NULL) {
         convergence_data->cmfd_res_end = residual;
         convergence_data->cmfd_iters = iter;
@@ -150,14 +176,124 @@ double eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, double k_eff,
   }
 
   log_printf(INFO_ONCE, "Matrix-Vector eigenvalue solve iterations: %d", iter);
-  if (iter == MAX_LINALG_POWER_ITERATIONS)
+  if (iter == max_iterations) {
+    if (max_iterations < MAX_LINALG_POWER_ITERATIONS) {
+      log_printf(INFO, "Eigenvalue solve failed to converge in %d iterations",
+                 iter);
+      return -1.0;
+    }
     log_printf(ERROR, "Eigenvalue solve failed to converge in %d iterations",
                iter);
+  }
+
+  /* Save the dominance ratio estimate for the next warm start */
+  if (dominance_ratio != NULL)
+    *dominance_ratio = dr;
 
   return k_eff;
 }
 
 
+/**
+ * @brief Performs the SOR update of all the groups of a cell using the
+ *        structured stencil form of the loss + streaming matrix.
+ * @details The neighbor cell couplings are applied to all groups at once. The
+ *          in-cell group-to-group block is applied column by column, first
+ *          the upper triangle with the fluxes of the previous iteration, then
+ *          the lower triangle with the updated fluxes as each group is
+ *          finalized, which reproduces the Gauss-Seidel ordering of the CSR
+ *          kernel while keeping every inner loop unit stride over groups.
+ * @param x the flux array
+ * @param b the source array
+ * @param diag the diagonal of the matrix
+ * @param stencil_cells the neighbor cells of each cell
+ * @param stencil_coeffs the neighbor coupling coefficients
+ * @param block_coeffs the in-cell blocks, ordered by group from and group to
+ * @param cell the cell to update
+ * @param num_groups the number of energy groups
+ * @param SOR_factor the successive over-relaxation factor
+ * @param comm an MPI communicator for the domain-decomposed solver
+ * @param color red or black color
+ * @param domain_surface_index index of the cell in the communicator buffers,
+ *        -1 if the cell is not on a domain surface
+ * @param coupling_sizes Number of connecting neighbors for each surface cell
+ * @param coupling_indexes Surface numbers of connecting neighbors
+ * @param coupling_coeffs Coupling coeffs with the connecting neighbors
+ * @param coupling_fluxes Fluxes of connecting neighbors
+ */
+inline void stencilSORCellUpdate(CMFD_PRECISION* x, CMFD_PRECISION* b,
+                                 CMFD_PRECISION* diag, int* stencil_cells,
+                                 CMFD_PRECISION* stencil_coeffs,
+                                 CMFD_PRECISION* block_coeffs, int cell,
+                                 int num_groups, double SOR_factor,
+                                 DomainCommunicator* comm, int color,
+                                 int domain_surface_index,
+                                 int* coupling_sizes, int** coupling_indexes,
+                                 CMFD_PRECISION** coupling_coeffs,
+                                 CMFD_PRECISION** coupling_fluxes) {
+
+  int row_start = cell * num_groups;
+  CMFD_PRECISION* x_cell = &x[row_start];
+  CMFD_PRECISION* b_cell = &b[row_start];
+  CMFD_PRECISION* diag_cell = &diag[row_start];
+  CMFD_PRECISION cell_source[num_groups]
+       __attribute__ ((aligned(VEC_ALIGNMENT)));
+
+  /* Source and relaxation terms */
+#pragma omp simd aligned(cell_source)
+  for (int g=0; g < num_groups; g++)
+    cell_source[g] = b_cell[g] + (1.0 - SOR_factor) * x_cell[g] *
+                     (diag_cell[g] / SOR_factor);
+
+  /* Contribution of neighbor cells */
+  for (int f=0; f < NUM_FACES; f++) {
+    CMFD_PRECISION* coeffs = &stencil_coeffs[(cell*NUM_FACES + f)*num_groups];
+    CMFD_PRECISION* x_next = &x[stencil_cells[cell*NUM_FACES + f]*num_groups];
+#pragma omp simd aligned(cell_source)
+    for (int g=0; g < num_groups; g++)
+      cell_source[g] -= coeffs[g] * x_next[g];
+  }
+
+  /* Upscattering contributions use the fluxes of the previous iteration */
+  for (int h=1; h < num_groups; h++) {
+    CMFD_PRECISION* column = &block_coeffs[(row_start + h)*num_groups];
+    CMFD_PRECISION x_h = x_cell[h];
+#pragma omp simd aligned(cell_source)
+    for (int g=0; g < h; g++)
+      cell_source[g] -= column[g] * x_h;
+  }
+
+  /* Finalize each group and pass it to the lower groups of the cell */
+  for (int h=0; h < num_groups; h++) {
+
+    if (fabs(diag_cell[h]) < FLT_EPSILON)
+      log_printf(ERROR, "A zero has been found on the diagonal of the CMFD "
+                 "matrix cell %d, group %d", cell, h);
+
+#ifdef MPIx
+    /* Contribution of off node fluxes */
+    if (comm != NULL && domain_surface_index != -1) {
+      int row_surf = domain_surface_index * num_groups + h;
+      for (int i = 0; i < coupling_sizes[row_surf]; i++) {
+        int idx = coupling_indexes[row_surf][i] * num_groups + h;
+        int domain = comm->domains[color][row_surf][i];
+        cell_source[h] -= coupling_coeffs[row_surf][i] *
+                          coupling_fluxes[domain][idx];
+      }
+    }
+#endif
+
+    x_cell[h] = cell_source[h] * (SOR_factor / diag_cell[h]);
+
+    CMFD_PRECISION* column = &block_coeffs[(row_start + h)*num_groups];
+    CMFD_PRECISION x_h = x_cell[h];
+#pragma omp simd aligned(cell_source)
+    for (int g=h+1; g < num_groups; g++)
+      cell_source[g] -= column[g] * x_h;
+  }
+}
+
+
 /**
  * @brief Solves a linear system using Red-Black Gauss Seidel with
  *        successive over-relaxation.
@@ -231,6 +367,12 @@ bool linearSolve(Matrix* A, Matrix* M, Vector* X, Vector* B, double tol,
   Vector old_source(cell_locks, num_x, num_y, num_z, num_groups);
   Vector new_source(cell_locks, num_x, num_y, num_z, num_groups);
 
+  /* Structured stencil form of the matrix, if available */
+  bool structured = A->hasStructuredStencil();
+  int* stencil_cells = A->getStencilCells();
+  CMFD_PRECISION* stencil_coeffs = A->getStencilCoeffs();
+  CMFD_PRECISION* block_coeffs = A->getBlockCoeffs();
+
   /* Compute initial source */
   matrixMultiplication(M, X, &old_source);
 
@@ -269,6 +411,16 @@ bool linearSolve(Matrix* A, Matrix* M, Vector* X, Vector* B, double tol,
             if (comm != NULL && on_surface)
               domain_surface_index = comm->mapLocalToSurface[cell];
 
+            /* Structured stencil kernel, vectorized over the cell groups */
+            if (structured) {
+              stencilSORCellUpdate(x, b, DIAG, stencil_cells, stencil_coeffs,
+                                   block_coeffs, cell, num_groups, SOR_factor,
+                                   comm, color, domain_surface_index,
+                                   coupling_sizes, coupling_indexes,
+                                   coupling_coeffs, coupling_fluxes);
+              continue;
+            }
+
             /* Contribution of off-diagonal terms, hard to SIMD vectorize */
             for (int g=0; g < num_groups; g++) {
 
@@ -130,7 +130,9 @@ void getCouplingTerms(DomainCommunicator* comm, int color, int*& coupling_sizes,
 double eigenvalueSolve(Matrix* A, Matrix* M, Vector* X, double k_eff,
                        double tol, double SOR_factor=1.5,
                        ConvergenceData* convergence_data = NULL,
-                       DomainCommunicator* comm = NULL);
+                       DomainCommunicator* comm = NULL,
+                       double* dominance_ratio = NULL,
+                       int max_iterations = MAX_LINALG_POWER_ITERATIONS);
 bool linearSolve(Matrix* A, Matrix* M, Vector* X, Vector* B, double tol,
                  double SOR_factor=1.5,
                  ConvergenceData* convergence_data = NULL,
@@ -0,0 +1,230 @@
+#ifdef __cplusplus
+#include "memory_accounting.h"
+#endif
+
+
+/**
+ * @var memory_names
+ * @brief The names of the memory types in the memory report.
+ */
+static const char* memory_names[NUM_MEMORY_TYPES] =
+  {"tracks", "segments", "fluxes", "sources", "linear source", "cmfd",
+   "fsrs and maps", "mpi buffers", "exponential tables"};
+
+
+/**
+ * @var memory_allocations
+ * @brief The accounted allocations by owner and label, with their memory
+ *        type and size in bytes.
+ */
+static std::map<std::pair<const void*, std::string>,
+                std::pair<memoryType, double> > memory_allocations;
+
+
+/**
+ * @var memory_usage
+ * @brief The accounted memory of each type in bytes.
+ */
+static double memory_usage[NUM_MEMORY_TYPES] = {0.};
+
+
+/**
+ * @var memory_peak
+ * @brief The peak of the total accounted memory in bytes.
+ */
+static double memory_peak = 0.;
+
+
+/**
+ * @var memory_budget
+ * @brief The memory budget of the domain in bytes, 0 if there is no budget.
+ */
+static double memory_budget = 0.;
+
+
+/**
+ * @brief Returns the total accounted memory in bytes.
+ * @return the sum of the memory of all types
+ */
+static double total_memory() {
+  double total = 0.;
+  for (int t=0; t < NUM_MEMORY_TYPES; t++)
+    total += memory_usage[t];
+  return total;
+}
+
+
+/**
+ * @brief Accounts an allocation before it is made, checking the memory
+ *        budget.
+ * @details An allocation is identified by its owner and label. Accounting
+ *          it again replaces its previous size, so re-allocations are
+ *          accounted with their new size and freed allocations with a size
+ *          of 0. If the allocation would exceed the memory budget, an ERROR
+ *          is reported before the memory is allocated.
+ * @param owner the object owning the allocation
+ * @param label a short description of the allocation
+ * @param type the subsystem of the allocation
+ * @param bytes the size of the allocation in bytes
+ */
+void account_memory(const void* owner, const char* label, memoryType type,
+                    double bytes) {
+
+  bool over_budget = false;
+  double total;
+
+#pragma omp critical (memory_accounting)
+  {
+    std::pair<const void*, std::string> key(owner, label);
+    std::map<std::pair<const void*, std::string>,
+             std::pair<memoryType, double> >::iterator iter =
+        memory_allocations.find(key);
+
+    /* Remove the previous size of the allocation */
+    double previous_bytes = 0.;
+    if (iter != memory_allocations.end()) {
+      previous_bytes = iter->second.second;
+      memory_usage[iter->second.first] -= previous_bytes;
+    }
+
+    total = total_memory() + bytes;
+    over_budget = (memory_budget > 0. && bytes > previous_bytes &&
+                   total > memory_budget);
+
+    if (over_budget) {
+      if (iter != memory_allocations.end())
+        memory_usage[iter->second.first] += previous_bytes;
+    }
+    else {
+      memory_usage[type] += bytes;
+      if (bytes > 0.)
+        memory_allocations[key] = std::make_pair(type, bytes);
+      else if (iter != memory_allocations.end())
+        memory_allocations.erase(iter);
+      memory_peak = std::max(memory_peak, total);
+    }
+  }
+
+  if (over_budget)
+    log_printf(ERROR, "Unable to allocate %.2f MB for the %s of the %s, "
+               "since the memory of the domain would reach %.2f MB over the "
+               "budget of %.2f MB", bytes / 1e6, label, memory_names[type],
+               total / 1e6, memory_budget / 1e6);
+}
+
+
+/**
+ * @brief Releases all the allocations of an owner, when it is deleted.
+ * @param owner the object owning the allocations
+ */
+void release_memory(const void* owner) {
+
+#pragma omp critical (memory_accounting)
+  {
+    std::map<std::pair<const void*, std::string>,
+             std::pair<memoryType, double> >::iterator iter =
+        memory_allocations.lower_bound(std::make_pair(owner, std::string()));
+    while (iter != memory_allocations.end() && iter->first.first == owner) {
+      memory_usage[iter->second.first] -= iter->second.second;
+      memory_allocations.erase(iter++);
+    }
+  }
+}
+
+
+/**
+ * @brief Sets the memory budget of each domain.
+ * @details Allocations which would bring the accounted memory of the domain
+ *          over the budget report an ERROR before being made.
+ * @param budget the memory budget in MB, 0 for no budget (default)
+ */
+void set_memory_budget(double budget) {
+  if (budget < 0)
+    log_printf(ERROR, "Unable to set a negative memory budget %f", budget);
+  memory_budget = budget * 1e6;
+}
+
+
+/**
+ * @brief Returns the memory budget of each domain.
+ * @return the memory budget in MB, 0 if there is no budget
+ */
+double get_memory_budget() {
+  return memory_budget / 1e6;
+}
+
+
+/**
+ * @brief Returns the accounted memory of a subsystem in the domain.
+ * @param type the subsystem
+ * @return the memory of the subsystem in MB
+ */
+double get_memory_usage(memoryType type) {
+  return memory_usage[type] / 1e6;
+}
+
+
+/**
+ * @brief Returns the total accounted memory in the domain.
+ * @return the memory of all the subsystems in MB
+ */
+double get_total_memory_usage() {
+  return total_memory() / 1e6;
+}
+
+
+/**
+ * @brief Returns the peak of the total accounted memory in the domain.
+ * @return the peak memory in MB
+ */
+double get_peak_memory_usage() {
+  return memory_peak / 1e6;
+}
+
+
+/**
+ * @brief Prints the accounted memory of each subsystem.
+ * @details With MPI, the memory of the largest domain is reported, and all
+ *          the domains must call this routine.
+ */
+void print_memory_report() {
+
+  double usage[NUM_MEMORY_TYPES + 2];
+  for (int t=0; t < NUM_MEMORY_TYPES; t++)
+    usage[t] = memory_usage[t] / 1e6;
+  usage[NUM_MEMORY_TYPES] = get_total_memory_usage();
+  usage[NUM_MEMORY_TYPES + 1] = get_peak_memory_usage();
+
+#ifdef MPIx
+  int mpi_initialized;
+  MPI_Initialized(&mpi_initialized);
+  if (mpi_initialized)
+    MPI_Allreduce(MPI_IN_PLACE, usage, NUM_MEMORY_TYPES + 2, MPI_DOUBLE,
+                  MPI_MAX, MPI_COMM_WORLD);
+#endif
+
+  std::string msg_string;
+  log_printf(TITLE, "MEMORY REPORT");
+  for (int t=0; t < NUM_MEMORY_TYPES; t++) {
+    msg_string = std::string("  Max ") + memory_names[t] +
+                 " storage per domain";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%8.2f MB", msg_string.c_str(), usage[t]);
+  }
+
+  msg_string = "Max total storage per domain";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%8.2f MB", msg_string.c_str(),
+             usage[NUM_MEMORY_TYPES]);
+
+  msg_string = "Max peak storage per domain";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%8.2f MB", msg_string.c_str(),
+             usage[NUM_MEMORY_TYPES + 1]);
+
+  if (memory_budget > 0.) {
+    msg_string = "Memory budget per domain";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%8.2f MB", msg_string.c_str(), memory_budget / 1e6);
+  }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file memory_accounting.h
+ * @brief Utility functions for accounting the memory of each subsystem
+ * @details The major allocations of the solvers, the CMFD solver, the
+ *          Geometry, the TrackGenerators and the exponential evaluators
+ *          register their size before being allocated, so that the memory of
+ *          each subsystem can be reported and checked against an optional
+ *          memory budget.
+ * @date October 18, 2026
+ *
+ */
+
+#ifndef MEMORY_ACCOUNTING_H_
+#define MEMORY_ACCOUNTING_H_
+
+#ifdef __cplusplus
+#include "log.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#endif
+
+
+/**
+ * @enum memoryTypes
+ * @brief The subsystems whose memory is accounted.
+ */
+typedef enum memoryTypes {
+
+  /** The 2D and 3D Tracks */
+  TRACK_MEMORY,
+
+  /** The explicit and temporary segments */
+  SEGMENT_MEMORY,
+
+  /** The scalar and angular fluxes */
+  FLUX_MEMORY,
+
+  /** The sources and FSR data of the solvers */
+  SOURCE_MEMORY,
+
+  /** The flux and source moments of the linear source solvers */
+  LINEAR_SOURCE_MEMORY,
+
+  /** The CMFD matrices, vectors, tallies and stencils */
+  CMFD_MEMORY,
+
+  /** The FSRs and their maps */
+  FSR_MEMORY,
+
+  /** The MPI communication buffers */
+  MPI_BUFFER_MEMORY,
+
+  /** The exponential interpolation tables */
+  EXP_TABLE_MEMORY,
+
+  /** The number of memory types */
+  NUM_MEMORY_TYPES
+} memoryType;
+
+
+void account_memory(const void* owner, const char* label, memoryType type,
+                    double bytes);
+void release_memory(const void* owner);
+
+void set_memory_budget(double budget);
+double get_memory_budget();
+double get_memory_usage(memoryType type);
+double get_total_memory_usage();
+double get_peak_memory_usage();
+void print_memory_report();
+
+#endif /* MEMORY_ACCOUNTING_H_ */
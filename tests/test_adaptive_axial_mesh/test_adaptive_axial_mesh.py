@@ -0,0 +1,163 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import InputSet
+import openmoc
+
+
+class AxialPinCellInput(InputSet):
+    """A 3D pin cell with vacuum boundaries at the top and bottom, on a
+    coarse 2.5 cm axial mesh."""
+
+    def create_materials(self):
+        """Instantiate C5G7 Materials."""
+        self.materials = \
+            openmoc.materialize.load_from_hdf5(filename='c5g7-mgxs.h5',
+                                               directory='../../sample-input/')
+
+    def create_geometry(self):
+        """Instantiate the 3D pin cell Geometry."""
+
+        xmin = openmoc.XPlane(x=-0.63, name='xmin')
+        xmax = openmoc.XPlane(x=+0.63, name='xmax')
+        ymin = openmoc.YPlane(y=-0.63, name='ymin')
+        ymax = openmoc.YPlane(y=+0.63, name='ymax')
+        zmin = openmoc.ZPlane(z=-5.0, name='zmin')
+        zmax = openmoc.ZPlane(z=+5.0, name='zmax')
+        for boundary in [xmin, xmax, ymin, ymax]:
+            boundary.setBoundaryType(openmoc.REFLECTIVE)
+        for boundary in [zmin, zmax]:
+            boundary.setBoundaryType(openmoc.VACUUM)
+
+        zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=0.54, name='pin')
+        fuel = openmoc.Cell(name='fuel')
+        fuel.setFill(self.materials['UO2'])
+        fuel.addSurface(halfspace=-1, surface=zcylinder)
+        moderator = openmoc.Cell(name='moderator')
+        moderator.setFill(self.materials['Water'])
+        moderator.addSurface(halfspace=+1, surface=zcylinder)
+
+        pin = openmoc.Universe(name='pin')
+        pin.addCell(fuel)
+        pin.addCell(moderator)
+
+        root_cell = openmoc.Cell(name='root cell')
+        root_cell.setFill(pin)
+        for halfspace, surface in [(+1, xmin), (-1, xmax), (+1, ymin),
+                                   (-1, ymax), (+1, zmin), (-1, zmax)]:
+            root_cell.addSurface(halfspace=halfspace, surface=surface)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(root_cell)
+
+        self.geometry = openmoc.Geometry()
+        self.geometry.setRootUniverse(root_universe)
+        self.geometry.setOverlaidMesh(2.5)
+
+
+class AdaptiveAxialMeshTestHarness(TestHarness):
+    """Remapping of the scalar fluxes of a 3D pin cell onto an adaptively
+    refined axial mesh, compared to the fluxes before the refinement."""
+
+    def __init__(self):
+        super(AdaptiveAxialMeshTestHarness, self).__init__()
+        self.num_polar = 2
+        self.azim_spacing = 0.5
+        self.z_spacing = 1.0
+        self.max_iters = 5
+        self.input_sets = [AxialPinCellInput(num_dimensions=3)
+                           for refine in [False, True]]
+        self.track_generators = []
+        self.solvers = []
+
+        # Points inside the fuel and the moderator, at the center of each FSR
+        # of the refined 1.25 cm axial mesh
+        self.points = [(name, x, y, -5.0 + 1.25 * (k + 0.5))
+                       for (name, x, y) in [('Fuel', 0.1, 0.2),
+                                            ('Moderator', 0.5, 0.45)]
+                       for k in range(8)]
+
+    def _create_geometry(self):
+        """Instantiate the Geometries without and with axial refinement."""
+
+        for input_set in self.input_sets:
+            input_set.create_materials()
+            input_set.create_geometry()
+
+    def _create_trackgenerator(self):
+        """Instantiate a TrackGenerator3D for each Geometry."""
+
+        for input_set in self.input_sets:
+            geometry = input_set.geometry
+            geometry.initializeFlatSourceRegions()
+            track_generator = \
+                openmoc.TrackGenerator3D(geometry, self.num_azim,
+                                         self.num_polar, self.azim_spacing,
+                                         self.z_spacing)
+            track_generator.setSegmentFormation(openmoc.OTF_TRACKS)
+            self.track_generators.append(track_generator)
+
+    def _generate_tracks(self):
+        """Generate Tracks for each Geometry."""
+
+        # The multi-threaded solver needs temporary Tracks and segments for
+        # the same number of threads
+        for track_generator in self.track_generators:
+            track_generator.setNumThreads(self.num_threads)
+            track_generator.generateTracks()
+
+    def _create_solver(self):
+        """Instantiate a CPUSolver for each Geometry, refining the axial mesh
+        of the second one at the last iteration."""
+
+        for track_generator in self.track_generators:
+            self.track_generator = track_generator
+            super(AdaptiveAxialMeshTestHarness, self)._create_solver()
+            self.solvers.append(self.solver)
+
+        self.solvers[1].useAdaptiveAxialMesh(0.05, self.max_iters, 1)
+
+    def _run_openmoc(self):
+        """Run the same source iterations without and with the refinement."""
+
+        for solver in self.solvers:
+            self.solver = solver
+            super(AdaptiveAxialMeshTestHarness, self)._run_openmoc()
+
+    def _find_fsr(self, geometry, x, y, z):
+        """Find the FSR containing a point."""
+        coords = openmoc.LocalCoords(x, y, z)
+        coords.setUniverse(geometry.getRootUniverse())
+        geometry.findCellContainingCoords(coords)
+        return geometry.getGlobalFSRId(coords, False)
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the number of FSRs, and the fluxes before and after the
+        refinement at the center of each refined FSR."""
+
+        coarse, refined = [input_set.geometry
+                           for input_set in self.input_sets]
+        outstr = '# FSRs: {0} coarse, {1} refined\n'.format(
+            coarse.getNumFSRs(), refined.getNumFSRs())
+
+        num_groups = coarse.getNumEnergyGroups()
+        for name, x, y, z in self.points:
+            coarse_fsr = self._find_fsr(coarse, x, y, z)
+            refined_fsr = self._find_fsr(refined, x, y, z)
+            outstr += '{0} at z = {1:.3f} cm:\n'.format(name, z)
+            for group in range(1, num_groups + 1):
+                outstr += '{0:12.6E}\t{1:12.6E}\n'.format(
+                    self.solvers[0].getFlux(coarse_fsr, group),
+                    self.solvers[1].getFlux(refined_fsr, group))
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = AdaptiveAxialMeshTestHarness()
+    harness.main()
@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import InputSet
+import openmoc
+
+
+class QuadrantLatticeInput(InputSet):
+    """The quadrant of a bare 8x8 lattice of UO2 pins."""
+
+    def __init__(self, num_pins=4):
+        super(QuadrantLatticeInput, self).__init__()
+        self.num_pins = num_pins
+
+    def create_materials(self):
+        """Instantiate C5G7 Materials."""
+        self.materials = \
+            openmoc.materialize.load_from_hdf5(filename='c5g7-mgxs.h5',
+                                               directory='../../sample-input/')
+
+    def create_geometry(self):
+        """Instantiate the quadrant Geometry."""
+
+        half_width = 1.26 * self.num_pins / 2.
+        xmin = openmoc.XPlane(x=-half_width, name='xmin')
+        xmax = openmoc.XPlane(x=+half_width, name='xmax')
+        ymin = openmoc.YPlane(y=-half_width, name='ymin')
+        ymax = openmoc.YPlane(y=+half_width, name='ymax')
+        xmin.setBoundaryType(openmoc.REFLECTIVE)
+        ymin.setBoundaryType(openmoc.REFLECTIVE)
+        xmax.setBoundaryType(openmoc.VACUUM)
+        ymax.setBoundaryType(openmoc.VACUUM)
+
+        zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=0.54, name='pin')
+        fuel = openmoc.Cell(name='fuel')
+        fuel.setFill(self.materials['UO2'])
+        fuel.addSurface(halfspace=-1, surface=zcylinder)
+        moderator = openmoc.Cell(name='moderator')
+        moderator.setFill(self.materials['Water'])
+        moderator.addSurface(halfspace=+1, surface=zcylinder)
+
+        pin = openmoc.Universe(name='pin')
+        pin.addCell(fuel)
+        pin.addCell(moderator)
+
+        lattice = openmoc.Lattice(name='pin lattice')
+        lattice.setWidth(width_x=1.26, width_y=1.26)
+        lattice.setUniverses([[[pin] * self.num_pins] * self.num_pins])
+
+        root_cell = openmoc.Cell(name='root cell')
+        root_cell.setFill(lattice)
+        root_cell.addSurface(halfspace=+1, surface=xmin)
+        root_cell.addSurface(halfspace=-1, surface=xmax)
+        root_cell.addSurface(halfspace=+1, surface=ymin)
+        root_cell.addSurface(halfspace=-1, surface=ymax)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(root_cell)
+
+        self.geometry = openmoc.Geometry()
+        self.geometry.setRootUniverse(root_universe)
+
+
+class CmfdCondensationFallbackTestHarness(TestHarness):
+    """Eigenvalue calculations in the quadrant of a bare 8x8 pin lattice with
+    CMFD, without group condensation and with condensed CMFD solves that are
+    limited to a single power iteration and thus fall back to the regular
+    CMFD solver."""
+
+    def __init__(self):
+        super(CmfdCondensationFallbackTestHarness, self).__init__()
+        self.input_set = QuadrantLatticeInput()
+        self.cmfd = None
+        self.keffs = []
+        self.num_iters = []
+
+    def _create_geometry(self):
+        """Add a pin-wise CMFD mesh to the Geometry."""
+
+        super(CmfdCondensationFallbackTestHarness, self)._create_geometry()
+
+        self.cmfd = openmoc.Cmfd()
+        self.cmfd.setSORRelaxationFactor(1.0)
+        self.cmfd.setLatticeStructure(self.input_set.num_pins,
+                                      self.input_set.num_pins)
+        self.cmfd.setKNearest(3)
+        self.input_set.geometry.setCmfd(self.cmfd)
+
+    def _run_openmoc(self):
+        """Compute the eigenvalue with the regular CMFD solver, then with
+        condensed CMFD solves that fail."""
+
+        super(CmfdCondensationFallbackTestHarness, self)._run_openmoc()
+        self.keffs.append(self.solver.getKeff())
+        self.num_iters.append(self.solver.getNumIterations())
+
+        self.cmfd.useAutomaticGroupCondensation(2, 0.8, 1)
+        super(CmfdCondensationFallbackTestHarness, self)._run_openmoc()
+        self.keffs.append(self.solver.getKeff())
+        self.num_iters.append(self.solver.getNumIterations())
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the iteration count and eigenvalue of both calculations."""
+
+        outstr = ''
+        for name, num_iters, keff in zip(['Regular', 'Fallback'],
+                                         self.num_iters, self.keffs):
+            outstr += '{0}: Iters: {1}\tkeff: {2:12.5E}\n'.format(
+                name, num_iters, keff)
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = CmfdCondensationFallbackTestHarness()
+    harness.main()
@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+
+import os
+import sys
+import numpy
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PinCellInput
+import openmoc
+
+
+class CriticalitySearchTestHarness(TestHarness):
+    """A search of the thermal absorber concentration in the moderator of a
+    pin cell with 7-group C5G7 data for which k_eff is 1."""
+
+    def __init__(self):
+        super(CriticalitySearchTestHarness, self).__init__()
+        self.input_set = PinCellInput()
+        self.search_tolerance = 1E-4
+        self.parameters = []
+
+    def _create_geometry(self):
+        """Instantiate a pin cell with a moderator interpolated between water
+        and water with an additional thermal absorber."""
+
+        super(CriticalitySearchTestHarness, self)._create_geometry()
+        materials = self.input_set.materials
+        water = materials['Water']
+        num_groups = water.getNumEnergyGroups()
+
+        # Absorber cross sections at a concentration of 1000
+        absorber = numpy.array([0., 0., 0., 0.002, 0.01, 0.02, 0.05])
+
+        self.moderator = openmoc.Material(name='Moderator')
+        self.borated_water = openmoc.Material(name='Borated water')
+        for material, sigma_a in [(self.moderator, 0. * absorber),
+                                  (self.borated_water, absorber)]:
+            sigma_t = numpy.array([water.getSigmaTByGroup(g+1)
+                                   for g in range(num_groups)]) + sigma_a
+            sigma_s = numpy.array([water.getSigmaSByGroup(g+1, gp+1)
+                                   for g in range(num_groups)
+                                   for gp in range(num_groups)])
+            material.setNumEnergyGroups(num_groups)
+            material.setSigmaT(sigma_t)
+            material.setNuSigmaF(numpy.zeros(num_groups))
+            material.setSigmaS(sigma_s)
+            material.setChi(numpy.zeros(num_groups))
+            material.setSigmaF(numpy.zeros(num_groups))
+
+        # Fill the moderator cell with the interpolated moderator
+        root_universe = self.input_set.geometry.getRootUniverse()
+        for cell in root_universe.getCells().values():
+            if cell.getName() == 'moderator':
+                cell.setFill(self.moderator)
+
+    def _create_solver(self):
+        """Instantiate a CPUSolver and a CriticalitySearch."""
+        super(CriticalitySearchTestHarness, self)._create_solver()
+        self.search = openmoc.CriticalitySearch(self.solver)
+        self.search.addInterpolatedMaterial(
+            self.moderator, self.input_set.materials['Water'], 0.,
+            self.borated_water, 1000.)
+        self.search.setParameterCallback(self.parameters.append)
+        self.search.setConvergenceThreshold(self.search_tolerance)
+
+    def _run_openmoc(self):
+        """Search the critical concentration, then compute the eigenvalue at
+        this concentration from a flat flux."""
+
+        self.critical_parameter = self.search.search(0., 500.)
+
+        solver = openmoc.CPUSolver(self.track_generator)
+        solver.setNumThreads(self.num_threads)
+        solver.setConvergenceThreshold(self.tolerance)
+        solver.computeEigenvalue(self.max_iters)
+        self.keff = solver.getKeff()
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the critical concentration and check its eigenvalue."""
+
+        outstr = 'Critical parameter: {0:.0f}\n'.format(
+            self.critical_parameter)
+        outstr += 'k_eff within tolerance of the target: {0}\n'.format(
+            abs(self.keff - 1.) < self.search_tolerance)
+        outstr += 'Callback applied the parameter of each solve: {0}\n'.format(
+            len(self.parameters) == self.search.getNumSolves() and
+            self.parameters[-1] == self.critical_parameter)
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = CriticalitySearchTestHarness()
+    harness.main()
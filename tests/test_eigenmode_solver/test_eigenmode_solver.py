@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import PinCellInput
+import openmoc
+
+
+class EigenmodeSolverTestHarness(TestHarness):
+    """An eigenmodes calculation in a pin cell with 7-group C5G7 data, compared
+    to an eigenvalue calculation."""
+
+    def __init__(self):
+        super(EigenmodeSolverTestHarness, self).__init__()
+        self.input_set = PinCellInput()
+        self.num_modes = 3
+
+    def _create_geometry(self):
+        """Instantiate materials and a pin cell Geometry."""
+
+        self.input_set.create_materials()
+
+        zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=1.0, name='pin')
+        xmin = openmoc.XPlane(x=-2.0, name='xmin')
+        xmax = openmoc.XPlane(x=+2.0, name='xmax')
+        ymin = openmoc.YPlane(y=-2.0, name='ymin')
+        ymax = openmoc.YPlane(y=+2.0, name='ymax')
+
+        xmin.setBoundaryType(openmoc.VACUUM)
+        xmax.setBoundaryType(openmoc.VACUUM)
+        ymin.setBoundaryType(openmoc.VACUUM)
+        ymax.setBoundaryType(openmoc.VACUUM)
+
+        fuel = openmoc.Cell(name='fuel')
+        fuel.setFill(self.input_set.materials['UO2'])
+        fuel.addSurface(halfspace=-1, surface=zcylinder)
+
+        moderator = openmoc.Cell(name='moderator')
+        moderator.setFill(self.input_set.materials['Water'])
+        moderator.addSurface(halfspace=+1, surface=zcylinder)
+        moderator.addSurface(halfspace=+1, surface=xmin)
+        moderator.addSurface(halfspace=-1, surface=xmax)
+        moderator.addSurface(halfspace=+1, surface=ymin)
+        moderator.addSurface(halfspace=-1, surface=ymax)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(fuel)
+        root_universe.addCell(moderator)
+
+        self.input_set.geometry = openmoc.Geometry()
+        self.input_set.geometry.setRootUniverse(root_universe)
+
+    def _create_solver(self):
+        """Instantiate a CPUSolver for the eigenvalue calculation and an
+        EigenmodeSolver on another CPUSolver."""
+        self.solver = openmoc.CPUSolver(self.track_generator)
+        self.solver.setNumThreads(self.num_threads)
+        self.solver.setConvergenceThreshold(self.tolerance)
+
+        moc_solver = openmoc.CPUSolver(self.track_generator)
+        moc_solver.setNumThreads(self.num_threads)
+        self.eigenmode_solver = openmoc.EigenmodeSolver(moc_solver)
+
+    def _run_openmoc(self):
+        """Run an eigenvalue and a forward eigenmodes calculation."""
+
+        # The scalar flux residual keeps iterating until k_eff, which is small
+        # in this leaky pin cell, has converged
+        self.solver.computeEigenvalue(self.max_iters,
+                                      res_type=openmoc.SCALAR_FLUX)
+        self.eigenmode_solver.computeEigenmodes(openmoc.FORWARD,
+                                                self.num_modes)
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Compare the fundamental eigenvalue to k_eff and check the order
+        and convergence of the eigenmodes."""
+
+        eigenvalues = [self.eigenmode_solver.getEigenvalue(mode)
+                       for mode in range(self.num_modes)]
+        keff = self.solver.getKeff()
+
+        outstr = 'Fundamental eigenvalue: {0:10.4E}\n'.format(eigenvalues[0])
+        outstr += 'Fundamental eigenvalue matches k_eff: {0}\n'.format(
+            abs(eigenvalues[0] - keff) < 1E-4 * keff)
+        outstr += 'Eigenvalues in decreasing order: {0}\n'.format(
+            all(eigenvalues[i] > eigenvalues[i+1] > 0.
+                for i in range(self.num_modes - 1)))
+        outstr += 'Eigenmodes converged: {0}\n'.format(
+            self.eigenmode_solver.isConverged())
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = EigenmodeSolverTestHarness()
+    harness.main()
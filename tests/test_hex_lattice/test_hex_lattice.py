@@ -0,0 +1,147 @@
+#!/usr/bin/env python
+
+import os
+import sys
+import math
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+import openmoc
+from testing_harness import TestHarness
+from openmoc.log import py_printf
+
+
+class HexLatticeTestHarness(TestHarness):
+    """Finding cells on the boundaries of a hexagonal lattice, before and after
+    dumping and loading the geometry."""
+
+    def __init__(self):
+        super(HexLatticeTestHarness, self).__init__()
+
+        # Points on either side of the faces and vertices of the central cell
+        eps = 1E-6
+        sqrt3 = math.sqrt(3.)
+        self.points = [(0., 0.), (0.5 - eps, 0.), (0.5 + eps, 0.),
+                       (-0.5 + eps, 0.), (-0.5 - eps, 0.),
+                       (0.25 - eps * 0.5, sqrt3 / 4. - eps * sqrt3 / 2.),
+                       (0.25 + eps * 0.5, sqrt3 / 4. + eps * sqrt3 / 2.),
+                       (-0.25 + eps * 0.5, -sqrt3 / 4. + eps * sqrt3 / 2.),
+                       (-0.25 - eps * 0.5, -sqrt3 / 4. - eps * sqrt3 / 2.),
+                       (0., 1. / sqrt3 - eps), (-eps, 1. / sqrt3 + eps),
+                       (eps, 1. / sqrt3 + eps), (1., 0.), (-0.5, -sqrt3 / 2.)]
+
+        # Points exactly on a face, with the two cells sharing the face
+        self.face_points = [((0.5, 0.), ('C', 'E')),
+                            ((-0.25, sqrt3 / 4.), ('C', 'NW')),
+                            ((0., -1. / sqrt3), ('C', 'SW', 'SE'))]
+
+    def _create_geometry(self):
+        """Instantiate a 2 ring hexagonal lattice with a distinct cell in each
+        lattice cell."""
+
+        self.materials = \
+            openmoc.materialize.load_from_hdf5(filename='c5g7-mgxs.h5',
+                                               directory='../../sample-input/')
+
+        # One universe per lattice cell, named after its position
+        names = [['NW', 'NE'], ['W', 'C', 'E'], ['SW', 'SE']]
+        rows = []
+        for row in names:
+            rows.append([])
+            for name in row:
+                cell = openmoc.Cell(name=name)
+                cell.setFill(self.materials['UO2'])
+                universe = openmoc.Universe(name=name)
+                universe.addCell(cell)
+                rows[-1].append(universe)
+
+        self.lattice = openmoc.HexLattice(name='2 ring hex lattice')
+        self.lattice.setPitch(1.0)
+        self.lattice.setUniverses([rows])
+
+        xmin = openmoc.XPlane(x=-1.5, name='xmin')
+        xmax = openmoc.XPlane(x=+1.5, name='xmax')
+        ymin = openmoc.YPlane(y=-1.5, name='ymin')
+        ymax = openmoc.YPlane(y=+1.5, name='ymax')
+        for boundary in [xmin, xmax, ymin, ymax]:
+            boundary.setBoundaryType(openmoc.VACUUM)
+
+        root_cell = openmoc.Cell(name='root cell')
+        root_cell.setFill(self.lattice)
+        root_cell.addSurface(halfspace=+1, surface=xmin)
+        root_cell.addSurface(halfspace=-1, surface=xmax)
+        root_cell.addSurface(halfspace=+1, surface=ymin)
+        root_cell.addSurface(halfspace=-1, surface=ymax)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(root_cell)
+
+        self.geometry = openmoc.Geometry()
+        self.geometry.setRootUniverse(root_universe)
+
+    def _create_solver(self):
+        pass
+
+    def _create_trackgenerator(self):
+        pass
+
+    def _generate_tracks(self):
+        pass
+
+    def _find_cells(self, geometry):
+        """Find the cells containing the points in a geometry."""
+
+        root = geometry.getRootUniverse()
+        names = []
+        for (x, y) in self.points + [p[0] for p in self.face_points]:
+            coords = openmoc.LocalCoords(x, y, 0)
+            coords.setUniverse(root)
+            cell = geometry.findCellContainingCoords(coords)
+            names.append(cell.getName())
+        return names
+
+    def _run_openmoc(self):
+        """Find the cells, then dump, load and dump the geometry again."""
+
+        self.cells = self._find_cells(self.geometry)
+
+        # Dump and reload the geometry
+        self.geometry.dumpToFile("geometry_file.geo")
+        self.loaded_geometry = openmoc.Geometry()
+        self.loaded_geometry.loadFromFile("geometry_file.geo")
+        self.loaded_geometry.dumpToFile("geometry_file_second.geo")
+        self.loaded_cells = self._find_cells(self.loaded_geometry)
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the lattice cell and cell of each point."""
+
+        outstr = ''
+        for i, (x, y) in enumerate(self.points):
+            point = openmoc.Point()
+            point.setCoords(x, y, 0.)
+            outstr += 'x = {0:9.6f}, y = {1:9.6f}: lattice cell {2}, ' \
+                      'cell {3}\n'.format(x, y,
+                                          self.lattice.getLatticeCell(point),
+                                          self.cells[i])
+
+        # Points on a face may be found in any of the cells sharing it
+        for i, (point, cells) in enumerate(self.face_points):
+            cell = self.cells[len(self.points) + i]
+            outstr += 'x = {0:9.6f}, y = {1:9.6f}: on a face of {2}, ' \
+                      '{3}\n'.format(point[0], point[1], '/'.join(cells),
+                                     cell in cells)
+
+        # The loaded geometry must be identical
+        if (os.system("cmp geometry_file.geo geometry_file_second.geo") != 0):
+            py_printf('ERROR', "Geometry files are not dumped and loaded "
+                      "properly")
+        outstr += 'Same cells after loading: {0}\n'.format(
+            self.cells == self.loaded_cells)
+
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = HexLatticeTestHarness()
+    harness.main()
@@ -0,0 +1,110 @@
+#!/usr/bin/env python
+
+import os
+import sys
+from mpi4py import MPI
+
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import InputSet
+import openmoc
+
+
+class QuadrantLatticeInput(InputSet):
+    """The quadrant of a bare 8x8 lattice of UO2 pins."""
+
+    def __init__(self, num_pins=4):
+        super(QuadrantLatticeInput, self).__init__()
+        self.num_pins = num_pins
+
+    def create_materials(self):
+        """Instantiate C5G7 Materials."""
+        self.materials = \
+            openmoc.materialize.load_from_hdf5(filename='c5g7-mgxs.h5',
+                                               directory='../../sample-input/')
+
+    def create_geometry(self):
+        """Instantiate the quadrant Geometry."""
+
+        half_width = 1.26 * self.num_pins / 2.
+        xmin = openmoc.XPlane(x=-half_width, name='xmin')
+        xmax = openmoc.XPlane(x=+half_width, name='xmax')
+        ymin = openmoc.YPlane(y=-half_width, name='ymin')
+        ymax = openmoc.YPlane(y=+half_width, name='ymax')
+        xmin.setBoundaryType(openmoc.REFLECTIVE)
+        ymin.setBoundaryType(openmoc.REFLECTIVE)
+        xmax.setBoundaryType(openmoc.VACUUM)
+        ymax.setBoundaryType(openmoc.VACUUM)
+
+        zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=0.54, name='pin')
+        fuel = openmoc.Cell(name='fuel')
+        fuel.setFill(self.materials['UO2'])
+        fuel.addSurface(halfspace=-1, surface=zcylinder)
+        moderator = openmoc.Cell(name='moderator')
+        moderator.setFill(self.materials['Water'])
+        moderator.addSurface(halfspace=+1, surface=zcylinder)
+
+        pin = openmoc.Universe(name='pin')
+        pin.addCell(fuel)
+        pin.addCell(moderator)
+
+        lattice = openmoc.Lattice(name='pin lattice')
+        lattice.setWidth(width_x=1.26, width_y=1.26)
+        lattice.setUniverses([[[pin] * self.num_pins] * self.num_pins])
+
+        root_cell = openmoc.Cell(name='root cell')
+        root_cell.setFill(lattice)
+        root_cell.addSurface(halfspace=+1, surface=xmin)
+        root_cell.addSurface(halfspace=-1, surface=xmax)
+        root_cell.addSurface(halfspace=+1, surface=ymin)
+        root_cell.addSurface(halfspace=-1, surface=ymax)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(root_cell)
+
+        self.geometry = openmoc.Geometry()
+        self.geometry.setRootUniverse(root_universe)
+
+
+class MPIRanksCmfdTestHarness(TestHarness):
+    """An eigenvalue calculation with CMFD in the quadrant of a bare 8x8 pin
+    lattice, split in as many domains along x as there are MPI ranks."""
+
+    def __init__(self):
+        super(MPIRanksCmfdTestHarness, self).__init__()
+        self.input_set = QuadrantLatticeInput()
+        self.tolerance = 1E-7
+
+    def _create_geometry(self):
+        """Decompose the domain and add a pin-wise CMFD mesh."""
+
+        super(MPIRanksCmfdTestHarness, self)._create_geometry()
+
+        num_ranks = MPI.COMM_WORLD.Get_size()
+        if num_ranks > 1:
+            self.input_set.geometry.setDomainDecomposition(
+                num_ranks, 1, 1, MPI.COMM_WORLD)
+
+        cmfd = openmoc.Cmfd()
+        cmfd.setSORRelaxationFactor(1.0)
+        cmfd.setLatticeStructure(self.input_set.num_pins,
+                                 self.input_set.num_pins)
+        cmfd.setGroupStructure([[1,2,3], [4,5,6,7]])
+        cmfd.setKNearest(3)
+        self.input_set.geometry.setCmfd(cmfd)
+
+    def _get_results(self, num_iters=False, keff=True, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the eigenvalue, since the number of iterations and the FSR
+        fluxes depend on the tracks laid down in each domain."""
+        return super(MPIRanksCmfdTestHarness, self)._get_results(
+                num_iters=num_iters, keff=keff, fluxes=fluxes,
+                num_fsrs=num_fsrs, num_tracks=num_tracks,
+                num_segments=num_segments, hash_output=hash_output)
+
+
+if __name__ == '__main__':
+    harness = MPIRanksCmfdTestHarness()
+    harness.main()
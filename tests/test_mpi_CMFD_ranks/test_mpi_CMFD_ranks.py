@@ -0,0 +1,11 @@
+import subprocess
+
+# This test should only be collected if OpenMOC was installed with an MPI
+# wrapped compiler. The eigenvalue on two domains is compared to the single
+# domain eigenvalue in results_true.dat.
+for num_ranks in ["1", "2"]:
+    output = subprocess.call(["mpirun", "-n", num_ranks, "--oversubscribe",
+                              "python", "quadrant_lattice.py"])
+
+    if output != 0:
+        raise RuntimeError("Test failed on {0} ranks".format(num_ranks))
@@ -0,0 +1,126 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import InputSet
+import openmoc
+
+
+class PinLattice3DInput(InputSet):
+    """A 2x2 lattice of UO2 pins, 3 cm high, reflective on three sides."""
+
+    def __init__(self):
+        super(PinLattice3DInput, self).__init__(num_dimensions=3)
+
+    def create_materials(self):
+        """Instantiate C5G7 Materials."""
+        self.materials = \
+            openmoc.materialize.load_from_hdf5(filename='c5g7-mgxs.h5',
+                                               directory='../../sample-input/')
+
+    def create_geometry(self):
+        """Instantiate the 3D pin lattice Geometry."""
+
+        xmin = openmoc.XPlane(x=-1.26, name='xmin')
+        xmax = openmoc.XPlane(x=+1.26, name='xmax')
+        ymin = openmoc.YPlane(y=-1.26, name='ymin')
+        ymax = openmoc.YPlane(y=+1.26, name='ymax')
+        zmin = openmoc.ZPlane(z=-1.5, name='zmin')
+        zmax = openmoc.ZPlane(z=+1.5, name='zmax')
+        xmin.setBoundaryType(openmoc.REFLECTIVE)
+        ymin.setBoundaryType(openmoc.REFLECTIVE)
+        zmin.setBoundaryType(openmoc.REFLECTIVE)
+        xmax.setBoundaryType(openmoc.VACUUM)
+        ymax.setBoundaryType(openmoc.VACUUM)
+        zmax.setBoundaryType(openmoc.VACUUM)
+
+        zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=0.54, name='pin')
+        fuel = openmoc.Cell(name='fuel')
+        fuel.setFill(self.materials['UO2'])
+        fuel.addSurface(halfspace=-1, surface=zcylinder)
+        fuel.setNumSectors(4)
+        moderator = openmoc.Cell(name='moderator')
+        moderator.setFill(self.materials['Water'])
+        moderator.addSurface(halfspace=+1, surface=zcylinder)
+        moderator.setNumSectors(4)
+
+        pin = openmoc.Universe(name='pin')
+        pin.addCell(fuel)
+        pin.addCell(moderator)
+
+        lattice = openmoc.Lattice(name='pin lattice')
+        lattice.setWidth(width_x=1.26, width_y=1.26, width_z=3.0)
+        lattice.setUniverses([[[pin, pin], [pin, pin]]])
+
+        root_cell = openmoc.Cell(name='root cell')
+        root_cell.setFill(lattice)
+        root_cell.addSurface(halfspace=+1, surface=xmin)
+        root_cell.addSurface(halfspace=-1, surface=xmax)
+        root_cell.addSurface(halfspace=+1, surface=ymin)
+        root_cell.addSurface(halfspace=-1, surface=ymax)
+        root_cell.addSurface(halfspace=+1, surface=zmin)
+        root_cell.addSurface(halfspace=-1, surface=zmax)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(root_cell)
+
+        self.geometry = openmoc.Geometry()
+        self.geometry.setRootUniverse(root_universe)
+
+
+class ResourceEstimatorTestHarness(TestHarness):
+    """Estimates the resources of a 3D calculation with all the z-stacks
+    sampled, to compare the estimated counts to the generated Tracks."""
+
+    def __init__(self):
+        super(ResourceEstimatorTestHarness, self).__init__()
+        self.input_set = PinLattice3DInput()
+        self.num_polar = 2
+        self.azim_spacing = 0.5
+        self.z_spacing = 0.5
+        self.estimator = None
+        self.num_fsrs = 0
+        self.num_tracks = 0
+        self.num_segments = 0
+
+    def _create_trackgenerator(self):
+        """Instantiate a TrackGenerator3D with explicit 3D segments."""
+        geometry = self.input_set.geometry
+        geometry.initializeFlatSourceRegions()
+        self.track_generator = \
+            openmoc.TrackGenerator3D(geometry, self.num_azim, self.num_polar,
+                                     self.azim_spacing, self.z_spacing)
+        self.track_generator.setSegmentFormation(openmoc.EXPLICIT_3D)
+
+    def _run_openmoc(self):
+        """Estimate the resources after the Tracks were generated."""
+
+        self.num_fsrs = self.input_set.geometry.getNumFSRs()
+        self.num_tracks = self.track_generator.getNumTracks()
+        self.num_segments = self.track_generator.getNumSegments()
+
+        self.estimator = openmoc.ResourceEstimator(self.track_generator)
+        self.estimator.setSampleFraction(1.0)
+        self.estimator.estimate()
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the generated and estimated numbers of FSRs, Tracks and
+        segments."""
+
+        outstr = '# FSRs: {0}\testimated: {1}\n'.format(
+            self.num_fsrs, self.estimator.getNumFSRs())
+        outstr += '# tracks: {0}\testimated: {1}\n'.format(
+            self.num_tracks, self.estimator.getNumTracks())
+        outstr += '# segments: {0}\testimated: {1}\n'.format(
+            self.num_segments, self.estimator.getNumSegments())
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = ResourceEstimatorTestHarness()
+    harness.main()
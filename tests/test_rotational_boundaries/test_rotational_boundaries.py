@@ -0,0 +1,184 @@
+#!/usr/bin/env python
+
+import os
+import sys
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import InputSet
+import openmoc
+
+
+class PinwheelLatticeInput(InputSet):
+    """A 4x4 pinwheel lattice, which is symmetric under a 90 degree rotation
+    but not under reflections. In 3D, it is 3 cm tall with a vacuum top."""
+
+    def create_materials(self):
+        """Instantiate C5G7 Materials."""
+        self.materials = \
+            openmoc.materialize.load_from_hdf5(filename='c5g7-mgxs.h5',
+                                               directory='../../sample-input/')
+
+    def create_geometry(self):
+        """Instantiate the full core pinwheel lattice Geometry."""
+
+        xmin = openmoc.XPlane(x=-2.52, name='xmin')
+        xmax = openmoc.XPlane(x=+2.52, name='xmax')
+        ymin = openmoc.YPlane(y=-2.52, name='ymin')
+        ymax = openmoc.YPlane(y=+2.52, name='ymax')
+        for boundary in [xmin, xmax, ymin, ymax]:
+            boundary.setBoundaryType(openmoc.REFLECTIVE)
+
+        large_zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=0.45,
+                                            name='large pin')
+        small_zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=0.3,
+                                            name='small pin')
+
+        large_fuel = openmoc.Cell(name='large fuel')
+        large_fuel.setFill(self.materials['UO2'])
+        large_fuel.addSurface(halfspace=-1, surface=large_zcylinder)
+        large_moderator = openmoc.Cell(name='large moderator')
+        large_moderator.setFill(self.materials['Water'])
+        large_moderator.addSurface(halfspace=+1, surface=large_zcylinder)
+
+        small_fuel = openmoc.Cell(name='small fuel')
+        small_fuel.setFill(self.materials['MOX-8.7%'])
+        small_fuel.addSurface(halfspace=-1, surface=small_zcylinder)
+        small_moderator = openmoc.Cell(name='small moderator')
+        small_moderator.setFill(self.materials['Water'])
+        small_moderator.addSurface(halfspace=+1, surface=small_zcylinder)
+
+        water = openmoc.Cell(name='water')
+        water.setFill(self.materials['Water'])
+
+        for cell in [large_fuel, large_moderator, small_fuel, small_moderator,
+                     water]:
+            cell.setNumSectors(4)
+
+        large_pin = openmoc.Universe(name='large pin')
+        large_pin.addCell(large_fuel)
+        large_pin.addCell(large_moderator)
+        small_pin = openmoc.Universe(name='small pin')
+        small_pin.addCell(small_fuel)
+        small_pin.addCell(small_moderator)
+        water_pin = openmoc.Universe(name='water pin')
+        water_pin.addCell(water)
+
+        # Each quadrant is the upper right one rotated by 90 degrees
+        l, s, w = large_pin, small_pin, water_pin
+        lattice = openmoc.Lattice(name='pinwheel')
+        lattice.setWidth(width_x=1.26, width_y=1.26)
+        lattice.setUniverses([[[l, w, s, l],
+                               [s, l, l, w],
+                               [w, l, l, s],
+                               [l, s, w, l]]])
+
+        root_cell = openmoc.Cell(name='root cell')
+        root_cell.setFill(lattice)
+        root_cell.addSurface(halfspace=+1, surface=xmin)
+        root_cell.addSurface(halfspace=-1, surface=xmax)
+        root_cell.addSurface(halfspace=+1, surface=ymin)
+        root_cell.addSurface(halfspace=-1, surface=ymax)
+
+        if self.dimensions == 3:
+            zmin = openmoc.ZPlane(z=-1.5, name='zmin')
+            zmax = openmoc.ZPlane(z=+1.5, name='zmax')
+            zmin.setBoundaryType(openmoc.REFLECTIVE)
+            zmax.setBoundaryType(openmoc.VACUUM)
+            root_cell.addSurface(halfspace=+1, surface=zmin)
+            root_cell.addSurface(halfspace=-1, surface=zmax)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(root_cell)
+
+        self.geometry = openmoc.Geometry()
+        self.geometry.setRootUniverse(root_universe)
+
+
+class RotationalBoundariesTestHarness(TestHarness):
+    """Eigenvalue calculations in a 2D and a 3D pinwheel lattice, in the full
+    core and in a quadrant with rotational and reflective boundaries."""
+
+    def __init__(self):
+        super(RotationalBoundariesTestHarness, self).__init__()
+        self.num_azim = 8
+        self.spacing = 0.05
+        self.num_polar = 4
+        self.azim_spacing = 0.3
+        self.z_spacing = 0.1
+        self.tolerance = 1E-6
+        self.cases = [(num_dimensions, symmetry)
+                      for num_dimensions in [2, 3]
+                      for symmetry in ['full core', 'rotational quadrant',
+                                       'reflective quadrant']]
+        self.input_sets = []
+        self.track_generators = []
+        self.solvers = []
+
+    def _create_geometry(self):
+        """Instantiate the full core and the quadrant Geometries."""
+
+        for num_dimensions, symmetry in self.cases:
+            input_set = PinwheelLatticeInput(num_dimensions=num_dimensions)
+            input_set.create_materials()
+            input_set.create_geometry()
+            if symmetry == 'rotational quadrant':
+                input_set.geometry.useRotationalSymmetry()
+            elif symmetry == 'reflective quadrant':
+                input_set.geometry.useSymmetry(True, True, False)
+            self.input_sets.append(input_set)
+
+    def _create_trackgenerator(self):
+        """Instantiate a TrackGenerator for each Geometry."""
+
+        for input_set in self.input_sets:
+            geometry = input_set.geometry
+            geometry.initializeFlatSourceRegions()
+            if input_set.dimensions == 2:
+                track_generator = openmoc.TrackGenerator(
+                    geometry, self.num_azim, self.spacing)
+            else:
+                track_generator = openmoc.TrackGenerator3D(
+                    geometry, self.num_azim, self.num_polar,
+                    self.azim_spacing, self.z_spacing)
+            self.track_generators.append(track_generator)
+
+    def _generate_tracks(self):
+        """Generate Tracks and segments for each Geometry."""
+
+        for track_generator in self.track_generators:
+            self.track_generator = track_generator
+            super(RotationalBoundariesTestHarness, self)._generate_tracks()
+
+    def _create_solver(self):
+        """Instantiate a CPUSolver for each Geometry."""
+
+        for track_generator in self.track_generators:
+            self.track_generator = track_generator
+            super(RotationalBoundariesTestHarness, self)._create_solver()
+            self.solvers.append(self.solver)
+
+    def _run_openmoc(self):
+        """Compute the eigenvalue of the full cores and of the quadrants."""
+
+        for solver in self.solvers:
+            self.solver = solver
+            super(RotationalBoundariesTestHarness, self)._run_openmoc()
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the iteration count and eigenvalue of each calculation."""
+
+        outstr = ''
+        for (num_dimensions, symmetry), solver in zip(self.cases,
+                                                      self.solvers):
+            outstr += '{0}D {1}: Iters: {2}\tkeff: {3:12.5E}\n'.format(
+                num_dimensions, symmetry, solver.getNumIterations(),
+                solver.getKeff())
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = RotationalBoundariesTestHarness()
+    harness.main()
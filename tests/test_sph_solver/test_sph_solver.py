@@ -0,0 +1,167 @@
+#!/usr/bin/env python
+
+import os
+import sys
+import numpy
+sys.path.insert(0, os.pardir)
+sys.path.insert(0, os.path.join(os.pardir, 'openmoc'))
+from testing_harness import TestHarness
+from input_set import InputSet
+import openmoc
+
+
+class VacuumTopPinCellInput(InputSet):
+    """A pin cell with a vacuum boundary at the top."""
+
+    def create_materials(self):
+        """Instantiate C5G7 Materials."""
+        self.materials = \
+            openmoc.materialize.load_from_hdf5(filename='c5g7-mgxs.h5',
+                                               directory='../../sample-input/')
+
+    def create_geometry(self):
+        """Instantiate the pin cell Geometry."""
+
+        zcylinder = openmoc.ZCylinder(x=0.0, y=0.0, radius=1.0, name='pin')
+        xmin = openmoc.XPlane(x=-2.0, name='xmin')
+        xmax = openmoc.XPlane(x=+2.0, name='xmax')
+        ymin = openmoc.YPlane(y=-2.0, name='ymin')
+        ymax = openmoc.YPlane(y=+2.0, name='ymax')
+
+        xmin.setBoundaryType(openmoc.REFLECTIVE)
+        xmax.setBoundaryType(openmoc.REFLECTIVE)
+        ymin.setBoundaryType(openmoc.REFLECTIVE)
+        ymax.setBoundaryType(openmoc.VACUUM)
+
+        self.fuel = openmoc.Cell(name='fuel')
+        self.fuel.setFill(self.materials['UO2'])
+        self.fuel.addSurface(halfspace=-1, surface=zcylinder)
+
+        moderator = openmoc.Cell(name='moderator')
+        moderator.setFill(self.materials['Water'])
+        moderator.addSurface(halfspace=+1, surface=zcylinder)
+        moderator.addSurface(halfspace=+1, surface=xmin)
+        moderator.addSurface(halfspace=-1, surface=xmax)
+        moderator.addSurface(halfspace=+1, surface=ymin)
+        moderator.addSurface(halfspace=-1, surface=ymax)
+
+        root_universe = openmoc.Universe(name='root universe')
+        root_universe.addCell(self.fuel)
+        root_universe.addCell(moderator)
+
+        self.geometry = openmoc.Geometry()
+        self.geometry.setRootUniverse(root_universe)
+
+
+class SPHSolverTestHarness(TestHarness):
+    """SPH factors of a pin cell with a fixed source in the fuel, preserving
+    the fluxes of a finer track laydown, with and without warm starts of the
+    fixed source calculations."""
+
+    def __init__(self):
+        super(SPHSolverTestHarness, self).__init__()
+        self.solution_type = 'flux'
+        self.num_azim = 8
+        self.tolerance = 1E-4
+        self.sph_tolerance = 1E-3
+        self.max_sph_iters = 30
+
+        # The reference laydown, then the cold and warm started SPH models
+        self.laydowns = [(16, 0.05), (self.num_azim, self.spacing),
+                         (self.num_azim, self.spacing)]
+        self.input_sets = [VacuumTopPinCellInput() for laydown in
+                           self.laydowns]
+        self.track_generators = []
+        self.solvers = []
+        self.sph_solvers = []
+
+    def _create_geometry(self):
+        """Instantiate a Geometry for each laydown, since the SPH factors are
+        applied to the Materials."""
+
+        for input_set in self.input_sets:
+            input_set.create_materials()
+            input_set.create_geometry()
+
+    def _create_trackgenerator(self):
+        """Instantiate a TrackGenerator for each laydown."""
+
+        for input_set, (num_azim, spacing) in zip(self.input_sets,
+                                                  self.laydowns):
+            geometry = input_set.geometry
+            geometry.initializeFlatSourceRegions()
+            self.track_generators.append(
+                openmoc.TrackGenerator(geometry, num_azim, spacing))
+
+    def _generate_tracks(self):
+        """Generate Tracks and segments for each laydown."""
+
+        for track_generator in self.track_generators:
+            self.track_generator = track_generator
+            super(SPHSolverTestHarness, self)._generate_tracks()
+
+    def _create_solver(self):
+        """Instantiate a CPUSolver with a fixed source in the fuel for each
+        laydown."""
+
+        for input_set, track_generator in zip(self.input_sets,
+                                              self.track_generators):
+            self.track_generator = track_generator
+            super(SPHSolverTestHarness, self)._create_solver()
+            num_groups = input_set.geometry.getNumEnergyGroups()
+            for group in range(1, num_groups + 1):
+                self.solver.setFixedSourceByCell(input_set.fuel, group, 1.0)
+            self.solvers.append(self.solver)
+
+    def _run_openmoc(self):
+        """Compute reference fluxes with fine tracks, then SPH factors with
+        cold and warm started fixed source calculations."""
+
+        # Volume-averaged reference fluxes of the fuel and the moderator
+        self.solver = self.solvers[0]
+        super(SPHSolverTestHarness, self)._run_openmoc()
+        geometry = self.input_sets[0].geometry
+        materials = self.input_sets[0].materials
+        domains = [materials['UO2'].getId(), materials['Water'].getId()]
+        num_groups = geometry.getNumEnergyGroups()
+        fluxes = numpy.zeros((len(domains), num_groups))
+        volumes = numpy.zeros(len(domains))
+        for fsr in range(geometry.getNumFSRs()):
+            d = domains.index(geometry.findFSRMaterial(fsr).getId())
+            volume = self.solver.getFSRVolume(fsr)
+            volumes[d] += volume
+            for group in range(num_groups):
+                fluxes[d, group] += self.solver.getFlux(fsr, group+1) * volume
+        fluxes /= volumes[:, numpy.newaxis]
+
+        for warm_start, solver in zip([False, True], self.solvers[1:]):
+            sph_solver = openmoc.SPHSolver(solver)
+            sph_solver.setSPHDomains(numpy.double(domains), 'material')
+            sph_solver.setReferenceFluxes(fluxes.flatten())
+            sph_solver.setConvergenceThreshold(self.sph_tolerance)
+            sph_solver.setWarmStart(warm_start)
+            sph_solver.computeSPHFactors(max_sph_iters=self.max_sph_iters)
+            self.sph_solvers.append(sph_solver)
+
+    def _get_results(self, num_iters=False, keff=False, fluxes=False,
+                     num_fsrs=False, num_tracks=False, num_segments=False,
+                     hash_output=False):
+        """Write the SPH iteration and transport sweep counts, and the SPH
+        factors, of the cold and warm started calculations."""
+
+        num_factors = 2 * self.input_sets[0].geometry.getNumEnergyGroups()
+        outstr = ''
+        for name, sph_solver in zip(['Cold', 'Warm'], self.sph_solvers):
+            outstr += '{0} start: Iters: {1}\tSweeps: {2}\n'.format(
+                name, sph_solver.getNumIterations(),
+                sph_solver.getNumTransportSweeps())
+            factors = sph_solver.getSPHFactors(num_factors)
+            outstr += 'SPH factors:\n'
+            outstr += '\n'.join(['{0:12.6E}'.format(factor)
+                                  for factor in factors]) + '\n'
+        return outstr
+
+
+if __name__ == '__main__':
+    harness = SPHSolverTestHarness()
+    harness.main()